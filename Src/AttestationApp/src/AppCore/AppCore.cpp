@@ -34,9 +34,29 @@
 #include "IAttestationLibraryAdapter.h"
 #include "StatusPrinter.h"
 
+#ifndef SGX_TRUSTED
+#include <Utils/Encoding.h>
+#endif //SGX_TRUSTED
+
 namespace intel { namespace sgx { namespace dcap {
 
 namespace {
+
+/**
+ * CRL read from file. PEM CRLs are kept as text, binary DER ones as bytes
+ * (hex encoded text in enclave builds, as enclave interface only takes text).
+ */
+struct CrlFile
+{
+    std::string text;
+    std::vector<uint8_t> der;
+
+    bool isDer() const
+    {
+        return text.empty();
+    }
+};
+
 inline std::string bytesToHexString(const std::vector<uint8_t> &vector)
 {
     std::string result;
@@ -53,6 +73,122 @@ inline std::string bytesToHexString(const std::vector<uint8_t> &vector)
     return result;
 }
 
+// CRL as taken by text API, binary CRLs are hex encoded
+std::string crlToText(const CrlFile& crl)
+{
+    return crl.isDer() ? bytesToHexString(crl.der) : crl.text;
+}
+
+#ifndef SGX_TRUSTED
+// Concatenated DER of every PEM block with given label, false if there is none or any of them can not be decoded
+bool pemToDer(const std::string& pem, const std::string& label, std::vector<uint8_t>& der)
+{
+    const auto beginLine = "-----BEGIN " + label + "-----";
+    der.clear();
+    for (auto pos = pem.find(beginLine); pos != std::string::npos; pos = pem.find(beginLine, pos + beginLine.size()))
+    {
+        std::vector<uint8_t> block;
+        if (decodePem(pem.data() + pos, pem.size() - pos, label, block) != DecodeStatus::OK)
+        {
+            return false;
+        }
+        der.insert(der.end(), block.cbegin(), block.cend());
+    }
+    return !der.empty();
+}
+
+bool certificatesToDer(const std::string& pem, std::vector<uint8_t>& der)
+{
+    return pemToDer(pem, "CERTIFICATE", der);
+}
+
+bool crlToDer(const CrlFile& crl, std::vector<uint8_t>& der)
+{
+    if (crl.isDer())
+    {
+        der = crl.der;
+        return true;
+    }
+    return pemToDer(crl.text, "X509 CRL", der);
+}
+#endif //SGX_TRUSTED
+
+CrlFile readCrl(const IFileReader& fileReader, const std::string& path)
+{
+    static constexpr char PEM_HEADER_STRING_X509_CRL[] = "-----BEGIN X509 CRL-----";
+    CrlFile crl;
+    crl.text = fileReader.readContent(path);
+    if (crl.text.rfind(PEM_HEADER_STRING_X509_CRL, 0) == std::string::npos)
+    {
+#ifdef SGX_TRUSTED
+        crl.text = bytesToHexString(fileReader.readBinaryContent(path));
+#else
+        crl.text.clear();
+        crl.der = fileReader.readBinaryContent(path);
+#endif //SGX_TRUSTED
+    }
+    return crl;
+}
+
+// Calls below pass all certificates and CRLs as DER when any CRL they take was given as DER.
+// If any PEM input can not be converted, they fall back to text API, which reports what is wrong with it.
+
+Status verifyPCKCertificate(const IAttestationLibraryAdapter& attestationLib, const std::string& pckCertChain, const CrlFile& rootCaCrl,
+                            const CrlFile& intermediateCaCrl, const std::string& trustedRootCACert, const time_t& expirationDate)
+{
+#ifndef SGX_TRUSTED
+    std::vector<uint8_t> pckCertChainDer, rootCaCrlDer, intermediateCaCrlDer, trustedRootCACertDer;
+    if ((rootCaCrl.isDer() || intermediateCaCrl.isDer()) &&
+        certificatesToDer(pckCertChain, pckCertChainDer) && crlToDer(rootCaCrl, rootCaCrlDer) &&
+        crlToDer(intermediateCaCrl, intermediateCaCrlDer) && certificatesToDer(trustedRootCACert, trustedRootCACertDer))
+    {
+        return attestationLib.verifyPCKCertificateDer(pckCertChainDer, rootCaCrlDer, intermediateCaCrlDer, trustedRootCACertDer, expirationDate);
+    }
+#endif //SGX_TRUSTED
+    return attestationLib.verifyPCKCertificate(pckCertChain, crlToText(rootCaCrl), crlToText(intermediateCaCrl), trustedRootCACert, expirationDate);
+}
+
+Status verifyTCBInfo(const IAttestationLibraryAdapter& attestationLib, const std::string& tcbInfo, const std::string& tcbSigningChain,
+                     const CrlFile& rootCaCrl, const std::string& trustedRootCACert, const time_t& expirationDate)
+{
+#ifndef SGX_TRUSTED
+    std::vector<uint8_t> tcbSigningChainDer, trustedRootCACertDer;
+    if (rootCaCrl.isDer() &&
+        certificatesToDer(tcbSigningChain, tcbSigningChainDer) && certificatesToDer(trustedRootCACert, trustedRootCACertDer))
+    {
+        return attestationLib.verifyTCBInfoDer(tcbInfo, tcbSigningChainDer, rootCaCrl.der, trustedRootCACertDer, expirationDate);
+    }
+#endif //SGX_TRUSTED
+    return attestationLib.verifyTCBInfo(tcbInfo, tcbSigningChain, crlToText(rootCaCrl), trustedRootCACert, expirationDate);
+}
+
+Status verifyQeIdentity(const IAttestationLibraryAdapter& attestationLib, const std::string& qeIdentity, const std::string& tcbSigningChain,
+                        const CrlFile& rootCaCrl, const std::string& trustedRootCACert, const time_t& expirationDate)
+{
+#ifndef SGX_TRUSTED
+    std::vector<uint8_t> tcbSigningChainDer, trustedRootCACertDer;
+    if (rootCaCrl.isDer() &&
+        certificatesToDer(tcbSigningChain, tcbSigningChainDer) && certificatesToDer(trustedRootCACert, trustedRootCACertDer))
+    {
+        return attestationLib.verifyQeIdentityDer(qeIdentity, tcbSigningChainDer, rootCaCrl.der, trustedRootCACertDer, expirationDate);
+    }
+#endif //SGX_TRUSTED
+    return attestationLib.verifyQeIdentity(qeIdentity, tcbSigningChain, crlToText(rootCaCrl), trustedRootCACert, expirationDate);
+}
+
+Status verifyQuote(const IAttestationLibraryAdapter& attestationLib, const std::vector<uint8_t>& quote, const std::string& pckCert,
+                   const CrlFile& intermediateCaCrl, const std::string& tcbInfo, const std::string& qeIdentity)
+{
+#ifndef SGX_TRUSTED
+    std::vector<uint8_t> pckCertDer;
+    if (intermediateCaCrl.isDer() && certificatesToDer(pckCert, pckCertDer))
+    {
+        return attestationLib.verifyQuoteDer(quote, pckCertDer, intermediateCaCrl.der, tcbInfo, qeIdentity);
+    }
+#endif //SGX_TRUSTED
+    return attestationLib.verifyQuote(quote, pckCert, crlToText(intermediateCaCrl), tcbInfo, qeIdentity);
+}
+
 void outputResult(const std::string& step, Status status, std::ostream& logger)
 {
     if (status != STATUS_OK)
@@ -80,28 +216,19 @@ bool AppCore::runVerification(const AppOptions& options, std::ostream& logger) c
 {
     try
     {
-        static constexpr char PEM_HEADER_STRING_X509_CRL[] = "-----BEGIN X509 CRL-----";
         const auto expirationDate = options.expirationDate;
         const auto pckCert = fileReader->readContent(options.pckCertificateFile);
         const auto pckSigningChain = fileReader->readContent(options.pckSigningChainFile);
         const auto pckCertChain = pckSigningChain + pckCert;
-        auto rootCaCrl = fileReader->readContent(options.rootCaCrlFile);
-        if (rootCaCrl.rfind(PEM_HEADER_STRING_X509_CRL, 0) == std::string::npos)
-        {
-            rootCaCrl = bytesToHexString(fileReader->readBinaryContent(options.rootCaCrlFile));
-        }
-        auto intermediateCaCrl = fileReader->readContent(options.intermediateCaCrlFile);
-        if (intermediateCaCrl.rfind(PEM_HEADER_STRING_X509_CRL, 0) == std::string::npos)
-        {
-            intermediateCaCrl = bytesToHexString(fileReader->readBinaryContent(options.intermediateCaCrlFile));
-        }
+        const auto rootCaCrl = readCrl(*fileReader, options.rootCaCrlFile);
+        const auto intermediateCaCrl = readCrl(*fileReader, options.intermediateCaCrlFile);
         const auto trustedRootCACert = fileReader->readContent(options.trustedRootCACertificateFile);
-        const auto pckVerifyStatus = attestationLib->verifyPCKCertificate(pckCertChain, rootCaCrl, intermediateCaCrl, trustedRootCACert, expirationDate);
+        const auto pckVerifyStatus = verifyPCKCertificate(*attestationLib, pckCertChain, rootCaCrl, intermediateCaCrl, trustedRootCACert, expirationDate);
         outputResult("PCK certificate chain", pckVerifyStatus, logger);
 
         const auto tcbInfo = fileReader->readContent(options.tcbInfoFile);
         const auto tcbSigningCert = fileReader->readContent(options.tcbSigningChainFile);
-        const auto tcbVerifyStatus = attestationLib->verifyTCBInfo(tcbInfo, tcbSigningCert, rootCaCrl, trustedRootCACert, expirationDate);
+        const auto tcbVerifyStatus = verifyTCBInfo(*attestationLib, tcbInfo, tcbSigningCert, rootCaCrl, trustedRootCACert, expirationDate);
         outputResult("TCB info", tcbVerifyStatus, logger);
 
         const auto qeIdentityPresent = !options.qeIdentityFile.empty();
@@ -110,7 +237,7 @@ bool AppCore::runVerification(const AppOptions& options, std::ostream& logger) c
         if (qeIdentityPresent)
         {
             qeIdentity = fileReader->readContent(options.qeIdentityFile);
-            qeIdentityVerifyStatus = attestationLib->verifyQeIdentity(qeIdentity, tcbSigningCert, rootCaCrl, trustedRootCACert, expirationDate);
+            qeIdentityVerifyStatus = verifyQeIdentity(*attestationLib, qeIdentity, tcbSigningCert, rootCaCrl, trustedRootCACert, expirationDate);
             outputResult("QeIdentity", qeIdentityVerifyStatus, logger);
         }
 
@@ -120,12 +247,12 @@ bool AppCore::runVerification(const AppOptions& options, std::ostream& logger) c
         if (qveIdentityPresent)
         {
             qveIdentity = fileReader->readContent(options.qveIdentityFile);
-            qveIdentityVerifyStatus = attestationLib->verifyQeIdentity(qveIdentity, tcbSigningCert, rootCaCrl, trustedRootCACert, expirationDate);
+            qveIdentityVerifyStatus = verifyQeIdentity(*attestationLib, qveIdentity, tcbSigningCert, rootCaCrl, trustedRootCACert, expirationDate);
             outputResult("QveIdentity", qveIdentityVerifyStatus, logger);
         }
 
         const auto quote = fileReader->readBinaryContent(options.quoteFile);
-        const auto quoteVerifyStatus = attestationLib->verifyQuote(quote, pckCert, intermediateCaCrl, tcbInfo, qeIdentity);
+        const auto quoteVerifyStatus = verifyQuote(*attestationLib, quote, pckCert, intermediateCaCrl, tcbInfo, qeIdentity);
         outputResult("Quote", quoteVerifyStatus, logger);
 
         return (pckVerifyStatus == STATUS_OK) && (tcbVerifyStatus == STATUS_OK) && (quoteVerifyStatus == STATUS_OK) &&
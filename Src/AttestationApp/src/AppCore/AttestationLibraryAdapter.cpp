@@ -105,4 +105,52 @@ Status AttestationLibraryAdapter::verifyQeIdentity(const std::string &qeIdentity
 #endif
 }
 
+#ifndef SGX_TRUSTED
+Status AttestationLibraryAdapter::verifyQuoteDer(const std::vector<uint8_t>& quote,
+                                                 const std::vector<uint8_t>& derPckCertificate,
+                                                 const std::vector<uint8_t>& derPckCrl,
+                                                 const std::string& tcbInfo,
+                                                 const std::string& qeIdentity) const
+{
+    const auto qeIdentityRawPtr = qeIdentity.empty() ? nullptr : qeIdentity.c_str();
+    return ::sgxAttestationVerifyQuoteDer(quote.data(), (uint32_t) quote.size(), derPckCertificate.data(), derPckCertificate.size(),
+                                          derPckCrl.data(), derPckCrl.size(), tcbInfo.c_str(), qeIdentityRawPtr);
+}
+
+Status AttestationLibraryAdapter::verifyPCKCertificateDer(const std::vector<uint8_t>& derCertChain,
+                                                          const std::vector<uint8_t>& derRootCaCrl,
+                                                          const std::vector<uint8_t>& derIntermediateCaCrl,
+                                                          const std::vector<uint8_t>& derRootCaCertificate,
+                                                          const time_t& expirationDate) const
+{
+    const std::array<const uint8_t*, 2> crls{{derRootCaCrl.data(), derIntermediateCaCrl.data()}};
+    const std::array<size_t, 2> crlSizes{{derRootCaCrl.size(), derIntermediateCaCrl.size()}};
+    return ::sgxAttestationVerifyPCKCertificateDer(derCertChain.data(), derCertChain.size(), crls.data(), crlSizes.data(),
+                                                   derRootCaCertificate.data(), derRootCaCertificate.size(), &expirationDate);
+}
+
+Status AttestationLibraryAdapter::verifyTCBInfoDer(const std::string& tcbInfo,
+                                                   const std::vector<uint8_t>& derSigningChain,
+                                                   const std::vector<uint8_t>& derRootCaCrl,
+                                                   const std::vector<uint8_t>& derTrustedRootCaCertificate,
+                                                   const time_t& expirationDate) const
+{
+    return ::sgxAttestationVerifyTCBInfoDer(tcbInfo.c_str(), derSigningChain.data(), derSigningChain.size(), derRootCaCrl.data(), derRootCaCrl.size(),
+                                            derTrustedRootCaCertificate.data(), derTrustedRootCaCertificate.size(), &expirationDate);
+}
+
+Status AttestationLibraryAdapter::verifyQeIdentityDer(const std::string& qeIdentity,
+                                                      const std::vector<uint8_t>& derSigningChain,
+                                                      const std::vector<uint8_t>& derRootCaCrl,
+                                                      const std::vector<uint8_t>& derTrustedRootCaCertificate,
+                                                      const time_t& expirationDate) const
+{
+    return ::sgxAttestationVerifyEnclaveIdentityDer(qeIdentity.c_str(),
+                                                    derSigningChain.data(), derSigningChain.size(),
+                                                    derRootCaCrl.data(), derRootCaCrl.size(),
+                                                    derTrustedRootCaCertificate.data(), derTrustedRootCaCertificate.size(),
+                                                    &expirationDate);
+}
+#endif //SGX_TRUSTED
+
 }}}
@@ -72,6 +72,32 @@ public:
                             const std::string& pemTrustedRootCaCertificate,
                             const time_t& expirationDate) const override;
 
+#ifndef SGX_TRUSTED
+    Status verifyQuoteDer(const std::vector<uint8_t>& quote,
+                          const std::vector<uint8_t>& derPckCertificate,
+                          const std::vector<uint8_t>& derPckCrl,
+                          const std::string& tcbInfo,
+                          const std::string& qeIdentity = std::string{}) const override;
+
+    Status verifyPCKCertificateDer(const std::vector<uint8_t>& derCertChain,
+                                   const std::vector<uint8_t>& derRootCaCrl,
+                                   const std::vector<uint8_t>& derIntermediateCaCrl,
+                                   const std::vector<uint8_t>& derRootCaCertificate,
+                                   const time_t& expirationDate) const override;
+
+    Status verifyTCBInfoDer(const std::string& tcbInfo,
+                            const std::vector<uint8_t>& derSigningChain,
+                            const std::vector<uint8_t>& derRootCaCrl,
+                            const std::vector<uint8_t>& derTrustedRootCaCertificate,
+                            const time_t& expirationDate) const override;
+
+    Status verifyQeIdentityDer(const std::string& qeIdentity,
+                               const std::vector<uint8_t>& derSigningChain,
+                               const std::vector<uint8_t>& derRootCaCrl,
+                               const std::vector<uint8_t>& derTrustedRootCaCertificate,
+                               const time_t& expirationDate) const override;
+#endif //SGX_TRUSTED
+
 private:
 #ifdef SGX_TRUSTED
     const EnclaveAdapter enclave = EnclaveAdapter();
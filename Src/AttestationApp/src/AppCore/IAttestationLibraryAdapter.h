@@ -68,6 +68,34 @@ struct IAttestationLibraryAdapter
                                     const std::string& pemRootCaCrl,
                                     const std::string& pemtrustedRootCaCertificate,
                                     const time_t& expirationDate) const = 0;
+
+#ifndef SGX_TRUSTED
+    // Same as above but certificates, chains and CRLs are binary DER, chains are concatenated DER certificates
+
+    virtual Status verifyQuoteDer(const std::vector<uint8_t>& quote,
+                                  const std::vector<uint8_t>& derPckCertificate,
+                                  const std::vector<uint8_t>& derPckCrl,
+                                  const std::string& tcbInfo,
+                                  const std::string& qeIdentity) const = 0;
+
+    virtual Status verifyPCKCertificateDer(const std::vector<uint8_t>& derCertChain,
+                                           const std::vector<uint8_t>& derRootCaCrl,
+                                           const std::vector<uint8_t>& derIntermediateCaCrl,
+                                           const std::vector<uint8_t>& derRootCaCertificate,
+                                           const time_t& expirationDate) const = 0;
+
+    virtual Status verifyTCBInfoDer(const std::string& tcbInfo,
+                                    const std::vector<uint8_t>& derSigningChain,
+                                    const std::vector<uint8_t>& derRootCaCrl,
+                                    const std::vector<uint8_t>& derTrustedRootCaCertificate,
+                                    const time_t& expirationDate) const = 0;
+
+    virtual Status verifyQeIdentityDer(const std::string& qeIdentity,
+                                       const std::vector<uint8_t>& derSigningChain,
+                                       const std::vector<uint8_t>& derRootCaCrl,
+                                       const std::vector<uint8_t>& derTrustedRootCaCertificate,
+                                       const time_t& expirationDate) const = 0;
+#endif //SGX_TRUSTED
 };
 
 }}}
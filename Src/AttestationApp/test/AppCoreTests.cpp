@@ -108,6 +108,79 @@ TEST_F(AppCoreTests, shouldVerifyInputDataFromProvidedFiles)
     EXPECT_TRUE(app.runVerification(options, log));
 }
 
+TEST_F(AppCoreTests, shouldVerifyWithDerInputsWhenCrlFilesAreBinary)
+{
+    const std::vector<uint8_t> rootCaCrlDer = {48, 1, 2};
+    const std::vector<uint8_t> intermediateCaCrlDer = {48, 3, 4};
+    const std::string pckCertPem = "-----BEGIN CERTIFICATE-----\nAQID\n-----END CERTIFICATE-----\n";
+    const std::string pckSigningChainPem = "-----BEGIN CERTIFICATE-----\nBAUG\n-----END CERTIFICATE-----\n";
+    const std::string trustedRootCertPem = "-----BEGIN CERTIFICATE-----\nBwgJ\n-----END CERTIFICATE-----\n";
+    const std::string tcbSigningChainPem = "-----BEGIN CERTIFICATE-----\nCgsM\n-----END CERTIFICATE-----\n";
+    const std::vector<uint8_t> pckCertDer = {1, 2, 3};
+    const std::vector<uint8_t> pckCertChainDer = {4, 5, 6, 1, 2, 3};
+    const std::vector<uint8_t> trustedRootCertDer = {7, 8, 9};
+    const std::vector<uint8_t> tcbSigningChainDer = {10, 11, 12};
+
+    EXPECT_CALL(*fileReaderMock, readContent(options.pckCertificateFile)).WillOnce(Return(pckCertPem));
+    EXPECT_CALL(*fileReaderMock, readContent(options.pckSigningChainFile)).WillOnce(Return(pckSigningChainPem));
+    EXPECT_CALL(*fileReaderMock, readContent(options.rootCaCrlFile)).WillOnce(Return("binary"));
+    EXPECT_CALL(*fileReaderMock, readContent(options.intermediateCaCrlFile)).WillOnce(Return("binary"));
+    EXPECT_CALL(*fileReaderMock, readContent(options.trustedRootCACertificateFile)).WillOnce(Return(trustedRootCertPem));
+    EXPECT_CALL(*fileReaderMock, readContent(options.tcbInfoFile)).WillOnce(Return(tcbInfoContent));
+    EXPECT_CALL(*fileReaderMock, readContent(options.qeIdentityFile)).WillOnce(Return(qeIdentityContent));
+    EXPECT_CALL(*fileReaderMock, readContent(options.qveIdentityFile)).WillOnce(Return(qveIdentityContent));
+    EXPECT_CALL(*fileReaderMock, readContent(options.tcbSigningChainFile)).WillOnce(Return(tcbSigningChainPem));
+    EXPECT_CALL(*fileReaderMock, readBinaryContent(options.rootCaCrlFile)).WillOnce(Return(rootCaCrlDer));
+    EXPECT_CALL(*fileReaderMock, readBinaryContent(options.intermediateCaCrlFile)).WillOnce(Return(intermediateCaCrlDer));
+    EXPECT_CALL(*fileReaderMock, readBinaryContent(options.quoteFile)).WillOnce(Return(quoteContent));
+
+    EXPECT_CALL(*attestationLibraryMock, verifyPCKCertificateDer(pckCertChainDer, rootCaCrlDer, intermediateCaCrlDer, trustedRootCertDer, _))
+        .WillOnce(Return(STATUS_OK));
+    EXPECT_CALL(*attestationLibraryMock, verifyTCBInfoDer(tcbInfoContent, tcbSigningChainDer, rootCaCrlDer, trustedRootCertDer, _))
+        .WillOnce(Return(STATUS_OK));
+    EXPECT_CALL(*attestationLibraryMock, verifyQeIdentityDer(qeIdentityContent, tcbSigningChainDer, rootCaCrlDer, trustedRootCertDer, _))
+        .WillOnce(Return(STATUS_OK));
+    EXPECT_CALL(*attestationLibraryMock, verifyQeIdentityDer(qveIdentityContent, tcbSigningChainDer, rootCaCrlDer, trustedRootCertDer, _))
+        .WillOnce(Return(STATUS_OK));
+    EXPECT_CALL(*attestationLibraryMock, verifyQuoteDer(quoteContent, pckCertDer, intermediateCaCrlDer, tcbInfoContent, qeIdentityContent))
+        .WillOnce(Return(STATUS_OK));
+
+    EXPECT_TRUE(app.runVerification(options, log));
+}
+
+TEST_F(AppCoreTests, shouldFallBackToPemInputsWhenCertificatesCanNotBeConvertedToDer)
+{
+    const std::vector<uint8_t> rootCaCrlDer = {48, 1, 2};
+    const std::vector<uint8_t> intermediateCaCrlDer = {48, 3, 4};
+
+    EXPECT_CALL(*fileReaderMock, readContent(options.pckCertificateFile)).WillOnce(Return(pckCertContent));
+    EXPECT_CALL(*fileReaderMock, readContent(options.pckSigningChainFile)).WillOnce(Return(pckSigningChainContent));
+    EXPECT_CALL(*fileReaderMock, readContent(options.rootCaCrlFile)).WillOnce(Return("binary"));
+    EXPECT_CALL(*fileReaderMock, readContent(options.intermediateCaCrlFile)).WillOnce(Return("binary"));
+    EXPECT_CALL(*fileReaderMock, readContent(options.trustedRootCACertificateFile)).WillOnce(Return(trustedRootCertContent));
+    EXPECT_CALL(*fileReaderMock, readContent(options.tcbInfoFile)).WillOnce(Return(tcbInfoContent));
+    EXPECT_CALL(*fileReaderMock, readContent(options.qeIdentityFile)).WillOnce(Return(qeIdentityContent));
+    EXPECT_CALL(*fileReaderMock, readContent(options.qveIdentityFile)).WillOnce(Return(qveIdentityContent));
+    EXPECT_CALL(*fileReaderMock, readContent(options.tcbSigningChainFile)).WillOnce(Return(tcbSigningChainContent));
+    EXPECT_CALL(*fileReaderMock, readBinaryContent(options.rootCaCrlFile)).WillOnce(Return(rootCaCrlDer));
+    EXPECT_CALL(*fileReaderMock, readBinaryContent(options.intermediateCaCrlFile)).WillOnce(Return(intermediateCaCrlDer));
+    EXPECT_CALL(*fileReaderMock, readBinaryContent(options.quoteFile)).WillOnce(Return(quoteContent));
+
+    // certificates are not PEM, so CRLs are passed hex encoded to text API, which reports the error
+    EXPECT_CALL(*attestationLibraryMock, verifyPCKCertificate(AllOf(HasSubstr(pckCertContent), HasSubstr(pckSigningChainContent)),
+        "300102", "300304", trustedRootCertContent, _)).WillOnce(Return(STATUS_UNSUPPORTED_CERT_FORMAT));
+    EXPECT_CALL(*attestationLibraryMock, verifyTCBInfo(tcbInfoContent, tcbSigningChainContent, "300102", trustedRootCertContent, _))
+        .WillOnce(Return(STATUS_UNSUPPORTED_CERT_FORMAT));
+    EXPECT_CALL(*attestationLibraryMock, verifyQeIdentity(qeIdentityContent, tcbSigningChainContent, "300102", trustedRootCertContent, _))
+        .WillOnce(Return(STATUS_UNSUPPORTED_CERT_FORMAT));
+    EXPECT_CALL(*attestationLibraryMock, verifyQeIdentity(qveIdentityContent, tcbSigningChainContent, "300102", trustedRootCertContent, _))
+        .WillOnce(Return(STATUS_UNSUPPORTED_CERT_FORMAT));
+    EXPECT_CALL(*attestationLibraryMock, verifyQuote(quoteContent, pckCertContent, "300304", tcbInfoContent, qeIdentityContent))
+        .WillOnce(Return(STATUS_UNSUPPORTED_CERT_FORMAT));
+
+    EXPECT_FALSE(app.runVerification(options, log));
+}
+
 TEST_F(AppCoreTests, shouldFailWhenFileOperationFailed)
 {
     std::string exceptionMessage = "Exception message";
@@ -132,7 +205,7 @@ TEST_F(AppCoreTests, shouldFailWhenBinaryFileOperationFailed)
 
 TEST_F(AppCoreTests, shouldFailWhenQuoteValidationFailed)
 {
-    EXPECT_CALL(*fileReaderMock, readContent(_)).WillRepeatedly(Return("content"));
+    EXPECT_CALL(*fileReaderMock, readContent(_)).WillRepeatedly(Return("-----BEGIN X509 CRL-----content"));
     EXPECT_CALL(*fileReaderMock, readBinaryContent(_)).WillRepeatedly(Return(quoteContent));
     EXPECT_CALL(*attestationLibraryMock, verifyTCBInfo(_, _, _, _, _)).WillOnce(Return(STATUS_OK));
     EXPECT_CALL(*attestationLibraryMock, verifyQeIdentity(_, _, _, _, _)).Times(2).WillRepeatedly(Return(STATUS_OK));
@@ -144,7 +217,7 @@ TEST_F(AppCoreTests, shouldFailWhenQuoteValidationFailed)
 
 TEST_F(AppCoreTests, shouldFailWhenPCKCertificateValidationFailed)
 {
-    EXPECT_CALL(*fileReaderMock, readContent(_)).WillRepeatedly(Return("content"));
+    EXPECT_CALL(*fileReaderMock, readContent(_)).WillRepeatedly(Return("-----BEGIN X509 CRL-----content"));
     EXPECT_CALL(*fileReaderMock, readBinaryContent(_)).WillRepeatedly(Return(quoteContent));
     EXPECT_CALL(*attestationLibraryMock, verifyQuote(_, _, _, _, _)).WillOnce(Return(STATUS_OK));
     EXPECT_CALL(*attestationLibraryMock, verifyTCBInfo(_, _, _, _, _)).WillOnce(Return(STATUS_OK));
@@ -158,7 +231,7 @@ TEST_F(AppCoreTests, shouldFailWhenPCKCertificateValidationFailed)
 
 TEST_F(AppCoreTests, shouldFailWhenTCBInfoValidationFailed)
 {
-    EXPECT_CALL(*fileReaderMock, readContent(_)).WillRepeatedly(Return("content"));
+    EXPECT_CALL(*fileReaderMock, readContent(_)).WillRepeatedly(Return("-----BEGIN X509 CRL-----content"));
     EXPECT_CALL(*fileReaderMock, readBinaryContent(_)).WillRepeatedly(Return(quoteContent));
     EXPECT_CALL(*attestationLibraryMock, verifyQuote(_, _, _, _, _)).WillOnce(Return(STATUS_OK));
     EXPECT_CALL(*attestationLibraryMock, verifyPCKCertificate(_, _, _, _, _)).WillOnce(Return(STATUS_OK));
@@ -171,7 +244,7 @@ TEST_F(AppCoreTests, shouldFailWhenTCBInfoValidationFailed)
 
 TEST_F(AppCoreTests, shouldFailWhenQeIdentityValidationFailed)
 {
-    EXPECT_CALL(*fileReaderMock, readContent(_)).WillRepeatedly(Return("content"));
+    EXPECT_CALL(*fileReaderMock, readContent(_)).WillRepeatedly(Return("-----BEGIN X509 CRL-----content"));
     EXPECT_CALL(*fileReaderMock, readBinaryContent(_)).WillRepeatedly(Return(quoteContent));
     EXPECT_CALL(*attestationLibraryMock, verifyQuote(_, _, _, _, _)).WillOnce(Return(STATUS_OK));
     EXPECT_CALL(*attestationLibraryMock, verifyPCKCertificate(_, _, _, _, _)).WillOnce(Return(STATUS_OK));
@@ -186,7 +259,7 @@ TEST_F(AppCoreTests, shouldFailWhenQeIdentityValidationFailed)
 
 TEST_F(AppCoreTests, shouldFailWhenQveIdentityValidationFailed)
 {
-    EXPECT_CALL(*fileReaderMock, readContent(_)).WillRepeatedly(Return("content"));
+    EXPECT_CALL(*fileReaderMock, readContent(_)).WillRepeatedly(Return("-----BEGIN X509 CRL-----content"));
     EXPECT_CALL(*fileReaderMock, readBinaryContent(_)).WillRepeatedly(Return(quoteContent));
     EXPECT_CALL(*attestationLibraryMock, verifyQuote(_, _, _, _, _)).WillOnce(Return(STATUS_OK));
     EXPECT_CALL(*attestationLibraryMock, verifyPCKCertificate(_, _, _, _, _)).WillOnce(Return(STATUS_OK));
@@ -216,7 +289,7 @@ TEST_F(AppCoreTests, shouldVerifyWhenQeIdentityAndQveIdentityFileWasNotGiven)
             0
     };
 
-    EXPECT_CALL(*fileReaderMock, readContent(_)).WillRepeatedly(Return("content"));
+    EXPECT_CALL(*fileReaderMock, readContent(_)).WillRepeatedly(Return("-----BEGIN X509 CRL-----content"));
     EXPECT_CALL(*fileReaderMock, readContent(options.qeIdentityFile)).Times(0);
     EXPECT_CALL(*fileReaderMock, readContent(options.qveIdentityFile)).Times(0);
     EXPECT_CALL(*fileReaderMock, readBinaryContent(_)).WillRepeatedly(Return(quoteContent));
@@ -245,7 +318,7 @@ TEST_F(AppCoreTests, shouldVerifyWhenQeIdentityFileWasNotGiven)
             0
     };
 
-    EXPECT_CALL(*fileReaderMock, readContent(_)).WillRepeatedly(Return("content"));
+    EXPECT_CALL(*fileReaderMock, readContent(_)).WillRepeatedly(Return("-----BEGIN X509 CRL-----content"));
     EXPECT_CALL(*fileReaderMock, readContent(options.qeIdentityFile)).Times(0);
     EXPECT_CALL(*fileReaderMock, readBinaryContent(_)).WillRepeatedly(Return(quoteContent));
     EXPECT_CALL(*attestationLibraryMock, verifyQuote(_, _, _, _, _)).WillOnce(Return(STATUS_OK));
@@ -273,7 +346,7 @@ TEST_F(AppCoreTests, shouldVerifyWhenQveIdentityFileWasNotGiven)
             0
     };
 
-    EXPECT_CALL(*fileReaderMock, readContent(_)).WillRepeatedly(Return("content"));
+    EXPECT_CALL(*fileReaderMock, readContent(_)).WillRepeatedly(Return("-----BEGIN X509 CRL-----content"));
     EXPECT_CALL(*fileReaderMock, readContent(options.qveIdentityFile)).Times(0);
     EXPECT_CALL(*fileReaderMock, readBinaryContent(_)).WillRepeatedly(Return(quoteContent));
     EXPECT_CALL(*attestationLibraryMock, verifyQuote(_, _, _, _, _)).WillOnce(Return(STATUS_OK));
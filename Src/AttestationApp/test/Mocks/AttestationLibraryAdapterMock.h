@@ -45,6 +45,10 @@ public:
     MOCK_CONST_METHOD5(verifyPCKCertificate, Status(const std::string&, const std::string&, const std::string&, const std::string&, const time_t&));
     MOCK_CONST_METHOD5(verifyTCBInfo, Status(const std::string&, const std::string&, const std::string&, const std::string&,const time_t&));
     MOCK_CONST_METHOD5(verifyQeIdentity, Status(const std::string&, const std::string&, const std::string&, const std::string&, const time_t&));
+    MOCK_CONST_METHOD5(verifyQuoteDer, Status(const std::vector<uint8_t>&, const std::vector<uint8_t>&, const std::vector<uint8_t>&, const std::string&, const std::string&));
+    MOCK_CONST_METHOD5(verifyPCKCertificateDer, Status(const std::vector<uint8_t>&, const std::vector<uint8_t>&, const std::vector<uint8_t>&, const std::vector<uint8_t>&, const time_t&));
+    MOCK_CONST_METHOD5(verifyTCBInfoDer, Status(const std::string&, const std::vector<uint8_t>&, const std::vector<uint8_t>&, const std::vector<uint8_t>&, const time_t&));
+    MOCK_CONST_METHOD5(verifyQeIdentityDer, Status(const std::string&, const std::vector<uint8_t>&, const std::vector<uint8_t>&, const std::vector<uint8_t>&, const time_t&));
 };
 }}}}
 
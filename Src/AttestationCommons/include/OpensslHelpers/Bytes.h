@@ -32,6 +32,9 @@
 #ifndef SGX_DCAP_COMMONS_BYTES_H
 #define SGX_DCAP_COMMONS_BYTES_H
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <stdexcept>
 #include <ctype.h>
@@ -39,31 +42,35 @@
 #include <algorithm>
 #include <iterator>
 
+#include "Utils/Encoding.h"
+
 namespace intel { namespace sgx { namespace dcap {
 
 using Bytes = std::vector<uint8_t>;
 
-namespace detail{
-inline uint8_t asciiToValue(const char in)
+/**
+ * Non-owning view of contiguous bytes. Memory it points to has to outlive the view.
+ */
+class ByteRange
 {
-    if (::isxdigit(static_cast<unsigned char>(in)))
-    {
-        if(in >= '0' && in <= '9')
-        {
-            return static_cast<uint8_t>(in - '0');
-        }
-        if(in >= 'A' && in <= 'F')
-        {
-            return static_cast<uint8_t>(in - 'A' + 10);
-        }
-        if(in >= 'a' && in <= 'f')
-        {
-             return static_cast<uint8_t>(in - 'a' + 10);
-        }
-    }
-    throw std::invalid_argument("Invalid hex character");
-}
-}//namespace detail
+public:
+    ByteRange() = default;
+    ByteRange(const uint8_t* data, size_t size): _data(data), _size(size) {}
+    ByteRange(const Bytes& bytes): _data(bytes.data()), _size(bytes.size()) {}
+
+    template<size_t N>
+    ByteRange(const std::array<uint8_t, N>& bytes): _data(bytes.data()), _size(N) {}
+
+    const uint8_t* data() const { return _data; }
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    const uint8_t* begin() const { return _data; }
+    const uint8_t* end() const { return _data + _size; }
+
+private:
+    const uint8_t* _data = nullptr;
+    size_t _size = 0;
+};
 
 inline Bytes operator+(const Bytes& lhs, const Bytes& rhs)
 {
@@ -74,26 +81,12 @@ inline Bytes operator+(const Bytes& lhs, const Bytes& rhs)
 
 inline Bytes hexStringToBytes(const std::string& hexEncoded)
 {
-    try{
-        if (hexEncoded.length() % 2 == 1) {
-            return {};
-        }
-
-        auto pos = hexEncoded.cbegin();
-        Bytes outBuffer;
-        outBuffer.reserve(hexEncoded.length() / 2);
-
-        while (pos < hexEncoded.cend())
-        {
-            outBuffer.push_back(static_cast<uint8_t>(detail::asciiToValue(*(pos + 1)) + (detail::asciiToValue(*pos) << 4)));
-            pos = std::next(pos, 2);
-        }
-        return outBuffer;
-    }
-    catch(const std::invalid_argument&)
+    Bytes outBuffer(hexEncoded.length() / 2);
+    if (decodeHex(hexEncoded.data(), hexEncoded.length(), outBuffer.data()) != DecodeStatus::OK)
     {
         return {};
     }
+    return outBuffer;
 }
 
 inline std::string bytesToHexString(const Bytes &vector)
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGX_DCAP_COMMONS_CIVIL_TIME_H
+#define SGX_DCAP_COMMONS_CIVIL_TIME_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+
+namespace intel { namespace sgx { namespace dcap {
+
+/**
+ * Conversions between UTC calendar dates and seconds since 1 Jan 1970 in proleptic Gregorian calendar.
+ * Nothing here allocates, touches time zone state or uses static buffers, so it is safe to call from many threads.
+ */
+
+/**
+ * @param year - calendar year, e.g. 2021
+ * @param month - month of year in range [1, 12]
+ * @param day - day of month in range [1, 31]
+ * @return number of days since 1 Jan 1970, negative for earlier dates
+ */
+int64_t daysFromCivil(int64_t year, unsigned month, unsigned day);
+
+/**
+ * Inverse of daysFromCivil.
+ */
+void civilFromDays(int64_t days, int64_t& year, unsigned& month, unsigned& day);
+
+bool isLeapYear(int64_t year);
+unsigned daysInMonth(int64_t year, unsigned month);
+
+/**
+ * Reentrant replacement of gmtime, fills all fields of result with tm_isdst set to 0.
+ *
+ * @return false when year does not fit into tm_year
+ */
+bool epochToTm(time_t time, struct tm& result);
+
+/**
+ * Parses "YYYY-MM-DDTHH:MM:SSZ" used by dates in TCB Info, Enclave Identity and CRL JSON structures.
+ * Exactly 20 characters are accepted, fields have to be in range and day has to exist in given month.
+ *
+ * @param text - date text, not null terminated
+ * @param length - length of date text
+ * @param result - set to broken down time on success, tm_isdst is set to 0
+ * @param epoch - set to seconds since 1 Jan 1970 on success
+ * @return true when text is a valid date
+ */
+bool parseIsoTime(const char* text, size_t length, struct tm& result, time_t& epoch);
+
+/**
+ * Converts DER encoded ASN.1 time contents to seconds since 1 Jan 1970.
+ * Only forms mandated by DER are accepted: UTCTime "YYMMDDHHMMSSZ" (years 1950 - 2049 as in RFC 5280)
+ * and GeneralizedTime "YYYYMMDDHHMMSSZ". Callers fall back to OpenSSL for anything else.
+ *
+ * @param data - contents of the time string
+ * @param length - length of contents
+ * @param generalized - true for GeneralizedTime, false for UTCTime
+ * @param epoch - set to seconds since 1 Jan 1970 on success
+ * @return true when contents are in one of the forms above and represent a valid date
+ */
+bool asn1TimeToEpoch(const uint8_t* data, size_t length, bool generalized, time_t& epoch);
+
+}}}
+
+#endif //SGX_DCAP_COMMONS_CIVIL_TIME_H
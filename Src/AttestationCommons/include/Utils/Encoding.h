@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGX_DCAP_COMMONS_ENCODING_H
+#define SGX_DCAP_COMMONS_ENCODING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace intel { namespace sgx { namespace dcap {
+
+enum class DecodeStatus
+{
+    OK,
+    INVALID_LENGTH,         // odd number of hex digits or base64 not padded to full quads
+    INVALID_CHARACTER,      // character outside of alphabet or misplaced base64 padding
+    MISSING_PEM_BOUNDARY    // no BEGIN/END line with expected label
+};
+
+enum class CodecImplementation
+{
+    SCALAR,     // one character at a time, available everywhere
+    SSE4,       // 16 characters per step
+    AVX2        // 32 characters per step
+};
+
+/**
+ * Widest implementation supported by this CPU, scalar in enclave builds.
+ */
+CodecImplementation selectedCodecImplementation();
+
+/**
+ * @return true if implementation can be used on this CPU
+ */
+bool isCodecImplementationSupported(CodecImplementation implementation);
+
+/**
+ * Decodes hex string, both upper and lower case digits are accepted.
+ *
+ * @param hex - hex digits, not null terminated
+ * @param length - number of hex digits
+ * @param out - buffer for at least length / 2 bytes
+ * @return OK or reason why input was rejected, content of out is unspecified then
+ */
+DecodeStatus decodeHex(const char* hex, size_t length, uint8_t* out);
+
+/**
+ * Same as above but with explicitly selected implementation, unsupported one falls back to scalar.
+ */
+DecodeStatus decodeHex(const char* hex, size_t length, uint8_t* out, CodecImplementation implementation);
+
+/**
+ * Decodes padded base64 (RFC 4648 alphabet), whitespace between characters is skipped so PEM body can be passed as is.
+ *
+ * @param base64 - base64 characters, not null terminated
+ * @param length - number of characters
+ * @param out - buffer for at least length / 4 * 3 bytes
+ * @param outLength - number of decoded bytes
+ * @return OK or reason why input was rejected, content of out is unspecified then
+ */
+DecodeStatus decodeBase64(const char* base64, size_t length, uint8_t* out, size_t& outLength);
+
+/**
+ * Same as above but with explicitly selected implementation, unsupported one falls back to scalar.
+ */
+DecodeStatus decodeBase64(const char* base64, size_t length, uint8_t* out, size_t& outLength,
+                          CodecImplementation implementation);
+
+/**
+ * Decodes body of the first PEM block in pem. Only plain blocks are decoded: status is not OK when block with another
+ * label precedes it or when it has encapsulated headers, callers fall back to OpenSSL PEM reader in that case.
+ *
+ * @param pem - PEM text
+ * @param length - length of PEM text
+ * @param label - expected label, e.g. "CERTIFICATE"
+ * @param der - decoded block
+ */
+DecodeStatus decodePem(const char* pem, size_t length, const std::string& label, std::vector<uint8_t>& der);
+
+}}}
+
+#endif //SGX_DCAP_COMMONS_ENCODING_H
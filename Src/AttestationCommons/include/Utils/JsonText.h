@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGX_DCAP_COMMONS_JSON_TEXT_H
+#define SGX_DCAP_COMMONS_JSON_TEXT_H
+
+#include <cstddef>
+
+namespace intel { namespace sgx { namespace dcap {
+
+/**
+ * Finds text of a member of the top level object in JSON that has already been parsed successfully.
+ * Signatures of TCB Info and Enclave Identity are calculated over compact bodies, so text is only returned
+ * when rapidjson::Writer would produce the same bytes: no whitespace, no escape sequences and only integer numbers.
+ *
+ * @param json - JSON text, not null terminated
+ * @param length - length of JSON text
+ * @param name - member name as written in JSON, first occurrence is taken as with rapidjson FindMember
+ * @param text - set to the first character of member value
+ * @param textLength - set to length of member value
+ * @return true when compact member text was found, otherwise caller has to serialize the value itself
+ */
+bool findCompactJsonMember(const char* json, size_t length, const char* name, const char*& text, size_t& textLength);
+
+}}}
+
+#endif //SGX_DCAP_COMMONS_JSON_TEXT_H
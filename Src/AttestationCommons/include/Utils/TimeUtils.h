@@ -33,6 +33,7 @@
 #define SGX_DCAP_PARSERS_TIMEUTILS_H
 
 
+#include <cstddef>
 #include <ctime>
 #include <string>
 
@@ -45,6 +46,13 @@ struct tm getTimeFromString(const std::string& date);
 time_t getEpochTimeFromString(const std::string& date);
 bool isValidTimeString(const std::string& timeString);
 
+/**
+ * Validates and converts "YYYY-MM-DDTHH:MM:SSZ" in one pass.
+ *
+ * @return false when date is not valid, time and epoch are unspecified then
+ */
+bool parseTimeString(const char* date, size_t length, struct tm& time, time_t& epoch);
+
 #ifndef SGX_TRUSTED
 namespace standard
 {
@@ -53,6 +61,7 @@ namespace standard
     time_t getCurrentTime(const time_t *in_time);
     struct tm getTimeFromString(const std::string& date);
     bool isValidTimeString(const std::string& timeString);
+    bool parseTimeString(const char* date, size_t length, struct tm& time, time_t& epoch);
 }
 #endif // SGX_TRUSTED
 
@@ -68,6 +77,7 @@ namespace enclave
     time_t getCurrentTime(const time_t *in_time);
     struct tm getTimeFromString(const std::string& date);
     bool isValidTimeString(const std::string& timeString);
+    bool parseTimeString(const char* date, size_t length, struct tm& time, time_t& epoch);
 }
 
 }}}
@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "CivilTime.h"
+
+#include <limits>
+
+namespace intel { namespace sgx { namespace dcap {
+
+namespace {
+
+constexpr int64_t SECONDS_IN_A_DAY = 24 * 60 * 60;
+constexpr int TM_YEAR_BASE = 1900;
+// Day of week of 1 Jan 1970, counted from Sunday as in tm_wday
+constexpr int64_t EPOCH_WEEKDAY = 4;
+
+static_assert(sizeof(time_t) >= sizeof(int64_t), "time_t size too small, the dates may overflow");
+
+bool readDigits(const char* text, size_t count, unsigned& value)
+{
+    value = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto digit = static_cast<unsigned>(static_cast<unsigned char>(text[i])) - '0';
+        if (digit > 9)
+        {
+            return false;
+        }
+        value = value * 10 + digit;
+    }
+    return true;
+}
+
+bool isValidDateTime(int64_t year, unsigned month, unsigned day, unsigned hour, unsigned minute, unsigned second)
+{
+    return month >= 1 && month <= 12 && day >= 1 && day <= daysInMonth(year, month)
+           && hour <= 23 && minute <= 59 && second <= 59;
+}
+
+time_t toEpoch(int64_t year, unsigned month, unsigned day, unsigned hour, unsigned minute, unsigned second)
+{
+    return static_cast<time_t>(daysFromCivil(year, month, day) * SECONDS_IN_A_DAY
+                               + static_cast<int64_t>(hour * 3600 + minute * 60 + second));
+}
+
+} // anonymous namespace
+
+// Algorithms by Howard Hinnant, http://howardhinnant.github.io/date_algorithms.html
+// Years are shifted to start in March, so leap day is the last day of a year, and split into 400 year eras
+int64_t daysFromCivil(int64_t year, unsigned month, unsigned day)
+{
+    year -= month <= 2 ? 1 : 0;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const auto yearOfEra = static_cast<unsigned>(year - era * 400);
+    const unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + static_cast<int64_t>(dayOfEra) - 719468;
+}
+
+void civilFromDays(int64_t days, int64_t& year, unsigned& month, unsigned& day)
+{
+    days += 719468;
+    const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const auto dayOfEra = static_cast<unsigned>(days - era * 146097);
+    const unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const unsigned shiftedMonth = (5 * dayOfYear + 2) / 153;
+    day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+    month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+    year = static_cast<int64_t>(yearOfEra) + era * 400 + (month <= 2 ? 1 : 0);
+}
+
+bool isLeapYear(int64_t year)
+{
+    return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+}
+
+unsigned daysInMonth(int64_t year, unsigned month)
+{
+    static constexpr unsigned DAYS_IN_MONTH[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    if (month == 2 && isLeapYear(year))
+    {
+        return 29;
+    }
+    return DAYS_IN_MONTH[(month - 1) % 12];
+}
+
+bool epochToTm(time_t time, struct tm& result)
+{
+    const auto seconds = static_cast<int64_t>(time);
+    int64_t days = seconds / SECONDS_IN_A_DAY;
+    int64_t secondOfDay = seconds % SECONDS_IN_A_DAY;
+    if (secondOfDay < 0)
+    {
+        secondOfDay += SECONDS_IN_A_DAY;
+        --days;
+    }
+
+    int64_t year = 0;
+    unsigned month = 0;
+    unsigned day = 0;
+    civilFromDays(days, year, month, day);
+    if (year - TM_YEAR_BASE < std::numeric_limits<int>::min() || year - TM_YEAR_BASE > std::numeric_limits<int>::max())
+    {
+        return false;
+    }
+
+    int64_t weekday = (days + EPOCH_WEEKDAY) % 7;
+    if (weekday < 0)
+    {
+        weekday += 7;
+    }
+
+    result = tm{};
+    result.tm_year = static_cast<int>(year - TM_YEAR_BASE);
+    result.tm_mon = static_cast<int>(month - 1);
+    result.tm_mday = static_cast<int>(day);
+    result.tm_hour = static_cast<int>(secondOfDay / 3600);
+    result.tm_min = static_cast<int>(secondOfDay / 60 % 60);
+    result.tm_sec = static_cast<int>(secondOfDay % 60);
+    result.tm_wday = static_cast<int>(weekday);
+    result.tm_yday = static_cast<int>(days - daysFromCivil(year, 1, 1));
+    result.tm_isdst = 0;
+    return true;
+}
+
+bool parseIsoTime(const char* text, size_t length, struct tm& result, time_t& epoch)
+{
+    static constexpr size_t ISO_TIME_LENGTH = 20; // YYYY-MM-DDTHH:MM:SSZ
+    if (text == nullptr || length != ISO_TIME_LENGTH
+        || text[4] != '-' || text[7] != '-' || text[10] != 'T' || text[13] != ':' || text[16] != ':' || text[19] != 'Z')
+    {
+        return false;
+    }
+
+    unsigned year, month, day, hour, minute, second;
+    if (!readDigits(text, 4, year) || !readDigits(text + 5, 2, month) || !readDigits(text + 8, 2, day)
+        || !readDigits(text + 11, 2, hour) || !readDigits(text + 14, 2, minute) || !readDigits(text + 17, 2, second)
+        || !isValidDateTime(year, month, day, hour, minute, second))
+    {
+        return false;
+    }
+
+    epoch = toEpoch(year, month, day, hour, minute, second);
+    return epochToTm(epoch, result);
+}
+
+bool asn1TimeToEpoch(const uint8_t* data, size_t length, bool generalized, time_t& epoch)
+{
+    static constexpr size_t UTC_TIME_LENGTH = 13;         // YYMMDDHHMMSSZ
+    static constexpr size_t GENERALIZED_TIME_LENGTH = 15; // YYYYMMDDHHMMSSZ
+    const size_t yearDigits = generalized ? 4 : 2;
+    if (data == nullptr || length != (generalized ? GENERALIZED_TIME_LENGTH : UTC_TIME_LENGTH) || data[length - 1] != 'Z')
+    {
+        return false;
+    }
+
+    const auto text = reinterpret_cast<const char*>(data);
+    unsigned year, month, day, hour, minute, second;
+    if (!readDigits(text, yearDigits, year) || !readDigits(text + yearDigits, 2, month)
+        || !readDigits(text + yearDigits + 2, 2, day) || !readDigits(text + yearDigits + 4, 2, hour)
+        || !readDigits(text + yearDigits + 6, 2, minute) || !readDigits(text + yearDigits + 8, 2, second))
+    {
+        return false;
+    }
+    if (!generalized)
+    {
+        year += year < 50 ? 2000 : 1900;
+    }
+    if (!isValidDateTime(year, month, day, hour, minute, second))
+    {
+        return false;
+    }
+
+    epoch = toEpoch(year, month, day, hour, minute, second);
+    return true;
+}
+
+}}}
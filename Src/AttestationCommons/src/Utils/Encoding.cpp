@@ -0,0 +1,445 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "Encoding.h"
+
+#include <algorithm>
+#include <array>
+
+// Enclaves can't execute CPUID, so only scalar implementation is available there
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(SGX_TRUSTED)
+#define ENCODING_SIMD
+#include <immintrin.h>
+#endif
+
+namespace intel { namespace sgx { namespace dcap {
+
+namespace {
+
+constexpr int8_t BASE64_INVALID = -1;
+constexpr int8_t BASE64_WHITESPACE = -2;
+constexpr int8_t BASE64_PADDING = -3;
+
+const std::array<int8_t, 256>& hexValues()
+{
+    static const auto values = []() {
+        std::array<int8_t, 256> table{};
+        table.fill(-1);
+        for (int8_t value = 0; value < 16; value++)
+        {
+            table[static_cast<unsigned char>("0123456789abcdef"[value])] = value;
+            table[static_cast<unsigned char>("0123456789ABCDEF"[value])] = value;
+        }
+        return table;
+    }();
+    return values;
+}
+
+DecodeStatus decodeHexScalar(const char* hex, size_t length, uint8_t* out)
+{
+    const auto& values = hexValues();
+    for (size_t i = 0; i < length; i += 2)
+    {
+        const auto high = values[static_cast<unsigned char>(hex[i])];
+        const auto low = values[static_cast<unsigned char>(hex[i + 1])];
+        if (high < 0 || low < 0)
+        {
+            return DecodeStatus::INVALID_CHARACTER;
+        }
+        out[i / 2] = static_cast<uint8_t>((high << 4) | low);
+    }
+    return DecodeStatus::OK;
+}
+
+const std::array<int8_t, 256>& base64Values()
+{
+    static const auto values = []() {
+        std::array<int8_t, 256> table{};
+        table.fill(BASE64_INVALID);
+        const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        for (int8_t value = 0; value < 64; value++)
+        {
+            table[static_cast<unsigned char>(alphabet[value])] = value;
+        }
+        for (const char whitespace : {' ', '\t', '\r', '\n'})
+        {
+            table[static_cast<unsigned char>(whitespace)] = BASE64_WHITESPACE;
+        }
+        table['='] = BASE64_PADDING;
+        return table;
+    }();
+    return values;
+}
+
+#ifdef ENCODING_SIMD
+
+// hex digits to nibble values, valid is cleared for lanes that are not hex digits
+__attribute__((target("sse4.1"))) inline __m128i hexNibbles(__m128i chars, __m128i& valid)
+{
+    const auto digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    const auto isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    const auto letter = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const auto isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+    valid = _mm_and_si128(valid, _mm_or_si128(isDigit, isLetter));
+    return _mm_blendv_epi8(_mm_add_epi8(letter, _mm_set1_epi8(10)), digit, isDigit);
+}
+
+// decodes full 32 character blocks, stops before block with invalid character and returns number of characters decoded
+__attribute__((target("sse4.1")))
+size_t decodeHexSse4(const char* hex, size_t length, uint8_t* out)
+{
+    // high nibble is even character of each pair: high * 16 + low
+    const auto weights = _mm_set1_epi16(0x0110);
+    size_t i = 0;
+    for (; length - i >= 32; i += 32)
+    {
+        auto valid = _mm_set1_epi8(-1);
+        const auto first = hexNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex + i)), valid);
+        const auto second = hexNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex + i + 16)), valid);
+        if (_mm_movemask_epi8(valid) != 0xFFFF)
+        {
+            break;
+        }
+        const auto bytes = _mm_packus_epi16(_mm_maddubs_epi16(first, weights), _mm_maddubs_epi16(second, weights));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i / 2), bytes);
+    }
+    return i;
+}
+
+__attribute__((target("avx2"))) inline __m256i hexNibbles(__m256i chars, __m256i& valid)
+{
+    const auto digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+    const auto isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+    const auto letter = _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    const auto isLetter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter, _mm256_set1_epi8(5)), letter);
+    valid = _mm256_and_si256(valid, _mm256_or_si256(isDigit, isLetter));
+    return _mm256_blendv_epi8(_mm256_add_epi8(letter, _mm256_set1_epi8(10)), digit, isDigit);
+}
+
+__attribute__((target("avx2")))
+size_t decodeHexAvx2(const char* hex, size_t length, uint8_t* out)
+{
+    const auto weights = _mm256_set1_epi16(0x0110);
+    size_t i = 0;
+    for (; length - i >= 64; i += 64)
+    {
+        auto valid = _mm256_set1_epi8(-1);
+        const auto first = hexNibbles(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(hex + i)), valid);
+        const auto second = hexNibbles(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(hex + i + 32)), valid);
+        if (_mm256_movemask_epi8(valid) != -1)
+        {
+            break;
+        }
+        // packing works within 128 bit lanes, restore order of 64 bit quarters afterwards
+        const auto packed = _mm256_packus_epi16(_mm256_maddubs_epi16(first, weights), _mm256_maddubs_epi16(second, weights));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i / 2), _mm256_permute4x64_epi64(packed, 0xD8));
+    }
+    return i;
+}
+
+/*
+ * Base64 kernels map characters to 6 bit values with nibble lookups: character is valid when its entries in lut_lo
+ * (by low nibble) and lut_hi (by high nibble) share no bit, then offset picked by high nibble (and '/') is added.
+ * Four 6 bit values are merged into three bytes with multiply-add and shuffle.
+ */
+#define BASE64_LUT_LO 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A
+#define BASE64_LUT_HI 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10
+#define BASE64_LUT_ROLL 0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0
+#define BASE64_SHUFFLE 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1
+
+// decodes full 16 character blocks while at least 24 characters remain, so 16 byte store never exceeds output buffer
+__attribute__((target("sse4.1")))
+size_t decodeBase64Sse4(const char* base64, size_t length, uint8_t* out)
+{
+    const auto lutLo = _mm_setr_epi8(BASE64_LUT_LO);
+    const auto lutHi = _mm_setr_epi8(BASE64_LUT_HI);
+    const auto lutRoll = _mm_setr_epi8(BASE64_LUT_ROLL);
+    const auto shuffle = _mm_setr_epi8(BASE64_SHUFFLE);
+    const auto mask2F = _mm_set1_epi8(0x2F);
+    size_t i = 0;
+    for (; length - i >= 24; i += 16, out += 12)
+    {
+        auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(base64 + i));
+        const auto hiNibbles = _mm_and_si128(_mm_srli_epi32(chars, 4), mask2F);
+        const auto loNibbles = _mm_and_si128(chars, mask2F);
+        const auto hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+        const auto lo = _mm_shuffle_epi8(lutLo, loNibbles);
+        if (!_mm_testz_si128(lo, hi))
+        {
+            break;
+        }
+        const auto roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(_mm_cmpeq_epi8(chars, mask2F), hiNibbles));
+        chars = _mm_add_epi8(chars, roll);
+
+        const auto pairs = _mm_maddubs_epi16(chars, _mm_set1_epi32(0x01400140));
+        const auto triples = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_shuffle_epi8(triples, shuffle));
+    }
+    return i;
+}
+
+// decodes full 32 character blocks while at least 48 characters remain, so 32 byte store never exceeds output buffer
+__attribute__((target("avx2")))
+size_t decodeBase64Avx2(const char* base64, size_t length, uint8_t* out)
+{
+    const auto lutLo = _mm256_setr_epi8(BASE64_LUT_LO, BASE64_LUT_LO);
+    const auto lutHi = _mm256_setr_epi8(BASE64_LUT_HI, BASE64_LUT_HI);
+    const auto lutRoll = _mm256_setr_epi8(BASE64_LUT_ROLL, BASE64_LUT_ROLL);
+    const auto shuffle = _mm256_setr_epi8(BASE64_SHUFFLE, BASE64_SHUFFLE);
+    const auto mask2F = _mm256_set1_epi8(0x2F);
+    size_t i = 0;
+    for (; length - i >= 48; i += 32, out += 24)
+    {
+        auto chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(base64 + i));
+        const auto hiNibbles = _mm256_and_si256(_mm256_srli_epi32(chars, 4), mask2F);
+        const auto loNibbles = _mm256_and_si256(chars, mask2F);
+        const auto hi = _mm256_shuffle_epi8(lutHi, hiNibbles);
+        const auto lo = _mm256_shuffle_epi8(lutLo, loNibbles);
+        if (!_mm256_testz_si256(lo, hi))
+        {
+            break;
+        }
+        const auto roll = _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(_mm256_cmpeq_epi8(chars, mask2F), hiNibbles));
+        chars = _mm256_add_epi8(chars, roll);
+
+        const auto pairs = _mm256_maddubs_epi16(chars, _mm256_set1_epi32(0x01400140));
+        const auto triples = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+        // 12 bytes in low half of each lane, move them together
+        const auto packed = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(triples, shuffle), _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), packed);
+    }
+    return i;
+}
+
+#undef BASE64_LUT_LO
+#undef BASE64_LUT_HI
+#undef BASE64_LUT_ROLL
+#undef BASE64_SHUFFLE
+
+#endif // ENCODING_SIMD
+
+size_t decodeHexBlocks(const char* hex, size_t length, uint8_t* out, CodecImplementation implementation)
+{
+    switch (implementation)
+    {
+#ifdef ENCODING_SIMD
+        case CodecImplementation::AVX2:
+            return decodeHexAvx2(hex, length, out);
+        case CodecImplementation::SSE4:
+            return decodeHexSse4(hex, length, out);
+#endif
+        case CodecImplementation::SCALAR:
+        default:
+            return 0;
+    }
+}
+
+size_t decodeBase64Blocks(const char* base64, size_t length, uint8_t* out, CodecImplementation implementation)
+{
+    switch (implementation)
+    {
+#ifdef ENCODING_SIMD
+        case CodecImplementation::AVX2:
+            return decodeBase64Avx2(base64, length, out);
+        case CodecImplementation::SSE4:
+            return decodeBase64Sse4(base64, length, out);
+#endif
+        case CodecImplementation::SCALAR:
+        default:
+            return 0;
+    }
+}
+
+} // anonymous namespace
+
+bool isCodecImplementationSupported(CodecImplementation implementation)
+{
+    switch (implementation)
+    {
+        case CodecImplementation::SCALAR:
+            return true;
+#ifdef ENCODING_SIMD
+        case CodecImplementation::SSE4:
+            return __builtin_cpu_supports("sse4.1");
+        case CodecImplementation::AVX2:
+            return __builtin_cpu_supports("avx2");
+#else
+        case CodecImplementation::SSE4:
+        case CodecImplementation::AVX2:
+            return false;
+#endif
+    }
+    return false;
+}
+
+CodecImplementation selectedCodecImplementation()
+{
+    static const auto selected = isCodecImplementationSupported(CodecImplementation::AVX2) ? CodecImplementation::AVX2 :
+                                 isCodecImplementationSupported(CodecImplementation::SSE4) ? CodecImplementation::SSE4 :
+                                 CodecImplementation::SCALAR;
+    return selected;
+}
+
+DecodeStatus decodeHex(const char* hex, size_t length, uint8_t* out)
+{
+    return decodeHex(hex, length, out, selectedCodecImplementation());
+}
+
+DecodeStatus decodeHex(const char* hex, size_t length, uint8_t* out, CodecImplementation implementation)
+{
+    if (length % 2 != 0)
+    {
+        return DecodeStatus::INVALID_LENGTH;
+    }
+    if (!isCodecImplementationSupported(implementation))
+    {
+        implementation = CodecImplementation::SCALAR;
+    }
+
+    // blocks with invalid characters are left to scalar loop which reports them
+    const auto decoded = decodeHexBlocks(hex, length, out, implementation);
+    return decodeHexScalar(hex + decoded, length - decoded, out + decoded / 2);
+}
+
+DecodeStatus decodeBase64(const char* base64, size_t length, uint8_t* out, size_t& outLength)
+{
+    return decodeBase64(base64, length, out, outLength, selectedCodecImplementation());
+}
+
+DecodeStatus decodeBase64(const char* base64, size_t length, uint8_t* out, size_t& outLength,
+                          CodecImplementation implementation)
+{
+    if (!isCodecImplementationSupported(implementation))
+    {
+        implementation = CodecImplementation::SCALAR;
+    }
+
+    const auto& values = base64Values();
+    const auto outBegin = out;
+    uint32_t quad = 0;
+    size_t quadSize = 0;
+    size_t padding = 0;
+    bool finished = false;
+    size_t i = 0;
+    while (i < length)
+    {
+        // runs of alphabet characters between line breaks go through vector kernel
+        if (quadSize == 0 && !finished)
+        {
+            const auto decoded = decodeBase64Blocks(base64 + i, length - i, out, implementation);
+            i += decoded;
+            out += decoded / 4 * 3;
+            if (i == length)
+            {
+                break;
+            }
+        }
+
+        const auto value = values[static_cast<unsigned char>(base64[i++])];
+        if (value == BASE64_WHITESPACE)
+        {
+            continue;
+        }
+        if (finished)
+        {
+            return DecodeStatus::INVALID_CHARACTER;
+        }
+        if (value == BASE64_PADDING)
+        {
+            // padding completes quad that has at least two characters
+            if (quadSize < 2)
+            {
+                return DecodeStatus::INVALID_CHARACTER;
+            }
+            padding++;
+            if (quadSize + padding == 4)
+            {
+                quad <<= 6 * padding;
+                *out++ = static_cast<uint8_t>(quad >> 16);
+                if (quadSize == 3)
+                {
+                    *out++ = static_cast<uint8_t>(quad >> 8);
+                }
+                finished = true;
+            }
+            continue;
+        }
+        if (value == BASE64_INVALID || padding != 0)
+        {
+            return DecodeStatus::INVALID_CHARACTER;
+        }
+
+        quad = (quad << 6) | static_cast<uint32_t>(value);
+        if (++quadSize == 4)
+        {
+            *out++ = static_cast<uint8_t>(quad >> 16);
+            *out++ = static_cast<uint8_t>(quad >> 8);
+            *out++ = static_cast<uint8_t>(quad);
+            quad = 0;
+            quadSize = 0;
+        }
+    }
+
+    if (quadSize != 0 && !finished)
+    {
+        return DecodeStatus::INVALID_LENGTH;
+    }
+    outLength = static_cast<size_t>(out - outBegin);
+    return DecodeStatus::OK;
+}
+
+DecodeStatus decodePem(const char* pem, size_t length, const std::string& label, std::vector<uint8_t>& der)
+{
+    static const std::string beginMarker = "-----BEGIN ";
+    const auto pemEnd = pem + length;
+    const auto begin = std::search(pem, pemEnd, beginMarker.cbegin(), beginMarker.cend());
+    const auto beginLine = beginMarker + label + "-----";
+    if (static_cast<size_t>(pemEnd - begin) < beginLine.size() || !std::equal(beginLine.cbegin(), beginLine.cend(), begin))
+    {
+        return DecodeStatus::MISSING_PEM_BOUNDARY;
+    }
+    const auto bodyBegin = begin + beginLine.size();
+    const auto endLine = "-----END " + label + "-----";
+    const auto bodyEnd = std::search(bodyBegin, pemEnd, endLine.cbegin(), endLine.cend());
+    if (bodyEnd == pemEnd)
+    {
+        return DecodeStatus::MISSING_PEM_BOUNDARY;
+    }
+
+    const auto bodyLength = static_cast<size_t>(bodyEnd - bodyBegin);
+    der.resize(bodyLength / 4 * 3);
+    size_t derLength = 0;
+    const auto status = decodeBase64(bodyBegin, bodyLength, der.data(), derLength);
+    der.resize(status == DecodeStatus::OK ? derLength : 0);
+    return status;
+}
+
+}}}
@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "JsonText.h"
+
+#include <algorithm>
+
+namespace intel { namespace sgx { namespace dcap {
+
+namespace {
+
+// Longer integers may not fit 64 bits and would be written back as doubles
+constexpr size_t MAX_COMPACT_NUMBER_DIGITS = 18;
+
+bool isWhitespace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+bool isNumberCharacter(char c)
+{
+    return isDigit(c) || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+}
+
+const char* skipWhitespace(const char* position, const char* end)
+{
+    while (position < end && isWhitespace(*position))
+    {
+        position++;
+    }
+    return position;
+}
+
+// position points at opening quote, returns position after closing quote or nullptr for unterminated string
+const char* skipString(const char* position, const char* end, bool& escaped)
+{
+    for (position++; position < end; position++)
+    {
+        if (*position == '"')
+        {
+            return position + 1;
+        }
+        if (*position == '\\')
+        {
+            escaped = true;
+            position++;
+        }
+    }
+    return nullptr;
+}
+
+// Returns position after the value or nullptr when it is not complete
+const char* skipValue(const char* position, const char* end, bool& compact)
+{
+    size_t depth = 0;
+    do
+    {
+        if (position >= end)
+        {
+            return nullptr;
+        }
+
+        switch (*position)
+        {
+            case '"':
+            {
+                bool escaped = false;
+                position = skipString(position, end, escaped);
+                if (position == nullptr)
+                {
+                    return nullptr;
+                }
+                compact = compact && !escaped;
+                break;
+            }
+            case '{':
+            case '[':
+                depth++;
+                position++;
+                break;
+            case '}':
+            case ']':
+                if (depth == 0)
+                {
+                    return nullptr;
+                }
+                depth--;
+                position++;
+                break;
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\r':
+                // whitespace between tokens is the only thing Writer doesn't reproduce outside of strings and numbers
+                compact = false;
+                position++;
+                break;
+            case '-':
+            case '0': case '1': case '2': case '3': case '4':
+            case '5': case '6': case '7': case '8': case '9':
+            {
+                const bool negative = *position == '-';
+                const char* const digits = negative ? position + 1 : position;
+                position = digits;
+                while (position < end && isDigit(*position))
+                {
+                    position++;
+                }
+                const auto digitCount = static_cast<size_t>(position - digits);
+                if (digitCount > MAX_COMPACT_NUMBER_DIGITS || (negative && digitCount > 0 && *digits == '0'))
+                {
+                    compact = false;
+                }
+                if (position < end && isNumberCharacter(*position))
+                {
+                    // fraction or exponent, Writer prints doubles in its own format
+                    compact = false;
+                    while (position < end && isNumberCharacter(*position))
+                    {
+                        position++;
+                    }
+                }
+                break;
+            }
+            default:
+                // separators and true, false, null literals
+                position++;
+                break;
+        }
+    } while (depth > 0);
+    return position;
+}
+
+} // anonymous namespace
+
+bool findCompactJsonMember(const char* json, size_t length, const char* name, const char*& text, size_t& textLength)
+{
+    if (json == nullptr || name == nullptr)
+    {
+        return false;
+    }
+
+    const char* const end = json + length;
+    const char* position = skipWhitespace(json, end);
+    if (position == end || *position != '{')
+    {
+        return false;
+    }
+    position++;
+
+    while (true)
+    {
+        position = skipWhitespace(position, end);
+        if (position == end || *position != '"')
+        {
+            // end of object or unexpected input, member not found
+            return false;
+        }
+
+        bool escaped = false;
+        const char* const key = position + 1;
+        position = skipString(position, end, escaped);
+        if (position == nullptr || escaped)
+        {
+            // escaped names can't be compared as written, so an earlier duplicate could be missed
+            return false;
+        }
+        const auto keyLength = static_cast<size_t>(position - 1 - key);
+
+        position = skipWhitespace(position, end);
+        if (position == end || *position != ':')
+        {
+            return false;
+        }
+        position = skipWhitespace(position + 1, end);
+
+        bool compact = true;
+        const char* const value = position;
+        position = skipValue(position, end, compact);
+        if (position == nullptr)
+        {
+            return false;
+        }
+
+        size_t nameLength = 0;
+        while (name[nameLength] != '\0' && nameLength <= keyLength)
+        {
+            nameLength++;
+        }
+        if (nameLength == keyLength && std::equal(key, key + keyLength, name))
+        {
+            if (!compact)
+            {
+                return false;
+            }
+            text = value;
+            textLength = static_cast<size_t>(position - value);
+            return true;
+        }
+
+        position = skipWhitespace(position, end);
+        if (position == end || *position != ',')
+        {
+            return false;
+        }
+        position++;
+    }
+}
+
+}}}
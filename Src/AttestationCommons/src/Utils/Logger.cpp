@@ -31,6 +31,7 @@
 
 #include <Utils/Logger.h>
 #ifdef SGX_LOGS
+#include <Utils/CivilTime.h>
 #include <spdlog/sinks/stdout_sinks.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #endif
@@ -136,7 +137,9 @@ std::string timeToString(const time_t time)
 {
 #ifdef SGX_LOGS
     char dateStr[20];
-    std::strftime(dateStr, sizeof(dateStr), "%Y-%m-%d %H:%M:%S", std::gmtime(&time));
+    struct tm utcTime{};
+    epochToTm(time, utcTime);
+    std::strftime(dateStr, sizeof(dateStr), "%Y-%m-%d %H:%M:%S", &utcTime);
     return dateStr;
 #else
     return std::to_string(time);
@@ -30,16 +30,13 @@
  */
 
 #include "TimeUtils.h"
+#include "CivilTime.h"
 
 #include <chrono>
 #include <stdexcept>
 
 #ifndef SGX_TRUSTED
-#include <sstream>
-#include <iomanip>
-#include <regex>
 #include <time.h>
-
 #endif
 
 extern struct tm *
@@ -86,12 +83,14 @@ tm getTimeFromString(const std::string& date)
 
 time_t getEpochTimeFromString(const std::string& date)
 {
-    auto time = getTimeFromString(date);
-#ifdef SGX_TRUSTED
-    return enclave::mktime(&time);
-#else // SGX_TRUSTED
-    return standard::mktime(&time);
-#endif
+    struct tm time{};
+    time_t epoch = 0;
+    if (parseTimeString(date.c_str(), date.length(), time, epoch))
+    {
+        return epoch;
+    }
+    time = tm{};
+    return dcap::mktime(&time);
 }
 
 bool isValidTimeString(const std::string& timeString)
@@ -103,6 +102,15 @@ bool isValidTimeString(const std::string& timeString)
 #endif // SGX_TRUSTED
 }
 
+bool parseTimeString(const char* date, size_t length, struct tm& time, time_t& epoch)
+{
+#ifdef SGX_TRUSTED
+    return enclave::parseTimeString(date, length, time, epoch);
+#else
+    return standard::parseTimeString(date, length, time, epoch);
+#endif // SGX_TRUSTED
+}
+
 #ifndef SGX_TRUSTED
 namespace standard
 {
@@ -112,15 +120,15 @@ namespace standard
         {
             throw std::runtime_error("Timestamp has invalid value");
         }
-        #ifdef _MSC_VER
-            #pragma warning(push)
-            #pragma warning(disable: 4996)
-        #endif
-        return std::gmtime(timep);
-        #ifdef _MSC_VER
-            #pragma warning(pop)
-        #endif
+        // per thread buffer keeps std::gmtime contract of returning a pointer without sharing it between threads
+        thread_local struct tm result;
+        if (!epochToTm(*timep, result))
+        {
+            return nullptr;
+        }
+        return &result;
     }
+
     time_t mktime(struct tm* tmp)
     {
 #ifdef _MSC_VER
@@ -142,37 +150,25 @@ namespace standard
 
     bool isValidTimeString(const std::string& timeString)
     {
-        // to make sure that this doesn't happen on windows:
-        // https://developercommunity.visualstudio.com/content/problem/18311/stdget-time-asserts-with-istreambuf-iterator-is-no.html
-        // first check with regex
-        std::regex timeRegex("[0-9]{4}-[0-9]{2}-[0-9]{2}T[0-9]{2}:[0-9]{2}:[0-9]{2}Z");
-        if (!std::regex_match(timeString, timeRegex))
-        {
-            return false;
-        }
-        std::tm time{};
-        std::istringstream input(timeString);
-        input >> std::get_time(&time, "%Y-%m-%dT%H:%M:%SZ");
-
-        //if tm format is incorrect, mktime will modify it. If it's correct time format, it'll keep it.
-        //e.g. giving mktime a date of 32/may/2019, it will change it to 2/june/2019, this way we know if the input time is correct or not.
-        auto validate = time;
-        standard::mktime(&time);
-        if (validate.tm_year != time.tm_year || validate.tm_mon != time.tm_mon ||
-            validate.tm_mday != time.tm_mday || validate.tm_hour != time.tm_hour ||
-            validate.tm_min != time.tm_min || validate.tm_sec != time.tm_sec)
-        {
-            return false;
-        }
-        return !input.fail();
+        struct tm time;
+        time_t epoch;
+        return parseIsoTime(timeString.c_str(), timeString.length(), time, epoch);
     }
 
     struct tm getTimeFromString(const std::string& date)
     {
         struct tm date_c{};
-        std::istringstream input(date);
-        input >> std::get_time(&date_c, "%Y-%m-%dT%H:%M:%SZ");
-        return date_c;
+        time_t epoch;
+        if (parseIsoTime(date.c_str(), date.length(), date_c, epoch))
+        {
+            return date_c;
+        }
+        return {};
+    }
+
+    bool parseTimeString(const char* date, size_t length, struct tm& time, time_t& epoch)
+    {
+        return parseIsoTime(date, length, time, epoch);
     }
 } // namespace standard
 #endif // SGX_TRUSTED
@@ -363,6 +359,13 @@ namespace enclave
         }
     }
 
+    bool parseTimeString(const char* date, size_t length, struct tm& time, time_t& epoch)
+    {
+        time = tm{};
+        epoch = enclave::qvlStringToTime(date, length, &time);
+        return epoch != -1;
+    }
+
 } // namespace enclave
 
 }}} // namespace intel { namespace sgx { namespace dcap {
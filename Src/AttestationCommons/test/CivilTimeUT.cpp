@@ -0,0 +1,288 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <Utils/CivilTime.h>
+#include <Utils/TimeUtils.h>
+#include "LegacyTimeConversions.h"
+
+#include <gtest/gtest.h>
+#include <openssl/asn1.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace intel::sgx::dcap;
+using namespace intel::sgx::dcap::test;
+
+namespace {
+
+std::string isoTime(int year, int month, int day, int hour, int minute, int second)
+{
+    char text[32];
+    std::snprintf(text, sizeof(text), "%04d-%02d-%02dT%02d:%02d:%02dZ", year, month, day, hour, minute, second);
+    return text;
+}
+
+std::string asn1Time(int year, int month, int day, int hour, int minute, int second, bool generalized)
+{
+    char text[32];
+    if (generalized)
+    {
+        std::snprintf(text, sizeof(text), "%04d%02d%02d%02d%02d%02dZ", year, month, day, hour, minute, second);
+    }
+    else
+    {
+        std::snprintf(text, sizeof(text), "%02d%02d%02d%02d%02d%02dZ", year % 100, month, day, hour, minute, second);
+    }
+    return text;
+}
+
+void expectSameIsoResult(const std::string& date)
+{
+    const auto expectedValid = legacyIsValidTimeString(date);
+    ASSERT_EQ(expectedValid, standard::isValidTimeString(date)) << date;
+    struct tm time{};
+    time_t epoch = 0;
+    ASSERT_EQ(expectedValid, standard::parseTimeString(date.data(), date.size(), time, epoch)) << date;
+    if (expectedValid)
+    {
+        const auto expectedEpoch = legacyGetEpochTimeFromString(date);
+        ASSERT_EQ(expectedEpoch, epoch) << date;
+        ASSERT_EQ(expectedEpoch, getEpochTimeFromString(date)) << date;
+        auto fromString = standard::getTimeFromString(date);
+        ASSERT_EQ(expectedEpoch, standard::mktime(&fromString)) << date;
+    }
+}
+
+void expectSameAsn1Result(const std::string& text, bool generalized)
+{
+    const auto time = makeAsn1Time(text, generalized);
+    time_t expected = 0;
+    time_t actual = 0;
+    const auto expectedValid = opensslAsn1TimeToEpoch(time.get(), expected);
+    ASSERT_EQ(expectedValid, newAsn1TimeToEpoch(time.get(), actual)) << text;
+    if (expectedValid)
+    {
+        ASSERT_EQ(expected, actual) << text;
+    }
+}
+
+} // anonymous namespace
+
+TEST(CivilTimeUT, daysFromCivilShouldRoundTripEveryDayAndMatchTimegm)
+{
+    for (int64_t days = daysFromCivil(1600, 1, 1); days < daysFromCivil(2600, 1, 1); ++days)
+    {
+        int64_t year = 0;
+        unsigned month = 0;
+        unsigned day = 0;
+        civilFromDays(days, year, month, day);
+        ASSERT_EQ(days, daysFromCivil(year, month, day));
+
+        struct tm time{};
+        time.tm_year = static_cast<int>(year - 1900);
+        time.tm_mon = static_cast<int>(month - 1);
+        time.tm_mday = static_cast<int>(day);
+        ASSERT_EQ(days * 24 * 60 * 60, static_cast<int64_t>(standard::mktime(&time))) << year << "-" << month << "-" << day;
+    }
+    EXPECT_EQ(0, daysFromCivil(1970, 1, 1));
+    EXPECT_EQ(-1, daysFromCivil(1969, 12, 31));
+    EXPECT_EQ(-719528, daysFromCivil(0, 1, 1));
+}
+
+TEST(CivilTimeUT, epochToTmShouldMatchGmtime)
+{
+    std::vector<time_t> inputs;
+    for (time_t time = -12219292800; time < 32503680000; time += 86399)
+    {
+        inputs.push_back(time);
+    }
+    inputs.insert(inputs.end(), {-1, 0, 1, 951782399, 951782400, 2147483647, 2147483648, 253402300799});
+
+    for (const auto time : inputs)
+    {
+#if defined(_MSC_VER)
+#pragma warning(disable:4996)
+#endif
+        const auto expected = *std::gmtime(&time);
+#if defined(_MSC_VER)
+#pragma warning(default:4996)
+#endif
+        struct tm actual{};
+        ASSERT_TRUE(epochToTm(time, actual));
+        ASSERT_EQ(expected.tm_sec, actual.tm_sec) << time;
+        ASSERT_EQ(expected.tm_min, actual.tm_min) << time;
+        ASSERT_EQ(expected.tm_hour, actual.tm_hour) << time;
+        ASSERT_EQ(expected.tm_mday, actual.tm_mday) << time;
+        ASSERT_EQ(expected.tm_mon, actual.tm_mon) << time;
+        ASSERT_EQ(expected.tm_year, actual.tm_year) << time;
+        ASSERT_EQ(expected.tm_wday, actual.tm_wday) << time;
+        ASSERT_EQ(expected.tm_yday, actual.tm_yday) << time;
+        ASSERT_EQ(expected.tm_isdst, actual.tm_isdst) << time;
+    }
+}
+
+TEST(CivilTimeUT, gmtimeShouldUseBufferOfCallingThread)
+{
+    const time_t first = 0;
+    const time_t second = 951782400;
+    const auto* firstResult = standard::gmtime(&first);
+    const auto* secondResult = standard::gmtime(&second);
+    ASSERT_NE(nullptr, secondResult);
+    EXPECT_EQ(firstResult, secondResult);
+    EXPECT_EQ(100, secondResult->tm_year);
+    EXPECT_EQ(1, secondResult->tm_mon);
+    EXPECT_EQ(29, secondResult->tm_mday);
+}
+
+TEST(CivilTimeUT, isoTimeShouldMatchLegacyParserForAllDaysOfSelectedYears)
+{
+    for (const int year : {0, 1, 1600, 1899, 1900, 1969, 1970, 1999, 2000, 2019, 2020, 2038, 2100, 2400, 9999})
+    {
+        for (int month = 0; month <= 13; ++month)
+        {
+            for (int day = 0; day <= 32; ++day)
+            {
+                expectSameIsoResult(isoTime(year, month, day, 12, 30, 45));
+            }
+        }
+    }
+}
+
+TEST(CivilTimeUT, isoTimeShouldMatchLegacyParserForAllTimesOfDay)
+{
+    for (int hour = 0; hour <= 25; ++hour)
+    {
+        for (int minute = 0; minute <= 61; ++minute)
+        {
+            expectSameIsoResult(isoTime(2021, 2, 28, hour, minute, 0));
+            expectSameIsoResult(isoTime(2021, 2, 28, hour, minute, 59));
+        }
+    }
+    for (int second = 0; second <= 99; ++second)
+    {
+        expectSameIsoResult(isoTime(2016, 12, 31, 23, 59, second));
+    }
+}
+
+TEST(CivilTimeUT, isoTimeShouldMatchLegacyParserForMalformedInput)
+{
+    const std::string valid = "2017-10-04T11:10:45Z";
+    expectSameIsoResult(valid);
+    expectSameIsoResult("");
+    expectSameIsoResult(valid + "Z");
+    expectSameIsoResult(" " + valid);
+    expectSameIsoResult("2017-10-04 11:10:45Z");
+    expectSameIsoResult("2017-10-04T11:10:45+00:00");
+    expectSameIsoResult("17-10-04T11:10:45Z");
+    for (size_t length = 0; length < valid.size(); ++length)
+    {
+        expectSameIsoResult(valid.substr(0, length));
+    }
+    for (size_t position = 0; position < valid.size(); ++position)
+    {
+        for (const char replacement : {'0', '9', '-', 'T', ':', 'Z', 't', 'z', '/', ' ', '+', 'a', '\0', '\xff'})
+        {
+            auto date = valid;
+            date[position] = replacement;
+            expectSameIsoResult(date);
+        }
+    }
+}
+
+TEST(CivilTimeUT, parseTimeStringShouldMatchEnclaveImplementationForValidDates)
+{
+    for (const auto& date : {"1970-01-01T00:00:00Z", "2017-10-04T11:10:45Z", "2020-02-29T23:59:59Z", "2038-01-19T03:14:08Z"})
+    {
+        struct tm standardTime{};
+        struct tm enclaveTime{};
+        time_t standardEpoch = 0;
+        time_t enclaveEpoch = 0;
+        ASSERT_TRUE(standard::parseTimeString(date, 20, standardTime, standardEpoch));
+        ASSERT_TRUE(enclave::parseTimeString(date, 20, enclaveTime, enclaveEpoch));
+        EXPECT_EQ(enclaveEpoch, standardEpoch) << date;
+        EXPECT_EQ(enclaveTime.tm_year, standardTime.tm_year) << date;
+        EXPECT_EQ(enclaveTime.tm_yday, standardTime.tm_yday) << date;
+        EXPECT_EQ(enclaveTime.tm_wday, standardTime.tm_wday) << date;
+    }
+}
+
+TEST(CivilTimeUT, asn1TimeShouldMatchOpensslForAllUtcTimeDays)
+{
+    for (int year = 1950; year < 2050; ++year)
+    {
+        for (int month = 0; month <= 13; ++month)
+        {
+            for (int day = 0; day <= 32; ++day)
+            {
+                expectSameAsn1Result(asn1Time(year, month, day, 23, 59, 59, false), false);
+            }
+        }
+    }
+}
+
+TEST(CivilTimeUT, asn1TimeShouldMatchOpensslForGeneralizedTime)
+{
+    for (const int year : {1, 1600, 1899, 1950, 1969, 1970, 2000, 2049, 2050, 2100, 2400, 9999})
+    {
+        for (int month = 0; month <= 13; ++month)
+        {
+            for (int day = 0; day <= 32; ++day)
+            {
+                expectSameAsn1Result(asn1Time(year, month, day, 0, 0, 0, true), true);
+            }
+        }
+    }
+    for (int hour = 0; hour <= 24; ++hour)
+    {
+        for (int minute = 0; minute <= 60; ++minute)
+        {
+            expectSameAsn1Result(asn1Time(2049, 12, 31, hour, minute, 60, true), true);
+            expectSameAsn1Result(asn1Time(2049, 12, 31, hour, minute, 30, false), false);
+        }
+    }
+}
+
+TEST(CivilTimeUT, asn1TimeShouldRejectNonDerForms)
+{
+    time_t epoch = 0;
+    for (const auto& text : {"2104011200Z", "210401120000+0100", "210401120000", "210401120000z", "21040112000AZ", ""})
+    {
+        const auto time = makeAsn1Time(text, false);
+        EXPECT_FALSE(newAsn1TimeToEpoch(time.get(), epoch)) << text;
+    }
+    for (const auto& text : {"20210401120000.5Z", "202104011200Z", "20210401120000", "20210431120000Z"})
+    {
+        const auto time = makeAsn1Time(text, true);
+        EXPECT_FALSE(newAsn1TimeToEpoch(time.get(), epoch)) << text;
+    }
+}
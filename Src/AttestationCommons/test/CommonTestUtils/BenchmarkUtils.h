@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGX_DCAP_COMMONS_TEST_BENCHMARK_UTILS_H
+#define SGX_DCAP_COMMONS_TEST_BENCHMARK_UTILS_H
+
+#include <chrono>
+#include <cstddef>
+
+namespace intel { namespace sgx { namespace dcap { namespace test {
+
+/**
+ * Helpers for benchmarks in AttestationLibrary/test/Benchmarks.
+ *
+ * Benchmarks only record their measurements with RecordProperty and are built into AttestationLibrary_BENCH,
+ * which is not part of the default test run. To collect the measurements run:
+ *   AttestationLibrary_BENCH --gtest_output=xml:benchmark.xml
+ */
+
+/**
+ * @param function - code to measure, called once
+ * @return wall time of the call in nanoseconds
+ */
+template<typename Function>
+long long elapsedNs(Function&& function)
+{
+    const auto start = std::chrono::steady_clock::now();
+    function();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<long long>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
+/**
+ * @param iterations - number of calls, has to be greater than 0
+ * @param function - code to measure
+ * @return average wall time of one call in nanoseconds
+ */
+template<typename Function>
+long long nsPerCall(size_t iterations, Function&& function)
+{
+    return elapsedNs([&]() {
+        for (size_t i = 0; i < iterations; i++)
+        {
+            function();
+        }
+    }) / static_cast<long long>(iterations);
+}
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace test {
+
+#endif // SGX_DCAP_COMMONS_TEST_BENCHMARK_UTILS_H
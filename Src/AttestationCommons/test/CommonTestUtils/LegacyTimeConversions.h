@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGX_DCAP_COMMONS_TEST_LEGACY_TIME_CONVERSIONS_H
+#define SGX_DCAP_COMMONS_TEST_LEGACY_TIME_CONVERSIONS_H
+
+#include <Utils/CivilTime.h>
+#include <Utils/TimeUtils.h>
+
+#include <openssl/asn1.h>
+
+#include <iomanip>
+#include <memory>
+#include <regex>
+#include <sstream>
+#include <string>
+
+namespace intel { namespace sgx { namespace dcap { namespace test {
+
+/**
+ * Implementations of standard::isValidTimeString, standard::getTimeFromString and asn1TimeToTimet from before
+ * they were moved to CivilTime, kept as reference for equivalence tests and benchmarks.
+ */
+
+inline bool legacyIsValidTimeString(const std::string& timeString)
+{
+    std::regex timeRegex("[0-9]{4}-[0-9]{2}-[0-9]{2}T[0-9]{2}:[0-9]{2}:[0-9]{2}Z");
+    if (!std::regex_match(timeString, timeRegex))
+    {
+        return false;
+    }
+    std::tm time{};
+    std::istringstream input(timeString);
+    input >> std::get_time(&time, "%Y-%m-%dT%H:%M:%SZ");
+
+    auto validate = time;
+    standard::mktime(&time);
+    if (validate.tm_year != time.tm_year || validate.tm_mon != time.tm_mon ||
+        validate.tm_mday != time.tm_mday || validate.tm_hour != time.tm_hour ||
+        validate.tm_min != time.tm_min || validate.tm_sec != time.tm_sec)
+    {
+        return false;
+    }
+    return !input.fail();
+}
+
+inline time_t legacyGetEpochTimeFromString(const std::string& date)
+{
+    struct tm time{};
+    std::istringstream input(date);
+    input >> std::get_time(&time, "%Y-%m-%dT%H:%M:%SZ");
+    return standard::mktime(&time);
+}
+
+// Converts ASN.1 time the way asn1TimeToTimet did before DER forms were converted directly
+inline bool opensslAsn1TimeToEpoch(const ASN1_TIME* asn1Time, time_t& epoch)
+{
+    int pday = 0;
+    int psec = 0;
+    std::unique_ptr<ASN1_TIME, decltype(&ASN1_TIME_free)> from(ASN1_TIME_new(), ASN1_TIME_free);
+    ASN1_TIME_set(from.get(), 0);
+    if (1 != ASN1_TIME_diff(&pday, &psec, from.get(), asn1Time))
+    {
+        return false;
+    }
+    epoch = static_cast<time_t>(pday) * 24 * 60 * 60 + psec;
+    return true;
+}
+
+inline std::unique_ptr<ASN1_TIME, decltype(&ASN1_TIME_free)> makeAsn1Time(const std::string& text, bool generalized)
+{
+    // ASN1_TIME_set_string validates input, contents are set directly so invalid dates reach ASN1_TIME_diff as well
+    std::unique_ptr<ASN1_TIME, decltype(&ASN1_TIME_free)> time(
+            ASN1_STRING_type_new(generalized ? V_ASN1_GENERALIZEDTIME : V_ASN1_UTCTIME), ASN1_TIME_free);
+    ASN1_STRING_set(time.get(), text.data(), static_cast<int>(text.size()));
+    return time;
+}
+
+inline bool newAsn1TimeToEpoch(const ASN1_TIME* asn1Time, time_t& epoch)
+{
+    return asn1TimeToEpoch(ASN1_STRING_get0_data(asn1Time), static_cast<size_t>(ASN1_STRING_length(asn1Time)),
+                           ASN1_STRING_type(asn1Time) == V_ASN1_GENERALIZEDTIME, epoch);
+}
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace test {
+
+#endif // SGX_DCAP_COMMONS_TEST_LEGACY_TIME_CONVERSIONS_H
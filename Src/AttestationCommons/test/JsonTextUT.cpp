@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "Utils/JsonText.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+using namespace intel::sgx::dcap;
+
+namespace {
+
+std::string findMember(const std::string& json, const char* name)
+{
+    const char* text = nullptr;
+    size_t textLength = 0;
+    if (!findCompactJsonMember(json.data(), json.size(), name, text, textLength))
+    {
+        return "<none>";
+    }
+    return std::string(text, textLength);
+}
+
+} // anonymous namespace
+
+TEST(JsonTextUT, shouldFindCompactMemberOfTopLevelObject)
+{
+    const std::string json = R"({"body":{"a":[1,{"b":"}]"}],"c":-5,"d":true},"signature":"abcd"})";
+    EXPECT_EQ(R"({"a":[1,{"b":"}]"}],"c":-5,"d":true})", findMember(json, "body"));
+    EXPECT_EQ(R"("abcd")", findMember(json, "signature"));
+}
+
+TEST(JsonTextUT, shouldAllowWhitespaceAroundMemberValue)
+{
+    const std::string json = "{ \"signature\" : \"ab\" ,\n \"body\" :\t{\"a\":1}\n}";
+    EXPECT_EQ(R"({"a":1})", findMember(json, "body"));
+}
+
+TEST(JsonTextUT, shouldNotFindMissingOrNestedMember)
+{
+    const std::string json = R"({"body":{"nested":1},"bodyLonger":2})";
+    EXPECT_EQ("<none>", findMember(json, "nested"));
+    EXPECT_EQ("<none>", findMember(json, "bod"));
+    EXPECT_EQ("2", findMember(json, "bodyLonger"));
+}
+
+TEST(JsonTextUT, shouldTakeFirstOccurrenceOfMember)
+{
+    EXPECT_EQ("1", findMember(R"({"body":1,"body":2})", "body"));
+}
+
+TEST(JsonTextUT, shouldRejectValuesThatWriterWouldChange)
+{
+    EXPECT_EQ("<none>", findMember(R"({"body":{"a": 1}})", "body"));
+    EXPECT_EQ("<none>", findMember(R"({"body":{"a":"\u0041"}})", "body"));
+    EXPECT_EQ("<none>", findMember(R"({"body":{"a":"\/"}})", "body"));
+    EXPECT_EQ("<none>", findMember(R"({"body":{"a":1.0}})", "body"));
+    EXPECT_EQ("<none>", findMember(R"({"body":{"a":1e3}})", "body"));
+    EXPECT_EQ("<none>", findMember(R"({"body":{"a":-0}})", "body"));
+    EXPECT_EQ("<none>", findMember(R"({"body":{"a":12345678901234567890}})", "body"));
+}
+
+TEST(JsonTextUT, shouldRejectEscapedMemberNames)
+{
+    EXPECT_EQ("<none>", findMember(R"({"b\u006fdy":1,"body":2})", "body"));
+}
+
+TEST(JsonTextUT, shouldRejectTruncatedInput)
+{
+    const std::string json = R"({"body":{"a":[1,2]}})";
+    const char* text = nullptr;
+    size_t textLength = 0;
+    EXPECT_FALSE(findCompactJsonMember(json.data(), json.size() - 3, "body", text, textLength));
+    EXPECT_FALSE(findCompactJsonMember(json.data(), 0, "body", text, textLength));
+    EXPECT_FALSE(findCompactJsonMember("[1]", 3, "body", text, textLength));
+}
@@ -204,6 +204,126 @@ typedef enum _status
  */
 QVL_API Status sgxAttestationVerifyQuote(const uint8_t* quote, uint32_t quoteSize, const char *pemPckCertificate, const char* intermediateCrl, const char* tcbInfoJson, const char* qeIdentityJson);
 
+/**
+ * This function is the same as sgxAttestationVerifyQuote but takes PCK certificate and PCK CRL in binary DER format,
+ * so no PEM or hex decoding is performed.
+ *
+ * @param quote - Buffer with serialized quote structure.
+ * @param quoteSize - Size of quote buffer. Function heavily relies on this input as internal buffer is allocated based on it without boundaries check! It's user responsibility to provide proper validation.
+ * @param derPckCertificate - Intel SGX PCK certificate in DER format.
+ * @param derPckCertificateSize - Size of derPckCertificate buffer.
+ * @param derIntermediateCrl - Intel SGX PCK Processor/Platform CRL in DER format.
+ * @param derIntermediateCrlSize - Size of derIntermediateCrl buffer.
+ * @param tcbInfoJson - TCB Info structure in JSON format signed by Intel SGX TCB Signing Certificate.
+ * @param qeIdentityJson - QE Identity structure in JSON format signed by Intel SGX TCB Signing Certificate. Optional.
+ * @return Status code of the operation, one of statuses returned by sgxAttestationVerifyQuote.
+ */
+QVL_API Status sgxAttestationVerifyQuoteDer(const uint8_t* quote, uint32_t quoteSize, const uint8_t* derPckCertificate, size_t derPckCertificateSize,
+                                            const uint8_t* derIntermediateCrl, size_t derIntermediateCrlSize, const char* tcbInfoJson, const char* qeIdentityJson);
+
+/**
+ * Opaque handle to quote verification collateral (PCK CRL, TCB Info and QE Identity) that has been parsed once
+ * by sgxAttestationCollateralCreate. The handle is immutable after creation and may be shared between threads
+ * calling sgxAttestationVerifyQuoteWithCollateral concurrently.
+ */
+typedef struct _collateral Collateral;
+
+/**
+ * This function parses quote verification collateral so that it can be reused by sgxAttestationVerifyQuoteWithCollateral.
+ * Returned handle has to be released with sgxAttestationCollateralFree.
+ *
+ * @param intermediateCrl - Null terminated, PEM or DER(hex encoded) formatted x.509 Intel SGX PCK Processor/Platform CRL
+ * @param tcbInfoJson - TCB Info structure in JSON format signed by Intel SGX TCB Signing Certificate.
+ * @param qeIdentityJson - QE Identity structure in JSON format signed by Intel SGX TCB Signing Certificate. Optional.
+ * @param collateral - Out parameter - will hold the handle to parsed collateral or NULL on failure.
+ * @return Status code of the operation, one of:
+ *      - STATUS_OK
+ *      - STATUS_MISSING_PARAMETERS
+ *      - STATUS_UNSUPPORTED_PCK_RL_FORMAT
+ *      - STATUS_UNSUPPORTED_TCB_INFO_FORMAT
+ *      - STATUS_UNSUPPORTED_QE_IDENTITY_FORMAT
+ */
+QVL_API Status sgxAttestationCollateralCreate(const char* intermediateCrl, const char* tcbInfoJson, const char* qeIdentityJson, Collateral** collateral);
+
+/**
+ * This function is the same as sgxAttestationCollateralCreate but takes PCK CRL in binary DER format.
+ * Returned handle has to be released with sgxAttestationCollateralFree.
+ *
+ * @param derIntermediateCrl - Intel SGX PCK Processor/Platform CRL in DER format.
+ * @param derIntermediateCrlSize - Size of derIntermediateCrl buffer.
+ * @param tcbInfoJson - TCB Info structure in JSON format signed by Intel SGX TCB Signing Certificate.
+ * @param qeIdentityJson - QE Identity structure in JSON format signed by Intel SGX TCB Signing Certificate. Optional.
+ * @param collateral - Out parameter - will hold the handle to parsed collateral or NULL on failure.
+ * @return Status code of the operation, one of statuses returned by sgxAttestationCollateralCreate.
+ */
+QVL_API Status sgxAttestationCollateralCreateDer(const uint8_t* derIntermediateCrl, size_t derIntermediateCrlSize, const char* tcbInfoJson,
+                                                 const char* qeIdentityJson, Collateral** collateral);
+
+/**
+ * This function is responsible for verifying provided quote against PCK certificate and collateral parsed
+ * by sgxAttestationCollateralCreate. Result is the same as sgxAttestationVerifyQuote called with the collateral
+ * the handle was created from.
+ *
+ * @param collateral - Handle returned by sgxAttestationCollateralCreate.
+ * @param quote - Buffer with serialized quote structure.
+ * @param quoteSize - Size of quote buffer. Function heavily relies on this input as internal buffer is allocated based on it without boundaries check! It's user responsibility to provide proper validation.
+ * @param pemPckCertificate - Null terminated Intel SGX PCK certificate in PEM format.
+ * @return Status code of the operation, one of statuses returned by sgxAttestationVerifyQuote except
+ *      STATUS_UNSUPPORTED_PCK_RL_FORMAT, STATUS_UNSUPPORTED_TCB_INFO_FORMAT and STATUS_UNSUPPORTED_QE_IDENTITY_FORMAT.
+ */
+QVL_API Status sgxAttestationVerifyQuoteWithCollateral(const Collateral* collateral, const uint8_t* quote, uint32_t quoteSize, const char *pemPckCertificate);
+
+/**
+ * This function is the same as sgxAttestationVerifyQuoteWithCollateral but takes PCK certificate in binary DER format.
+ *
+ * @param collateral - Handle returned by sgxAttestationCollateralCreate or sgxAttestationCollateralCreateDer.
+ * @param quote - Buffer with serialized quote structure.
+ * @param quoteSize - Size of quote buffer. Function heavily relies on this input as internal buffer is allocated based on it without boundaries check! It's user responsibility to provide proper validation.
+ * @param derPckCertificate - Intel SGX PCK certificate in DER format.
+ * @param derPckCertificateSize - Size of derPckCertificate buffer.
+ * @return Status code of the operation, one of statuses returned by sgxAttestationVerifyQuoteWithCollateral.
+ */
+QVL_API Status sgxAttestationVerifyQuoteWithCollateralDer(const Collateral* collateral, const uint8_t* quote, uint32_t quoteSize,
+                                                          const uint8_t* derPckCertificate, size_t derPckCertificateSize);
+
+/**
+ * This function releases collateral created by sgxAttestationCollateralCreate. Passing NULL is allowed.
+ *
+ * @param collateral - Handle returned by sgxAttestationCollateralCreate.
+ */
+QVL_API void sgxAttestationCollateralFree(Collateral* collateral);
+
+/**
+ * This function is responsible for verifying a batch of quotes against their PCK certificates and one set of collateral.
+ * Collateral is parsed once and shared between all quotes, which are verified concurrently by the calling thread and
+ * library worker threads. Worker threads are started on first use and kept for later calls.
+ * Result of each quote is the same as the one returned by sgxAttestationVerifyQuote for that quote.
+ * Unexpected errors are reported as STATUS_UNSUPPORTED_QUOTE_FORMAT of the quote that caused them.
+ *
+ * @param quotes - Table of quoteCount buffers with serialized quote structures.
+ * @param quoteSizes - Table of quoteCount sizes of quote buffers. Function heavily relies on this input as internal buffer is allocated based on it without boundaries check! It's user responsibility to provide proper validation.
+ * @param pemPckCertificates - Table of quoteCount null terminated Intel SGX PCK certificates in PEM format, one for each quote.
+ * @param quoteCount - Number of quotes in the batch.
+ * @param intermediateCrl - Null terminated, PEM or DER(hex encoded) formatted x.509 Intel SGX PCK Processor/Platform CRL
+ * @param tcbInfoJson - TCB Info structure in JSON format signed by Intel SGX TCB Signing Certificate.
+ * @param qeIdentityJson - QE Identity structure in JSON format signed by Intel SGX TCB Signing Certificate. Optional.
+ * @param threadCount - Maximum number of threads used for verification, including the calling thread. 0 means number of hardware threads.
+ *        Values above the number of hardware threads are lowered to it. Library keeps as many worker threads as the largest
+ *        threadCount used so far, less the calling thread, until the process exits.
+ *        Ignored inside an SGX Enclave where quotes are verified sequentially.
+ * @param results - Table of quoteCount statuses. Out parameter - will hold status of each quote verification.
+ *        If collateral can not be parsed every entry holds the returned status.
+ * @return Status code of the operation, one of:
+ *      - STATUS_OK - batch was processed, per quote results are stored in results table
+ *      - STATUS_MISSING_PARAMETERS
+ *      - STATUS_UNSUPPORTED_PCK_RL_FORMAT
+ *      - STATUS_UNSUPPORTED_TCB_INFO_FORMAT
+ *      - STATUS_UNSUPPORTED_QE_IDENTITY_FORMAT
+ */
+QVL_API Status sgxAttestationVerifyQuoteBatch(const uint8_t* const quotes[], const uint32_t quoteSizes[], const char* const pemPckCertificates[],
+                                              uint32_t quoteCount, const char* intermediateCrl, const char* tcbInfoJson, const char* qeIdentityJson,
+                                              uint32_t threadCount, Status results[]);
+
 /**
  *
  * @param enclaveReport - Buffer with serialized Enclave Report  structure.
@@ -324,6 +444,23 @@ QVL_API Status sgxAttestationGetQECertificationData(
  */
 QVL_API Status sgxAttestationVerifyPCKCertificate(const char *pemCertChain, const char *const crls[], const char *pemRootCaCertificate, const time_t* expirationCheckDate);
 
+/**
+ * This function is the same as sgxAttestationVerifyPCKCertificate but takes certificates and CRLs in binary DER format.
+ *
+ * @param derCertChain - Concatenated DER encoded x.509 certificates, same certificates as expected in PEM chain.
+ * @param derCertChainSize - Size of derCertChain buffer.
+ * @param derCrls - Table with two DER formatted x.509 CRLs:
+ *      - derCrls[0] - CRL issued by root CA
+ *      - derCrls[1] - CRL issued by intermediate certificate.
+ * @param derCrlSizes - Table with sizes of the two derCrls buffers.
+ * @param derRootCaCertificate - Intel SGX Root CA certificate (x.509, self-signed) in DER format.
+ * @param derRootCaCertificateSize - Size of derRootCaCertificate buffer.
+ * @param expirationCheckDate - Time stamp used to verify if the certificates & CRLs have not expired, see sgxAttestationVerifyPCKCertificate.
+ * @return Status code of the operation, one of statuses returned by sgxAttestationVerifyPCKCertificate.
+ */
+QVL_API Status sgxAttestationVerifyPCKCertificateDer(const uint8_t *derCertChain, size_t derCertChainSize, const uint8_t *const derCrls[], const size_t derCrlSizes[],
+                                                     const uint8_t *derRootCaCertificate, size_t derRootCaCertificateSize, const time_t* expirationCheckDate);
+
 /**
  * This function is responsible for verifying TCB Info structure issued by Intel SGX TCB Signing Certificate.
  *
@@ -363,6 +500,22 @@ QVL_API Status sgxAttestationVerifyPCKCertificate(const char *pemCertChain, cons
  */
 QVL_API Status sgxAttestationVerifyTCBInfo(const char *tcbInfo, const char *pemCertChain, const char *rootCaCrl, const char *pemRootCaCertificate, const time_t* expirationCheckDate);
 
+/**
+ * This function is the same as sgxAttestationVerifyTCBInfo but takes certificates and CRL in binary DER format.
+ *
+ * @param tcbInfo - TCB Info structure in JSON format signed by Intel SGX TCB Signing Certificate.
+ * @param derCertChain - Concatenated DER encoded x.509 TCB Signing Certificate chain (that signed provided TCBInfo).
+ * @param derCertChainSize - Size of derCertChain buffer.
+ * @param derRootCaCrl - x.509 SGX Root CA CRL in DER format.
+ * @param derRootCaCrlSize - Size of derRootCaCrl buffer.
+ * @param derRootCaCertificate - Intel SGX Root CA certificate (x.509, self-signed) in DER format.
+ * @param derRootCaCertificateSize - Size of derRootCaCertificate buffer.
+ * @param expirationCheckDate - Time stamp used to verify if the certificates & CRLs have not expired, see sgxAttestationVerifyTCBInfo.
+ * @return Status code of the operation, one of statuses returned by sgxAttestationVerifyTCBInfo.
+ */
+QVL_API Status sgxAttestationVerifyTCBInfoDer(const char *tcbInfo, const uint8_t *derCertChain, size_t derCertChainSize, const uint8_t *derRootCaCrl, size_t derRootCaCrlSize,
+                                              const uint8_t *derRootCaCertificate, size_t derRootCaCertificateSize, const time_t* expirationCheckDate);
+
 /**
  * This function is responsible for verifying Enclave Identity structure.
  *
@@ -402,6 +555,24 @@ QVL_API Status sgxAttestationVerifyTCBInfo(const char *tcbInfo, const char *pemC
  */
 QVL_API Status sgxAttestationVerifyEnclaveIdentity(const char *enclaveIdentityString, const char *pemCertChain, const char *rootCaCrl, const char *pemRootCaCertificate, const time_t* expirationCheckDate);
 
+/**
+ * This function is the same as sgxAttestationVerifyEnclaveIdentity but takes certificates and CRL in binary DER format.
+ *
+ * @param enclaveIdentityString - Enclave Identity structure in JSON format signed by Intel SGX TCB Signing Certificate.
+ * @param derCertChain - Concatenated DER encoded x.509 TCB Signing Certificate chain (that signed provided QE Identity).
+ * @param derCertChainSize - Size of derCertChain buffer.
+ * @param derRootCaCrl - x.509 SGX Root CA CRL in DER format.
+ * @param derRootCaCrlSize - Size of derRootCaCrl buffer.
+ * @param derRootCaCertificate - Intel SGX Root CA certificate (x.509, self-signed) in DER format.
+ * @param derRootCaCertificateSize - Size of derRootCaCertificate buffer.
+ * @param expirationCheckDate - Time stamp used to verify if the certificates & CRLs have not expired, see sgxAttestationVerifyEnclaveIdentity.
+ * @return Status code of the operation, one of statuses returned by sgxAttestationVerifyEnclaveIdentity.
+ */
+QVL_API Status sgxAttestationVerifyEnclaveIdentityDer(const char *enclaveIdentityString, const uint8_t *derCertChain, size_t derCertChainSize,
+                                                      const uint8_t *derRootCaCrl, size_t derRootCaCrlSize,
+                                                      const uint8_t *derRootCaCertificate, size_t derRootCaCertificateSize,
+                                                      const time_t* expirationCheckDate);
+
 /**
  * This function is responsible for verifying Certificate Revocation Lists issued by one of the CA certificates in
  * PCK Certificate Chain.
@@ -427,6 +598,51 @@ QVL_API Status sgxAttestationVerifyEnclaveIdentity(const char *enclaveIdentitySt
  */
 QVL_API Status sgxAttestationVerifyPCKRevocationList(const char *crl, const char *pemCACertChain, const char *pemTrustedRootCaCert);
 
+/**
+ * This function is the same as sgxAttestationVerifyPCKRevocationList but takes CRL and certificates in binary DER format.
+ *
+ * @param derCrl - x.509 Certificate Revocation List supported by PCK Certificate Chain in DER format, see sgxAttestationVerifyPCKRevocationList.
+ * @param derCrlSize - Size of derCrl buffer.
+ * @param derCACertChain - Concatenated DER encoded x.509 CA certificates (that issued provided CRL).
+ * @param derCACertChainSize - Size of derCACertChain buffer.
+ * @param derTrustedRootCaCert - Intel SGX Root CA certificate (x.509, self-signed) in DER format.
+ * @param derTrustedRootCaCertSize - Size of derTrustedRootCaCert buffer.
+ * @return Status code of the operation, one of statuses returned by sgxAttestationVerifyPCKRevocationList.
+ */
+QVL_API Status sgxAttestationVerifyPCKRevocationListDer(const uint8_t *derCrl, size_t derCrlSize, const uint8_t *derCACertChain, size_t derCACertChainSize,
+                                                        const uint8_t *derTrustedRootCaCert, size_t derTrustedRootCaCertSize);
+
+/**
+ * Statistics of the parse cache, see sgxAttestationParseCacheSetup.
+ */
+typedef struct _parseCacheStatistics
+{
+    uint64_t hits;      ///< Number of inputs found in the cache.
+    uint64_t misses;    ///< Number of inputs that had to be parsed.
+    uint64_t evictions; ///< Number of least recently used entries removed to respect the size limit.
+    uint64_t entries;   ///< Number of entries currently held in the cache.
+} ParseCacheStatistics;
+
+/**
+ * This function enables process wide cache of parsed PCK certificates, PCK CRLs, TCB Info and QE Identity structures
+ * passed to quote verification functions. Inputs are identified by SHA-256 of their bytes, so byte-identical inputs
+ * are parsed only once. When more than maxEntries objects are cached the least recently used one is evicted.
+ * Cache is disabled by default. Calling this function clears the cache and resets its statistics.
+ *
+ * @param maxEntries - Maximum number of cached objects. 0 disables the cache.
+ */
+QVL_API void sgxAttestationParseCacheSetup(uint32_t maxEntries);
+
+/**
+ * This function returns statistics of the parse cache collected since the last sgxAttestationParseCacheSetup call.
+ *
+ * @param statistics - Out parameter - will hold the statistics.
+ * @return Status code of the operation, one of:
+ *      - STATUS_OK
+ *      - STATUS_MISSING_PARAMETERS
+ */
+QVL_API Status sgxAttestationParseCacheGetStatistics(ParseCacheStatistics* statistics);
+
 /**
  * This function allows user to setup logging in QVL. If fileLogLevel is empty or set to OFF or fileName is empty there
  * will be no file logger created.
@@ -35,19 +35,45 @@
 #include "Utils/Logger.h"
 
 #include <algorithm>
+#include <limits>
+#include <unordered_set>
+
+#include <openssl/asn1.h>
 
 namespace intel { namespace sgx { namespace dcap {
 
 
 Status CertificateChain::parse(const std::string& pemCertChain)
 {
-    const auto certStrs = splitChain(pemCertChain);
+    return parseCertificates(splitChain(pemCertChain), [&pemCertChain](const CertificateRange& certRange) {
+        return dcap::parser::x509::Certificate::parse(pemCertChain.substr(certRange.offset, certRange.length));
+    }, [&pemCertChain](const CertificateRange& certRange) {
+        return pemCertChain.substr(certRange.offset, certRange.length);
+    });
+}
+
+Status CertificateChain::parseDer(const uint8_t* derCertChain, size_t length)
+{
+    return parseCertificates(splitDerChain(derCertChain, length), [derCertChain](const CertificateRange& certRange) {
+        return dcap::parser::x509::Certificate::parseDer(derCertChain + certRange.offset, certRange.length);
+    }, [](const CertificateRange& certRange) {
+        return "DER certificate at offset " + std::to_string(certRange.offset);
+    });
+}
 
-    certs.reserve(certStrs.size());
-    for(const auto& certPem : certStrs)
+Status CertificateChain::parseCertificates(const std::vector<CertificateRange>& certRanges,
+                                           const std::function<dcap::parser::x509::Certificate(const CertificateRange&)>& parseCertificate,
+                                           const std::function<std::string(const CertificateRange&)>& describe)
+{
+#ifndef SGX_LOGS
+    // suppress unused variable warning when logs are disabled
+    (void)describe;
+#endif
+    certs.reserve(certRanges.size());
+    for(const auto& certRange : certRanges)
     {
         try {
-            auto cert = std::make_shared<dcap::parser::x509::Certificate>(dcap::parser::x509::Certificate::parse(certPem));
+            auto cert = std::make_shared<const dcap::parser::x509::Certificate>(parseCertificate(certRange));
 
             if (cert->getSubject() == cert->getIssuer())
             {
@@ -55,13 +81,14 @@ Status CertificateChain::parse(const std::string& pemCertChain)
             }
 
             certs.emplace_back(cert);
+            certsBySubject.emplace(cert->getSubject(), cert);
         }
         // any cert in chain has wrong format
         // then whole chain should be considered invalid
         catch (const dcap::parser::FormatException& ex)
         {
             LOG_ERROR("Cert Chain format error: {}, wrong certChain element: {}",
-                      ex.what(), certPem);
+                      ex.what(), describe(certRange));
             return STATUS_UNSUPPORTED_CERT_FORMAT;
         }
         catch (const dcap::parser::InvalidExtensionException& ex)
@@ -77,7 +104,7 @@ Status CertificateChain::parse(const std::string& pemCertChain)
             }
             if (certs.size() == 1) // second cert wll be probably an intermediate CA
             {
-                if (certStrs.size() == 2)
+                if (certRanges.size() == 2)
                 {
                     LOG_ERROR("Error while parsing TCB Signing cert from cert chain: {}", ex.what());
                     return STATUS_SGX_TCB_SIGNING_CERT_INVALID_EXTENSIONS;
@@ -93,22 +120,24 @@ Status CertificateChain::parse(const std::string& pemCertChain)
         }
     }
 
+    // issuers of certificates that are not self-signed, topmost certificate did not sign any of them
+    std::unordered_set<dcap::parser::x509::DistinguishedName, DistinguishedNameHash> signingSubjects;
     for(auto const &cert: certs)
     {
-        auto signedCertIter = std::find_if(certs.cbegin(), certs.cend(), [cert](const std::shared_ptr<const dcap::parser::x509::Certificate> &found)
+        if (cert->getSubject() != cert->getIssuer())
         {
-            return found->getSubject() != cert->getSubject()
-                   && found->getIssuer() == cert->getSubject();
-        });
-        if(signedCertIter == certs.cend())
-        {
-            topmostCert = cert;
+            signingSubjects.insert(cert->getIssuer());
         }
+    }
+
+    for(auto &cert: certs)
+    {
         if (cert->getSubject().getCommonName().find(constants::SGX_PCK_CN_PHRASE) != std::string::npos)
         {
             try
             {
-                pckCert = std::make_shared<dcap::parser::x509::PckCertificate>(dcap::parser::x509::PckCertificate(*cert));
+                // shares decoded certificate with cert, only SGX extension is decoded here
+                pckCert = std::make_shared<const dcap::parser::x509::PckCertificate>(*cert);
             }
             catch (const dcap::parser::FormatException& ex)
             {
@@ -120,6 +149,18 @@ Status CertificateChain::parse(const std::string& pemCertChain)
                 LOG_ERROR("PCK CertChain invalid extension error: {}", ex.what());
                 return STATUS_SGX_PCK_INVALID_EXTENSIONS;
             }
+
+            // keep single instance of PCK certificate in the chain
+            auto subjectIt = certsBySubject.find(cert->getSubject());
+            if (subjectIt->second == cert)
+            {
+                subjectIt->second = pckCert;
+            }
+            cert = pckCert;
+        }
+        if(signingSubjects.find(cert->getSubject()) == signingSubjects.cend())
+        {
+            topmostCert = cert;
         }
     }
 
@@ -139,15 +180,12 @@ size_t CertificateChain::length() const
 
 std::shared_ptr<const dcap::parser::x509::Certificate> CertificateChain::get(const dcap::parser::x509::DistinguishedName &subject) const
 {
-    auto it = std::find_if(certs.cbegin(), certs.cend(), [&subject](const std::shared_ptr<const dcap::parser::x509::Certificate> &cert)
-    {
-        return cert->getSubject() == subject;
-    });
-    if(it == certs.end())
+    const auto it = certsBySubject.find(subject);
+    if(it == certsBySubject.cend())
     {
         return nullptr;
     }
-    return *it;
+    return it->second;
 }
 
 std::shared_ptr<const dcap::parser::x509::Certificate> CertificateChain::getIntermediateCert() const
@@ -184,15 +222,15 @@ std::vector<std::shared_ptr<const dcap::parser::x509::Certificate>> CertificateC
     return certs;
 }
 
-std::vector<std::string> CertificateChain::splitChain(const std::string &pemChain) const
+std::vector<CertificateChain::CertificateRange> CertificateChain::splitChain(const std::string &pemChain) const
 {
     if(pemChain.empty())
     {
         return {};
     }
 
-    const std::string begCert = "-----BEGIN CERTIFICATE-----";
-    const std::string endCert = "-----END CERTIFICATE-----";
+    static const std::string begCert = "-----BEGIN CERTIFICATE-----";
+    static const std::string endCert = "-----END CERTIFICATE-----";
 
     const size_t begPos = pemChain.find(begCert);
     const size_t endPos = pemChain.find(endCert);
@@ -202,7 +240,7 @@ std::vector<std::string> CertificateChain::splitChain(const std::string &pemChai
         return {};
     }
 
-    std::vector<std::string> ret;
+    std::vector<CertificateRange> ret;
     size_t newStartPos = begPos;
     size_t foundEndPos = endPos;
     while(foundEndPos != std::string::npos)
@@ -215,13 +253,14 @@ std::vector<std::string> CertificateChain::splitChain(const std::string &pemChai
         while(pemChain.at(newStartPos) != '-') ++newStartPos;
 
         const size_t newEndPos = foundEndPos + endCert.size();
-        const std::string cert = pemChain.substr(newStartPos, newEndPos - newStartPos);
 
         // we do not check for this in second and further iteration
-        // and it's cheaper to check on shorter string
-        if(cert.find(begCert) != std::string::npos)
+        // and it's cheaper to check on certificate range only
+        const auto certBegin = pemChain.cbegin() + static_cast<std::ptrdiff_t>(newStartPos);
+        const auto certEnd = pemChain.cbegin() + static_cast<std::ptrdiff_t>(newEndPos);
+        if(std::search(certBegin, certEnd, begCert.cbegin(), begCert.cend()) != certEnd)
         {
-            ret.push_back(cert);
+            ret.push_back({newStartPos, newEndPos - newStartPos});
         }
 
         newStartPos = newEndPos;
@@ -236,4 +275,35 @@ std::vector<std::string> CertificateChain::splitChain(const std::string &pemChai
     return ret;
 }
 
+std::vector<CertificateChain::CertificateRange> CertificateChain::splitDerChain(const uint8_t* derChain, size_t length) const
+{
+    if(derChain == nullptr || length == 0 || length > static_cast<size_t>(std::numeric_limits<long>::max()))
+    {
+        return {};
+    }
+
+    // certificates are concatenated DER SEQUENCEs, only their headers are read here
+    std::vector<CertificateRange> ret;
+    size_t offset = 0;
+    while(offset < length)
+    {
+        const unsigned char *certBegin = derChain + offset;
+        const unsigned char *content = certBegin;
+        long contentLength = 0;
+        int tag = 0;
+        int tagClass = 0;
+        const auto result = ASN1_get_object(&content, &contentLength, &tag, &tagClass, static_cast<long>(length - offset));
+        if((result & 0x80) != 0 || result != V_ASN1_CONSTRUCTED || tag != V_ASN1_SEQUENCE || tagClass != V_ASN1_UNIVERSAL)
+        {
+            return {};
+        }
+
+        const auto certLength = static_cast<size_t>(content - certBegin) + static_cast<size_t>(contentLength);
+        ret.push_back({offset, certLength});
+        offset += certLength;
+    }
+
+    return ret;
+}
+
 }}}
@@ -34,7 +34,9 @@
 
 #include <string>
 #include <vector>
+#include <functional>
 #include <memory>
+#include <unordered_map>
 #include <PckParser/PckParser.h>
 #include <Verifiers/BaseVerifier.h>
 #include <SgxEcdsaAttestation/AttestationParsers.h>
@@ -64,6 +66,16 @@ public:
     */
     virtual Status parse(const std::string& pemCertChain);
 
+    /**
+    * Parse certificate chain of concatenated DER encoded certificates.
+    * Check if there is at least one valid x.509 certificate in the chain.
+    *
+    * @param derCertChain - buffer with concatenated DER certificates
+    * @param length - length of derCertChain buffer
+    * @return STATUS_OK if chain has been successfully parsed
+    */
+    virtual Status parseDer(const uint8_t* derCertChain, size_t length);
+
     /**
     * Get length of the parsed chain
     * @return chain length.
@@ -114,10 +126,34 @@ public:
     virtual std::vector<std::shared_ptr<const dcap::parser::x509::Certificate>> getCerts() const;
 
 private:
+    struct DistinguishedNameHash
+    {
+        size_t operator()(const dcap::parser::x509::DistinguishedName &name) const
+        {
+            return name.getHash();
+        }
+    };
+
     BaseVerifier _baseVerifier{};
 
-    std::vector<std::string> splitChain(const std::string &pemChain) const;
+    /**
+     * Position of a single encoded certificate within the chain
+     */
+    struct CertificateRange
+    {
+        size_t offset;
+        size_t length;
+    };
+
+    std::vector<CertificateRange> splitChain(const std::string &pemChain) const;
+    std::vector<CertificateRange> splitDerChain(const uint8_t* derChain, size_t length) const;
+    Status parseCertificates(const std::vector<CertificateRange>& certRanges,
+                             const std::function<dcap::parser::x509::Certificate(const CertificateRange&)>& parseCertificate,
+                             const std::function<std::string(const CertificateRange&)>& describe);
     std::vector<std::shared_ptr<const dcap::parser::x509::Certificate>> certs{};
+    std::unordered_map<dcap::parser::x509::DistinguishedName,
+                       std::shared_ptr<const dcap::parser::x509::Certificate>,
+                       DistinguishedNameHash> certsBySubject{};
     std::shared_ptr<const dcap::parser::x509::Certificate> rootCert{};
     std::shared_ptr<const dcap::parser::x509::Certificate> topmostCert{};
     std::shared_ptr<const dcap::parser::x509::PckCertificate> pckCert{};
@@ -32,16 +32,20 @@
 
 #include "DigestUtils.h"
 
-#include <openssl/sha.h>
 
 namespace intel { namespace sgx { namespace dcap { namespace crypto {
 
 Bytes sha256Digest(const Bytes& data)
+{
+    return sha256Digest(data.data(), data.size());
+}
+
+Bytes sha256Digest(const uint8_t* data, size_t size)
 {
     Bytes hash(SHA256_DIGEST_LENGTH);
     SHA256_CTX ctx;
     if(SHA256_Init(&ctx) == 1 &&
-        SHA256_Update(&ctx, data.data(), data.size()) == 1 &&
+        SHA256_Update(&ctx, data, size) == 1 &&
         SHA256_Final(hash.data(), &ctx) == 1)
     {
         return hash;
@@ -52,4 +56,35 @@ Bytes sha256Digest(const Bytes& data)
     }
 }
 
+bool sha256Digest(const ByteRange& data, Sha256Digest& digest)
+{
+    return Sha256().update(data).finalize(digest);
+}
+
+bool sha256Digest(std::initializer_list<ByteRange> data, Sha256Digest& digest)
+{
+    Sha256 sha;
+    for (const auto& range : data)
+    {
+        sha.update(range);
+    }
+    return sha.finalize(digest);
+}
+
+Sha256::Sha256(): _valid(SHA256_Init(&_ctx) == 1)
+{
+}
+
+Sha256& Sha256::update(const ByteRange& data)
+{
+    _valid = _valid && SHA256_Update(&_ctx, data.data(), data.size()) == 1;
+    return *this;
+}
+
+bool Sha256::finalize(Sha256Digest& digest)
+{
+    _valid = _valid && SHA256_Final(digest.data(), &_ctx) == 1;
+    return _valid;
+}
+
 }}}}
@@ -34,9 +34,50 @@
 
 #include <OpensslHelpers/Bytes.h>
 
+#include <openssl/sha.h>
+
+#include <array>
+#include <initializer_list>
+
 namespace intel { namespace sgx { namespace dcap { namespace crypto {
 
 Bytes sha256Digest(const Bytes& data);
+Bytes sha256Digest(const uint8_t* data, size_t size);
+
+using Sha256Digest = std::array<uint8_t, 32>;
+
+/**
+ * Computes SHA-256 into fixed size output, without any heap allocation.
+ * @return true on success
+ */
+bool sha256Digest(const ByteRange& data, Sha256Digest& digest);
+
+/**
+ * Computes SHA-256 over concatenation of given ranges, without concatenating them.
+ * @return true on success
+ */
+bool sha256Digest(std::initializer_list<ByteRange> data, Sha256Digest& digest);
+
+/**
+ * Incremental SHA-256. Hashing context is kept inline, so hashing never allocates.
+ */
+class Sha256
+{
+public:
+    Sha256();
+
+    Sha256& update(const ByteRange& data);
+
+    /**
+     * Writes digest of all updated data.
+     * @return false if any of the hashing steps failed
+     */
+    bool finalize(Sha256Digest& digest);
+
+private:
+    SHA256_CTX _ctx;
+    bool _valid;
+};
 
 }}}} // namespace intel { namespace sgx { namespace dcap { namespace crypto {
 
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "PublicKeyCache.h"
+#include "KeyUtils.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace intel { namespace sgx { namespace dcap { namespace crypto {
+
+constexpr size_t PublicKeyCache::DEFAULT_CAPACITY;
+
+PublicKeyCache& PublicKeyCache::instance()
+{
+    static PublicKeyCache cache;
+    return cache;
+}
+
+EVP_PKEY_sptr PublicKeyCache::convert(const std::array<uint8_t, 64>& rawKey)
+{
+    const auto ecKey = rawToP256PubKey(rawKey);
+    if (!ecKey)
+    {
+        return nullptr;
+    }
+    auto evp = toEvp(*ecKey);
+    if (!evp)
+    {
+        return nullptr;
+    }
+    return EVP_PKEY_sptr(evp.release(), EVP_PKEY_free);
+}
+
+size_t PublicKeyCache::RawKeyHash::operator()(const RawKey& key) const
+{
+    // X coordinate of a public key is uniformly distributed, its first bytes are good enough as a hash
+    size_t hash = 0;
+    std::memcpy(&hash, key.data(), sizeof(hash));
+    return hash;
+}
+
+EVP_PKEY_sptr PublicKeyCache::get(const std::array<uint8_t, 64>& rawKey)
+{
+    EVP_PKEY_sptr key;
+    if (_cache.get(rawKey, key))
+    {
+        return key;
+    }
+
+    // conversion is done without the lock, the same key converted concurrently is simply stored twice
+    key = convert(rawKey);
+    if (key)
+    {
+        _cache.put(rawKey, key);
+    }
+    return key;
+}
+
+EVP_PKEY_sptr PublicKeyCache::get(const std::vector<uint8_t>& uncompressedKey)
+{
+    RawKey raw{};
+    if (uncompressedKey.size() != raw.size() + 1)
+    {
+        return nullptr;
+    }
+    std::copy_n(uncompressedKey.begin() + 1, raw.size(), raw.begin()); // skip header byte
+    return get(raw);
+}
+
+void PublicKeyCache::setCapacity(size_t capacity)
+{
+    _cache.setCapacity(capacity);
+}
+
+size_t PublicKeyCache::size() const
+{
+    return _cache.size();
+}
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace crypto {
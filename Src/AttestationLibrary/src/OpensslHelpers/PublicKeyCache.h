@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef INTEL_SGX_QVL_PUBLIC_KEY_CACHE_H_
+#define INTEL_SGX_QVL_PUBLIC_KEY_CACHE_H_
+
+#include "OpensslHelpers/OpensslTypes.h"
+#include "Utils/LruCache.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace intel { namespace sgx { namespace dcap { namespace crypto {
+
+/**
+ * Process wide, bounded LRU cache of ready to use P-256 public keys.
+ * Keys are indexed by their raw 64 byte (X || Y) representation, so keys repeating between verifications
+ * (PCK certificates, CRL and TCB Info / QE Identity signers) are converted to EVP_PKEY only once.
+ * Quote attestation keys are converted with convert() instead, they are different in almost every quote
+ * and would only evict the keys above.
+ * Returned keys are never modified and may be used concurrently from multiple threads.
+ */
+class PublicKeyCache
+{
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 256;
+
+    static PublicKeyCache& instance();
+
+    /**
+     * Returns key for raw X || Y coordinates or nullptr if they don't describe a valid P-256 point.
+     */
+    EVP_PKEY_sptr get(const std::array<uint8_t, 64>& rawKey);
+
+    /**
+     * Returns key for uncompressed point (header byte followed by X || Y), as stored in X.509 certificates.
+     */
+    EVP_PKEY_sptr get(const std::vector<uint8_t>& uncompressedKey);
+
+    /**
+     * Converts raw X || Y coordinates to a key without caching it, returns nullptr if they don't describe a valid P-256 point.
+     */
+    static EVP_PKEY_sptr convert(const std::array<uint8_t, 64>& rawKey);
+
+    /**
+     * Sets maximum number of cached keys and clears the cache. 0 disables caching.
+     */
+    void setCapacity(size_t capacity);
+    size_t size() const;
+
+private:
+    using RawKey = std::array<uint8_t, 64>;
+
+    struct RawKeyHash
+    {
+        size_t operator()(const RawKey& key) const;
+    };
+
+    PublicKeyCache() = default;
+
+    LruCache<RawKey, EVP_PKEY_sptr, RawKeyHash> _cache{DEFAULT_CAPACITY};
+};
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace crypto {
+
+#endif // INTEL_SGX_QVL_PUBLIC_KEY_CACHE_H_
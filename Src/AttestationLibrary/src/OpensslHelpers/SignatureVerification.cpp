@@ -32,25 +32,96 @@
 #include <algorithm>
 #include "SignatureVerification.h"
 #include "KeyUtils.h"
+#include "PublicKeyCache.h"
 
 namespace intel { namespace sgx { namespace dcap { namespace crypto {
 
-bool verifySignature(const pckparser::CrlStore& crl, const std::vector<uint8_t>& pubKey)
+namespace {
+
+/// ECDSA_SIG with preallocated r and s, reused by all raw signature verifications done on the thread
+ECDSA_SIG* reusableEcdsaSignature()
+{
+    struct Holder
+    {
+        ECDSA_SIG_uptr sig{crypto::make_unique(ECDSA_SIG_new())};
+
+        Holder()
+        {
+            auto bnR = crypto::make_unique(BN_new());
+            auto bnS = crypto::make_unique(BN_new());
+            if (!sig || !bnR || !bnS || 1 != ECDSA_SIG_set0(sig.get(), bnR.get(), bnS.get()))
+            {
+                sig.reset();
+                return;
+            }
+            bnR.release();
+            bnS.release();
+        }
+    };
+
+    thread_local Holder holder;
+    return holder.sig.get();
+}
+
+/// Verifies signature over TBSCertList bytes kept by streaming CrlStore, which keeps them only for CRLs signed
+/// with ecdsa-with-SHA256. Match of both signature algorithm fields is checked when CRL is walked.
+bool verifyTbsCertList(const X509_CRL& crl, const ByteRange& tbsCertList, EVP_PKEY& pubKey)
 {
-    auto publicKey = crypto::rawToP256PubKey(pubKey);
-    if (publicKey == nullptr)
+    const ASN1_BIT_STRING *signature = nullptr;
+    const X509_ALGOR *algorithm = nullptr;
+    X509_CRL_get0_signature(&crl, &signature, &algorithm);
+    if(!signature || !algorithm || OBJ_obj2nid(algorithm->algorithm) != NID_ecdsa_with_SHA256
+       || EVP_PKEY_base_id(&pubKey) != EVP_PKEY_EC)
+    {
+        return false;
+    }
+
+    // bit string with unused bits is not a valid signature
+    if((signature->flags & ASN1_STRING_FLAG_BITS_LEFT) && (signature->flags & 0x07) != 0)
+    {
+        return false;
+    }
+
+    auto ctx = crypto::make_unique(EVP_MD_CTX_new());
+    if(!ctx)
     {
         return false;
     }
-    const auto evp = crypto::toEvp(*publicKey);
+
+    return (EVP_DigestVerifyInit(ctx.get(), nullptr, EVP_sha256(), nullptr, &pubKey) == 1)
+        && (EVP_DigestVerifyUpdate(ctx.get(), tbsCertList.data(), tbsCertList.size()) == 1)
+        && (EVP_DigestVerifyFinal(ctx.get(), signature->data, static_cast<size_t>(signature->length)) == 1);
+}
+
+} // anonymous namespace
+
+bool verifySignature(const pckparser::CrlStore& crl, const std::vector<uint8_t>& pubKey)
+{
+    const auto evp = PublicKeyCache::instance().get(pubKey);
     if(!evp)
     {
         return false;
     }
+
+    const auto tbsCertList = crl.getTbsCertList();
+    if(!tbsCertList.empty())
+    {
+        return verifyTbsCertList(crl.getCrl(), tbsCertList, *evp);
+    }
     return 1 == X509_CRL_verify(&const_cast<X509_CRL&>(crl.getCrl()), evp.get());
 }
 
 bool verifySha256Signature(const Bytes& signature, const Bytes& msg, const EC_KEY& pubKey)
+{
+    return verifySha256Signature(signature, ByteRange(msg), pubKey);
+}
+
+bool verifySha256Signature(const Bytes& signature, const Bytes& message, const EVP_PKEY& pubKey)
+{
+    return verifySha256Signature(signature, ByteRange(message), pubKey);
+}
+
+bool verifySha256Signature(const Bytes& signature, const ByteRange& msg, const EC_KEY& pubKey)
 {
     const auto evp = crypto::toEvp(pubKey);
     if(!evp)
@@ -60,7 +131,7 @@ bool verifySha256Signature(const Bytes& signature, const Bytes& msg, const EC_KE
     return verifySha256Signature(signature, msg, *evp);
 }
 
-bool verifySha256Signature(const Bytes& signature, const Bytes& message, const EVP_PKEY& pubKey)
+bool verifySha256Signature(const Bytes& signature, const ByteRange& message, const EVP_PKEY& pubKey)
 {
     auto ctx = crypto::make_unique(EVP_MD_CTX_new());
     if (!ctx)
@@ -105,11 +176,35 @@ std::vector<uint8_t> rawEcdsaSignatureToDER(const std::array<uint8_t,constants::
 
 bool verifySha256EcdsaSignature(const std::array<uint8_t, constants::ECDSA_P256_SIGNATURE_BYTE_LEN> &signature,
                                 const std::vector<uint8_t> &message, const EC_KEY &publicKey)
+{
+    return verifySha256EcdsaSignature(signature, ByteRange(message), publicKey);
+}
+
+bool verifySha256EcdsaSignature(const std::array<uint8_t, constants::ECDSA_P256_SIGNATURE_BYTE_LEN> &signature,
+                                const ByteRange &message, const EC_KEY &publicKey)
+{
+    const std::vector<uint8_t> sig = rawEcdsaSignatureToDER(signature);
+    return verifySha256Signature(sig, message, publicKey);
+}
+
+bool verifySha256EcdsaSignature(const std::array<uint8_t, constants::ECDSA_P256_SIGNATURE_BYTE_LEN> &signature,
+                                const ByteRange &message, const EVP_PKEY &publicKey)
 {
     const std::vector<uint8_t> sig = rawEcdsaSignatureToDER(signature);
     return verifySha256Signature(sig, message, publicKey);
 }
 
+bool verifySha256EcdsaSignature(const Bytes &signature, const std::vector<uint8_t> &message, const EVP_PKEY &publicKey)
+{
+    if(signature.size() != constants::ECDSA_P256_SIGNATURE_BYTE_LEN)
+    {
+        return false;
+    }
+    std::array<uint8_t, constants::ECDSA_P256_SIGNATURE_BYTE_LEN> signatureArr{};
+    std::copy_n(signature.begin(), constants::ECDSA_P256_SIGNATURE_BYTE_LEN, signatureArr.begin());
+    return verifySha256EcdsaSignature(signatureArr, message, publicKey);
+}
+
 bool verifySha256EcdsaSignature(const Bytes &signature, const std::vector<uint8_t> &message, const EC_KEY &publicKey)
 {
     if(signature.size() != constants::ECDSA_P256_SIGNATURE_BYTE_LEN)
@@ -121,9 +216,32 @@ bool verifySha256EcdsaSignature(const Bytes &signature, const std::vector<uint8_
     return verifySha256EcdsaSignature(signatureArr, message, publicKey);
 }
 
+bool verifyRawEcdsaSignature(const std::array<uint8_t, constants::ECDSA_P256_SIGNATURE_BYTE_LEN> &signature,
+                             const Sha256Digest &digest, const EVP_PKEY &publicKey)
+{
+    const EC_KEY* ecKey = EVP_PKEY_get0_EC_KEY(&const_cast<EVP_PKEY&>(publicKey));
+    auto ecdsaSig = reusableEcdsaSignature();
+    if (!ecKey || !ecdsaSig)
+    {
+        return false;
+    }
+
+    const BIGNUM* bnR = nullptr;
+    const BIGNUM* bnS = nullptr;
+    ECDSA_SIG_get0(ecdsaSig, &bnR, &bnS);
+    constexpr int coordinateSize = constants::ECDSA_P256_SIGNATURE_BYTE_LEN / 2;
+    if (!BN_bin2bn(signature.data(), coordinateSize, const_cast<BIGNUM*>(bnR)) ||
+        !BN_bin2bn(signature.data() + coordinateSize, coordinateSize, const_cast<BIGNUM*>(bnS)))
+    {
+        return false;
+    }
+
+    return 1 == ECDSA_do_verify(digest.data(), static_cast<int>(digest.size()), ecdsaSig, const_cast<EC_KEY*>(ecKey));
+}
+
 bool verifySha256EcdsaSignature(const dcap::parser::x509::Signature &signature, const std::vector<uint8_t> &message, const std::vector<uint8_t> &publicKey)
 {
-    auto pubKey = rawToP256PubKey(publicKey);
+    const auto pubKey = PublicKeyCache::instance().get(publicKey);
     if (pubKey == nullptr)
     {
         return false;
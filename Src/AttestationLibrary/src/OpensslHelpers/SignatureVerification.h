@@ -35,6 +35,7 @@
 #include <SgxEcdsaAttestation/AttestationParsers.h>
 
 #include "OpensslHelpers/Bytes.h"
+#include "OpensslHelpers/DigestUtils.h"
 #include "OpensslHelpers/OpensslTypes.h"
 
 #include <PckParser/CrlStore.h>
@@ -48,6 +49,8 @@ bool verifySignature(const pckparser::CrlStore& crl, const std::vector<uint8_t>&
 
 bool verifySha256Signature(const Bytes& signature, const Bytes& message, const EC_KEY& publicKey);
 bool verifySha256Signature(const Bytes& signature, const Bytes& message, const EVP_PKEY& publicKey);
+bool verifySha256Signature(const Bytes& signature, const ByteRange& message, const EC_KEY& publicKey);
+bool verifySha256Signature(const Bytes& signature, const ByteRange& message, const EVP_PKEY& publicKey);
 
 template<size_t N>
 bool verifySha256Signature(const Bytes& signature, const std::array<uint8_t,N>& message, const EC_KEY& publicKey)
@@ -66,7 +69,21 @@ bool verifySha256EcdsaSignature(const std::array<uint8_t, constants::ECDSA_P256_
 bool verifySha256EcdsaSignature(const std::array<uint8_t, constants::ECDSA_P256_SIGNATURE_BYTE_LEN> &signature,
                                 const std::vector<uint8_t> &message, const EC_KEY &publicKey);
 
+bool verifySha256EcdsaSignature(const std::array<uint8_t, constants::ECDSA_P256_SIGNATURE_BYTE_LEN> &signature,
+                                const ByteRange &message, const EC_KEY &publicKey);
+
+bool verifySha256EcdsaSignature(const std::array<uint8_t, constants::ECDSA_P256_SIGNATURE_BYTE_LEN> &signature,
+                                const ByteRange &message, const EVP_PKEY &publicKey);
+
 bool verifySha256EcdsaSignature(const Bytes &signature, const std::vector<uint8_t> &message, const EC_KEY &publicKey);
+bool verifySha256EcdsaSignature(const Bytes &signature, const std::vector<uint8_t> &message, const EVP_PKEY &publicKey);
+
+/**
+ * Verifies raw (r || s) P-256 ECDSA signature over already computed SHA-256 digest.
+ * Signature is not converted to DER, it is decoded into a per thread ECDSA_SIG reused between calls.
+ */
+bool verifyRawEcdsaSignature(const std::array<uint8_t, constants::ECDSA_P256_SIGNATURE_BYTE_LEN> &signature,
+                             const Sha256Digest &digest, const EVP_PKEY &publicKey);
 
 bool verifySha256EcdsaSignature(const dcap::parser::x509::Signature &signature, const std::vector<uint8_t> &message, const std::vector<uint8_t> &publicKey);
 
@@ -0,0 +1,269 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "CrlDerWalker.h"
+
+#include <openssl/asn1.h>
+#include <openssl/err.h>
+#include <openssl/x509.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace intel { namespace sgx { namespace dcap { namespace pckparser {
+
+namespace {
+
+struct DerElement
+{
+    const uint8_t* begin = nullptr; // first byte of the header
+    const uint8_t* content = nullptr;
+    const uint8_t* end = nullptr;
+    int tag = 0;
+    int tagClass = 0;
+    bool constructed = false;
+
+    size_t size() const { return static_cast<size_t>(end - begin); }
+    size_t contentSize() const { return static_cast<size_t>(end - content); }
+};
+
+bool readElement(const uint8_t*& position, const uint8_t* end, DerElement& element)
+{
+    if(position >= end || static_cast<size_t>(end - position) > static_cast<size_t>(std::numeric_limits<long>::max()))
+    {
+        return false;
+    }
+
+    const unsigned char *content = position;
+    long contentLength = 0;
+    const auto result = ASN1_get_object(&content, &contentLength, &element.tag, &element.tagClass,
+                                        static_cast<long>(end - position));
+    // 0x80 flags an error, constructed indefinite length form is not DER
+    if((result & 0x80) != 0 || result == (V_ASN1_CONSTRUCTED | 0x01))
+    {
+        return false;
+    }
+
+    element.begin = position;
+    element.content = content;
+    element.end = content + contentLength;
+    element.constructed = (result & V_ASN1_CONSTRUCTED) != 0;
+    position = element.end;
+    return true;
+}
+
+bool isUniversal(const DerElement& element, int tag, bool constructed)
+{
+    return element.tagClass == V_ASN1_UNIVERSAL && element.tag == tag && element.constructed == constructed;
+}
+
+bool isTime(const DerElement& element)
+{
+    return isUniversal(element, V_ASN1_UTCTIME, false) || isUniversal(element, V_ASN1_GENERALIZEDTIME, false);
+}
+
+void appendHeader(std::vector<uint8_t>& out, uint8_t tag, size_t length)
+{
+    out.push_back(tag);
+    if(length < 0x80)
+    {
+        out.push_back(static_cast<uint8_t>(length));
+        return;
+    }
+
+    uint8_t lengthBytes[sizeof(size_t)];
+    size_t count = 0;
+    for(auto remaining = length; remaining != 0; remaining >>= 8)
+    {
+        lengthBytes[count++] = static_cast<uint8_t>(remaining & 0xFF);
+    }
+    out.push_back(static_cast<uint8_t>(0x80 | count));
+    while(count > 0)
+    {
+        out.push_back(lengthBytes[--count]);
+    }
+}
+
+bool areValidEntryExtensions(const DerElement& extensions)
+{
+    // OpenSSL rejects whole CRL when entry extensions do not decode, so they are checked the same way
+    const unsigned char *data = extensions.begin;
+    auto decoded = d2i_X509_EXTENSIONS(nullptr, &data, static_cast<long>(extensions.size()));
+    if(!decoded)
+    {
+        ERR_clear_error();
+        return false;
+    }
+    sk_X509_EXTENSION_pop_free(decoded, X509_EXTENSION_free);
+    return true;
+}
+
+} // anonymous namespace
+
+bool walkCrlDer(const uint8_t* der, size_t length, CrlDerLayout& layout)
+{
+    if(der == nullptr || length == 0)
+    {
+        return false;
+    }
+
+    const uint8_t *position = der;
+    DerElement certificateList;
+    if(!readElement(position, der + length, certificateList) || !isUniversal(certificateList, V_ASN1_SEQUENCE, true))
+    {
+        return false;
+    }
+
+    // CertificateList ::= SEQUENCE { tbsCertList, signatureAlgorithm, signatureValue }
+    position = certificateList.content;
+    DerElement tbsCertList, signatureAlgorithm, signatureValue;
+    if(!readElement(position, certificateList.end, tbsCertList) || !isUniversal(tbsCertList, V_ASN1_SEQUENCE, true)
+       || !readElement(position, certificateList.end, signatureAlgorithm)
+       || !readElement(position, certificateList.end, signatureValue)
+       || position != certificateList.end)
+    {
+        return false;
+    }
+
+    // TBSCertList ::= SEQUENCE { version OPTIONAL, signature, issuer, thisUpdate, nextUpdate OPTIONAL,
+    //                            revokedCertificates OPTIONAL, crlExtensions [0] OPTIONAL }
+    position = tbsCertList.content;
+    DerElement element;
+    if(!readElement(position, tbsCertList.end, element))
+    {
+        return false;
+    }
+    if(isUniversal(element, V_ASN1_INTEGER, false) && !readElement(position, tbsCertList.end, element))
+    {
+        return false;
+    }
+    // signature in TBSCertList has to match signatureAlgorithm, verification over raw TBSCertList relies on it
+    if(!isUniversal(element, V_ASN1_SEQUENCE, true) || element.size() != signatureAlgorithm.size()
+       || !std::equal(element.begin, element.end, signatureAlgorithm.begin)
+       || !readElement(position, tbsCertList.end, element) || !isUniversal(element, V_ASN1_SEQUENCE, true)
+       || !readElement(position, tbsCertList.end, element) || !isTime(element))
+    {
+        return false;
+    }
+
+    auto next = position;
+    if(next < tbsCertList.end && readElement(next, tbsCertList.end, element) && isTime(element))
+    {
+        position = next;
+    }
+
+    DerElement revokedCertificates;
+    next = position;
+    const auto hasRevoked = next < tbsCertList.end && readElement(next, tbsCertList.end, revokedCertificates)
+                            && isUniversal(revokedCertificates, V_ASN1_SEQUENCE, true);
+    const auto revokedBegin = position;
+    const auto revokedEnd = hasRevoked ? next : position;
+
+    layout.tbsCertList = ByteRange(tbsCertList.begin, tbsCertList.size());
+    layout.revokedCertificates = hasRevoked
+            ? ByteRange(revokedCertificates.content, revokedCertificates.contentSize())
+            : ByteRange();
+
+    const auto tbsContentSize = static_cast<size_t>(revokedBegin - tbsCertList.content)
+                                + static_cast<size_t>(tbsCertList.end - revokedEnd);
+    std::vector<uint8_t> tbsHeader;
+    appendHeader(tbsHeader, V_ASN1_SEQUENCE | V_ASN1_CONSTRUCTED, tbsContentSize);
+    const auto signatureSize = static_cast<size_t>(signatureValue.end - signatureAlgorithm.begin);
+
+    auto& skeleton = layout.skeleton;
+    skeleton.clear();
+    appendHeader(skeleton, V_ASN1_SEQUENCE | V_ASN1_CONSTRUCTED, tbsHeader.size() + tbsContentSize + signatureSize);
+    skeleton.insert(skeleton.end(), tbsHeader.cbegin(), tbsHeader.cend());
+    skeleton.insert(skeleton.end(), tbsCertList.content, revokedBegin);
+    skeleton.insert(skeleton.end(), revokedEnd, tbsCertList.end);
+    skeleton.insert(skeleton.end(), signatureAlgorithm.begin, signatureValue.end);
+    return true;
+}
+
+bool forEachRevokedEntry(const ByteRange& revokedCertificates,
+                         const std::function<bool(const ByteRange&, const ByteRange&)>& visit)
+{
+    const uint8_t *position = revokedCertificates.data();
+    const auto end = revokedCertificates.data() + revokedCertificates.size();
+    while(position < end)
+    {
+        // SEQUENCE { userCertificate INTEGER, revocationDate Time, crlEntryExtensions Extensions OPTIONAL }
+        DerElement entry, serialNumber, revocationDate;
+        if(!readElement(position, end, entry) || !isUniversal(entry, V_ASN1_SEQUENCE, true))
+        {
+            return false;
+        }
+
+        auto field = entry.content;
+        if(!readElement(field, entry.end, serialNumber) || !isUniversal(serialNumber, V_ASN1_INTEGER, false)
+           || !readElement(field, entry.end, revocationDate) || !isTime(revocationDate))
+        {
+            return false;
+        }
+
+        if(field < entry.end)
+        {
+            DerElement extensions;
+            if(!readElement(field, entry.end, extensions) || !isUniversal(extensions, V_ASN1_SEQUENCE, true)
+               || field != entry.end || !areValidEntryExtensions(extensions))
+            {
+                return false;
+            }
+        }
+
+        // ASN1_INTEGER keeps magnitude: single padding zero of positive number is dropped, padding that is not needed
+        // is rejected by OpenSSL. Negative serials are two's complement converted there, such CRLs are left to OpenSSL.
+        const auto serialSize = serialNumber.contentSize();
+        if(serialSize == 0 || (serialNumber.content[0] & 0x80) != 0)
+        {
+            return false;
+        }
+        size_t padding = 0;
+        if(serialSize > 1 && serialNumber.content[0] == 0)
+        {
+            if((serialNumber.content[1] & 0x80) == 0)
+            {
+                return false;
+            }
+            padding = 1;
+        }
+
+        if(!visit(ByteRange(serialNumber.content + padding, serialSize - padding),
+                  ByteRange(revocationDate.begin, revocationDate.size())))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace pckparser {
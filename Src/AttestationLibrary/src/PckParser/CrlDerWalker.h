@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGX_INTEL_QVL_CRLDERWALKER_H_
+#define SGX_INTEL_QVL_CRLDERWALKER_H_
+
+#include <OpensslHelpers/Bytes.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace intel { namespace sgx { namespace dcap { namespace pckparser {
+
+/**
+ * Parts of DER encoded CRL located without building X509_REVOKED entries. Ranges point into the walked buffer.
+ */
+struct CrlDerLayout
+{
+    ByteRange tbsCertList;          // whole TBSCertList element, exactly the bytes covered by the signature
+    ByteRange revokedCertificates;  // content of revokedCertificates SEQUENCE, empty when CRL has no entries
+    std::vector<uint8_t> skeleton;  // CertificateList re-encoded without revokedCertificates
+};
+
+/**
+ * Splits DER encoded CertificateList (RFC 5280 5.1). Only structure around revokedCertificates is checked here,
+ * skeleton is expected to be decoded by OpenSSL which validates the rest. Data following the CRL is ignored.
+ *
+ * @return false if input is not a definite length CertificateList or if signature algorithm inside TBSCertList
+ *         differs from signatureAlgorithm (such CRL never verifies, it is left to OpenSSL)
+ */
+bool walkCrlDer(const uint8_t* der, size_t length, CrlDerLayout& layout);
+
+/**
+ * Visits revokedCertificates entries in encoding order.
+ *
+ * Serial number passed to visitor is the INTEGER magnitude the way OpenSSL stores it in ASN1_INTEGER,
+ * revocation date is the whole DER Time element. Entry extensions are validated but not decoded.
+ *
+ * @param revokedCertificates - CrlDerLayout::revokedCertificates
+ * @param visit - called with serial number and revocation date, returning false stops the walk
+ * @return false if an entry is malformed, uses negative serial number or visitor stopped the walk
+ */
+bool forEachRevokedEntry(const ByteRange& revokedCertificates,
+                         const std::function<bool(const ByteRange&, const ByteRange&)>& visit);
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace pckparser {
+
+#endif // SGX_INTEL_QVL_CRLDERWALKER_H_
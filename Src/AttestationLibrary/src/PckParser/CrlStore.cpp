@@ -31,23 +31,73 @@
 
 
 #include "CrlStore.h"
+#include "CrlDerWalker.h"
 #include "FormatException.h"
 #include "Utils/Logger.h"
 
 #include <OpensslHelpers/Assert.h>
+#include <Utils/Encoding.h>
 
-#include <algorithm>
+#include <openssl/err.h>
+#include <openssl/objects.h>
+#include <openssl/pem.h>
+
+#if defined(__unix__) && !defined(SGX_TRUSTED)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#elif !defined(SGX_TRUSTED)
+#include <fstream>
+#include <iterator>
+#endif
 
 namespace intel { namespace sgx { namespace dcap { namespace pckparser {
 
+namespace {
+
+// Same dispatch as str2X509Crl, only input that can be decoded without OpenSSL is accepted
+bool decodeCrlString(const std::string& crlString, std::vector<uint8_t>& der)
+{
+    if(crlString.rfind(PEM_STRING_X509_CRL, 12) == std::string::npos)
+    {
+        der.resize(crlString.size() / 2);
+        return !der.empty() && decodeHex(crlString.data(), crlString.size(), der.data()) == DecodeStatus::OK;
+    }
+    return decodePem(crlString.data(), crlString.size(), PEM_STRING_X509_CRL, der) == DecodeStatus::OK && !der.empty();
+}
+
+std::shared_ptr<const uint8_t> share(std::vector<uint8_t> bytes)
+{
+    const auto owner = std::make_shared<std::vector<uint8_t>>(std::move(bytes));
+    return std::shared_ptr<const uint8_t>(owner, owner->data());
+}
+
+// Signature over raw TBSCertList is verified only for ecdsa-with-SHA256, the algorithm Intel SGX CAs sign CRLs with.
+// CRLs signed with other algorithms are parsed by OpenSSL and verified with X509_CRL_verify.
+bool isSignedWithEcdsaSha256(const X509_CRL& crl)
+{
+    const X509_ALGOR *algorithm = nullptr;
+    X509_CRL_get0_signature(&crl, nullptr, &algorithm);
+    return algorithm != nullptr && OBJ_obj2nid(algorithm->algorithm) == NID_ecdsa_with_SHA256;
+}
+
+} // anonymous namespace
+
 CrlStore::CrlStore()
     : _crl{crypto::make_unique(X509_CRL_new())},
+      _der{},
+      _tbsCertList{},
+      _revokedCertificates{},
       _issuer{},
       _validity{},
-      _revoked{},
+      _revoked{std::make_shared<RevokedEntries>()},
+      _revokedIndex{},
       _extensions{},
       _signature{},
-      _crlNum{}
+      _crlNum{},
+      _derDigest{},
+      _hasDerDigest{false}
 {
 }
 
@@ -65,17 +115,19 @@ bool CrlStore::operator!=(const CrlStore& other) const
 
 bool CrlStore::parse(const std::string& crlString)
 {
-    try
+    std::vector<uint8_t> der;
+    if(decodeCrlString(crlString, der))
     {
-        _crl = pckparser::str2X509Crl(crlString);
-        QVL_ASSERT(_crl);
+        const auto size = der.size();
+        if(parseStreaming(share(std::move(der)), size))
+        {
+            return true;
+        }
+    }
 
-        _issuer = pckparser::getIssuer(*_crl);
-        _validity = pckparser::getValidity(*_crl);
-        _extensions = pckparser::getExtensions(*_crl);
-        _revoked = pckparser::getRevoked(*_crl);
-        _signature = pckparser::getSignature(*_crl);
-        _crlNum = pckparser::getCrlNum(*_crl);
+    try
+    {
+        setMembers(pckparser::str2X509Crl(crlString));
     }
     catch(const FormatException& ex)
     {
@@ -83,9 +135,88 @@ bool CrlStore::parse(const std::string& crlString)
         return false;
     }
 
+    // input was not decoded here, digest is taken over OpenSSL encoding of what it has parsed
+    unsigned char *encoded = nullptr;
+    const auto length = i2d_X509_CRL(_crl.get(), &encoded);
+    std::unique_ptr<unsigned char, decltype(&crypto::freeOPENSSL)> encodedOwner(encoded, crypto::freeOPENSSL);
+    setDerDigest(length > 0 ? ByteRange(encoded, static_cast<size_t>(length)) : ByteRange());
     return true;
 }
 
+bool CrlStore::parseDer(const uint8_t* der, size_t length)
+{
+    if(der != nullptr && length != 0 && parseStreaming(share(std::vector<uint8_t>(der, der + length)), length))
+    {
+        return true;
+    }
+
+    return parseWithOpenssl(der, length);
+}
+
+bool CrlStore::parseWithOpenssl(const uint8_t* der, size_t length)
+{
+    try
+    {
+        setMembers(pckparser::der2X509Crl(der, length));
+    }
+    catch(const FormatException& ex)
+    {
+        LOG_ERROR("Error while parsing DER CRL: {}", ex.what());
+        return false;
+    }
+
+    setDerDigest(ByteRange(der, length));
+    return true;
+}
+
+bool CrlStore::parseDerFile(const std::string& path)
+{
+#if defined(__unix__) && !defined(SGX_TRUSTED)
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if(fd < 0)
+    {
+        LOG_ERROR("Can't open CRL file: {}", path);
+        return false;
+    }
+
+    struct stat fileStat{};
+    if(fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0)
+    {
+        close(fd);
+        LOG_ERROR("Can't read size of CRL file or it is empty: {}", path);
+        return false;
+    }
+
+    const auto size = static_cast<size_t>(fileStat.st_size);
+    void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(mapping == MAP_FAILED)
+    {
+        LOG_ERROR("Can't map CRL file: {}", path);
+        return false;
+    }
+
+    const std::shared_ptr<const uint8_t> der(static_cast<const uint8_t*>(mapping), [size](const uint8_t* data) {
+        munmap(const_cast<uint8_t*>(data), size);
+    });
+    return parseStreaming(der, size) || parseWithOpenssl(der.get(), size);
+#elif !defined(SGX_TRUSTED)
+    std::ifstream file(path, std::ios::binary);
+    if(!file)
+    {
+        LOG_ERROR("Can't open CRL file: {}", path);
+        return false;
+    }
+
+    std::vector<uint8_t> der((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return parseDer(der.data(), der.size());
+#else
+    (void)path;
+    LOG_ERROR("CRL files are not supported in enclave");
+    return false;
+#endif
+}
+
 bool CrlStore::expired(const time_t& expirationDate) const
 {
     return !_validity.isValid(expirationDate);
@@ -103,7 +234,18 @@ const Validity& CrlStore::getValidity() const
 
 const std::vector<Revoked>& CrlStore::getRevoked() const
 {
-    return _revoked;
+    QVL_ASSERT(_revoked);
+    std::lock_guard<std::mutex> lock(_revoked->mutex);
+    if(!_revoked->decoded)
+    {
+        // entries were validated by parseStreaming, so the walk can't fail here
+        forEachRevokedEntry(_revokedCertificates, [this](const ByteRange& serialNumber, const ByteRange& revocationDate) {
+            _revoked->entries.emplace_back(pckparser::getRevoked(serialNumber, revocationDate));
+            return true;
+        });
+        _revoked->decoded = true;
+    }
+    return _revoked->entries;
 }
 
 long CrlStore::getCrlNum() const
@@ -129,11 +271,103 @@ const X509_CRL& CrlStore::getCrl() const
 
 bool CrlStore::isRevoked(const dcap::parser::x509::Certificate& cert) const
 {
-    return std::find_if(
-            getRevoked().cbegin(),
-            getRevoked().cend(), [&](const pckparser::Revoked& revoked){
-                return revoked.serialNumber == cert.getSerialNumber();
-            }) != getRevoked().cend();
+    return _revokedIndex.contains(cert.getSerialNumber());
+}
+
+ByteRange CrlStore::getTbsCertList() const
+{
+    return _tbsCertList;
+}
+
+bool CrlStore::getDerDigest(crypto::Sha256Digest& digest) const
+{
+    digest = _derDigest;
+    return _hasDerDigest;
+}
+
+// Private
+
+bool CrlStore::parseStreaming(std::shared_ptr<const uint8_t> der, size_t length)
+{
+    CrlDerLayout layout;
+    if(!walkCrlDer(der.get(), length, layout))
+    {
+        return false;
+    }
+
+    std::vector<ByteRange> revokedSerialNumbers;
+    if(!forEachRevokedEntry(layout.revokedCertificates, [&revokedSerialNumbers](const ByteRange& serialNumber, const ByteRange&) {
+        revokedSerialNumbers.push_back(serialNumber);
+        return true;
+    }))
+    {
+        return false;
+    }
+
+    const uint8_t *skeleton = layout.skeleton.data();
+    auto crl = crypto::make_unique(d2i_X509_CRL(nullptr, &skeleton, static_cast<long>(layout.skeleton.size())));
+    if(!crl || !isSignedWithEcdsaSha256(*crl))
+    {
+        ERR_clear_error();
+        return false;
+    }
+
+    try
+    {
+        setMembers(std::move(crl));
+    }
+    catch(const FormatException&)
+    {
+        return false;
+    }
+
+    _der = std::move(der);
+    _tbsCertList = layout.tbsCertList;
+    _revokedCertificates = layout.revokedCertificates;
+    _revoked = std::make_shared<RevokedEntries>();
+    _revoked->decoded = layout.revokedCertificates.empty();
+    _revokedIndex = SerialNumberIndex(revokedSerialNumbers);
+    setDerDigest(ByteRange(_der.get(), length));
+    return true;
+}
+
+void CrlStore::setMembers(crypto::X509_CRL_uptr crl)
+{
+    QVL_ASSERT(crl);
+
+    // members are replaced only when whole CRL is decoded
+    auto issuer = pckparser::getIssuer(*crl);
+    auto validity = pckparser::getValidity(*crl);
+    auto extensions = pckparser::getExtensions(*crl);
+    auto revoked = std::make_shared<RevokedEntries>();
+    revoked->entries = pckparser::getRevoked(*crl);
+    auto signature = pckparser::getSignature(*crl);
+    const auto crlNum = pckparser::getCrlNum(*crl);
+
+    std::vector<ByteRange> revokedSerialNumbers;
+    revokedSerialNumbers.reserve(revoked->entries.size());
+    for (const auto& entry : revoked->entries)
+    {
+        revokedSerialNumbers.emplace_back(entry.serialNumber);
+    }
+
+    _crl = std::move(crl);
+    _der.reset();
+    _tbsCertList = {};
+    _revokedCertificates = {};
+    _issuer = std::move(issuer);
+    _validity = validity;
+    _extensions = std::move(extensions);
+    _revoked = std::move(revoked);
+    _signature = std::move(signature);
+    _crlNum = crlNum;
+    _revokedIndex = SerialNumberIndex(revokedSerialNumbers);
+    _hasDerDigest = false;
+}
+
+void CrlStore::setDerDigest(const ByteRange& der)
+{
+    _hasDerDigest = !der.empty() && crypto::sha256Digest(der, _derDigest);
 }
 
 }}}} // namespace intel { namespace sgx { namespace dcap { namespace pckparser {
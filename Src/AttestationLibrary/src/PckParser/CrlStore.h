@@ -34,10 +34,15 @@
 #define SGX_INTEL_QVL_CRLSTORE_H_
 
 #include "PckParser.h"
+#include "SerialNumberIndex.h"
 #include <SgxEcdsaAttestation/AttestationParsers.h>
 
+#include <OpensslHelpers/DigestUtils.h>
 #include <OpensslHelpers/OpensslTypes.h>
 
+#include <memory>
+#include <mutex>
+
 using namespace intel::sgx::dcap;
 
 namespace intel { namespace sgx { namespace dcap { namespace pckparser {
@@ -55,8 +60,26 @@ public:
     bool operator==(const CrlStore& other) const;
     bool operator!=(const CrlStore& other) const;
 
+    /**
+     * Plain hex and PEM input is decoded and parsed in streaming mode, see parseDer.
+     * Anything the streaming parser does not handle is parsed by OpenSSL as a whole.
+     */
     virtual bool parse(const std::string& crlString);
 
+    /**
+     * Streaming mode: revokedCertificates sequence is walked in place and only serial numbers are indexed,
+     * OpenSSL decodes the CRL without its entries. Revoked entries with their dates are decoded on first getRevoked().
+     * Input is copied, CRLs the streaming parser does not handle (e.g. negative serial numbers, signature algorithms
+     * without separate digest) are parsed by OpenSSL as a whole.
+     */
+    virtual bool parseDer(const uint8_t* der, size_t length);
+
+    /**
+     * Same as parseDer but the file is mapped into memory instead of being copied, where the platform allows it.
+     * File must not be modified while the store is alive.
+     */
+    virtual bool parseDerFile(const std::string& path);
+
     virtual bool expired(const time_t& expirationDate) const;
     virtual const Issuer& getIssuer() const;
     virtual const Validity& getValidity() const;
@@ -67,15 +90,47 @@ public:
     virtual const X509_CRL& getCrl() const;
     virtual bool isRevoked(const dcap::parser::x509::Certificate& cert) const;
 
+    /**
+     * @return signed TBSCertList bytes when parsed in streaming mode, empty otherwise.
+     * In streaming mode getCrl() has no revoked entries, so its signature has to be checked over these bytes.
+     */
+    virtual ByteRange getTbsCertList() const;
+
+    /**
+     * SHA-256 of the parsed DER CRL, identifies CRL content regardless of input format.
+     * @return false if no CRL was parsed
+     */
+    virtual bool getDerDigest(crypto::Sha256Digest& digest) const;
+
 private:
+    struct RevokedEntries
+    {
+        std::mutex mutex;
+        bool decoded = true;
+        std::vector<Revoked> entries;
+    };
+
+    bool parseStreaming(std::shared_ptr<const uint8_t> der, size_t length);
+    bool parseWithOpenssl(const uint8_t* der, size_t length);
+    void setMembers(crypto::X509_CRL_uptr crl);
+    void setDerDigest(const ByteRange& der);
+
     crypto::X509_CRL_uptr _crl;
 
+    // streaming mode only, ranges point into _der
+    std::shared_ptr<const uint8_t> _der;
+    ByteRange _tbsCertList;
+    ByteRange _revokedCertificates;
+
     Issuer _issuer;
     Validity _validity;
-    std::vector<Revoked> _revoked;
+    std::shared_ptr<RevokedEntries> _revoked;
+    SerialNumberIndex _revokedIndex;
     std::vector<Extension> _extensions;
     Signature _signature;
     long _crlNum;
+    crypto::Sha256Digest _derDigest;
+    bool _hasDerDigest;
 };
 
 }}}} // namespace intel { namespace sgx { namespace dcap { namespace pckparser {
@@ -36,7 +36,10 @@
 #include <iterator>
 #include <map>
 #include <iomanip>
+#include <limits>
+#include <Utils/Encoding.h>
 #include <Utils/TimeUtils.h>
+#include <Utils/CivilTime.h>
 #include <Utils/SafeMemcpy.h>
 
 #include "FormatException.h"
@@ -409,13 +412,23 @@ Revoked getRevoked(const STACK_OF(X509_REVOKED)* revokedStack, int index)
 
 bool initialized = false;
 
-// Converts ASN1_TIME to time_t using ASN1_TIME_diff to get number of seconds from 1 Jan 1970
+// Converts ASN1_TIME to time_t, DER forms are converted directly and anything else
+// goes through ASN1_TIME_diff to get number of seconds from 1 Jan 1970
 std::time_t asn1TimeToTimet(
         const ASN1_TIME* asn1Time)
 {
     static_assert(sizeof(std::time_t) >= sizeof(int64_t), "std::time_t size too small, the dates may overflow");
     static constexpr int64_t SECONDS_IN_A_DAY = 24 * 60 * 60;
 
+    const auto type = asn1Time != nullptr ? ASN1_STRING_type(asn1Time) : V_ASN1_UNDEF;
+    time_t epoch = 0;
+    if((type == V_ASN1_UTCTIME || type == V_ASN1_GENERALIZEDTIME)
+       && asn1TimeToEpoch(ASN1_STRING_get0_data(asn1Time), static_cast<size_t>(ASN1_STRING_length(asn1Time)),
+                          type == V_ASN1_GENERALIZEDTIME, epoch))
+    {
+        return epoch;
+    }
+
     int pday;
     int psec;
     auto from = crypto::make_unique(ASN1_TIME_new());
@@ -464,30 +477,52 @@ void cleanUpOpenSSL()
 
 crypto::X509_CRL_uptr str2X509Crl(const std::string& string)
 {
-    auto bio_mem = crypto::make_unique(BIO_new(BIO_s_mem()));
-    crypto::X509_CRL_uptr ret = crypto::make_unique<X509_CRL>(nullptr);
     if(string.rfind(PEM_STRING_X509_CRL, 12) == std::string::npos)
     {
         // Attempt to read CRL as DER
         const auto bytes = hexStringToBytes(string);
-        const auto ec = BIO_write(bio_mem.get(), bytes.data(), (int) bytes.size());
-        if (ec < 1)
-        {
-            throw FormatException(getLastError());
-        }
-        ret.reset(d2i_X509_CRL_bio(bio_mem.get(), nullptr));
+        return der2X509Crl(bytes.data(), bytes.size());
     }
-    else
+
+    // Attempt to read CRL as PEM, plain block is decoded here, anything else is left to OpenSSL
+    std::vector<uint8_t> der;
+    if(decodePem(string.data(), string.size(), PEM_STRING_X509_CRL, der) == DecodeStatus::OK && !der.empty())
     {
-        // Attempt to read CRL as PEM
-        const auto ec = BIO_puts(bio_mem.get(), string.c_str());
-        if (ec < 1)
+        const uint8_t* data = der.data();
+        auto crl = crypto::make_unique(d2i_X509_CRL(nullptr, &data, static_cast<long>(der.size())));
+        if(crl)
         {
-            throw FormatException(getLastError());
+            return crl;
         }
-        ret.reset(PEM_read_bio_X509_CRL(bio_mem.get(), nullptr, nullptr, nullptr));
+        ERR_clear_error();
+    }
+
+    auto bio_mem = crypto::make_unique(BIO_new(BIO_s_mem()));
+    const auto ec = BIO_puts(bio_mem.get(), string.c_str());
+    if (ec < 1)
+    {
+        throw FormatException(getLastError());
+    }
+
+    auto ret = crypto::make_unique(PEM_read_bio_X509_CRL(bio_mem.get(), nullptr, nullptr, nullptr));
+    if(!ret)
+    {
+        throw FormatException(getLastError());
+    }
+
+    return ret;
+}
+
+crypto::X509_CRL_uptr der2X509Crl(const uint8_t* der, size_t length)
+{
+    if(der == nullptr || length == 0 || length > static_cast<size_t>(std::numeric_limits<long>::max()))
+    {
+        throw FormatException("DER CRL is empty or too long");
     }
 
+    // d2i_X509_CRL decodes directly from the buffer, trailing data is ignored as it was with d2i_X509_CRL_bio
+    auto data = der;
+    auto ret = crypto::make_unique(d2i_X509_CRL(nullptr, &data, static_cast<long>(length)));
     if(!ret)
     {
         throw FormatException(getLastError());
@@ -617,6 +652,27 @@ std::vector<Revoked> getRevoked(X509_CRL& crl)
     return ret;
 }
 
+Revoked getRevoked(const ByteRange& serialNumber, const ByteRange& revocationDate)
+{
+    if(serialNumber.empty() || revocationDate.size() > static_cast<size_t>(std::numeric_limits<long>::max()))
+    {
+        return {};
+    }
+
+    const unsigned char *data = revocationDate.data();
+    const auto time = crypto::make_unique(d2i_ASN1_TIME(nullptr, &data, static_cast<long>(revocationDate.size())));
+    if(!time)
+    {
+        ERR_clear_error();
+        return {};
+    }
+
+    return Revoked{
+        asn1ToString(time.get()),
+        Bytes(serialNumber.begin(), serialNumber.end())
+    };
+}
+
 Validity getValidity(const X509_CRL& crl)
 {
     const ASN1_TIME *lastUpdate = X509_CRL_get0_lastUpdate(&crl);
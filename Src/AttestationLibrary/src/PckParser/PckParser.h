@@ -49,6 +49,8 @@ using namespace intel::sgx::dcap;
 namespace intel { namespace sgx { namespace dcap { namespace pckparser {
 
 struct Subject;
+// Issuer and Subject are filled and modified through their public fields after construction,
+// so unlike x509::DistinguishedName they cannot keep a precomputed hash and compare field by field
 struct Issuer
 {
     std::string raw;
@@ -137,6 +139,7 @@ void cleanUpOpenSSL();
 ////////////////////////////////////////////////////////////////////////////
 
 crypto::X509_CRL_uptr str2X509Crl(const std::string& data);
+crypto::X509_CRL_uptr der2X509Crl(const uint8_t* der, size_t length);
 long getVersion(const X509_CRL& crl);
 Issuer getIssuer(const X509_CRL& crl);
 int getExtensionCount(const X509_CRL& crl);
@@ -146,6 +149,8 @@ Validity getValidity(const X509_CRL& crl);
 
 int getRevokedCount(X509_CRL& crl);
 std::vector<Revoked> getRevoked(X509_CRL& crl);
+// Builds entry the same way as getRevoked(X509_CRL&) does, from serial number magnitude and DER encoded Time
+Revoked getRevoked(const ByteRange& serialNumber, const ByteRange& revocationDate);
 long getCrlNum(X509_CRL& crl);
 
 }}}} // namespace intel { namespace sgx { namespace dcap { namespace pckparser {
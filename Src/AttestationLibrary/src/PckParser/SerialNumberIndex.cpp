@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "SerialNumberIndex.h"
+
+#include <algorithm>
+
+namespace intel { namespace sgx { namespace dcap { namespace pckparser {
+
+SerialNumberIndex::SerialNumberIndex(const std::vector<ByteRange>& serialNumbers)
+{
+    // power of two capacity with load factor at most 1/2 keeps probe sequences short
+    size_t capacity = 2;
+    while (capacity < serialNumbers.size() * 2)
+    {
+        capacity *= 2;
+    }
+    _slots.resize(capacity, Slot{});
+
+    for (const auto& serialNumber : serialNumbers)
+    {
+        if (serialNumber.size() > MAX_INLINE_SERIAL_LENGTH)
+        {
+            _longSerialNumbers.emplace_back(serialNumber.begin(), serialNumber.end());
+        }
+        else if (insert(serialNumber))
+        {
+            _size++;
+        }
+    }
+    std::sort(_longSerialNumbers.begin(), _longSerialNumbers.end());
+    _longSerialNumbers.erase(std::unique(_longSerialNumbers.begin(), _longSerialNumbers.end()), _longSerialNumbers.end());
+    _size += _longSerialNumbers.size();
+}
+
+bool SerialNumberIndex::contains(ByteRange serialNumber) const
+{
+    if (serialNumber.empty())
+    {
+        return _containsEmpty;
+    }
+    if (serialNumber.size() > MAX_INLINE_SERIAL_LENGTH)
+    {
+        return std::binary_search(_longSerialNumbers.cbegin(), _longSerialNumbers.cend(),
+                                  Bytes(serialNumber.begin(), serialNumber.end()));
+    }
+    if (_slots.empty())
+    {
+        return false;
+    }
+
+    const auto mask = _slots.size() - 1;
+    for (auto position = static_cast<size_t>(hash(serialNumber)) & mask;; position = (position + 1) & mask)
+    {
+        const auto& slot = _slots[position];
+        if (slot.length == 0)
+        {
+            return false;
+        }
+        if (slot.length == serialNumber.size() && std::equal(serialNumber.begin(), serialNumber.end(), slot.serialNumber.cbegin()))
+        {
+            return true;
+        }
+    }
+}
+
+size_t SerialNumberIndex::size() const
+{
+    return _size;
+}
+
+// Private
+
+uint64_t SerialNumberIndex::hash(ByteRange serialNumber)
+{
+    // FNV-1a, serial numbers are already random so no stronger mixing is needed
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (const auto byte : serialNumber)
+    {
+        hash = (hash ^ byte) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+bool SerialNumberIndex::insert(ByteRange serialNumber)
+{
+    if (serialNumber.empty())
+    {
+        const auto inserted = !_containsEmpty;
+        _containsEmpty = true;
+        return inserted;
+    }
+    const auto mask = _slots.size() - 1;
+    for (auto position = static_cast<size_t>(hash(serialNumber)) & mask;; position = (position + 1) & mask)
+    {
+        auto& slot = _slots[position];
+        if (slot.length == 0)
+        {
+            slot.length = static_cast<uint8_t>(serialNumber.size());
+            std::copy(serialNumber.begin(), serialNumber.end(), slot.serialNumber.begin());
+            return true;
+        }
+        if (slot.length == serialNumber.size() && std::equal(serialNumber.begin(), serialNumber.end(), slot.serialNumber.cbegin()))
+        {
+            return false;
+        }
+    }
+}
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace pckparser {
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGX_INTEL_QVL_SERIALNUMBERINDEX_H_
+#define SGX_INTEL_QVL_SERIALNUMBERINDEX_H_
+
+#include <OpensslHelpers/Bytes.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace intel { namespace sgx { namespace dcap { namespace pckparser {
+
+/**
+ * Immutable set of certificate serial numbers built once per CRL.
+ *
+ * Serials up to 20 bytes (RFC 5280 limit) are stored inline in open addressing table, so lookup touches
+ * a single slot in common case. Longer serials are kept sorted aside and searched with binary search.
+ */
+class SerialNumberIndex
+{
+public:
+    static constexpr size_t MAX_INLINE_SERIAL_LENGTH = 20;
+
+    SerialNumberIndex() = default;
+    explicit SerialNumberIndex(const std::vector<ByteRange>& serialNumbers);
+
+    bool contains(ByteRange serialNumber) const;
+    size_t size() const;
+
+private:
+    struct Slot
+    {
+        uint8_t length; // 0 marks empty slot
+        std::array<uint8_t, MAX_INLINE_SERIAL_LENGTH> serialNumber;
+    };
+
+    static uint64_t hash(ByteRange serialNumber);
+    bool insert(ByteRange serialNumber); // serial not longer than MAX_INLINE_SERIAL_LENGTH, false if already present
+
+    std::vector<Slot> _slots;
+    std::vector<Bytes> _longSerialNumbers;
+    bool _containsEmpty = false;
+    size_t _size = 0;
+};
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace pckparser {
+
+#endif // SGX_INTEL_QVL_SERIALNUMBERINDEX_H_
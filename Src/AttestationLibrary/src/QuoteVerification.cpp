@@ -30,15 +30,22 @@
  */
 
 
+#include <cstring>
 #include <string>
 #include <memory>
 #include <algorithm>
+#ifndef SGX_TRUSTED
+#include <atomic>
+#include <exception>
+#include <thread>
+#endif
 
 #include "PckParser/CrlStore.h"
 #include "CertVerification/CertificateChain.h"
 #include "QuoteVerification/Quote.h"
 #include "QuoteVerification/QuoteConstants.h"
 #include "QuoteVerification/QuoteParsers.h"
+#include "QuoteVerification/QuoteView.h"
 
 #include "Verifiers/PckCertVerifier.h"
 #include "Verifiers/PckCrlVerifier.h"
@@ -50,6 +57,10 @@
 #include "Verifiers/EnclaveIdentityV2.h"
 #include "Utils/TimeUtils.h"
 #include "Utils/SafeMemcpy.h"
+#include "Utils/ParseCache.h"
+#ifndef SGX_TRUSTED
+#include "Utils/ThreadPool.h"
+#endif
 
 #include <SgxEcdsaAttestation/QuoteVerification.h>
 #include <Version/Version.h>
@@ -79,7 +90,62 @@ void sgxEnclaveAttestationGetVersion(char *version, size_t len)
     safeMemcpy(version, VERSION, strln);
 }
 
-Status sgxAttestationVerifyPCKCertificate(const char *pemCertChain, const char * const crls[], const char *pemRootCaCertificate, const time_t* expirationDate)
+namespace {
+
+/**
+ * Certificate, certificate chain or CRL passed to C API either as null terminated text (PEM, CRLs may also be hex
+ * encoded DER) or as binary DER buffer.
+ */
+struct EncodedInput
+{
+    const char* text = nullptr;
+    const uint8_t* der = nullptr;
+    size_t derSize = 0;
+
+    static EncodedInput fromText(const char* text)
+    {
+        EncodedInput input;
+        input.text = text;
+        return input;
+    }
+
+    static EncodedInput fromDer(const uint8_t* der, size_t derSize)
+    {
+        EncodedInput input;
+        input.der = der;
+        input.derSize = derSize;
+        return input;
+    }
+
+    bool provided() const
+    {
+        return text != nullptr || der != nullptr;
+    }
+
+    std::string toString() const
+    {
+        return text != nullptr ? std::string(text) : "DER of " + std::to_string(derSize) + " bytes";
+    }
+};
+
+Status parseChain(const EncodedInput& input, dcap::CertificateChain& chain)
+{
+    return input.text != nullptr ? chain.parse(input.text) : chain.parseDer(input.der, input.derSize);
+}
+
+bool parseCrl(const EncodedInput& input, dcap::pckparser::CrlStore& crl)
+{
+    return input.text != nullptr ? crl.parse(input.text) : crl.parseDer(input.der, input.derSize);
+}
+
+dcap::parser::x509::Certificate parseCertificate(const EncodedInput& input)
+{
+    return input.text != nullptr ? dcap::parser::x509::Certificate::parse(input.text)
+                                 : dcap::parser::x509::Certificate::parseDer(input.der, input.derSize);
+}
+
+Status verifyPckCertificate(const EncodedInput& certChain, const EncodedInput& rootCaCrlInput, const EncodedInput& intermediateCrlInput,
+                            const EncodedInput& rootCaCertificate, const time_t* expirationDate)
 {
     time_t currentTime;
     try
@@ -92,18 +158,17 @@ Status sgxAttestationVerifyPCKCertificate(const char *pemCertChain, const char *
         return STATUS_INVALID_PARAMETER;
     }
 
-    if(!pemCertChain ||
-        !pemRootCaCertificate ||
-        !crls ||
-        !crls[0] ||
-        !crls[1])
+    if(!certChain.provided() ||
+        !rootCaCertificate.provided() ||
+        !rootCaCrlInput.provided() ||
+        !intermediateCrlInput.provided())
     {
         LOG_ERROR("pemCertChain, pemRootCaCertificate, CRLs (RootCaCrl, IntermediateCaCrl) was not provided");
         return STATUS_UNSUPPORTED_CERT_FORMAT;
     }
 
     dcap::CertificateChain chain;
-    const auto status = chain.parse(pemCertChain);
+    const auto status = parseChain(certChain, chain);
 
     if(status != STATUS_OK)
     {
@@ -114,26 +179,26 @@ Status sgxAttestationVerifyPCKCertificate(const char *pemCertChain, const char *
     if(chain.length() != EXPECTED_CERTIFICATE_COUNT_IN_PCK_CHAIN)
     {
         LOG_ERROR("PCK chain length is not correct. Expected: {}, actual: {}, cert chain: {}",
-                  EXPECTED_CERTIFICATE_COUNT_IN_PCK_CHAIN, chain.length(), pemCertChain);
+                  EXPECTED_CERTIFICATE_COUNT_IN_PCK_CHAIN, chain.length(), certChain.toString());
         return STATUS_UNSUPPORTED_CERT_FORMAT;
     }
 
     dcap::pckparser::CrlStore rootCaCrl, intermediateCrl;
-    if(!rootCaCrl.parse(crls[0]))
+    if(!parseCrl(rootCaCrlInput, rootCaCrl))
     {
-        LOG_ERROR("rootCaCrl parsing failed. RootCaCrl: {}", crls[0]);
+        LOG_ERROR("rootCaCrl parsing failed. RootCaCrl: {}", rootCaCrlInput.toString());
         return STATUS_SGX_CRL_UNSUPPORTED_FORMAT;
     }
 
-    if(!intermediateCrl.parse(crls[1]))
+    if(!parseCrl(intermediateCrlInput, intermediateCrl))
     {
-        LOG_ERROR("IntermediateCaCrl parsing failed. IntermediateCaCrl: {}", crls[1]);
+        LOG_ERROR("IntermediateCaCrl parsing failed. IntermediateCaCrl: {}", intermediateCrlInput.toString());
         return STATUS_SGX_CRL_UNSUPPORTED_FORMAT;
     }
 
     try
     {
-        auto rootCa = dcap::parser::x509::Certificate::parse(pemRootCaCertificate);
+        auto rootCa = parseCertificate(rootCaCertificate);
         return dcap::PckCertVerifier{}.verify(chain, rootCaCrl, intermediateCrl, rootCa, currentTime);
     }
     catch (const dcap::parser::FormatException& ex)
@@ -143,22 +208,21 @@ Status sgxAttestationVerifyPCKCertificate(const char *pemCertChain, const char *
     }
 }
 
-// Deprecated
-Status sgxAttestationVerifyPCKRevocationList(const char* crl, const char *pemCACertChain, const char *pemTrustedRootCaCert)
+Status verifyPckRevocationList(const EncodedInput& crl, const EncodedInput& caCertChain, const EncodedInput& trustedRootCaCert)
 {
-    if(!crl || !pemCACertChain || !pemTrustedRootCaCert)
+    if(!crl.provided() || !caCertChain.provided() || !trustedRootCaCert.provided())
     {
         return STATUS_SGX_CRL_UNSUPPORTED_FORMAT;
     }
 
     dcap::pckparser::CrlStore x509Crl;
-    if(!x509Crl.parse(crl))
+    if(!parseCrl(crl, x509Crl))
     {
         return STATUS_SGX_CRL_UNSUPPORTED_FORMAT;
     }
 
     dcap::CertificateChain chain;
-    const auto status = chain.parse(pemCACertChain);
+    const auto status = parseChain(caCertChain, chain);
     if (status != STATUS_OK)
     {
         return STATUS_SGX_CA_CERT_UNSUPPORTED_FORMAT;
@@ -166,7 +230,7 @@ Status sgxAttestationVerifyPCKRevocationList(const char* crl, const char *pemCAC
 
     try
     {
-        auto trustedRootCACert = dcap::parser::x509::Certificate::parse(pemTrustedRootCaCert);
+        auto trustedRootCACert = parseCertificate(trustedRootCaCert);
         return dcap::PckCrlVerifier{}.verify(x509Crl, chain, trustedRootCACert);
     }
     catch (const dcap::parser::FormatException&)
@@ -179,47 +243,16 @@ Status sgxAttestationVerifyPCKRevocationList(const char* crl, const char *pemCAC
     }
 }
 
-Status sgxAttestationVerifyTCBInfo(const char *tcbInfo, const char *pemCertChain, const char *stringRootCaCrl,
-        const char *pemRootCaCertificate, const time_t* expirationDate)
+/**
+ * Parses TCB signing chain, Root CA CRL and trusted Root CA certificate shared by TCB Info and Enclave Identity verification
+ * and calls verify with them.
+ */
+template<typename Verify>
+Status verifyWithTcbSigningChain(const EncodedInput& certChain, const EncodedInput& rootCaCrlInput, const EncodedInput& rootCaCertificate,
+                                 Verify verify)
 {
-    time_t currentTime;
-    try
-    {
-        currentTime = dcap::getCurrentTime(expirationDate);
-    }
-    catch (const std::runtime_error&)
-    {
-        LOG_ERROR("Can't get current time or it was not provided");
-        return STATUS_INVALID_PARAMETER;
-    }
-
-    if(!tcbInfo ||
-       !pemCertChain ||
-       !stringRootCaCrl ||
-       !pemRootCaCertificate)
-    {
-        LOG_ERROR("TcbInfo, pemCertChain, stringRootCaCrl, pemRootCaCertificate was not provided");
-        return STATUS_UNSUPPORTED_CERT_FORMAT;
-    }
-
-    dcap::parser::json::TcbInfo tcbInfoJson;
-    try
-    {
-        tcbInfoJson = dcap::parser::json::TcbInfo::parse(tcbInfo);
-    }
-    catch (const dcap::parser::FormatException& ex)
-    {
-        LOG_ERROR("TcbInfo format error: {}, tcbInfo: {}", ex.what(), tcbInfo);
-        return STATUS_SGX_TCB_INFO_UNSUPPORTED_FORMAT;
-    }
-    catch (const dcap::parser::InvalidExtensionException& ex)
-    {
-        LOG_ERROR("TcbInfo invalid extension error: {}, tcbInfo: {}", ex.what(), tcbInfo);
-        return STATUS_SGX_TCB_INFO_INVALID;
-    }
-
     dcap::CertificateChain chain;
-    const auto status = chain.parse(pemCertChain);
+    const auto status = parseChain(certChain, chain);
     if (status != STATUS_OK)
     {
         LOG_ERROR("TCBInfo Signing chain parse error: {}", status);
@@ -229,21 +262,21 @@ Status sgxAttestationVerifyTCBInfo(const char *tcbInfo, const char *pemCertChain
     if(chain.length() != EXPECTED_CERTIFICATE_COUNT_IN_TCB_CHAIN)
     {
         LOG_ERROR("TCBInfo Signing chain length is not correct. Expected: {}, actual: {}, cert chain: {}",
-                  EXPECTED_CERTIFICATE_COUNT_IN_TCB_CHAIN, chain.length(), pemCertChain);
+                  EXPECTED_CERTIFICATE_COUNT_IN_TCB_CHAIN, chain.length(), certChain.toString());
         return STATUS_UNSUPPORTED_CERT_FORMAT;
     }
 
     dcap::pckparser::CrlStore rootCaCrl;
-    if(!rootCaCrl.parse(stringRootCaCrl))
+    if(!parseCrl(rootCaCrlInput, rootCaCrl))
     {
-        LOG_ERROR("RootCA CRL parsing failed. CRL: {}", stringRootCaCrl);
+        LOG_ERROR("RootCA CRL parsing failed. CRL: {}", rootCaCrlInput.toString());
         return STATUS_SGX_CRL_UNSUPPORTED_FORMAT;
     }
 
     try
     {
-        auto trustedRootCa = dcap::parser::x509::Certificate::parse(pemRootCaCertificate);
-        return dcap::TCBInfoVerifier{}.verify(tcbInfoJson, chain, rootCaCrl, trustedRootCa, currentTime);
+        auto trustedRootCa = parseCertificate(rootCaCertificate);
+        return verify(chain, rootCaCrl, trustedRootCa);
     }
     catch (const dcap::parser::FormatException& ex)
     {
@@ -257,8 +290,8 @@ Status sgxAttestationVerifyTCBInfo(const char *tcbInfo, const char *pemCertChain
     }
 }
 
-Status sgxAttestationVerifyEnclaveIdentity(const char *enclaveIdentityString, const char *pemCertChain, const char *stringRootCaCrl,
-        const char *pemRootCaCertificate, const time_t* expirationDate)
+Status verifyTcbInfo(const char *tcbInfo, const EncodedInput& certChain, const EncodedInput& rootCaCrl,
+                     const EncodedInput& rootCaCertificate, const time_t* expirationDate)
 {
     time_t currentTime;
     try
@@ -271,103 +304,209 @@ Status sgxAttestationVerifyEnclaveIdentity(const char *enclaveIdentityString, co
         return STATUS_INVALID_PARAMETER;
     }
 
-    if(!enclaveIdentityString ||
-       !pemCertChain ||
-       !stringRootCaCrl ||
-       !pemRootCaCertificate)
+    if(!tcbInfo ||
+       !certChain.provided() ||
+       !rootCaCrl.provided() ||
+       !rootCaCertificate.provided())
     {
-        LOG_ERROR("enclaveIdentityString, pemCertChain, stringRootCaCrl, pemRootCaCertificate was not provided");
+        LOG_ERROR("TcbInfo, pemCertChain, stringRootCaCrl, pemRootCaCertificate was not provided");
         return STATUS_UNSUPPORTED_CERT_FORMAT;
     }
 
-    dcap::EnclaveIdentityParser parser;
-    std::unique_ptr<dcap::EnclaveIdentityV2> enclaveIdentity;
+    dcap::parser::json::TcbInfo tcbInfoJson;
     try
     {
-        enclaveIdentity = parser.parse(enclaveIdentityString);
+        tcbInfoJson = dcap::parser::json::TcbInfo::parse(tcbInfo, std::strlen(tcbInfo));
     }
-    catch (const dcap::ParserException &e)
+    catch (const dcap::parser::FormatException& ex)
     {
-        return e.getStatus();
+        LOG_ERROR("TcbInfo format error: {}, tcbInfo: {}", ex.what(), tcbInfo);
+        return STATUS_SGX_TCB_INFO_UNSUPPORTED_FORMAT;
     }
-
-    dcap::CertificateChain chain;
-    const auto status = chain.parse(pemCertChain);
-    if(status != STATUS_OK)
+    catch (const dcap::parser::InvalidExtensionException& ex)
     {
-        LOG_ERROR("TCBInfo Signing chain parse error: {}", status);
-        return status;
+        LOG_ERROR("TcbInfo invalid extension error: {}, tcbInfo: {}", ex.what(), tcbInfo);
+        return STATUS_SGX_TCB_INFO_INVALID;
     }
 
-    if(chain.length() != EXPECTED_CERTIFICATE_COUNT_IN_TCB_CHAIN)
+    return verifyWithTcbSigningChain(certChain, rootCaCrl, rootCaCertificate,
+        [&tcbInfoJson, currentTime](const dcap::CertificateChain& chain, const dcap::pckparser::CrlStore& crl,
+                                    const dcap::parser::x509::Certificate& trustedRootCa) {
+            return dcap::TCBInfoVerifier{}.verify(tcbInfoJson, chain, crl, trustedRootCa, currentTime);
+        });
+}
+
+Status verifyEnclaveIdentity(const char *enclaveIdentityString, const EncodedInput& certChain, const EncodedInput& rootCaCrl,
+                             const EncodedInput& rootCaCertificate, const time_t* expirationDate)
+{
+    time_t currentTime;
+    try
     {
-        LOG_ERROR("TCBInfo Signing chain length is not correct. Expected: {}, actual: {}, cert chain: {}",
-                  EXPECTED_CERTIFICATE_COUNT_IN_TCB_CHAIN, chain.length(), pemCertChain);
-        return STATUS_UNSUPPORTED_CERT_FORMAT;
+        currentTime = dcap::getCurrentTime(expirationDate);
     }
-
-    dcap::pckparser::CrlStore rootCaCrl;
-    if(!rootCaCrl.parse(stringRootCaCrl))
+    catch (const std::runtime_error&)
     {
-        LOG_ERROR("RootCA CRL parsing failed. CRL: {}", stringRootCaCrl);
-        return STATUS_SGX_CRL_UNSUPPORTED_FORMAT;
+        LOG_ERROR("Can't get current time or it was not provided");
+        return STATUS_INVALID_PARAMETER;
     }
 
-    try
+    if(!enclaveIdentityString ||
+       !certChain.provided() ||
+       !rootCaCrl.provided() ||
+       !rootCaCertificate.provided())
     {
-        auto trustedRootCa = dcap::parser::x509::Certificate::parse(pemRootCaCertificate);
-        return dcap::EnclaveIdentityVerifier{}.verify(*enclaveIdentity, chain, rootCaCrl, trustedRootCa, currentTime);
+        LOG_ERROR("enclaveIdentityString, pemCertChain, stringRootCaCrl, pemRootCaCertificate was not provided");
+        return STATUS_UNSUPPORTED_CERT_FORMAT;
     }
-    catch (const dcap::parser::FormatException& ex)
+
+    dcap::EnclaveIdentityParser parser;
+    std::unique_ptr<dcap::EnclaveIdentityV2> enclaveIdentity;
+    try
     {
-        LOG_ERROR("Trusted RootCA parsing failed: {}", ex.what());
-        return STATUS_UNSUPPORTED_CERT_FORMAT;
+        enclaveIdentity = parser.parse(enclaveIdentityString, std::strlen(enclaveIdentityString));
     }
-    catch (const dcap::parser::InvalidExtensionException& ex)
+    catch (const dcap::ParserException &e)
     {
-        LOG_ERROR("Trusted RootCA parsing failed: {}", ex.what());
-        return STATUS_SGX_ROOT_CA_INVALID_EXTENSIONS;
+        return e.getStatus();
     }
+
+    return verifyWithTcbSigningChain(certChain, rootCaCrl, rootCaCertificate,
+        [&enclaveIdentity, currentTime](const dcap::CertificateChain& chain, const dcap::pckparser::CrlStore& crl,
+                                        const dcap::parser::x509::Certificate& trustedRootCa) {
+            return dcap::EnclaveIdentityVerifier{}.verify(*enclaveIdentity, chain, crl, trustedRootCa, currentTime);
+        });
 }
 
-Status sgxAttestationVerifyQuote(const uint8_t* rawQuote, uint32_t quoteSize, const char *pemPckCertificate, const char* pckCrl,
-                                 const char* tcbInfoJson, const char* qeIdentityJson)
+} // anonymous namespace
+
+Status sgxAttestationVerifyPCKCertificate(const char *pemCertChain, const char * const crls[], const char *pemRootCaCertificate, const time_t* expirationDate)
+{
+    return verifyPckCertificate(EncodedInput::fromText(pemCertChain),
+                                EncodedInput::fromText(crls ? crls[0] : nullptr),
+                                EncodedInput::fromText(crls ? crls[1] : nullptr),
+                                EncodedInput::fromText(pemRootCaCertificate), expirationDate);
+}
+
+Status sgxAttestationVerifyPCKCertificateDer(const uint8_t *derCertChain, size_t derCertChainSize, const uint8_t * const derCrls[], const size_t derCrlSizes[],
+                                             const uint8_t *derRootCaCertificate, size_t derRootCaCertificateSize, const time_t* expirationDate)
+{
+    const bool crlsProvided = derCrls && derCrlSizes;
+    return verifyPckCertificate(EncodedInput::fromDer(derCertChain, derCertChainSize),
+                                crlsProvided ? EncodedInput::fromDer(derCrls[0], derCrlSizes[0]) : EncodedInput{},
+                                crlsProvided ? EncodedInput::fromDer(derCrls[1], derCrlSizes[1]) : EncodedInput{},
+                                EncodedInput::fromDer(derRootCaCertificate, derRootCaCertificateSize), expirationDate);
+}
+
+// Deprecated
+Status sgxAttestationVerifyPCKRevocationList(const char* crl, const char *pemCACertChain, const char *pemTrustedRootCaCert)
+{
+    return verifyPckRevocationList(EncodedInput::fromText(crl), EncodedInput::fromText(pemCACertChain),
+                                   EncodedInput::fromText(pemTrustedRootCaCert));
+}
+
+Status sgxAttestationVerifyPCKRevocationListDer(const uint8_t *derCrl, size_t derCrlSize, const uint8_t *derCACertChain, size_t derCACertChainSize,
+                                                const uint8_t *derTrustedRootCaCert, size_t derTrustedRootCaCertSize)
+{
+    return verifyPckRevocationList(EncodedInput::fromDer(derCrl, derCrlSize), EncodedInput::fromDer(derCACertChain, derCACertChainSize),
+                                   EncodedInput::fromDer(derTrustedRootCaCert, derTrustedRootCaCertSize));
+}
+
+Status sgxAttestationVerifyTCBInfo(const char *tcbInfo, const char *pemCertChain, const char *stringRootCaCrl,
+        const char *pemRootCaCertificate, const time_t* expirationDate)
+{
+    return verifyTcbInfo(tcbInfo, EncodedInput::fromText(pemCertChain), EncodedInput::fromText(stringRootCaCrl),
+                         EncodedInput::fromText(pemRootCaCertificate), expirationDate);
+}
+
+Status sgxAttestationVerifyTCBInfoDer(const char *tcbInfo, const uint8_t *derCertChain, size_t derCertChainSize,
+                                      const uint8_t *derRootCaCrl, size_t derRootCaCrlSize,
+                                      const uint8_t *derRootCaCertificate, size_t derRootCaCertificateSize, const time_t* expirationDate)
+{
+    return verifyTcbInfo(tcbInfo, EncodedInput::fromDer(derCertChain, derCertChainSize), EncodedInput::fromDer(derRootCaCrl, derRootCaCrlSize),
+                         EncodedInput::fromDer(derRootCaCertificate, derRootCaCertificateSize), expirationDate);
+}
+
+Status sgxAttestationVerifyEnclaveIdentity(const char *enclaveIdentityString, const char *pemCertChain, const char *stringRootCaCrl,
+        const char *pemRootCaCertificate, const time_t* expirationDate)
+{
+    return verifyEnclaveIdentity(enclaveIdentityString, EncodedInput::fromText(pemCertChain), EncodedInput::fromText(stringRootCaCrl),
+                                 EncodedInput::fromText(pemRootCaCertificate), expirationDate);
+}
+
+Status sgxAttestationVerifyEnclaveIdentityDer(const char *enclaveIdentityString, const uint8_t *derCertChain, size_t derCertChainSize,
+                                              const uint8_t *derRootCaCrl, size_t derRootCaCrlSize,
+                                              const uint8_t *derRootCaCertificate, size_t derRootCaCertificateSize, const time_t* expirationDate)
+{
+    return verifyEnclaveIdentity(enclaveIdentityString, EncodedInput::fromDer(derCertChain, derCertChainSize),
+                                 EncodedInput::fromDer(derRootCaCrl, derRootCaCrlSize),
+                                 EncodedInput::fromDer(derRootCaCertificate, derRootCaCertificateSize), expirationDate);
+}
+
+struct _collateral
+{
+    std::shared_ptr<const dcap::pckparser::CrlStore> pckCrlStore;
+    std::shared_ptr<const dcap::parser::json::TcbInfo> tcbInfo;
+    std::shared_ptr<const dcap::EnclaveIdentityV2> enclaveIdentity;
+};
+
+namespace {
+
+Status parseQuote(const uint8_t* rawQuote, uint32_t quoteSize, dcap::Quote& quote)
 {
-    /// 4.1.2.4.1
-    if(!rawQuote ||
-       !pemPckCertificate ||
-       !pckCrl ||
-       !tcbInfoJson)
-    {
-        LOG_ERROR("rawQuote, pemPckCertificate, pckCrl, tcbInfoJson was not provided");
-        return STATUS_MISSING_PARAMETERS;
-    }
-   
     // We totally trust user on this, it should be explicitly and clearly
     // mentioned in doc, is there any max quote len other than numeric_limit<uint32_t>::max() ?
-    const std::vector<uint8_t> vecQuote(rawQuote, std::next(rawQuote, quoteSize));
-
     /// 4.1.2.4.2
-    dcap::Quote quote;
-    if(!quote.parse(vecQuote) || !quote.validate())
+    if(!quote.parse(rawQuote, quoteSize) || !quote.validate())
     {
         LOG_ERROR("Quote format verification failure");
         return Status::STATUS_UNSUPPORTED_QUOTE_FORMAT;
     }
+    return STATUS_OK;
+}
+
+/**
+ * Returns bytes hashed into parse cache key for given input, DER inputs are kept apart from text ones under separate kinds.
+ */
+const uint8_t* cacheInput(const EncodedInput& input)
+{
+    return input.text != nullptr ? reinterpret_cast<const uint8_t*>(input.text) : input.der;
+}
+
+size_t cacheInputSize(const EncodedInput& input)
+{
+    return input.text != nullptr ? std::strlen(input.text) : input.derSize;
+}
+
+Status parseCollateral(const EncodedInput& pckCrl, const char* tcbInfoJson, const char* qeIdentityJson, Collateral& collateral)
+{
+    auto& parseCache = dcap::ParseCache::instance();
 
     /// 4.1.2.4.5
-    dcap::pckparser::CrlStore pckCrlStore;
-    if(!pckCrlStore.parse(pckCrl))
-    {
-        LOG_ERROR("PCK Revocation list is invalid. pckCrl: {}", pckCrl);
+    const auto pckCrlKind = pckCrl.text != nullptr ? dcap::ParseCache::Kind::PCK_CRL : dcap::ParseCache::Kind::PCK_CRL_DER;
+    collateral.pckCrlStore = parseCache.getOrParse<dcap::pckparser::CrlStore>(
+            pckCrlKind, cacheInput(pckCrl), cacheInputSize(pckCrl), [&pckCrl]() -> std::shared_ptr<const dcap::pckparser::CrlStore> {
+                auto crlStore = std::make_shared<dcap::pckparser::CrlStore>();
+                if(!parseCrl(pckCrl, *crlStore))
+                {
+                    return nullptr;
+                }
+                return crlStore;
+            });
+    if(!collateral.pckCrlStore)
+    {
+        LOG_ERROR("PCK Revocation list is invalid. pckCrl: {}", pckCrl.toString());
         return STATUS_UNSUPPORTED_PCK_RL_FORMAT;
     }
 
     /// 4.1.2.4.8
-    dcap::parser::json::TcbInfo tcbInfo;
     try
     {
-        tcbInfo = dcap::parser::json::TcbInfo::parse(tcbInfoJson);
+        const auto tcbInfoLength = std::strlen(tcbInfoJson);
+        collateral.tcbInfo = parseCache.getOrParse<dcap::parser::json::TcbInfo>(
+                dcap::ParseCache::Kind::TCB_INFO, reinterpret_cast<const uint8_t*>(tcbInfoJson), tcbInfoLength,
+                [tcbInfoJson, tcbInfoLength]() {
+                    return std::make_shared<const dcap::parser::json::TcbInfo>(dcap::parser::json::TcbInfo::parse(tcbInfoJson, tcbInfoLength));
+                });
     }
     catch (const dcap::parser::FormatException& ex)
     {
@@ -380,12 +519,16 @@ Status sgxAttestationVerifyQuote(const uint8_t* rawQuote, uint32_t quoteSize, co
         return STATUS_UNSUPPORTED_TCB_INFO_FORMAT;
     }
 
-    dcap::EnclaveIdentityParser parser;
-    std::unique_ptr<dcap::EnclaveIdentityV2> enclaveIdentity;
     if (qeIdentityJson != nullptr)
     {
         try {
-            enclaveIdentity = parser.parse(qeIdentityJson);
+            const auto qeIdentityLength = std::strlen(qeIdentityJson);
+            collateral.enclaveIdentity = parseCache.getOrParse<dcap::EnclaveIdentityV2>(
+                    dcap::ParseCache::Kind::ENCLAVE_IDENTITY, reinterpret_cast<const uint8_t*>(qeIdentityJson), qeIdentityLength,
+                    [qeIdentityJson, qeIdentityLength]() {
+                        dcap::EnclaveIdentityParser parser;
+                        return std::shared_ptr<const dcap::EnclaveIdentityV2>(parser.parse(qeIdentityJson, qeIdentityLength));
+                    });
         }
         catch (const dcap::ParserException& ex)
         {
@@ -393,11 +536,23 @@ Status sgxAttestationVerifyQuote(const uint8_t* rawQuote, uint32_t quoteSize, co
             return STATUS_UNSUPPORTED_QE_IDENTITY_FORMAT;
         }
     }
+    return STATUS_OK;
+}
 
+Status verifyQuote(const dcap::Quote& quote, const EncodedInput& pckCertificate, const Collateral& collateral)
+{
     try
     {
-        auto pckCert = dcap::parser::x509::PckCertificate::parse(pemPckCertificate);
-        return dcap::QuoteVerifier{}.verify(quote, pckCert, pckCrlStore, tcbInfo, enclaveIdentity.get(), dcap::EnclaveReportVerifier());
+        const auto pckCertKind = pckCertificate.text != nullptr ? dcap::ParseCache::Kind::PCK_CERTIFICATE
+                                                                : dcap::ParseCache::Kind::PCK_CERTIFICATE_DER;
+        const auto pckCert = dcap::ParseCache::instance().getOrParse<dcap::parser::x509::PckCertificate>(
+                pckCertKind, cacheInput(pckCertificate), cacheInputSize(pckCertificate), [&pckCertificate]() {
+                    return std::make_shared<const dcap::parser::x509::PckCertificate>(pckCertificate.text != nullptr
+                            ? dcap::parser::x509::PckCertificate::parse(pckCertificate.text)
+                            : dcap::parser::x509::PckCertificate::parseDer(pckCertificate.der, pckCertificate.derSize));
+                });
+        return dcap::QuoteVerifier{}.verify(quote, *pckCert, *collateral.pckCrlStore, *collateral.tcbInfo,
+                                            collateral.enclaveIdentity.get(), dcap::EnclaveReportVerifier());
     }
     catch (const dcap::parser::FormatException& ex) /// 4.1.2.4.3
     {
@@ -411,6 +566,229 @@ Status sgxAttestationVerifyQuote(const uint8_t* rawQuote, uint32_t quoteSize, co
     }
 }
 
+Status verifyQuote(const Collateral& collateral, const uint8_t* rawQuote, uint32_t quoteSize, const EncodedInput& pckCertificate)
+{
+    if(!rawQuote ||
+       !pckCertificate.provided())
+    {
+        LOG_ERROR("rawQuote, pemPckCertificate was not provided");
+        return STATUS_MISSING_PARAMETERS;
+    }
+
+    dcap::Quote quote;
+    const auto status = parseQuote(rawQuote, quoteSize, quote);
+    if(status != STATUS_OK)
+    {
+        return status;
+    }
+
+    return verifyQuote(quote, pckCertificate, collateral);
+}
+
+Status verifyQuote(const uint8_t* rawQuote, uint32_t quoteSize, const EncodedInput& pckCertificate, const EncodedInput& pckCrl,
+                   const char* tcbInfoJson, const char* qeIdentityJson)
+{
+    /// 4.1.2.4.1
+    if(!rawQuote ||
+       !pckCertificate.provided() ||
+       !pckCrl.provided() ||
+       !tcbInfoJson)
+    {
+        LOG_ERROR("rawQuote, pemPckCertificate, pckCrl, tcbInfoJson was not provided");
+        return STATUS_MISSING_PARAMETERS;
+    }
+
+    dcap::Quote quote;
+    auto status = parseQuote(rawQuote, quoteSize, quote);
+    if(status != STATUS_OK)
+    {
+        return status;
+    }
+
+    Collateral collateral;
+    status = parseCollateral(pckCrl, tcbInfoJson, qeIdentityJson, collateral);
+    if(status != STATUS_OK)
+    {
+        return status;
+    }
+
+    return verifyQuote(quote, pckCertificate, collateral);
+}
+
+Status createCollateral(const EncodedInput& pckCrl, const char* tcbInfoJson, const char* qeIdentityJson, Collateral** collateral)
+{
+    if(!pckCrl.provided() ||
+       !tcbInfoJson ||
+       !collateral)
+    {
+        LOG_ERROR("pckCrl, tcbInfoJson or output pointer for collateral was not provided");
+        return STATUS_MISSING_PARAMETERS;
+    }
+    *collateral = nullptr;
+
+    std::unique_ptr<Collateral> parsed(new Collateral());
+    const auto status = parseCollateral(pckCrl, tcbInfoJson, qeIdentityJson, *parsed);
+    if(status != STATUS_OK)
+    {
+        return status;
+    }
+
+    *collateral = parsed.release();
+    return STATUS_OK;
+}
+
+Status verifyQuoteWithCollateral(const Collateral* collateral, const uint8_t* rawQuote, uint32_t quoteSize, const EncodedInput& pckCertificate)
+{
+    if(!collateral)
+    {
+        LOG_ERROR("collateral was not provided");
+        return STATUS_MISSING_PARAMETERS;
+    }
+
+    return verifyQuote(*collateral, rawQuote, quoteSize, pckCertificate);
+}
+
+/**
+ * Verifies one quote of a batch. Results of the batch are only reported through statuses,
+ * so no exception may leave a worker thread or the C API.
+ */
+Status verifyBatchItem(const Collateral& collateral, const uint8_t* rawQuote, uint32_t quoteSize, const char* pemPckCertificate)
+{
+    try
+    {
+        return verifyQuote(collateral, rawQuote, quoteSize, EncodedInput::fromText(pemPckCertificate));
+    }
+    catch (const dcap::ParserException& ex)
+    {
+        LOG_ERROR("Quote verification error: {}", ex.what());
+        return ex.getStatus();
+    }
+    catch (const std::exception& ex)
+    {
+        LOG_ERROR("Quote verification error: {}", ex.what());
+        return STATUS_UNSUPPORTED_QUOTE_FORMAT;
+    }
+    catch (...)
+    {
+        LOG_ERROR("Quote verification error: unknown exception");
+        return STATUS_UNSUPPORTED_QUOTE_FORMAT;
+    }
+}
+
+void verifyQuoteBatch(const Collateral& collateral, const uint8_t* const quotes[], const uint32_t quoteSizes[],
+                      const char* const pemPckCertificates[], uint32_t quoteCount, uint32_t threadCount, Status results[])
+{
+#ifdef SGX_TRUSTED
+    (void)threadCount;
+    for (uint32_t i = 0; i < quoteCount; i++)
+    {
+        results[i] = verifyBatchItem(collateral, quotes[i], quoteSizes[i], pemPckCertificates[i]);
+    }
+#else
+    if (quoteCount == 0)
+    {
+        return;
+    }
+    const auto hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    if (threadCount == 0 || threadCount > hardwareThreads)
+    {
+        threadCount = hardwareThreads;
+    }
+    threadCount = std::min(threadCount, quoteCount);
+
+    std::atomic<uint32_t> next{0};
+    const auto worker = [&]() {
+        for (auto i = next++; i < quoteCount; i = next++)
+        {
+            results[i] = verifyBatchItem(collateral, quotes[i], quoteSizes[i], pemPckCertificates[i]);
+        }
+    };
+
+    // calling thread is one of the workers, quotes are taken by whichever thread is free first
+    try
+    {
+        ThreadPool::instance().run(threadCount - 1, worker);
+    }
+    catch (const std::exception& ex)
+    {
+        LOG_WARN("Batch verification continues on calling thread only: {}", ex.what());
+        worker();
+    }
+#endif
+}
+
+} // anonymous namespace
+
+Status sgxAttestationVerifyQuote(const uint8_t* rawQuote, uint32_t quoteSize, const char *pemPckCertificate, const char* pckCrl,
+                                 const char* tcbInfoJson, const char* qeIdentityJson)
+{
+    return verifyQuote(rawQuote, quoteSize, EncodedInput::fromText(pemPckCertificate), EncodedInput::fromText(pckCrl),
+                       tcbInfoJson, qeIdentityJson);
+}
+
+Status sgxAttestationVerifyQuoteDer(const uint8_t* rawQuote, uint32_t quoteSize, const uint8_t *derPckCertificate, size_t derPckCertificateSize,
+                                    const uint8_t* derPckCrl, size_t derPckCrlSize, const char* tcbInfoJson, const char* qeIdentityJson)
+{
+    return verifyQuote(rawQuote, quoteSize, EncodedInput::fromDer(derPckCertificate, derPckCertificateSize),
+                       EncodedInput::fromDer(derPckCrl, derPckCrlSize), tcbInfoJson, qeIdentityJson);
+}
+
+Status sgxAttestationCollateralCreate(const char* pckCrl, const char* tcbInfoJson, const char* qeIdentityJson,
+                                      Collateral** collateral)
+{
+    return createCollateral(EncodedInput::fromText(pckCrl), tcbInfoJson, qeIdentityJson, collateral);
+}
+
+Status sgxAttestationCollateralCreateDer(const uint8_t* derPckCrl, size_t derPckCrlSize, const char* tcbInfoJson, const char* qeIdentityJson,
+                                         Collateral** collateral)
+{
+    return createCollateral(EncodedInput::fromDer(derPckCrl, derPckCrlSize), tcbInfoJson, qeIdentityJson, collateral);
+}
+
+Status sgxAttestationVerifyQuoteWithCollateral(const Collateral* collateral, const uint8_t* rawQuote, uint32_t quoteSize,
+                                               const char *pemPckCertificate)
+{
+    return verifyQuoteWithCollateral(collateral, rawQuote, quoteSize, EncodedInput::fromText(pemPckCertificate));
+}
+
+Status sgxAttestationVerifyQuoteWithCollateralDer(const Collateral* collateral, const uint8_t* rawQuote, uint32_t quoteSize,
+                                                  const uint8_t *derPckCertificate, size_t derPckCertificateSize)
+{
+    return verifyQuoteWithCollateral(collateral, rawQuote, quoteSize, EncodedInput::fromDer(derPckCertificate, derPckCertificateSize));
+}
+
+void sgxAttestationCollateralFree(Collateral* collateral)
+{
+    delete collateral;
+}
+
+Status sgxAttestationVerifyQuoteBatch(const uint8_t* const quotes[], const uint32_t quoteSizes[], const char* const pemPckCertificates[],
+                                      uint32_t quoteCount, const char* pckCrl, const char* tcbInfoJson, const char* qeIdentityJson,
+                                      uint32_t threadCount, Status results[])
+{
+    if(!quotes ||
+       !quoteSizes ||
+       !pemPckCertificates ||
+       !pckCrl ||
+       !tcbInfoJson ||
+       !results)
+    {
+        LOG_ERROR("quotes, quoteSizes, pemPckCertificates, pckCrl, tcbInfoJson or results was not provided");
+        return STATUS_MISSING_PARAMETERS;
+    }
+
+    Collateral collateral;
+    const auto status = parseCollateral(EncodedInput::fromText(pckCrl), tcbInfoJson, qeIdentityJson, collateral);
+    if(status != STATUS_OK)
+    {
+        std::fill(results, std::next(results, quoteCount), status);
+        return status;
+    }
+
+    verifyQuoteBatch(collateral, quotes, quoteSizes, pemPckCertificates, quoteCount, threadCount, results);
+    return STATUS_OK;
+}
+
 Status sgxAttestationVerifyEnclaveReport(const uint8_t* enclaveReport, const char* enclaveIdentity)
 {
     if(!enclaveReport || !enclaveIdentity)
@@ -444,7 +822,7 @@ Status sgxAttestationVerifyEnclaveReport(const uint8_t* enclaveReport, const cha
     std::unique_ptr<dcap::EnclaveIdentityV2> enclaveIdentityParsed;
     try
     {
-        enclaveIdentityParsed = parser.parse(enclaveIdentity);
+        enclaveIdentityParsed = parser.parse(enclaveIdentity, std::strlen(enclaveIdentity));
     }
     catch(const dcap::ParserException &ex)
     {
@@ -469,16 +847,14 @@ Status sgxAttestationGetQECertificationDataSize(
 
     // We totally trust user on this, it should be explicitly and clearly
     // mentioned in doc, is there any max quote len other than numeric_limit<uint32_t>::max() ?
-    const std::vector<uint8_t> vecQuote(rawQuote, std::next(rawQuote, quoteSize));
-
-    dcap::Quote quote;
-    if(!quote.parse(vecQuote) || !quote.validate())
+    dcap::QuoteView quote;
+    if(!quote.parse(rawQuote, quoteSize) || !quote.validate())
     {
         LOG_ERROR("Can't parse or validate quote");
         return Status::STATUS_UNSUPPORTED_QUOTE_FORMAT;
     }
 
-    *qeCertificationDataSize = static_cast<uint32_t>(quote.getCertificationData().parsedDataSize);
+    *qeCertificationDataSize = static_cast<uint32_t>(quote.getCertificationData().size());
 
     return STATUS_OK;
 }
@@ -500,33 +876,52 @@ Status sgxAttestationGetQECertificationData(
 
     // We totally trust user on this, it should be explicitly and clearly
     // mentioned in doc, is there any max quote len other than numeric_limit<uint32_t>::max() ?
-    const std::vector<uint8_t> vecQuote(rawQuote, std::next(rawQuote, quoteSize));
-
-    dcap::Quote quote;
-
-    if(!quote.parse(vecQuote) || !quote.validate())
+    // certification data is copied straight from caller memory, quote itself is not decoded
+    dcap::QuoteView quote;
+    if(!quote.parse(rawQuote, quoteSize) || !quote.validate())
     {
         LOG_ERROR("Can't parse or validate quote");
         return STATUS_UNSUPPORTED_QUOTE_FORMAT;
     }
 
-    const auto& quoteCertificationData = quote.getCertificationData();
+    const auto quoteCertificationData = quote.getCertificationData();
 
-    if(qeCertificationDataSize != quoteCertificationData.parsedDataSize)
+    if(qeCertificationDataSize != quoteCertificationData.size())
     {
         LOG_ERROR("Provided certification data size doesn't match one in quote");
         return STATUS_INVALID_QE_CERTIFICATION_DATA_SIZE;
     }
 
-    *qeCertificationDataType = quoteCertificationData.type;
+    *qeCertificationDataType = quote.getCertificationDataType();
 
     // buffer pointed to by 'qeCertificationData' must be at least 'qeCertificationDataSize' long
-    std::copy(std::begin(quoteCertificationData.data), std::end(quoteCertificationData.data), qeCertificationData);
+    std::copy(quoteCertificationData.begin(), quoteCertificationData.end(), qeCertificationData);
 
     return STATUS_OK;
 }
 
 
+void sgxAttestationParseCacheSetup(uint32_t maxEntries)
+{
+    dcap::ParseCache::instance().setCapacity(maxEntries);
+}
+
+Status sgxAttestationParseCacheGetStatistics(ParseCacheStatistics* statistics)
+{
+    if(!statistics)
+    {
+        LOG_ERROR("Output pointer for statistics was not provided");
+        return STATUS_MISSING_PARAMETERS;
+    }
+
+    const auto cacheStatistics = dcap::ParseCache::instance().getStatistics();
+    statistics->hits = cacheStatistics.hits;
+    statistics->misses = cacheStatistics.misses;
+    statistics->evictions = cacheStatistics.evictions;
+    statistics->entries = cacheStatistics.entries;
+    return STATUS_OK;
+}
+
 void sgxAttestationLoggerSetup(const char *name, const char *consoleLogLevel, const char *fileLogLevel,
                                const char *fileName, const char *pattern)
 {
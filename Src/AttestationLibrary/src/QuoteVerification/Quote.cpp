@@ -31,6 +31,7 @@
 
 #include "Quote.h"
 #include "QuoteParsers.h"
+#include "QuoteView.h"
 #include "Utils/Logger.h"
 
 #include <algorithm>
@@ -41,15 +42,21 @@ using namespace constants;
 
 bool Quote::parse(const std::vector<uint8_t>& rawQuote)
 {
-    if(rawQuote.size() < QUOTE_MIN_BYTE_LEN)
+    return parse(rawQuote.data(), rawQuote.size());
+}
+
+bool Quote::parse(const uint8_t* rawQuote, size_t quoteSize)
+{
+    if(rawQuote == nullptr || quoteSize < QUOTE_MIN_BYTE_LEN)
     {
-        LOG_ERROR("Quote size {} is not at least {}.", rawQuote.size(), QUOTE_MIN_BYTE_LEN);
+        LOG_ERROR("Quote size {} is not at least {}.", quoteSize, QUOTE_MIN_BYTE_LEN);
         return false;
     }
 
-    auto from = rawQuote.cbegin();
+    const uint8_t* from = rawQuote;
+    const uint8_t* const quoteEnd = rawQuote + quoteSize;
     Header localHeader{};
-    if (!copyAndAdvance(localHeader, from, HEADER_BYTE_LEN, rawQuote.cend())) {
+    if (!copyAndAdvance(localHeader, from, HEADER_BYTE_LEN, quoteEnd)) {
         LOG_ERROR("Can't read header from quote. Expected size: {}", HEADER_BYTE_LEN);
         return false;
     }
@@ -60,7 +67,7 @@ bool Quote::parse(const std::vector<uint8_t>& rawQuote)
     TDReport localTdReport{};
     if (localHeader.teeType == TEE_TYPE_SGX)
     {
-        if (!copyAndAdvance(localEnclaveReport, from, ENCLAVE_REPORT_BYTE_LEN, rawQuote.end()))
+        if (!copyAndAdvance(localEnclaveReport, from, ENCLAVE_REPORT_BYTE_LEN, quoteEnd))
         {
             LOG_ERROR("Can't read SGX enclave report from quote. Expected size: {}", ENCLAVE_REPORT_BYTE_LEN);
             return false;
@@ -68,7 +75,7 @@ bool Quote::parse(const std::vector<uint8_t>& rawQuote)
     }
     else if (localHeader.teeType == TEE_TYPE_TDX)
     {
-        if (!copyAndAdvance(localTdReport, from, TD_REPORT_BYTE_LEN, rawQuote.end()))
+        if (!copyAndAdvance(localTdReport, from, TD_REPORT_BYTE_LEN, quoteEnd))
         {
             LOG_ERROR("Can't read TDX TD Report from quote. Expected size: {}", TD_REPORT_BYTE_LEN);
             return false;
@@ -76,11 +83,11 @@ bool Quote::parse(const std::vector<uint8_t>& rawQuote)
     }
 
     uint32_t localAuthDataSize = 0;
-    if (!copyAndAdvance(localAuthDataSize, from, rawQuote.end())) {
+    if (!copyAndAdvance(localAuthDataSize, from, quoteEnd)) {
         LOG_ERROR("Can't read auth data size  from quote.");
         return false;
     }
-    const auto remainingDistance = std::distance(from, rawQuote.end());
+    const auto remainingDistance = std::distance(from, quoteEnd);
     if(localAuthDataSize != remainingDistance)
     {
         LOG_ERROR("Declared auth data size {} doesn't match remaining quote size {}", localAuthDataSize, remainingDistance);
@@ -91,7 +98,7 @@ bool Quote::parse(const std::vector<uint8_t>& rawQuote)
     Ecdsa256BitQuoteV4AuthData localQuoteV4Auth{};
     if (localHeader.version == constants::QUOTE_VERSION_3)
     {
-        if (!copyAndAdvance(localQuoteV3Auth, from, static_cast<size_t>(localAuthDataSize), rawQuote.end()))
+        if (!copyAndAdvance(localQuoteV3Auth, from, static_cast<size_t>(localAuthDataSize), quoteEnd))
         {
             LOG_ERROR("Can't read QUOTE v3 Auth data. Expected size: {}", localAuthDataSize);
             return false;
@@ -105,13 +112,13 @@ bool Quote::parse(const std::vector<uint8_t>& rawQuote)
     }
     else if (localHeader.version == constants::QUOTE_VERSION_4)
     {
-        if (!copyAndAdvance(localQuoteV4Auth, from, static_cast<size_t>(localAuthDataSize), rawQuote.end()))
+        if (!copyAndAdvance(localQuoteV4Auth, from, static_cast<size_t>(localAuthDataSize), quoteEnd))
         {
             LOG_ERROR("Can't read QUOTE v4 Auth data. Expected size: {}", localAuthDataSize);
             return false;
         }
         
-        const auto reportBytes = localQuoteV4Auth.certificationData.data;
+        const auto& reportBytes = localQuoteV4Auth.certificationData.data;
         auto beg = reportBytes.cbegin();
         QEReportCertificationData qeReportData;
         if (!qeReportData.insert(beg, reportBytes.cend()))
@@ -129,7 +136,7 @@ bool Quote::parse(const std::vector<uint8_t>& rawQuote)
     // parsing done, we should be precisely at the end of our buffer
     // if we're not it means inconsistency in internal structure
     // and it means invalid format
-    if(from != rawQuote.end())
+    if(from != quoteEnd)
     {
         LOG_ERROR("There is additional, not expected data in quote.");
         return false;
@@ -141,13 +148,15 @@ bool Quote::parse(const std::vector<uint8_t>& rawQuote)
     authDataV3 = localQuoteV3Auth;
     authDataV4 = localQuoteV4Auth;
 
-    if (localHeader.teeType == TEE_TYPE_SGX)
-    {
-        signedData = getDataToSignatureVerification(rawQuote, HEADER_BYTE_LEN + QE_REPORT_BYTE_LEN);
-    }
-    else if (localHeader.teeType == TEE_TYPE_TDX)
+    // signed parts are hashed directly in caller memory, so they don't have to be copied for signature verification
+    const auto signedDataSize = quoteSize - AUTH_DATA_SIZE_BYTE_LEN - localAuthDataSize;
+    const auto qeReportOffset = signedDataSize + AUTH_DATA_SIZE_BYTE_LEN + ECDSA_SIGNATURE_BYTE_LEN + ECDSA_PUBKEY_BYTE_LEN +
+            (localHeader.version == QUOTE_VERSION_4 ? CERTIFICATION_DATA_TYPE_BYTE_LEN + CERTIFICATION_DATA_SIZE_BYTE_LEN : 0);
+    if (!crypto::sha256Digest(ByteRange(rawQuote, signedDataSize), signedDataDigest) ||
+        !crypto::sha256Digest(ByteRange(rawQuote + qeReportOffset, QE_REPORT_BYTE_LEN), qeReportDigest))
     {
-        signedData = getDataToSignatureVerification(rawQuote, HEADER_BYTE_LEN + TD_REPORT_BYTE_LEN);
+        LOG_ERROR("Can't calculate digest of signed quote data.");
+        return false;
     }
 
     return true;
@@ -155,63 +164,10 @@ bool Quote::parse(const std::vector<uint8_t>& rawQuote)
 
 bool Quote::validate() const
 {
-    if(std::find(ALLOWED_QUOTE_VERSIONS.begin(), ALLOWED_QUOTE_VERSIONS.end(), header.version) ==
-       ALLOWED_QUOTE_VERSIONS.end())
-    {
-        LOG_ERROR("Quote version {} is not supported", header.version);
-        return false;
-    }
-
-    if(std::find(ALLOWED_ATTESTATION_KEY_TYPES.begin(), ALLOWED_ATTESTATION_KEY_TYPES.end(), header.attestationKeyType) ==
-       ALLOWED_ATTESTATION_KEY_TYPES.end())
-    {
-        LOG_ERROR("Attestation Key type {} is not supported", header.attestationKeyType);
-        return false;
-    }
-
-    if(std::find(ALLOWED_TEE_TYPES.begin(), ALLOWED_TEE_TYPES.end(), header.teeType) == ALLOWED_TEE_TYPES.end())
-    {
-        LOG_ERROR("TEE Type {} is not supported", header.teeType);
-        return false;
-    }
-
-    if(header.qeVendorId != INTEL_QE_VENDOR_ID) {
-        LOG_ERROR("Wrong QE vendor ID. Found: {}, expected: {}", header.qeVendorId, INTEL_QE_VENDOR_ID);
-        return false;
-    }
-
-    if (header.version == QUOTE_VERSION_3)
-    {
-        if (header.teeType != TEE_TYPE_SGX)
-        {
-            LOG_ERROR("Quote v3 supports only SGX tee type but found {}", header.teeType);
-            return false;
-        }
-        if (authDataV3.certificationData.type < 1 || authDataV3.certificationData.type > 5) // QuoteV3 supports only 1-5 types
-        {
-            LOG_ERROR("Quote v3 supports certification data types from 1 to 5 but found {}",
-                      authDataV3.certificationData.type);
-            return false;
-        }
-    }
-
-    if(header.version == QUOTE_VERSION_4)
-    {
-        if (authDataV4.certificationData.type != constants::PCK_ID_QE_REPORT_CERTIFICATION_DATA)
-        {
-            LOG_ERROR("Quote v4 supports only {} certification data type but found {}",
-                      constants::PCK_ID_QE_REPORT_CERTIFICATION_DATA, authDataV4.certificationData.type);
-            return false;
-        }
-        if (certificationData.type < 1 || certificationData.type > 5)
-        {
-            LOG_ERROR("Quote v4 supports QE Report Certification data types from 1 to 5 but found: {}",
-                      certificationData.type);
-            return false;
-        }
-    }
-
-    return true;
+    const auto authDataCertificationDataType = header.version == QUOTE_VERSION_4 ?
+            authDataV4.certificationData.type : authDataV3.certificationData.type;
+    return QuoteView::validate(header.version, header.attestationKeyType, header.teeType, header.qeVendorId,
+                               authDataCertificationDataType, certificationData.type);
 }
 
 const Header& Quote::getHeader() const
@@ -234,9 +190,14 @@ uint32_t Quote::getAuthDataSize() const
     return authDataSize;
 }
 
-const std::vector<uint8_t>& Quote::getSignedData() const
+const crypto::Sha256Digest& Quote::getSignedDataDigest() const
 {
-    return signedData;
+    return signedDataDigest;
+}
+
+const crypto::Sha256Digest& Quote::getQeReportDigest() const
+{
+    return qeReportDigest;
 }
 
 const Ecdsa256BitQuoteV3AuthData& Quote::getAuthDataV3() const
@@ -272,13 +233,4 @@ const std::array<uint8_t, constants::ECDSA_SIGNATURE_BYTE_LEN> &Quote::getQuoteS
     return quoteSignature;
 }
 
-std::vector<uint8_t> Quote::getDataToSignatureVerification(const std::vector<uint8_t>& rawQuote,
-                                                           const std::vector<uint8_t>::difference_type sizeToCopy) const
-{
-    // private method, we call it at the end of parsing, so
-    // here we assume format is valid
-    std::vector<uint8_t> ret(rawQuote.begin(), std::next(rawQuote.begin(), sizeToCopy));
-    return ret;
-}
-
 }}} //namespace intel { namespace sgx { namespace dcap {
@@ -34,6 +34,8 @@
 
 #include "QuoteStructures.h"
 
+#include <OpensslHelpers/DigestUtils.h>
+
 namespace intel { namespace sgx { namespace dcap {
 using namespace intel::sgx::dcap::quote;
 
@@ -41,6 +43,11 @@ class Quote
 {
 public:
     bool parse(const std::vector<uint8_t>& rawQuote);
+    /**
+     * Parses quote directly from caller memory, without copying it into an intermediate buffer.
+     * Parsed structures are owned by Quote, so rawQuote may be released afterwards.
+     */
+    bool parse(const uint8_t* rawQuote, size_t quoteSize);
 
     bool validate() const;
 
@@ -48,7 +55,8 @@ public:
     const EnclaveReport& getEnclaveReport() const;
     const TDReport& getTdReport() const;
     uint32_t getAuthDataSize() const;
-    const std::vector<uint8_t>& getSignedData() const;
+    /// SHA-256 of header and report, data signed with attestation key
+    const crypto::Sha256Digest& getSignedDataDigest() const;
 
     // Auth data getters
     const Ecdsa256BitQuoteV3AuthData& getAuthDataV3() const;
@@ -59,13 +67,15 @@ public:
     const std::vector<uint8_t>& getQeAuthData() const;
     const CertificationData& getCertificationData() const;
     const std::array<uint8_t, constants::ECDSA_SIGNATURE_BYTE_LEN>& getQuoteSignature() const;
+    /// SHA-256 of QE Report, data signed with PCK key
+    const crypto::Sha256Digest& getQeReportDigest() const;
 
 protected:
     Header header{};
     EnclaveReport enclaveReport{};
     TDReport tdReport{};
     uint32_t authDataSize;
-    std::vector<uint8_t> signedData{};
+    crypto::Sha256Digest signedDataDigest{};
 
     // Auth data
     Ecdsa256BitQuoteV3AuthData authDataV3{};
@@ -76,10 +86,7 @@ protected:
     std::vector<uint8_t> qeAuthData{};
     CertificationData certificationData{};
     std::array<uint8_t, constants::ECDSA_SIGNATURE_BYTE_LEN> quoteSignature{};
-
-private:
-    std::vector<uint8_t> getDataToSignatureVerification(const std::vector<uint8_t>& rawQuote,
-                                                        const std::vector<uint8_t>::difference_type) const;
+    crypto::Sha256Digest qeReportDigest{};
 };
 
 }}} // namespace intel { namespace sgx { namespace dcap { namespace test {
@@ -32,15 +32,17 @@
 #ifndef INTEL_SGX_QVL_QUOTEPARSERS_H_
 #define INTEL_SGX_QVL_QUOTEPARSERS_H_
 
+#include <algorithm>
+#include <array>
+#include <iterator>
 #include <vector>
 #include "QuoteConstants.h"
 #include "ByteOperands.h"
 
 namespace intel { namespace sgx { namespace dcap { namespace quote {
 
-template<typename T>
-inline bool copyAndAdvance(T &val, std::vector<uint8_t>::const_iterator &from, size_t amount,
-                           const std::vector<uint8_t>::const_iterator &totalEnd) {
+template<typename T, typename Iterator>
+inline bool copyAndAdvance(T &val, Iterator &from, size_t amount, const Iterator &totalEnd) {
     const auto available = std::distance(from, totalEnd);
     if (available < 0 || (unsigned) available < amount) {
         return false;
@@ -49,9 +51,8 @@ inline bool copyAndAdvance(T &val, std::vector<uint8_t>::const_iterator &from, s
     return val.insert(from, end);
 }
 
-template<size_t N>
-inline bool copyAndAdvance(std::array <uint8_t, N> &arr, std::vector<uint8_t>::const_iterator &from,
-                           const std::vector<uint8_t>::const_iterator &totalEnd) {
+template<size_t N, typename Iterator>
+inline bool copyAndAdvance(std::array <uint8_t, N> &arr, Iterator &from, const Iterator &totalEnd) {
     const auto capacity = std::distance(arr.cbegin(), arr.cend());
     if (std::distance(from, totalEnd) < capacity) {
         return false;
@@ -62,8 +63,8 @@ inline bool copyAndAdvance(std::array <uint8_t, N> &arr, std::vector<uint8_t>::c
     return true;
 }
 
-inline bool copyAndAdvance(uint16_t &val, std::vector<uint8_t>::const_iterator &from,
-                           const std::vector<uint8_t>::const_iterator &totalEnd) {
+template<typename Iterator>
+inline bool copyAndAdvance(uint16_t &val, Iterator &from, const Iterator &totalEnd) {
     const auto available = std::distance(from, totalEnd);
     const auto capacity = sizeof(uint16_t);
     if (available < 0 || (unsigned) available < capacity) {
@@ -75,9 +76,8 @@ inline bool copyAndAdvance(uint16_t &val, std::vector<uint8_t>::const_iterator &
     return true;
 }
 
-
-inline bool copyAndAdvance(uint32_t &val, std::vector<uint8_t>::const_iterator &position,
-                           const std::vector<uint8_t>::const_iterator &totalEnd) {
+template<typename Iterator>
+inline bool copyAndAdvance(uint32_t &val, Iterator &position, const Iterator &totalEnd) {
     const auto available = std::distance(position, totalEnd);
     const auto capacity = sizeof(uint32_t);
     if (available < 0 || (unsigned) available < capacity) {
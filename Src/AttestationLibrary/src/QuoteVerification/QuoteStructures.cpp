@@ -9,7 +9,8 @@
 namespace intel { namespace sgx { namespace dcap { namespace quote {
 using namespace constants;
 
-bool Header::insert(std::vector<uint8_t>::const_iterator& from, const std::vector<uint8_t>::const_iterator& end)
+template<typename Iterator>
+bool Header::insert(Iterator& from, const Iterator& end)
 {
     if (!copyAndAdvance(version, from, end)) { return false; }
     if (!copyAndAdvance(attestationKeyType, from, end)) { return false; }
@@ -21,7 +22,8 @@ bool Header::insert(std::vector<uint8_t>::const_iterator& from, const std::vecto
     return true;
 }
 
-bool EnclaveReport::insert(std::vector<uint8_t>::const_iterator& from, const std::vector<uint8_t>::const_iterator& end)
+template<typename Iterator>
+bool EnclaveReport::insert(Iterator& from, const Iterator& end)
 {
     if (!copyAndAdvance(cpuSvn, from, end)) { return false; }
     if (!copyAndAdvance(miscSelect, from, end)) { return false; }
@@ -84,7 +86,8 @@ std::array<uint8_t,ENCLAVE_REPORT_BYTE_LEN> EnclaveReport::rawBlob() const
     return ret;
 }
 
-bool TDReport::insert(std::vector<uint8_t>::const_iterator& from, const std::vector<uint8_t>::const_iterator& end)
+template<typename Iterator>
+bool TDReport::insert(Iterator& from, const Iterator& end)
 {
     if (!copyAndAdvance(teeTcbSvn, from, end)) { return false; }
     if (!copyAndAdvance(mrSeam, from, end)) { return false; }
@@ -162,17 +165,20 @@ uint32_t TDReport::getSeamSvn() const
     return teeTcbSvn[0];
 }
 
-bool Ecdsa256BitSignature::insert(std::vector<uint8_t>::const_iterator& from, const std::vector<uint8_t>::const_iterator& end)
+template<typename Iterator>
+bool Ecdsa256BitSignature::insert(Iterator& from, const Iterator& end)
 {
     return copyAndAdvance(signature, from, end);
 }
 
-bool Ecdsa256BitPubkey::insert(std::vector<uint8_t>::const_iterator& from, const std::vector<uint8_t>::const_iterator& end)
+template<typename Iterator>
+bool Ecdsa256BitPubkey::insert(Iterator& from, const Iterator& end)
 {
     return copyAndAdvance(pubKey, from, end);
 }
 
-bool QeAuthData::insert(std::vector<uint8_t>::const_iterator& from, const std::vector<uint8_t>::const_iterator& end)
+template<typename Iterator>
+bool QeAuthData::insert(Iterator& from, const Iterator& end)
 {
     const auto amount = static_cast<size_t>(std::distance(from, end));
     if(from > end || amount < QE_AUTH_DATA_SIZE_BYTE_LEN)
@@ -207,7 +213,8 @@ bool QeAuthData::insert(std::vector<uint8_t>::const_iterator& from, const std::v
     return true;
 }
 
-bool CertificationData::insert(std::vector<uint8_t>::const_iterator& from, const std::vector<uint8_t>::const_iterator& end)
+template<typename Iterator>
+bool CertificationData::insert(Iterator& from, const Iterator& end)
 {
     const auto minLen = CERTIFICATION_DATA_SIZE_BYTE_LEN + CERTIFICATION_DATA_TYPE_BYTE_LEN;
     const auto amount = static_cast<size_t>(std::distance(from, end));
@@ -239,7 +246,8 @@ bool CertificationData::insert(std::vector<uint8_t>::const_iterator& from, const
     return true;
 }
 
-bool QEReportCertificationData::insert(std::vector<uint8_t>::const_iterator& from, const std::vector<uint8_t>::const_iterator& end)
+template<typename Iterator>
+bool QEReportCertificationData::insert(Iterator& from, const Iterator& end)
 {
     if (!copyAndAdvance(qeReport, from, ENCLAVE_REPORT_BYTE_LEN, end))
     {
@@ -293,7 +301,8 @@ bool QEReportCertificationData::insert(std::vector<uint8_t>::const_iterator& fro
     return true;
 }
 
-bool Ecdsa256BitQuoteV3AuthData::insert(std::vector<uint8_t>::const_iterator& from, const std::vector<uint8_t>::const_iterator& end)
+template<typename Iterator>
+bool Ecdsa256BitQuoteV3AuthData::insert(Iterator& from, const Iterator& end)
 {
     if (!copyAndAdvance(ecdsa256BitSignature, from, ECDSA_SIGNATURE_BYTE_LEN, end)) { return false; }
     if (!copyAndAdvance(ecdsaAttestationKey, from, ECDSA_PUBKEY_BYTE_LEN, end)) { return false; }
@@ -330,7 +339,8 @@ bool Ecdsa256BitQuoteV3AuthData::insert(std::vector<uint8_t>::const_iterator& fr
     return true;
 }
 
-bool Ecdsa256BitQuoteV4AuthData::insert(std::vector<uint8_t>::const_iterator& from, const std::vector<uint8_t>::const_iterator& end)
+template<typename Iterator>
+bool Ecdsa256BitQuoteV4AuthData::insert(Iterator& from, const Iterator& end)
 {
     if (!copyAndAdvance(ecdsa256BitSignature, from, ECDSA_SIGNATURE_BYTE_LEN, end)) { return false; }
     if (!copyAndAdvance(ecdsaAttestationKey, from, ECDSA_PUBKEY_BYTE_LEN, end)) { return false; }
@@ -354,4 +364,26 @@ bool Ecdsa256BitQuoteV4AuthData::insert(std::vector<uint8_t>::const_iterator& fr
     return true;
 }
 
+// parsing is done over std::vector (tests, enclave report) and directly over caller memory (quote)
+template bool Header::insert(std::vector<uint8_t>::const_iterator& from, const std::vector<uint8_t>::const_iterator& end);
+template bool EnclaveReport::insert(std::vector<uint8_t>::const_iterator& from, const std::vector<uint8_t>::const_iterator& end);
+template bool TDReport::insert(std::vector<uint8_t>::const_iterator& from, const std::vector<uint8_t>::const_iterator& end);
+template bool Ecdsa256BitSignature::insert(std::vector<uint8_t>::const_iterator& from, const std::vector<uint8_t>::const_iterator& end);
+template bool Ecdsa256BitPubkey::insert(std::vector<uint8_t>::const_iterator& from, const std::vector<uint8_t>::const_iterator& end);
+template bool QeAuthData::insert(std::vector<uint8_t>::const_iterator& from, const std::vector<uint8_t>::const_iterator& end);
+template bool CertificationData::insert(std::vector<uint8_t>::const_iterator& from, const std::vector<uint8_t>::const_iterator& end);
+template bool QEReportCertificationData::insert(std::vector<uint8_t>::const_iterator& from, const std::vector<uint8_t>::const_iterator& end);
+template bool Ecdsa256BitQuoteV3AuthData::insert(std::vector<uint8_t>::const_iterator& from, const std::vector<uint8_t>::const_iterator& end);
+template bool Ecdsa256BitQuoteV4AuthData::insert(std::vector<uint8_t>::const_iterator& from, const std::vector<uint8_t>::const_iterator& end);
+template bool Header::insert(const uint8_t*& from, const uint8_t* const& end);
+template bool EnclaveReport::insert(const uint8_t*& from, const uint8_t* const& end);
+template bool TDReport::insert(const uint8_t*& from, const uint8_t* const& end);
+template bool Ecdsa256BitSignature::insert(const uint8_t*& from, const uint8_t* const& end);
+template bool Ecdsa256BitPubkey::insert(const uint8_t*& from, const uint8_t* const& end);
+template bool QeAuthData::insert(const uint8_t*& from, const uint8_t* const& end);
+template bool CertificationData::insert(const uint8_t*& from, const uint8_t* const& end);
+template bool QEReportCertificationData::insert(const uint8_t*& from, const uint8_t* const& end);
+template bool Ecdsa256BitQuoteV3AuthData::insert(const uint8_t*& from, const uint8_t* const& end);
+template bool Ecdsa256BitQuoteV4AuthData::insert(const uint8_t*& from, const uint8_t* const& end);
+
 }}}}
@@ -49,7 +49,8 @@ struct Header
     std::array<uint8_t, 16> qeVendorId;
     std::array<uint8_t, 20> userData;
 
-    bool insert(std::vector<uint8_t>::const_iterator& from, const std::vector<uint8_t>::const_iterator& end);
+    template<typename Iterator>
+    bool insert(Iterator& from, const Iterator& end);
 };
 
 struct EnclaveReport
@@ -67,7 +68,8 @@ struct EnclaveReport
     std::array<uint8_t, 60> reserved4;
     std::array<uint8_t, 64> reportData;
 
-    bool insert(std::vector<uint8_t>::const_iterator& from, const std::vector<uint8_t>::const_iterator& end);
+    template<typename Iterator>
+    bool insert(Iterator& from, const Iterator& end);
     std::array<uint8_t, constants::ENCLAVE_REPORT_BYTE_LEN> rawBlob() const;
 };
 
@@ -89,7 +91,8 @@ struct TDReport
     std::array<uint8_t, 48> rtMr3;
     std::array<uint8_t, 64> reportData;
 
-    bool insert(std::vector<uint8_t>::const_iterator& from, const std::vector<uint8_t>::const_iterator& end);
+    template<typename Iterator>
+    bool insert(Iterator& from, const Iterator& end);
     std::array<uint8_t, constants::TD_REPORT_BYTE_LEN> rawBlob() const;
 
     /// Retrieve SeamSvn from TEE TCB SVN
@@ -100,21 +103,24 @@ struct Ecdsa256BitSignature
 {
     std::array<uint8_t, dcap::constants::ECDSA_P256_SIGNATURE_BYTE_LEN> signature;
 
-    bool insert(std::vector<uint8_t>::const_iterator& from, const std::vector<uint8_t>::const_iterator& end);
+    template<typename Iterator>
+    bool insert(Iterator& from, const Iterator& end);
 };
 
 struct Ecdsa256BitPubkey
 {
     std::array<uint8_t, 64> pubKey;
 
-    bool insert(std::vector<uint8_t>::const_iterator& from, const std::vector<uint8_t>::const_iterator& end);
+    template<typename Iterator>
+    bool insert(Iterator& from, const Iterator& end);
 };
 
 struct QeAuthData
 {
     uint16_t parsedDataSize;
     std::vector<uint8_t> data;
-    bool insert(std::vector<uint8_t>::const_iterator& from, const std::vector<uint8_t>::const_iterator& end);
+    template<typename Iterator>
+    bool insert(Iterator& from, const Iterator& end);
 };
 
 struct CertificationData
@@ -122,7 +128,8 @@ struct CertificationData
     uint16_t type;
     uint32_t parsedDataSize;
     std::vector<uint8_t> data;
-    bool insert(std::vector<uint8_t>::const_iterator& from, const std::vector<uint8_t>::const_iterator& end);
+    template<typename Iterator>
+    bool insert(Iterator& from, const Iterator& end);
 };
 
 struct QEReportCertificationData
@@ -132,7 +139,8 @@ struct QEReportCertificationData
     QeAuthData qeAuthData{};
     CertificationData certificationData{};
 
-    bool insert(std::vector<uint8_t>::const_iterator& from, const std::vector<uint8_t>::const_iterator& end);
+    template<typename Iterator>
+    bool insert(Iterator& from, const Iterator& end);
 };
 
 struct Ecdsa256BitQuoteV3AuthData
@@ -145,7 +153,8 @@ struct Ecdsa256BitQuoteV3AuthData
     QeAuthData qeAuthData{};
     CertificationData certificationData{};
 
-    bool insert(std::vector<uint8_t>::const_iterator& from, const std::vector<uint8_t>::const_iterator& end);
+    template<typename Iterator>
+    bool insert(Iterator& from, const Iterator& end);
 };
 
 struct Ecdsa256BitQuoteV4AuthData
@@ -154,7 +163,8 @@ struct Ecdsa256BitQuoteV4AuthData
     Ecdsa256BitPubkey ecdsaAttestationKey{};
     CertificationData certificationData{};
 
-    bool insert(std::vector<uint8_t>::const_iterator& from, const std::vector<uint8_t>::const_iterator& end);
+    template<typename Iterator>
+    bool insert(Iterator& from, const Iterator& end);
 };
 
 }}}}
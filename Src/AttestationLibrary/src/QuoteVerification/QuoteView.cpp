@@ -0,0 +1,379 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "QuoteView.h"
+#include "Utils/Logger.h"
+
+#include <algorithm>
+
+namespace intel { namespace sgx { namespace dcap {
+using namespace constants;
+
+namespace {
+
+/// Bounds checked, little endian reader over a byte range
+class Reader
+{
+public:
+    explicit Reader(const ByteRange& range): position(range.begin()), end(range.end()) {}
+
+    size_t remaining() const
+    {
+        return static_cast<size_t>(end - position);
+    }
+
+    bool atEnd() const
+    {
+        return position == end;
+    }
+
+    bool read(size_t size, ByteRange& out)
+    {
+        if (remaining() < size)
+        {
+            return false;
+        }
+        out = ByteRange(position, size);
+        position += size;
+        return true;
+    }
+
+    bool read(uint16_t& out)
+    {
+        ByteRange bytes;
+        if (!read(sizeof(uint16_t), bytes))
+        {
+            return false;
+        }
+        out = static_cast<uint16_t>(bytes.data()[0] | (bytes.data()[1] << 8));
+        return true;
+    }
+
+    bool read(uint32_t& out)
+    {
+        ByteRange bytes;
+        if (!read(sizeof(uint32_t), bytes))
+        {
+            return false;
+        }
+        out = static_cast<uint32_t>(bytes.data()[0]) |
+              static_cast<uint32_t>(bytes.data()[1]) << 8 |
+              static_cast<uint32_t>(bytes.data()[2]) << 16 |
+              static_cast<uint32_t>(bytes.data()[3]) << 24;
+        return true;
+    }
+
+private:
+    const uint8_t* position;
+    const uint8_t* end;
+};
+
+bool readQeAuthData(Reader& reader, ByteRange& qeAuthData)
+{
+    uint16_t size = 0;
+    return reader.read(size) && reader.read(size, qeAuthData);
+}
+
+bool readCertificationData(Reader& reader, uint16_t& type, ByteRange& certificationData)
+{
+    uint32_t size = 0;
+    return reader.read(type) && reader.read(size) && reader.read(size, certificationData);
+}
+
+} // anonymous namespace
+
+bool QuoteView::parse(const uint8_t* rawQuote, size_t quoteSize)
+{
+    if(quoteSize < QUOTE_MIN_BYTE_LEN)
+    {
+        LOG_ERROR("Quote size {} is not at least {}.", quoteSize, QUOTE_MIN_BYTE_LEN);
+        return false;
+    }
+
+    Reader reader(ByteRange(rawQuote, quoteSize));
+    ByteRange localHeader;
+    reader.read(HEADER_BYTE_LEN, localHeader);
+    Reader headerReader(localHeader);
+    uint16_t localVersion = 0;
+    uint16_t localAttestationKeyType = 0;
+    uint32_t localTeeType = 0;
+    headerReader.read(localVersion);
+    headerReader.read(localAttestationKeyType);
+    headerReader.read(localTeeType);
+
+    ByteRange localReport;
+    if (localTeeType == TEE_TYPE_SGX && !reader.read(ENCLAVE_REPORT_BYTE_LEN, localReport))
+    {
+        LOG_ERROR("Can't read SGX enclave report from quote. Expected size: {}", ENCLAVE_REPORT_BYTE_LEN);
+        return false;
+    }
+    if (localTeeType == TEE_TYPE_TDX && !reader.read(TD_REPORT_BYTE_LEN, localReport))
+    {
+        LOG_ERROR("Can't read TDX TD Report from quote. Expected size: {}", TD_REPORT_BYTE_LEN);
+        return false;
+    }
+
+    uint32_t localAuthDataSize = 0;
+    if (!reader.read(localAuthDataSize))
+    {
+        LOG_ERROR("Can't read auth data size  from quote.");
+        return false;
+    }
+    if (localAuthDataSize != reader.remaining())
+    {
+        LOG_ERROR("Declared auth data size {} doesn't match remaining quote size {}", localAuthDataSize, reader.remaining());
+        return false;
+    }
+
+    ByteRange localAuthData;
+    reader.read(localAuthDataSize, localAuthData);
+    Reader authReader(localAuthData);
+    uint16_t localAuthDataCertificationDataType = 0;
+    uint16_t localCertificationDataType = 0;
+    ByteRange localCertificationData;
+    ByteRange localQuoteSignature;
+    ByteRange localAttestKeyData;
+    ByteRange localQeReport;
+    ByteRange localQeReportSignature;
+    ByteRange localQeAuthData;
+    if (localVersion == QUOTE_VERSION_3)
+    {
+        if (!authReader.read(ECDSA_SIGNATURE_BYTE_LEN, localQuoteSignature) ||
+            !authReader.read(ECDSA_PUBKEY_BYTE_LEN, localAttestKeyData) ||
+            !authReader.read(QE_REPORT_BYTE_LEN, localQeReport) ||
+            !authReader.read(QE_REPORT_SIG_BYTE_LEN, localQeReportSignature) ||
+            !readQeAuthData(authReader, localQeAuthData) ||
+            !readCertificationData(authReader, localCertificationDataType, localCertificationData))
+        {
+            LOG_ERROR("Can't read QUOTE v3 Auth data. Expected size: {}", localAuthDataSize);
+            return false;
+        }
+        localAuthDataCertificationDataType = localCertificationDataType;
+    }
+    else if (localVersion == QUOTE_VERSION_4)
+    {
+        ByteRange qeReportCertificationData;
+        if (!authReader.read(ECDSA_SIGNATURE_BYTE_LEN, localQuoteSignature) ||
+            !authReader.read(ECDSA_PUBKEY_BYTE_LEN, localAttestKeyData) ||
+            !readCertificationData(authReader, localAuthDataCertificationDataType, qeReportCertificationData))
+        {
+            LOG_ERROR("Can't read QUOTE v4 Auth data. Expected size: {}", localAuthDataSize);
+            return false;
+        }
+
+        Reader qeReportReader(qeReportCertificationData);
+        if (!qeReportReader.read(QE_REPORT_BYTE_LEN, localQeReport) ||
+            !qeReportReader.read(QE_REPORT_SIG_BYTE_LEN, localQeReportSignature) ||
+            !readQeAuthData(qeReportReader, localQeAuthData) ||
+            !readCertificationData(qeReportReader, localCertificationDataType, localCertificationData))
+        {
+            LOG_ERROR("Can't read QE Report Certification Data from quote.");
+            return false;
+        }
+        if (!qeReportReader.atEnd())
+        {
+            LOG_ERROR("There is additional, not expected data in quote.");
+            return false;
+        }
+    }
+
+    // parsing done, we should be precisely at the end of auth data
+    // if we're not it means inconsistency in internal structure
+    // and it means invalid format
+    if (!authReader.atEnd())
+    {
+        LOG_ERROR("There is additional, not expected data in quote.");
+        return false;
+    }
+
+    version = localVersion;
+    attestationKeyType = localAttestationKeyType;
+    teeType = localTeeType;
+    authDataSize = localAuthDataSize;
+    authDataCertificationDataType = localAuthDataCertificationDataType;
+    certificationDataType = localCertificationDataType;
+    header = localHeader;
+    report = localReport;
+    authData = localAuthData;
+    certificationData = localCertificationData;
+    quoteSignature = localQuoteSignature;
+    attestKeyData = localAttestKeyData;
+    qeReport = localQeReport;
+    qeReportSignature = localQeReportSignature;
+    qeAuthData = localQeAuthData;
+    return true;
+}
+
+bool QuoteView::validate() const
+{
+    return validate(version, attestationKeyType, teeType, ByteRange(header.data() + 12, INTEL_QE_VENDOR_ID.size()),
+                    authDataCertificationDataType, certificationDataType);
+}
+
+bool QuoteView::validate(uint16_t version, uint16_t attestationKeyType, uint32_t teeType, const ByteRange& qeVendorId,
+                         uint16_t authDataCertificationDataType, uint16_t certificationDataType)
+{
+    if(std::find(ALLOWED_QUOTE_VERSIONS.begin(), ALLOWED_QUOTE_VERSIONS.end(), version) ==
+       ALLOWED_QUOTE_VERSIONS.end())
+    {
+        LOG_ERROR("Quote version {} is not supported", version);
+        return false;
+    }
+
+    if(std::find(ALLOWED_ATTESTATION_KEY_TYPES.begin(), ALLOWED_ATTESTATION_KEY_TYPES.end(), attestationKeyType) ==
+       ALLOWED_ATTESTATION_KEY_TYPES.end())
+    {
+        LOG_ERROR("Attestation Key type {} is not supported", attestationKeyType);
+        return false;
+    }
+
+    if(std::find(ALLOWED_TEE_TYPES.begin(), ALLOWED_TEE_TYPES.end(), teeType) == ALLOWED_TEE_TYPES.end())
+    {
+        LOG_ERROR("TEE Type {} is not supported", teeType);
+        return false;
+    }
+
+    if(qeVendorId.size() != INTEL_QE_VENDOR_ID.size() ||
+       !std::equal(INTEL_QE_VENDOR_ID.begin(), INTEL_QE_VENDOR_ID.end(), qeVendorId.begin())) {
+        LOG_ERROR("Wrong QE vendor ID. Found: {}, expected: {}", Bytes(qeVendorId.begin(), qeVendorId.end()), INTEL_QE_VENDOR_ID);
+        return false;
+    }
+
+    if (version == QUOTE_VERSION_3)
+    {
+        if (teeType != TEE_TYPE_SGX)
+        {
+            LOG_ERROR("Quote v3 supports only SGX tee type but found {}", teeType);
+            return false;
+        }
+        if (authDataCertificationDataType < 1 || authDataCertificationDataType > 5) // QuoteV3 supports only 1-5 types
+        {
+            LOG_ERROR("Quote v3 supports certification data types from 1 to 5 but found {}",
+                      authDataCertificationDataType);
+            return false;
+        }
+    }
+
+    if(version == QUOTE_VERSION_4)
+    {
+        if (authDataCertificationDataType != constants::PCK_ID_QE_REPORT_CERTIFICATION_DATA)
+        {
+            LOG_ERROR("Quote v4 supports only {} certification data type but found {}",
+                      constants::PCK_ID_QE_REPORT_CERTIFICATION_DATA, authDataCertificationDataType);
+            return false;
+        }
+        if (certificationDataType < 1 || certificationDataType > 5)
+        {
+            LOG_ERROR("Quote v4 supports QE Report Certification data types from 1 to 5 but found: {}",
+                      certificationDataType);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+uint16_t QuoteView::getVersion() const
+{
+    return version;
+}
+
+uint16_t QuoteView::getAttestationKeyType() const
+{
+    return attestationKeyType;
+}
+
+uint32_t QuoteView::getTeeType() const
+{
+    return teeType;
+}
+
+uint32_t QuoteView::getAuthDataSize() const
+{
+    return authDataSize;
+}
+
+ByteRange QuoteView::getHeader() const
+{
+    return header;
+}
+
+ByteRange QuoteView::getReport() const
+{
+    return report;
+}
+
+ByteRange QuoteView::getSignedData() const
+{
+    return ByteRange(header.data(), header.size() + report.size());
+}
+
+ByteRange QuoteView::getAuthData() const
+{
+    return authData;
+}
+
+ByteRange QuoteView::getQuoteSignature() const
+{
+    return quoteSignature;
+}
+
+ByteRange QuoteView::getAttestKeyData() const
+{
+    return attestKeyData;
+}
+
+ByteRange QuoteView::getQeReport() const
+{
+    return qeReport;
+}
+
+ByteRange QuoteView::getQeReportSignature() const
+{
+    return qeReportSignature;
+}
+
+ByteRange QuoteView::getQeAuthData() const
+{
+    return qeAuthData;
+}
+
+uint16_t QuoteView::getCertificationDataType() const
+{
+    return certificationDataType;
+}
+
+ByteRange QuoteView::getCertificationData() const
+{
+    return certificationData;
+}
+
+}}} //namespace intel { namespace sgx { namespace dcap {
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef INTEL_SGX_QVL_QUOTE_VIEW_H_
+#define INTEL_SGX_QVL_QUOTE_VIEW_H_
+
+#include "QuoteConstants.h"
+
+#include <OpensslHelpers/Bytes.h>
+
+namespace intel { namespace sgx { namespace dcap {
+
+/**
+ * Non-owning, zero-copy view of a serialized quote.
+ * parse() validates quote layout in place and remembers where each part of the quote is located, returned ranges
+ * point into the parsed buffer which has to outlive the view.
+ */
+class QuoteView
+{
+public:
+    bool parse(const uint8_t* rawQuote, size_t quoteSize);
+
+    bool validate() const;
+
+    uint16_t getVersion() const;
+    uint16_t getAttestationKeyType() const;
+    uint32_t getTeeType() const;
+    uint32_t getAuthDataSize() const;
+
+    ByteRange getHeader() const;
+    /// SGX Enclave Report or TDX TD Report, depending on TEE type
+    ByteRange getReport() const;
+    /// Header and report, data signed by the attestation key
+    ByteRange getSignedData() const;
+    ByteRange getAuthData() const;
+
+    // Auth data parts
+    ByteRange getQuoteSignature() const;
+    ByteRange getAttestKeyData() const;
+    ByteRange getQeReport() const;
+    ByteRange getQeReportSignature() const;
+    ByteRange getQeAuthData() const;
+    uint16_t getCertificationDataType() const;
+    ByteRange getCertificationData() const;
+
+    /**
+     * Checks header fields and certification data types against supported values.
+     * @param authDataCertificationDataType - type of certification data in auth data (QE Report Certification Data for Quote v4)
+     * @param certificationDataType - type of QE certification data
+     */
+    static bool validate(uint16_t version, uint16_t attestationKeyType, uint32_t teeType, const ByteRange& qeVendorId,
+                         uint16_t authDataCertificationDataType, uint16_t certificationDataType);
+
+private:
+    uint16_t version = 0;
+    uint16_t attestationKeyType = 0;
+    uint32_t teeType = 0;
+    uint32_t authDataSize = 0;
+    uint16_t authDataCertificationDataType = 0;
+    uint16_t certificationDataType = 0;
+
+    ByteRange header;
+    ByteRange report;
+    ByteRange authData;
+    ByteRange quoteSignature;
+    ByteRange attestKeyData;
+    ByteRange qeReport;
+    ByteRange qeReportSignature;
+    ByteRange qeAuthData;
+    ByteRange certificationData;
+};
+
+}}} // namespace intel { namespace sgx { namespace dcap {
+
+#endif //INTEL_SGX_QVL_QUOTE_VIEW_H_
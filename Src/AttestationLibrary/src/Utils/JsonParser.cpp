@@ -32,6 +32,7 @@
 #include "JsonParser.h"
 
 #include "OpensslHelpers/Bytes.h"
+#include "Utils/Encoding.h"
 #include "Utils/TimeUtils.h"
 
 #include <rapidjson/stringbuffer.h>
@@ -41,13 +42,34 @@
 
 namespace intel { namespace sgx { namespace dcap {
 
+namespace {
+
+const ::rapidjson::Value* findFieldOf(const ::rapidjson::Value& parent, const std::string& fieldName)
+{
+    if(!parent.IsObject())
+    {
+        return nullptr;
+    }
+    const auto member = parent.FindMember(fieldName.c_str());
+    return member != parent.MemberEnd() ? &member->value : nullptr;
+}
+
+} // anonymous namespace
+
 bool JsonParser::parse(const std::string& json)
 {
-    if(json.empty())
+    return parse(json.data(), json.size());
+}
+
+bool JsonParser::parse(const char* json, size_t length)
+{
+    if(json == nullptr || length == 0)
     {
         return false;
     }
-    jsonDocument.Parse(json.c_str());
+    jsonBuffer.assign(json, json + length);
+    jsonBuffer.push_back('\0');
+    jsonDocument.ParseInsitu(jsonBuffer.data());
     return !jsonDocument.HasParseError() && jsonDocument.IsObject();
 }
 
@@ -58,20 +80,17 @@ const rapidjson::Value* JsonParser::getRoot() const
 
 const rapidjson::Value* JsonParser::getField(const std::string& fieldName) const
 {
-    if(!jsonDocument.IsObject() || !jsonDocument.HasMember(fieldName.c_str()))
-    {
-        return nullptr;
-    }
-    return &jsonDocument[fieldName.c_str()];
+    return findFieldOf(jsonDocument, fieldName);
 }
 
 std::pair<std::string, JsonParser::ParseStatus> JsonParser::getStringFieldOf(const ::rapidjson::Value &parent, const std::string &fieldName) const
 {
-    if(!parent.HasMember(fieldName.c_str()))
+    const auto* field = findFieldOf(parent, fieldName);
+    if(field == nullptr)
     {
         return std::make_pair("", ParseStatus::Missing);
     }
-    const ::rapidjson::Value& property_v = parent[fieldName.c_str()];
+    const ::rapidjson::Value& property_v = *field;
     if(!property_v.IsString())
     {
         return std::make_pair("", ParseStatus::Invalid);
@@ -84,20 +103,22 @@ std::pair<std::string, JsonParser::ParseStatus> JsonParser::getStringFieldOf(con
 std::pair<std::vector<uint8_t>, JsonParser::ParseStatus> JsonParser::getHexstringFieldOf(const ::rapidjson::Value& parent, const std::string& fieldName, size_t length) const
 {
     static auto FailedReturnValue = std::make_pair(std::vector<uint8_t>{}, false);
-    if(!parent.IsObject() || !parent.HasMember(fieldName.c_str()))
+    const auto* field = findFieldOf(parent, fieldName);
+    if(field == nullptr)
     {
         return std::make_pair(std::vector<uint8_t>{}, ParseStatus::Missing);
     }
-    const ::rapidjson::Value& property_v = parent[fieldName.c_str()];
+    const ::rapidjson::Value& property_v = *field;
     if(!property_v.IsString())
     {
         return std::make_pair(std::vector<uint8_t>{}, ParseStatus::Invalid);
     }
 
-    const std::string propertyStr = property_v.GetString();
-    if(propertyStr.length() == length && isValidHexstring(propertyStr))
+    std::vector<uint8_t> bytes(length / 2);
+    if(property_v.GetStringLength() == length &&
+       decodeHex(property_v.GetString(), length, bytes.data()) == DecodeStatus::OK)
     {
-        return std::make_pair(hexStringToBytes(propertyStr), ParseStatus::OK);
+        return std::make_pair(bytes, ParseStatus::OK);
     }
     return std::make_pair(std::vector<uint8_t>{}, ParseStatus::Invalid);
 }
@@ -105,16 +126,19 @@ std::pair<std::vector<uint8_t>, JsonParser::ParseStatus> JsonParser::getHexstrin
 std::pair<tm, JsonParser::ParseStatus> JsonParser::getDateFieldOf(
         const ::rapidjson::Value& parent, const std::string& fieldName) const
 {
-    if(!parent.IsObject() || !parent.HasMember(fieldName.c_str()))
+    const auto* field = findFieldOf(parent, fieldName);
+    if(field == nullptr)
     {
         return std::make_pair(tm{}, ParseStatus::Missing);
     }
-    const auto& date = parent[fieldName.c_str()];
-    if(!date.IsString() || !isValidTimeString(date.GetString()))
+    const auto& date = *field;
+    struct tm time{};
+    time_t epoch = 0;
+    if(!date.IsString() || !parseTimeString(date.GetString(), date.GetStringLength(), time, epoch))
     {
         return std::make_pair(tm{}, ParseStatus::Invalid);
     }
-    return std::make_pair(getTimeFromString(date.GetString()), ParseStatus::OK);
+    return std::make_pair(time, ParseStatus::OK);
 }
 
 JsonParser::ParseStatus JsonParser::checkDateFieldOf(const ::rapidjson::Value& parent, const std::string& fieldName) const
@@ -127,11 +151,12 @@ JsonParser::ParseStatus JsonParser::checkDateFieldOf(const ::rapidjson::Value& p
 std::pair<uint32_t, JsonParser::ParseStatus> JsonParser::getUintFieldOf(
         const ::rapidjson::Value& parent, const std::string& fieldName) const
 {
-    if(!parent.IsObject() || !parent.HasMember(fieldName.c_str()))
+    const auto* field = findFieldOf(parent, fieldName);
+    if(field == nullptr)
     {
         return std::make_pair(0u, ParseStatus::Missing);
     }
-    const ::rapidjson::Value& value = parent[fieldName.c_str()];
+    const ::rapidjson::Value& value = *field;
     if(!value.IsUint())
     {
         return std::make_pair(0u, ParseStatus::Invalid);
@@ -142,11 +167,12 @@ std::pair<uint32_t, JsonParser::ParseStatus> JsonParser::getUintFieldOf(
 std::pair<int, JsonParser::ParseStatus> JsonParser::getIntFieldOf(
         const ::rapidjson::Value& parent, const std::string& fieldName) const
 {
-    if(!parent.IsObject() || !parent.HasMember(fieldName.c_str()))
+    const auto* field = findFieldOf(parent, fieldName);
+    if(field == nullptr)
     {
         return std::make_pair(0, ParseStatus::Missing);
     }
-    const ::rapidjson::Value& value = parent[fieldName.c_str()];
+    const ::rapidjson::Value& value = *field;
     if(!value.IsInt())
     {
         return std::make_pair(0, ParseStatus::Invalid);
@@ -154,10 +180,4 @@ std::pair<int, JsonParser::ParseStatus> JsonParser::getIntFieldOf(
     return std::make_pair(value.GetInt(), ParseStatus::OK);
 }
 
-bool JsonParser::isValidHexstring(const std::string& hexString) const
-{
-    return std::find_if(hexString.cbegin(), hexString.cend(),
-                        [](const char c){return !::isxdigit(static_cast<unsigned char>(c));}) == hexString.cend();
-}
-
 }}} // namespace intel { namespace sgx { namespace dcap {
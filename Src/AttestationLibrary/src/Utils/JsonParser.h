@@ -51,6 +51,8 @@ public:
     };
 
     bool parse(const std::string& json);
+    /// Parses in-situ from a single copy of json, strings of the document point into that copy
+    bool parse(const char* json, size_t length);
     const rapidjson::Value* getRoot() const;
     const rapidjson::Value* getField(const std::string& fieldName) const;
     std::pair<std::vector<uint8_t>, ParseStatus> getHexstringFieldOf(const ::rapidjson::Value& parent, const std::string& fieldName, size_t length) const;
@@ -61,8 +63,7 @@ public:
     std::pair<int, ParseStatus> getIntFieldOf(const ::rapidjson::Value& parent, const std::string& fieldName) const;
 
 private:
-    bool isValidHexstring(const std::string& hexString) const;
-
+    std::vector<char> jsonBuffer;
     rapidjson::Document jsonDocument;
 };
 
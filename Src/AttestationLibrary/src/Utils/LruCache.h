@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef INTEL_SGX_QVL_LRU_CACHE_H_
+#define INTEL_SGX_QVL_LRU_CACHE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace intel { namespace sgx { namespace dcap {
+
+/**
+ * Bounded, mutex guarded map evicting least recently used entries, shared by process wide caches of the library.
+ * Values are copied out under the lock, so they should be cheap to copy (e.g. std::shared_ptr).
+ * Capacity 0 disables the cache: nothing is stored and every lookup misses.
+ */
+template<typename Key, typename Value, typename Hash>
+class LruCache
+{
+public:
+    explicit LruCache(size_t capacity): _capacity(capacity) {}
+
+    LruCache(const LruCache&) = delete;
+    LruCache& operator=(const LruCache&) = delete;
+
+    /**
+     * Checked without taking the lock, lets callers skip building keys when the cache is disabled.
+     */
+    bool enabled() const
+    {
+        return _capacity != 0;
+    }
+
+    /**
+     * Copies value of key to value and marks it as most recently used.
+     * @return false if key is not cached
+     */
+    bool get(const Key& key, Value& value)
+    {
+        return get(key, value, [](const Value&) { return true; });
+    }
+
+    /**
+     * As above, but entry for which isValid(value) returns false is removed and reported as missing.
+     */
+    template<typename IsValid>
+    bool get(const Key& key, Value& value, IsValid isValid)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const auto it = _index.find(key);
+        if (it == _index.end())
+        {
+            return false;
+        }
+        if (!isValid(it->second->second))
+        {
+            _lru.erase(it->second);
+            _index.erase(it);
+            return false;
+        }
+        _lru.splice(_lru.begin(), _lru, it->second);
+        value = it->second->second;
+        return true;
+    }
+
+    /**
+     * Inserts or replaces value of key and marks it as most recently used.
+     * @return number of entries evicted to stay within capacity
+     */
+    size_t put(const Key& key, Value value)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_capacity == 0)
+        {
+            return 0;
+        }
+
+        const auto it = _index.find(key);
+        if (it != _index.end())
+        {
+            it->second->second = std::move(value);
+            _lru.splice(_lru.begin(), _lru, it->second);
+            return 0;
+        }
+
+        _lru.emplace_front(key, std::move(value));
+        _index.emplace(key, _lru.begin());
+        size_t evicted = 0;
+        while (_index.size() > _capacity)
+        {
+            _index.erase(_lru.back().first);
+            _lru.pop_back();
+            evicted++;
+        }
+        return evicted;
+    }
+
+    /**
+     * Sets maximum number of entries and clears the cache.
+     */
+    void setCapacity(size_t capacity)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _capacity = capacity;
+        _lru.clear();
+        _index.clear();
+    }
+
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _index.size();
+    }
+
+private:
+    using Entries = std::list<std::pair<Key, Value>>;
+
+    mutable std::mutex _mutex;
+    std::atomic<size_t> _capacity;
+    Entries _lru;
+    std::unordered_map<Key, typename Entries::iterator, Hash> _index;
+};
+
+}}} // namespace intel { namespace sgx { namespace dcap {
+
+#endif // INTEL_SGX_QVL_LRU_CACHE_H_
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "ParseCache.h"
+
+#include <cstring>
+#include <utility>
+
+namespace intel { namespace sgx { namespace dcap {
+
+ParseCache& ParseCache::instance()
+{
+    static ParseCache cache;
+    return cache;
+}
+
+void ParseCache::setCapacity(size_t capacity)
+{
+    _cache.setCapacity(capacity);
+    _hits = 0;
+    _misses = 0;
+    _evictions = 0;
+}
+
+ParseCache::Statistics ParseCache::getStatistics() const
+{
+    return Statistics{_hits, _misses, _evictions, _cache.size()};
+}
+
+size_t ParseCache::KeyHash::operator()(const Key& key) const
+{
+    // digest is uniformly distributed, its first bytes are good enough as a hash
+    size_t hash = 0;
+    std::memcpy(&hash, key.digest.data(), sizeof(hash));
+    return hash ^ static_cast<size_t>(key.kind);
+}
+
+bool ParseCache::makeKey(Kind kind, const uint8_t* input, size_t inputSize, Key& key) const
+{
+    // hashed straight into the key, lookups don't allocate
+    if (!crypto::sha256Digest(ByteRange(input, inputSize), key.digest))
+    {
+        return false;
+    }
+    key.kind = kind;
+    return true;
+}
+
+std::shared_ptr<const void> ParseCache::find(const Key& key)
+{
+    std::shared_ptr<const void> value;
+    if (!_cache.get(key, value))
+    {
+        _misses++;
+        return nullptr;
+    }
+    _hits++;
+    return value;
+}
+
+void ParseCache::insert(const Key& key, std::shared_ptr<const void> value)
+{
+    // object parsed concurrently by another thread is simply replaced, both are equal
+    _evictions += _cache.put(key, std::move(value));
+}
+
+}}} // namespace intel { namespace sgx { namespace dcap {
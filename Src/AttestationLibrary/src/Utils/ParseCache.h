@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGXECDSAATTESTATION_PARSECACHE_H
+#define SGXECDSAATTESTATION_PARSECACHE_H
+
+#include "OpensslHelpers/DigestUtils.h"
+#include "Utils/LruCache.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace intel { namespace sgx { namespace dcap {
+
+/**
+ * Process wide, bounded LRU cache of immutable objects parsed from C API inputs.
+ * Entries are keyed by kind of object and SHA-256 of the input bytes, so byte-identical input is parsed only once.
+ * Cache is disabled (capacity 0) until enabled with setCapacity.
+ */
+class ParseCache
+{
+public:
+    enum class Kind : uint8_t
+    {
+        PCK_CERTIFICATE,
+        PCK_CRL,
+        TCB_INFO,
+        ENCLAVE_IDENTITY,
+        PCK_CERTIFICATE_DER,
+        PCK_CRL_DER
+    };
+
+    struct Statistics
+    {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t evictions;
+        uint64_t entries;
+    };
+
+    static ParseCache& instance();
+
+    /**
+     * Sets maximum number of cached entries. Clears the cache and resets statistics. 0 disables caching.
+     */
+    void setCapacity(size_t capacity);
+    Statistics getStatistics() const;
+
+    /**
+     * Returns object parsed from input, calling parse() on cache miss. parse() returns std::shared_ptr<const T>,
+     * it may throw or return nullptr on failure in which case nothing is cached.
+     * Input is only hashed when cache is enabled and is never copied.
+     */
+    template<typename T, typename Parse>
+    std::shared_ptr<const T> getOrParse(Kind kind, const uint8_t* input, size_t inputSize, Parse parse);
+
+    template<typename T, typename Parse>
+    std::shared_ptr<const T> getOrParse(Kind kind, const std::string& input, Parse parse)
+    {
+        return getOrParse<T>(kind, reinterpret_cast<const uint8_t*>(input.data()), input.size(), parse);
+    }
+
+private:
+    using Digest = crypto::Sha256Digest;
+
+    struct Key
+    {
+        Kind kind;
+        Digest digest;
+
+        bool operator==(const Key& other) const
+        {
+            return kind == other.kind && digest == other.digest;
+        }
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const;
+    };
+
+    ParseCache() = default;
+
+    bool makeKey(Kind kind, const uint8_t* input, size_t inputSize, Key& key) const;
+    std::shared_ptr<const void> find(const Key& key);
+    void insert(const Key& key, std::shared_ptr<const void> value);
+
+    LruCache<Key, std::shared_ptr<const void>, KeyHash> _cache{0};
+
+    std::atomic<uint64_t> _hits{0};
+    std::atomic<uint64_t> _misses{0};
+    std::atomic<uint64_t> _evictions{0};
+};
+
+template<typename T, typename Parse>
+std::shared_ptr<const T> ParseCache::getOrParse(Kind kind, const uint8_t* input, size_t inputSize, Parse parse)
+{
+    Key key{};
+    if (!_cache.enabled() || !makeKey(kind, input, inputSize, key))
+    {
+        return parse();
+    }
+
+    auto cached = find(key);
+    if (cached)
+    {
+        return std::static_pointer_cast<const T>(cached);
+    }
+
+    std::shared_ptr<const T> parsed = parse();
+    if (parsed)
+    {
+        insert(key, parsed);
+    }
+    return parsed;
+}
+
+}}} // namespace intel { namespace sgx { namespace dcap {
+
+#endif //SGXECDSAATTESTATION_PARSECACHE_H
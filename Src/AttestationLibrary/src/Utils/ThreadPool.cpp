@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGX_TRUSTED
+
+#include "ThreadPool.h"
+
+#include <Utils/Logger.h>
+
+#include <algorithm>
+#include <exception>
+#include <iterator>
+
+namespace intel { namespace sgx { namespace dcap {
+
+ThreadPool& ThreadPool::instance()
+{
+    // intentionally leaked, see the declaration
+    static auto *pool = new ThreadPool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+    return *pool;
+}
+
+ThreadPool::ThreadPool(size_t maxThreads): _maxThreads(maxThreads)
+{}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _jobAvailable.notify_all();
+    for (auto& thread : _threads)
+    {
+        thread.join();
+    }
+}
+
+size_t ThreadPool::run(size_t helperCount, const std::function<void()>& task)
+{
+    Completion completion;
+    size_t queued = 0;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        grow(std::min(helperCount, _maxThreads));
+        try
+        {
+            for (; queued < std::min(helperCount, _threads.size()); queued++)
+            {
+                _jobs.push_back(Job{&task, &completion});
+            }
+        }
+        catch (const std::exception& ex)
+        {
+            LOG_WARN("Queued {} of {} batch verification jobs: {}", queued, helperCount, ex.what());
+        }
+        // jobs are only taken under _mutex, so none of them finished before pending is set
+        completion.pending = queued;
+    }
+    if (queued == 1)
+    {
+        _jobAvailable.notify_one();
+    }
+    else if (queued > 1)
+    {
+        _jobAvailable.notify_all();
+    }
+
+    task();
+
+    // whatever was left for jobs that did not start has already been taken by the calling thread
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const auto notStarted = std::remove_if(_jobs.begin(), _jobs.end(), [&](const Job& job) {
+            return job.completion == &completion;
+        });
+        const auto dropped = static_cast<size_t>(std::distance(notStarted, _jobs.end()));
+        _jobs.erase(notStarted, _jobs.end());
+        std::lock_guard<std::mutex> completionLock(completion.mutex);
+        completion.pending -= dropped;
+    }
+
+    std::unique_lock<std::mutex> completionLock(completion.mutex);
+    completion.finished.wait(completionLock, [&]() { return completion.pending == 0; });
+    return queued;
+}
+
+size_t ThreadPool::size() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _threads.size();
+}
+
+void ThreadPool::grow(size_t threadCount)
+{
+    if (_threads.size() >= threadCount)
+    {
+        return;
+    }
+    try
+    {
+        _threads.reserve(threadCount);
+        while (_threads.size() < threadCount)
+        {
+            _threads.emplace_back(&ThreadPool::workerLoop, this);
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        LOG_WARN("Started {} of {} batch verification threads: {}", _threads.size(), threadCount, ex.what());
+    }
+}
+
+void ThreadPool::workerLoop()
+{
+    for (;;)
+    {
+        Job job{};
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _jobAvailable.wait(lock, [&]() { return _stopping || !_jobs.empty(); });
+            if (_jobs.empty())
+            {
+                return;
+            }
+            job = _jobs.front();
+            _jobs.pop_front();
+        }
+
+        (*job.task)();
+
+        std::lock_guard<std::mutex> lock(job.completion->mutex);
+        if (--job.completion->pending == 0)
+        {
+            job.completion->finished.notify_all();
+        }
+    }
+}
+
+}}} // namespace intel { namespace sgx { namespace dcap {
+
+#endif // SGX_TRUSTED
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef INTEL_SGX_QVL_THREAD_POOL_H_
+#define INTEL_SGX_QVL_THREAD_POOL_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace intel { namespace sgx { namespace dcap {
+
+/**
+ * Resident worker threads for batch verification, not available inside an SGX Enclave.
+ * Threads are started on first use, grow to the largest number requested so far but never above maxThreads,
+ * and stay blocked on a condition variable between calls, so bursts of batches do not pay for thread start-up.
+ * They are joined when the pool is destroyed.
+ */
+class ThreadPool
+{
+public:
+    /**
+     * Pool shared by batch verification calls, limited to one thread less than hardware threads as the calling
+     * thread is also a worker. It is never destroyed: joining threads from a static destructor would deadlock
+     * under the loader lock on Windows, so its idle threads end together with the process.
+     */
+    static ThreadPool& instance();
+
+    explicit ThreadPool(size_t maxThreads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Calls task on the calling thread and on up to helperCount pool threads, returns when every call finished.
+     * helperCount is limited to maxThreads.
+     * Calls that have not started when the calling thread finishes its own are dropped, so task has to be
+     * a worker that takes items from shared state until there are none left. task must not throw.
+     * If threads can not be started, the ones already running are used.
+     * @return number of pool threads task was queued for
+     */
+    size_t run(size_t helperCount, const std::function<void()>& task);
+
+    /**
+     * @return number of resident threads
+     */
+    size_t size() const;
+
+private:
+    struct Completion
+    {
+        std::mutex mutex;
+        std::condition_variable finished;
+        size_t pending = 0;
+    };
+
+    struct Job
+    {
+        const std::function<void()>* task;
+        Completion* completion;
+    };
+
+    void grow(size_t threadCount);
+    void workerLoop();
+
+    mutable std::mutex _mutex;
+    std::condition_variable _jobAvailable;
+    std::deque<Job> _jobs;
+    std::vector<std::thread> _threads;
+    const size_t _maxThreads;
+    bool _stopping = false;
+};
+
+}}} // namespace intel { namespace sgx { namespace dcap {
+
+#endif // INTEL_SGX_QVL_THREAD_POOL_H_
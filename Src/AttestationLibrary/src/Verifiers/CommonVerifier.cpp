@@ -34,7 +34,7 @@
 #include "Utils/Logger.h"
 
 #include <OpensslHelpers/SignatureVerification.h>
-#include <OpensslHelpers/KeyUtils.h>
+#include <OpensslHelpers/PublicKeyCache.h>
 
 #include <algorithm>
 
@@ -115,7 +115,7 @@ bool CommonVerifier::checkSignature(const pckparser::CrlStore &crl, const dcap::
 
 bool CommonVerifier::checkSha256EcdsaSignature(const Bytes &signature, const std::vector<uint8_t> &message,
                                                const std::vector<uint8_t> &publicKey) const {
-    auto pubKey = crypto::rawToP256PubKey(publicKey);
+    const auto pubKey = crypto::PublicKeyCache::instance().get(publicKey);
     if (pubKey == nullptr)
     {
         LOG_ERROR("Parsing publickey failed: {}", publicKey);
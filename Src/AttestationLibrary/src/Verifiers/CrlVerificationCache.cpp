@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "CrlVerificationCache.h"
+
+#include <cstring>
+
+namespace intel { namespace sgx { namespace dcap {
+
+constexpr size_t CrlVerificationCache::DEFAULT_CAPACITY;
+
+CrlVerificationCache& CrlVerificationCache::instance()
+{
+    static CrlVerificationCache cache;
+    return cache;
+}
+
+size_t CrlVerificationCache::KeyHash::operator()(const Key& key) const
+{
+    // digests are uniformly distributed, their first bytes are good enough as a hash
+    size_t crlHash = 0;
+    size_t issuerHash = 0;
+    std::memcpy(&crlHash, key.crl.data(), sizeof(crlHash));
+    std::memcpy(&issuerHash, key.issuer.data(), sizeof(issuerHash));
+    return crlHash ^ issuerHash;
+}
+
+bool CrlVerificationCache::contains(const Key& key, time_t currentTime)
+{
+    time_t nextUpdate = 0;
+    return _cache.get(key, nextUpdate, [currentTime](time_t entryNextUpdate) { return currentTime <= entryNextUpdate; });
+}
+
+void CrlVerificationCache::insert(const Key& key, time_t nextUpdate)
+{
+    _cache.put(key, nextUpdate);
+}
+
+void CrlVerificationCache::setCapacity(size_t capacity)
+{
+    _cache.setCapacity(capacity);
+}
+
+size_t CrlVerificationCache::size() const
+{
+    return _cache.size();
+}
+
+}}} // namespace intel { namespace sgx { namespace dcap {
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef INTEL_SGX_QVL_CRL_VERIFICATION_CACHE_H_
+#define INTEL_SGX_QVL_CRL_VERIFICATION_CACHE_H_
+
+#include "OpensslHelpers/DigestUtils.h"
+#include "Utils/LruCache.h"
+
+#include <ctime>
+
+namespace intel { namespace sgx { namespace dcap {
+
+/**
+ * Process wide, bounded LRU set of CRLs that passed PckCrlVerifier checks against given issuer certificate.
+ * Entries are keyed by SHA-256 of CRL DER and SHA-256 fingerprint of the issuer and expire after CRL nextUpdate.
+ * Only successful verifications are stored, failures are always recomputed so their Status stays the same.
+ */
+class CrlVerificationCache
+{
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 64;
+
+    struct Key
+    {
+        crypto::Sha256Digest crl;
+        crypto::Sha256Digest issuer;
+
+        bool operator==(const Key& other) const
+        {
+            return crl == other.crl && issuer == other.issuer;
+        }
+    };
+
+    static CrlVerificationCache& instance();
+
+    /**
+     * @return true if CRL was verified against issuer and its nextUpdate is not before currentTime.
+     * Expired entry is removed.
+     */
+    bool contains(const Key& key, time_t currentTime);
+    void insert(const Key& key, time_t nextUpdate);
+
+    /**
+     * Sets maximum number of cached verifications and clears the cache. 0 disables caching.
+     */
+    void setCapacity(size_t capacity);
+    size_t size() const;
+
+private:
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const;
+    };
+
+    CrlVerificationCache() = default;
+
+    // nextUpdate of each verified CRL
+    LruCache<Key, time_t, KeyHash> _cache{DEFAULT_CAPACITY};
+};
+
+}}} // namespace intel { namespace sgx { namespace dcap {
+
+#endif // INTEL_SGX_QVL_CRL_VERIFICATION_CACHE_H_
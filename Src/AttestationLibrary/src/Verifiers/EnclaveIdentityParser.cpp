@@ -33,6 +33,7 @@
 #include <OpensslHelpers/Bytes.h>
 #include "EnclaveIdentityParser.h"
 #include "EnclaveIdentityV2.h"
+#include "Utils/JsonText.h"
 #include "Utils/Logger.h"
 
 #include <tuple>
@@ -42,9 +43,14 @@ namespace intel { namespace sgx { namespace dcap {
 
     std::unique_ptr<dcap::EnclaveIdentityV2> EnclaveIdentityParser::parse(const std::string &input)
     {
-        if (!jsonParser.parse(input))
+        return parse(input.data(), input.size());
+    }
+
+    std::unique_ptr<dcap::EnclaveIdentityV2> EnclaveIdentityParser::parse(const char *input, size_t length)
+    {
+        if (!jsonParser.parse(input, length))
         {
-            LOG_ERROR("Enclave Identity format error. Enclave Identity: {}", input);
+            LOG_ERROR("Enclave Identity format error. Enclave Identity: {}", std::string(input, length));
             throw ParserException(STATUS_SGX_ENCLAVE_IDENTITY_UNSUPPORTED_FORMAT);
         }
 
@@ -58,7 +64,7 @@ namespace intel { namespace sgx { namespace dcap {
 
         if (signature == nullptr)
         {
-            LOG_ERROR("Enclave Identity format error. Enclave Identity: {}", input);
+            LOG_ERROR("Enclave Identity format error. Enclave Identity: {}", std::string(input, length));
             throw ParserException(STATUS_SGX_ENCLAVE_IDENTITY_UNSUPPORTED_FORMAT);
         }
 
@@ -100,7 +106,11 @@ namespace intel { namespace sgx { namespace dcap {
         {
             case EnclaveIdentityV2::V2:
             {
-                std::unique_ptr<dcap::EnclaveIdentityV2> identity = std::unique_ptr<dcap::EnclaveIdentityV2>(new EnclaveIdentityV2(*identityField)); // TODO make std::make_unique work in SGX enclave
+                // signed body is taken from the input as is when it's already compact
+                const char* bodyText = nullptr;
+                size_t bodyTextLength = 0;
+                const bool compactBody = findCompactJsonMember(input, length, "enclaveIdentity", bodyText, bodyTextLength);
+                std::unique_ptr<dcap::EnclaveIdentityV2> identity = std::unique_ptr<dcap::EnclaveIdentityV2>(new EnclaveIdentityV2(*identityField, compactBody ? bodyText : nullptr, bodyTextLength)); // TODO make std::make_unique work in SGX enclave
                 if (identity->getStatus() != STATUS_OK)
                 {
                     LOG_ERROR("EnclaveIdentityV2 parsing error: {}", identity->getStatus());
@@ -42,6 +42,7 @@ namespace intel { namespace sgx { namespace dcap {
     {
     public:
         std::unique_ptr<dcap::EnclaveIdentityV2> parse(const std::string &input);
+        std::unique_ptr<dcap::EnclaveIdentityV2> parse(const char *input, size_t length);
     protected:
         JsonParser jsonParser;
     };
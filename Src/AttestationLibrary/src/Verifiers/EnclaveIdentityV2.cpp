@@ -42,6 +42,11 @@
 
 namespace intel { namespace sgx { namespace dcap {
     EnclaveIdentityV2::EnclaveIdentityV2(const ::rapidjson::Value &p_body)
+            : EnclaveIdentityV2(p_body, nullptr, 0)
+    {
+    }
+
+    EnclaveIdentityV2::EnclaveIdentityV2(const ::rapidjson::Value &p_body, const char *p_bodyText, size_t p_bodyTextLength)
             : tcbEvaluationDataNumber(0)
     {
         if(!p_body.IsObject())
@@ -64,11 +69,18 @@ namespace intel { namespace sgx { namespace dcap {
             return;
         }
 
-        rapidjson::StringBuffer buffer;
-        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-        p_body.Accept(writer);
+        if (p_bodyText != nullptr)
+        {
+            this->body = std::vector<uint8_t>{p_bodyText, p_bodyText + p_bodyTextLength};
+        }
+        else
+        {
+            rapidjson::StringBuffer buffer;
+            rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+            p_body.Accept(writer);
 
-        this->body = std::vector<uint8_t>{buffer.GetString(), &buffer.GetString()[buffer.GetSize()]};
+            this->body = std::vector<uint8_t>{buffer.GetString(), &buffer.GetString()[buffer.GetSize()]};
+        }
         status = STATUS_OK;
     }
     void EnclaveIdentityV2::setSignature(std::vector<uint8_t> &p_signature)
@@ -257,12 +269,13 @@ namespace intel { namespace sgx { namespace dcap {
 
     bool EnclaveIdentityV2::parseTcbLevels(const rapidjson::Value &input)
     {
-        if (!input.HasMember("tcbLevels"))
+        const auto tcbLevelsMember = input.FindMember("tcbLevels");
+        if (tcbLevelsMember == input.MemberEnd())
         {
             return false;
         }
 
-        const ::rapidjson::Value& l_tcbLevels = input["tcbLevels"];
+        const ::rapidjson::Value& l_tcbLevels = tcbLevelsMember->value;
 
         if (!l_tcbLevels.IsArray() || l_tcbLevels.Empty()) // must be a non empty array
         {
@@ -287,12 +300,13 @@ namespace intel { namespace sgx { namespace dcap {
                 return false;
             }
 
-            if (!(*itr).HasMember("tcb"))
+            const auto tcbMember = itr->FindMember("tcb");
+            if (tcbMember == itr->MemberEnd())
             {
                 return false;
             }
 
-            const ::rapidjson::Value& tcb = (*itr)["tcb"];
+            const ::rapidjson::Value& tcb = tcbMember->value;
 
             if (!tcb.IsObject())
             {
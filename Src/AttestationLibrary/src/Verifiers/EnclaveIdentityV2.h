@@ -76,6 +76,8 @@ namespace intel { namespace sgx { namespace dcap {
         };
 
         explicit EnclaveIdentityV2(const ::rapidjson::Value &p_body);
+        /// p_bodyText is the compact text p_body was parsed from, it becomes the signed body without serializing p_body
+        EnclaveIdentityV2(const ::rapidjson::Value &p_body, const char *p_bodyText, size_t p_bodyTextLength);
         virtual ~EnclaveIdentityV2() = default;
 
         virtual void setSignature(std::vector<uint8_t> &p_signature);
@@ -30,24 +30,55 @@
  */
 
 #include "PckCrlVerifier.h"
+#include "CrlVerificationCache.h"
 #include "Utils/Logger.h"
+#include "Utils/TimeUtils.h"
 
 #include <CertVerification/X509Constants.h>
 #include <OpensslHelpers/SignatureVerification.h>
 
 namespace intel { namespace sgx { namespace dcap {
 
-PckCrlVerifier::PckCrlVerifier() : _commonVerifier(new CommonVerifier())
+namespace {
+
+bool makeCacheKey(const pckparser::CrlStore &crl, const dcap::parser::x509::Certificate &cert,
+                  CrlVerificationCache::Key& key)
+{
+    const auto& info = cert.getInfo();
+    const auto& signature = cert.getSignature().getRawDer();
+    return crl.getDerDigest(key.crl) && !info.empty()
+           && crypto::sha256Digest({ByteRange(info), ByteRange(signature)}, key.issuer);
+}
+
+} // anonymous namespace
+
+PckCrlVerifier::PckCrlVerifier()
+    : _commonVerifier(new CommonVerifier()),
+#ifdef SGX_TRUSTED
+      // there is no clock in enclave to expire memoized results at CRL nextUpdate
+      _memoize(false)
+#else
+      _memoize(true)
+#endif
 {
 }
 
 PckCrlVerifier::PckCrlVerifier(std::unique_ptr<CommonVerifier>&& commonVerifier)
-    : _commonVerifier(std::move(commonVerifier))
+    : _commonVerifier(std::move(commonVerifier)),
+      _memoize(false)
 {
 }
 
 Status PckCrlVerifier::verify(const pckparser::CrlStore &crl, const dcap::parser::x509::Certificate &cert) const
 {
+    // outcome depends only on CRL and issuer content, so only their successful verification is remembered
+    CrlVerificationCache::Key key;
+    const auto memoize = _memoize && makeCacheKey(crl, cert, key);
+    if(memoize && CrlVerificationCache::instance().contains(key, getCurrentTime(nullptr)))
+    {
+        return STATUS_OK;
+    }
+
     const auto &crlIssuer = crl.getIssuer();
     const auto &certSubject = cert.getSubject();
     // this will have to go when CRLs get new parser
@@ -74,6 +105,10 @@ Status PckCrlVerifier::verify(const pckparser::CrlStore &crl, const dcap::parser
         return STATUS_SGX_CRL_INVALID_SIGNATURE;
     }
 
+    if(memoize)
+    {
+        CrlVerificationCache::instance().insert(key, crl.getValidity().notAfterTime);
+    }
     return STATUS_OK;
 }
 
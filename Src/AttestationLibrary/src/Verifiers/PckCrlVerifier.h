@@ -41,8 +41,14 @@ namespace intel { namespace sgx { namespace dcap {
 class PckCrlVerifier
 {
 public:
+    /**
+     * Results of verify(crl, crlIssuer) are not memoized, checks are always done by given commonVerifier.
+     */
     PckCrlVerifier(std::unique_ptr<CommonVerifier>&& commonVerifier);
 
+    /**
+     * Successful verify(crl, crlIssuer) results are memoized in CrlVerificationCache until CRL nextUpdate.
+     */
     PckCrlVerifier();
     PckCrlVerifier(const PckCrlVerifier&) = delete;
     PckCrlVerifier(PckCrlVerifier&&) = delete;
@@ -72,6 +78,7 @@ public:
 private:
     std::unique_ptr<CommonVerifier> _commonVerifier;
     BaseVerifier _baseVerifier;
+    bool _memoize;
 };
 
 }}} // namespace intel { namespace sgx { namespace dcap {
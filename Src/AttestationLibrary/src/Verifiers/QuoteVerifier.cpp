@@ -34,12 +34,13 @@
 #include "Utils/RuntimeException.h"
 
 #include <algorithm>
+#include <array>
 #include <functional>
 
 #include <CertVerification/X509Constants.h>
 #include <QuoteVerification/QuoteConstants.h>
 #include <OpensslHelpers/DigestUtils.h>
-#include <OpensslHelpers/KeyUtils.h>
+#include <OpensslHelpers/PublicKeyCache.h>
 #include <OpensslHelpers/SignatureVerification.h>
 #include <OpensslHelpers/Bytes.h>
 #include <Verifiers/PckCertVerifier.h>
@@ -49,79 +50,43 @@ namespace intel { namespace sgx { namespace dcap {
 
 namespace {
 
-constexpr int CPUSVN_LOWER = false;
-constexpr int CPUSVN_EQUAL_OR_HIGHER = true;
-
-bool isCpuSvnHigherOrEqual(const dcap::parser::x509::PckCertificate& pckCert,
-                           const dcap::parser::json::TcbLevel& tcbLevel)
+struct TcbStatusMapping
 {
-    for(uint32_t index = 0; index < constants::CPUSVN_BYTE_LEN; ++index)
-    {
-        const auto componentValue = pckCert.getTcb().getSgxTcbComponentSvn(index);
-        const auto otherComponentValue = tcbLevel.getSgxTcbComponentSvn(index);
-        if(componentValue < otherComponentValue)
-        {
-            // If *ANY* CPUSVN component is lower then CPUSVN is considered lower
-            return CPUSVN_LOWER;
-        }
-    }
-    // but for CPUSVN to be considered higher it requires that *EVERY* CPUSVN component to be higher or equal
-    return CPUSVN_EQUAL_OR_HIGHER;
+    Status status;
+    Status statusWhenQeOutOfDate;
+};
+
+/// Indexed by parser::json::TcbStatus
+constexpr TcbStatusMapping TCB_STATUS_MAPPINGS[] = {
+    /* UpToDate */                          {STATUS_OK, STATUS_TCB_OUT_OF_DATE},
+    /* SWHardeningNeeded */                 {STATUS_TCB_SW_HARDENING_NEEDED, STATUS_TCB_OUT_OF_DATE},
+    /* ConfigurationNeeded */               {STATUS_TCB_CONFIGURATION_NEEDED, STATUS_TCB_OUT_OF_DATE_CONFIGURATION_NEEDED},
+    /* ConfigurationAndSWHardeningNeeded */ {STATUS_TCB_CONFIGURATION_AND_SW_HARDENING_NEEDED, STATUS_TCB_OUT_OF_DATE_CONFIGURATION_NEEDED},
+    /* OutOfDate */                         {STATUS_TCB_OUT_OF_DATE, STATUS_TCB_OUT_OF_DATE},
+    /* OutOfDateConfigurationNeeded */      {STATUS_TCB_OUT_OF_DATE_CONFIGURATION_NEEDED, STATUS_TCB_OUT_OF_DATE_CONFIGURATION_NEEDED},
+    /* Revoked */                           {STATUS_TCB_REVOKED, STATUS_TCB_REVOKED},
+    /* Unrecognized */                      {STATUS_TCB_UNRECOGNIZED_STATUS, STATUS_TCB_UNRECOGNIZED_STATUS}
+};
+
+static_assert(sizeof(TCB_STATUS_MAPPINGS) / sizeof(TCB_STATUS_MAPPINGS[0]) ==
+              static_cast<size_t>(parser::json::TcbStatus::Unrecognized) + 1, "every TcbStatus needs a mapping");
+
+const TcbStatusMapping& tcbStatusMapping(parser::json::TcbStatus tcbStatus)
+{
+    return TCB_STATUS_MAPPINGS[static_cast<size_t>(tcbStatus)];
 }
 
-bool isTdxTcbHigherOrEqual(const dcap::quote::TDReport& tdReport,
-                           const dcap::parser::json::TcbLevel& tcbLevel)
+/// Maps selected TCB Level to status
+Status evaluateTcbLevel(const dcap::parser::json::TcbInfo& tcbInfoJson, const dcap::parser::json::TcbLevel* selectedTcbLevel,
+                        const dcap::parser::x509::PckCertificate& pckCert, const Quote& quote)
 {
-    for(uint32_t index = 0; index < constants::CPUSVN_BYTE_LEN; ++index)
+    if (selectedTcbLevel == nullptr)
     {
-        const auto componentValue = tdReport.teeTcbSvn[index];
-        const auto otherComponentValue = tcbLevel.getTdxTcbComponent(index);
-        if(componentValue < otherComponentValue.getSvn())
-        {
-            // If *ANY* SVN is lower then TCB level is considered lower
-            return false;
-        }
+        /// 4.1.2.4.17.3
+        LOG_ERROR("TCB Level has not been selected");
+        return STATUS_TCB_NOT_SUPPORTED;
     }
-    // but for TCB level to be considered higher it requires *EVERY* SVN to be higher or equal
-    return true;
-}
-const parser::json::TcbLevel& getMatchingTcbLevel(const dcap::parser::json::TcbInfo &tcbInfo,
-                                       const dcap::parser::x509::PckCertificate &pckCert,
-                                       const Quote &quote)
-{
-    const auto &tcbs = tcbInfo.getTcbLevels();
-    const auto certPceSvn = pckCert.getTcb().getPceSvn();
-
-    for (const auto& tcb : tcbs)
-    {
-        if(isCpuSvnHigherOrEqual(pckCert, tcb) && certPceSvn >= tcb.getPceSvn())
-        {
-            if (tcbInfo.getVersion() >= 3 &&
-                tcbInfo.getId() == parser::json::TcbInfo::TDX_ID &&
-                quote.getHeader().teeType == constants::TEE_TYPE_TDX)
-            {
-                if (isTdxTcbHigherOrEqual(quote.getTdReport(), tcb))
-                {
-                    return tcb;
-                }
-            }
-            else
-            {
-                return tcb;
-            }
-        }
-    }
-
-    /// 4.1.2.4.17.3
-    LOG_ERROR("TCB Level has not been selected");
-    throw RuntimeException(STATUS_TCB_NOT_SUPPORTED);
-}
-
-Status checkTcbLevel(const dcap::parser::json::TcbInfo& tcbInfoJson, const dcap::parser::x509::PckCertificate& pckCert,
-        const Quote& quote)
-{
-    /// 4.1.2.4.17.1 & 4.1.2.4.17.2
-    const auto& tcbLevel = getMatchingTcbLevel(tcbInfoJson, pckCert, quote);
+    const auto& tcbLevel = *selectedTcbLevel;
 
     if (tcbInfoJson.getVersion() >= 3 && tcbInfoJson.getId() == parser::json::TcbInfo::TDX_ID
         && tcbLevel.getTdxTcbComponent(1).getSvn() != quote.getTdReport().teeTcbSvn[1])
@@ -132,8 +97,6 @@ Status checkTcbLevel(const dcap::parser::json::TcbInfo& tcbInfoJson, const dcap:
         return STATUS_TCB_INFO_MISMATCH;
     }
 
-    const auto& tcbLevelStatus = tcbLevel.getStatus();
-
     const auto pckTcb = pckCert.getTcb();
     if(tcbInfoJson.getVersion() >= 3 && tcbInfoJson.getId() == parser::json::TcbInfo::TDX_ID)
     {
@@ -150,7 +113,7 @@ Status checkTcbLevel(const dcap::parser::json::TcbInfo& tcbInfoJson, const dcap:
                  bytesToHexString(tcbLevel.getCpuSvn()),
                  bytesToHexString(tdxTcbComponentsSvnsVec),
                  tcbLevel.getPceSvn(),
-                 tcbLevelStatus,
+                 tcbLevel.getStatus(),
                  bytesToHexString(pckTcb.getCpuSvn()),
                  pckTcb.getPceSvn(),
                  bytesToHexString(std::vector<uint8_t>(begin(quote.getTdReport().teeTcbSvn), end(quote.getTdReport().teeTcbSvn))));
@@ -161,93 +124,78 @@ Status checkTcbLevel(const dcap::parser::json::TcbInfo& tcbInfoJson, const dcap:
                  "PCK TCB - cpuSvn: {}, pceSvn: {}",
                  bytesToHexString(tcbLevel.getCpuSvn()),
                  tcbLevel.getPceSvn(),
-                 tcbLevelStatus,
+                 tcbLevel.getStatus(),
                  bytesToHexString(pckTcb.getCpuSvn()),
                  pckTcb.getPceSvn());
     }
 
-    if (tcbLevelStatus == "OutOfDate")
+    const auto& mapping = tcbStatusMapping(tcbLevel.getTcbStatus());
+    if (mapping.status == STATUS_TCB_OUT_OF_DATE_CONFIGURATION_NEEDED && tcbInfoJson.getVersion() <= 1)
     {
-        LOG_INFO("TCB Level status is \"OutOfDate\"");
-        return STATUS_TCB_OUT_OF_DATE;
+        LOG_ERROR("TCB Level error status is unrecognized");
+        return STATUS_TCB_UNRECOGNIZED_STATUS;
     }
-
-    if (tcbLevelStatus == "Revoked")
+    if (mapping.status == STATUS_TCB_UNRECOGNIZED_STATUS)
     {
-        LOG_INFO("TCB Level status is \"Revoked\"");
-        return STATUS_TCB_REVOKED;
+        LOG_ERROR("TCB Level error status is unrecognized");
     }
-
-    if (tcbLevelStatus == "ConfigurationNeeded")
+    else if (mapping.status != STATUS_OK)
     {
-        LOG_INFO("TCB Level status is \"ConfigurationNeeded\"");
-        return STATUS_TCB_CONFIGURATION_NEEDED;
+        LOG_INFO("TCB Level status is \"{}\"", tcbLevel.getStatus());
     }
+    return mapping.status;
+}
 
-    if (tcbLevelStatus == "ConfigurationAndSWHardeningNeeded")
+Status checkTcbLevel(const dcap::parser::json::TcbInfo& tcbInfoJson, const dcap::parser::x509::PckCertificate& pckCert,
+        const Quote& quote)
+{
+    const auto& pckTcb = pckCert.getTcb();
+    std::array<uint8_t, constants::CPUSVN_BYTE_LEN> sgxTcbComponentSvns{};
+    for (uint32_t index = 0; index < constants::CPUSVN_BYTE_LEN; ++index)
     {
-        LOG_INFO("TCB Level status is \"ConfigurationAndSWHardeningNeeded\"");
-        return STATUS_TCB_CONFIGURATION_AND_SW_HARDENING_NEEDED;
+        sgxTcbComponentSvns[index] = static_cast<uint8_t>(pckTcb.getSgxTcbComponentSvn(index));
     }
 
-    if (tcbLevelStatus == "UpToDate")
-    {
-        return STATUS_OK;
-    }
+    /// 4.1.2.4.17.1 & 4.1.2.4.17.2
+    // For TDX, every TEE TCB SVN has to be higher or equal too
+    const auto isTdxTcbInfo = tcbInfoJson.getVersion() >= 3 && tcbInfoJson.getId() == parser::json::TcbInfo::TDX_ID;
+    const auto compareTdx = isTdxTcbInfo && quote.getHeader().teeType == constants::TEE_TYPE_TDX;
 
-    if (tcbLevelStatus == "SWHardeningNeeded")
-    {
-        LOG_INFO("TCB Level status is \"SWHardeningNeeded\"");
-        return STATUS_TCB_SW_HARDENING_NEEDED;
-    }
+    // Platforms repeat across quotes, so level selection is memoized per TcbInfo, status is mapped and logged every time
+    const auto status = tcbInfoJson.evaluateTcbLevel(
+            sgxTcbComponentSvns.data(), pckTcb.getPceSvn(), compareTdx ? quote.getTdReport().teeTcbSvn.data() : nullptr,
+            [&](const dcap::parser::json::TcbLevel* tcbLevel) {
+                return evaluateTcbLevel(tcbInfoJson, tcbLevel, pckCert, quote);
+            });
 
-    if(tcbInfoJson.getVersion() > 1 && tcbLevelStatus == "OutOfDateConfigurationNeeded")
+    if (status == STATUS_TCB_NOT_SUPPORTED || status == STATUS_TCB_UNRECOGNIZED_STATUS)
     {
-        LOG_INFO("TCB Level status is \"OutOfDateConfigurationNeeded\"");
-        return STATUS_TCB_OUT_OF_DATE_CONFIGURATION_NEEDED;
+        throw RuntimeException(status);
     }
-
-    LOG_ERROR("TCB Level error status is unrecognized");
-    throw RuntimeException(STATUS_TCB_UNRECOGNIZED_STATUS);
+    return status;
 }
 
 Status convergeTcbStatus(Status tcbLevelStatus, Status qeTcbStatus)
 {
-    if (qeTcbStatus == STATUS_SGX_ENCLAVE_REPORT_ISVSVN_OUT_OF_DATE)
+    const auto mapping = std::find_if(std::begin(TCB_STATUS_MAPPINGS), std::end(TCB_STATUS_MAPPINGS),
+                                      [tcbLevelStatus](const TcbStatusMapping& entry) { return entry.status == tcbLevelStatus; });
+    if (qeTcbStatus == STATUS_SGX_ENCLAVE_REPORT_ISVSVN_OUT_OF_DATE && mapping != std::end(TCB_STATUS_MAPPINGS))
     {
         LOG_INFO("QE TCB status is \"OutOfDate\" and TCB Level status is \"{}\"",
                   tcbLevelStatus);
-        if (tcbLevelStatus == STATUS_OK ||
-            tcbLevelStatus == STATUS_TCB_SW_HARDENING_NEEDED)
-        {
-            return STATUS_TCB_OUT_OF_DATE;
-        }
-        if (tcbLevelStatus == STATUS_TCB_CONFIGURATION_NEEDED ||
-            tcbLevelStatus == STATUS_TCB_CONFIGURATION_AND_SW_HARDENING_NEEDED)
-        {
-            return STATUS_TCB_OUT_OF_DATE_CONFIGURATION_NEEDED;
-        }
+        return mapping->statusWhenQeOutOfDate;
     }
     if (qeTcbStatus == STATUS_SGX_ENCLAVE_REPORT_ISVSVN_REVOKED)
     {
             LOG_INFO("QE TCB status is \"Revoked\"");
             return STATUS_TCB_REVOKED;
     }
-
-    switch (tcbLevelStatus)
+    if (mapping == std::end(TCB_STATUS_MAPPINGS))
     {
-        case STATUS_TCB_OUT_OF_DATE:
-        case STATUS_TCB_REVOKED:
-        case STATUS_TCB_CONFIGURATION_NEEDED:
-        case STATUS_TCB_OUT_OF_DATE_CONFIGURATION_NEEDED:
-        case STATUS_TCB_SW_HARDENING_NEEDED:
-        case STATUS_TCB_CONFIGURATION_AND_SW_HARDENING_NEEDED:
-        case STATUS_OK:
-            return tcbLevelStatus;
-        default:
-            /// 4.1.2.4.16.4
-            return STATUS_TCB_UNRECOGNIZED_STATUS;
+        /// 4.1.2.4.16.4
+        return STATUS_TCB_UNRECOGNIZED_STATUS;
     }
+    return mapping->status;
 }
 
 }//anonymous namespace
@@ -334,7 +282,7 @@ Status QuoteVerifier::verify(const Quote& quote,
         return certificationDataVerificationStatus;
     }
 
-    auto pubKey = crypto::rawToP256PubKey(pckCert.getPubKey());
+    const auto pubKey = crypto::PublicKeyCache::instance().get(pckCert.getPubKey());
     if (pubKey == nullptr)
     {
         LOG_ERROR("Public key parsing error. PCK Certificate is invalid");
@@ -379,7 +327,7 @@ Status QuoteVerifier::verify(const Quote& quote,
     }
 
     /// 4.1.2.4.12
-    if (!crypto::verifySha256EcdsaSignature(quote.getQeReportSignature(), quote.getQeReport().rawBlob(), *pubKey))
+    if (!crypto::verifyRawEcdsaSignature(quote.getQeReportSignature(), quote.getQeReportDigest(), *pubKey))
     {
         LOG_ERROR("QE Report Signature extracted from quote ({}) cannot be verified with the Public Key extracted from PCK Certificate ({})",
                   bytesToHexString(std::vector<uint8_t>(begin(quote.getQeReportSignature()), end(quote.getQeReportSignature()))),
@@ -388,23 +336,15 @@ Status QuoteVerifier::verify(const Quote& quote,
     }
 
     /// 4.1.2.4.13
-    const auto hashedConcatOfAttestKeyAndQeReportData = [&]() -> std::vector<uint8_t>
-    {
-        std::vector<uint8_t> ret;
-        ret.reserve(quote.getAttestKeyData().size() + quote.getQeAuthData().size());
-        std::copy(quote.getAttestKeyData().begin(), quote.getAttestKeyData().end(), std::back_inserter(ret));
-        std::copy(quote.getQeAuthData().begin(), quote.getQeAuthData().end(), std::back_inserter(ret));
-
-        return crypto::sha256Digest(ret);
-    }();
-
-    if(hashedConcatOfAttestKeyAndQeReportData.empty() || !std::equal(hashedConcatOfAttestKeyAndQeReportData.begin(),
-                                                                     hashedConcatOfAttestKeyAndQeReportData.end(),
-                                                                     quote.getQeReport().reportData.begin()))
+    crypto::Sha256Digest hashedConcatOfAttestKeyAndQeReportData{};
+    if(!crypto::sha256Digest({quote.getAttestKeyData(), quote.getQeAuthData()}, hashedConcatOfAttestKeyAndQeReportData) ||
+       !std::equal(hashedConcatOfAttestKeyAndQeReportData.begin(),
+                   hashedConcatOfAttestKeyAndQeReportData.end(),
+                   quote.getQeReport().reportData.begin()))
     {
         LOG_ERROR("Report Data value extracted from QE Report in Quote ({}) and the value of SHA256 calculated over the concatenation of ECDSA Attestation Key and QE Authenticated Data extracted from Quote ({}) are not the same",
                   bytesToHexString(std::vector<uint8_t>(begin(quote.getQeReport().reportData), end(quote.getQeReport().reportData))),
-                  bytesToHexString(hashedConcatOfAttestKeyAndQeReportData));
+                  bytesToHexString(std::vector<uint8_t>(begin(hashedConcatOfAttestKeyAndQeReportData), end(hashedConcatOfAttestKeyAndQeReportData))));
         return STATUS_INVALID_QE_REPORT_DATA;
     }
 
@@ -462,16 +402,14 @@ Status QuoteVerifier::verify(const Quote& quote,
         }
     }
 
-    const auto attestKey = crypto::rawToP256PubKey(quote.getAttestKeyData());
+    const auto attestKey = crypto::PublicKeyCache::convert(quote.getAttestKeyData());
     if(!attestKey)
     {
         return STATUS_UNSUPPORTED_QUOTE_FORMAT;
     }
 
     /// 4.1.2.4.16
-    if (!crypto::verifySha256EcdsaSignature(quote.getQuoteSignature(),
-                                            quote.getSignedData(),
-                                            *attestKey))
+    if (!crypto::verifyRawEcdsaSignature(quote.getQuoteSignature(), quote.getSignedDataDigest(), *attestKey))
     {
         LOG_ERROR("Quote Signature ({}) cannot be verified with ECDSA Attestation Key ({})",
                   bytesToHexString(std::vector<uint8_t>(begin(quote.getQuoteSignature()), end(quote.getQuoteSignature()))),
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <SgxEcdsaAttestation/AttestationParsers.h>
+#include <X509TestConstants.h>
+#include <X509CertGenerator.h>
+#include <BenchmarkUtils.h>
+
+#include <gtest/gtest.h>
+
+using namespace intel::sgx::dcap;
+using namespace intel::sgx::dcap::parser;
+using intel::sgx::dcap::test::nsPerCall;
+
+struct CertificateBenchmark : public testing::Test
+{
+    parser::test::X509CertGenerator certGenerator;
+    std::string pemPckCert;
+
+    CertificateBenchmark()
+    {
+        const auto keyInt = certGenerator.generateEcKeypair();
+        const auto key = certGenerator.generateEcKeypair();
+        const auto cert = certGenerator.generatePCKCert(2, {0x40, 0x66, 0xB0, 0x01}, 0, 3600, key.get(), keyInt.get(),
+                                                        constants::PCK_SUBJECT, constants::PLATFORM_CA_SUBJECT,
+                                                        Bytes(16, 0xaa), Bytes(16, 0x09), {0x03, 0xf2}, {0x04, 0xf3},
+                                                        {0x05, 0xf4, 0x44, 0x45, 0xaa, 0x00}, 0);
+        pemPckCert = certGenerator.x509ToString(cert.get());
+    }
+};
+
+TEST_F(CertificateBenchmark, pckCertificateParse)
+{
+    constexpr size_t iterations = 1000;
+
+    const auto parseOnlyNs = nsPerCall(iterations, [&]() {
+        const auto certificate = x509::Certificate::parse(pemPckCert);
+        ASSERT_FALSE(certificate.getPubKey().empty());
+    });
+
+    const auto parseAndAccessAllNs = nsPerCall(iterations, [&]() {
+        const auto certificate = x509::Certificate::parse(pemPckCert);
+        ASSERT_FALSE(certificate.getInfo().empty());
+        ASSERT_FALSE(certificate.getSubject().getRaw().empty());
+        ASSERT_FALSE(certificate.getIssuer().getRaw().empty());
+        ASSERT_FALSE(certificate.getSerialNumber().empty());
+        ASSERT_FALSE(certificate.getExtensions().empty());
+    });
+
+    RecordProperty("parseNsPerCertificate", std::to_string(parseOnlyNs));
+    RecordProperty("parseAndAccessAllNsPerCertificate", std::to_string(parseAndAccessAllNs));
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <LegacyTimeConversions.h>
+#include <BenchmarkUtils.h>
+
+#include <gtest/gtest.h>
+
+#include <ctime>
+
+using namespace intel::sgx::dcap;
+using namespace intel::sgx::dcap::test;
+
+TEST(CivilTimeBenchmark, conversionOfCollateralDates)
+{
+    const std::string date = "2021-08-06T12:34:56Z";
+    volatile time_t sink = 0;
+    RecordProperty("legacyIsoTimeNs", std::to_string(test::nsPerCall(2000, [&]() {
+        EXPECT_TRUE(legacyIsValidTimeString(date));
+        sink = legacyGetEpochTimeFromString(date);
+    })));
+    RecordProperty("isoTimeNs", std::to_string(test::nsPerCall(1000000, [&]() {
+        struct tm time;
+        time_t epoch = 0;
+        EXPECT_TRUE(parseTimeString(date.data(), date.size(), time, epoch));
+        sink = epoch;
+    })));
+
+    const auto utcTime = makeAsn1Time("210806123456Z", false);
+    RecordProperty("opensslAsn1TimeNs", std::to_string(test::nsPerCall(100000, [&]() {
+        time_t epoch = 0;
+        EXPECT_TRUE(opensslAsn1TimeToEpoch(utcTime.get(), epoch));
+        sink = epoch;
+    })));
+    RecordProperty("asn1TimeNs", std::to_string(test::nsPerCall(1000000, [&]() {
+        time_t epoch = 0;
+        EXPECT_TRUE(newAsn1TimeToEpoch(utcTime.get(), epoch));
+        sink = epoch;
+    })));
+
+    time_t time = 1628253296;
+    RecordProperty("stdGmtimeNs", std::to_string(test::nsPerCall(1000000, [&]() {
+#if defined(_MSC_VER)
+#pragma warning(disable:4996)
+#endif
+        sink = std::gmtime(&time)->tm_mday;
+#if defined(_MSC_VER)
+#pragma warning(default:4996)
+#endif
+    })));
+    RecordProperty("gmtimeNs", std::to_string(test::nsPerCall(1000000, [&]() {
+        sink = standard::gmtime(&time)->tm_mday;
+    })));
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <PckParser/CrlStore.h>
+#include <CertVerification/X509Constants.h>
+#include <X509CertGenerator.h>
+#include <X509CrlGenerator.h>
+#include <BenchmarkUtils.h>
+
+#include <algorithm>
+#include <random>
+
+using namespace testing;
+using namespace intel::sgx::dcap;
+using namespace intel::sgx::dcap::test;
+using namespace intel::sgx::dcap::parser::test;
+
+namespace {
+
+std::vector<Bytes> randomSerialNumbers(size_t count, std::mt19937& generator)
+{
+    std::uniform_int_distribution<int> distribution(0, 255);
+    std::vector<Bytes> serialNumbers(count, Bytes(20));
+    for (auto& serialNumber : serialNumbers)
+    {
+        for (auto& byte : serialNumber)
+        {
+            byte = static_cast<uint8_t>(distribution(generator));
+        }
+        // positive integer without leading zero, so it is stored in CRL and certificate exactly as given
+        serialNumber[0] = static_cast<uint8_t>(serialNumber[0] | 0x01) & 0x7F;
+    }
+    return serialNumbers;
+}
+
+} // anonymous namespace
+
+struct CrlStoreBenchmark : public Test
+{
+    X509CertGenerator certGenerator;
+    X509CrlGenerator crlGenerator;
+    crypto::EVP_PKEY_uptr key = certGenerator.generateEcKeypair();
+    crypto::X509_uptr issuer = certGenerator.generateCaCert(2, {0x01}, 0, 3600, key.get(), key.get(),
+                                                            constants::ROOT_CA_SUBJECT, constants::ROOT_CA_SUBJECT);
+    std::mt19937 generator{1234};
+
+    std::shared_ptr<pckparser::CrlStore> crlWith(const std::vector<Bytes>& revokedSerialNumbers)
+    {
+        const auto crl = crlGenerator.generateCRL(CRLVersion::CRL_VERSION_2, 0, 3600, issuer, revokedSerialNumbers);
+        const auto der = X509CrlGenerator::x509CrlToDER(crl.get());
+        auto crlStore = std::make_shared<pckparser::CrlStore>();
+        EXPECT_TRUE(crlStore->parseDer(der.data(), der.size()));
+        return crlStore;
+    }
+
+    parser::x509::Certificate certificateWith(const Bytes& serialNumber)
+    {
+        const auto cert = certGenerator.generateCaCert(2, serialNumber, 0, 3600, key.get(), key.get(),
+                                                       constants::PLATFORM_CA_SUBJECT, constants::ROOT_CA_SUBJECT);
+        return parser::x509::Certificate::parse(certGenerator.x509ToString(cert.get()));
+    }
+};
+
+TEST_F(CrlStoreBenchmark, isRevoked)
+{
+    const auto notRevokedCert = certificateWith({0x12, 0x34});
+    for (const size_t revokedCount : {size_t{10}, size_t{10000}, size_t{1000000}})
+    {
+        const auto revoked = randomSerialNumbers(revokedCount, generator);
+        const auto crlStore = crlWith(revoked);
+        const auto revokedCert = certificateWith(revoked[revokedCount / 2]);
+
+        const auto indexedNs = nsPerCall(1000, [&]() {
+            ASSERT_TRUE(crlStore->isRevoked(revokedCert));
+            ASSERT_FALSE(crlStore->isRevoked(notRevokedCert));
+        });
+
+        // former lookup, linear scan over revoked entries
+        const auto& entries = crlStore->getRevoked();
+        const auto linearNs = elapsedNs([&]() {
+            EXPECT_TRUE(std::none_of(entries.cbegin(), entries.cend(), [&](const pckparser::Revoked& entry) {
+                return entry.serialNumber == notRevokedCert.getSerialNumber();
+            }));
+        });
+
+        const auto suffix = std::to_string(revokedCount);
+        RecordProperty("indexedNsPerLookup" + suffix, std::to_string(indexedNs / 2));
+        RecordProperty("linearNsPerLookup" + suffix, std::to_string(linearNs));
+    }
+}
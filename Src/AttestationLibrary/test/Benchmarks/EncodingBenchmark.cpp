@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <Utils/Encoding.h>
+#include <OpensslHelpers/Bytes.h>
+#include <BenchmarkUtils.h>
+
+#include <gtest/gtest.h>
+#include <openssl/evp.h>
+
+#include <random>
+
+using namespace intel::sgx::dcap;
+
+namespace {
+
+Bytes randomBytes(size_t size, std::mt19937& generator)
+{
+    std::uniform_int_distribution<int> distribution(0, 255);
+    Bytes bytes(size);
+    for (auto& byte : bytes)
+    {
+        byte = static_cast<uint8_t>(distribution(generator));
+    }
+    return bytes;
+}
+
+std::string toBase64Lines(const Bytes& bytes, size_t lineLength)
+{
+    std::string encoded(4 * ((bytes.size() + 2) / 3) + 1, '\0');
+    const auto length = EVP_EncodeBlock(reinterpret_cast<unsigned char*>(&encoded[0]), bytes.data(), static_cast<int>(bytes.size()));
+    encoded.resize(static_cast<size_t>(length));
+    std::string lines;
+    for (size_t i = 0; i < encoded.size(); i += lineLength)
+    {
+        lines += encoded.substr(i, lineLength) + "\n";
+    }
+    return lines;
+}
+
+const char* implementationName(CodecImplementation implementation)
+{
+    switch (implementation)
+    {
+        case CodecImplementation::SCALAR:
+            return "scalar";
+        case CodecImplementation::SSE4:
+            return "sse4";
+        case CodecImplementation::AVX2:
+            return "avx2";
+    }
+    return "";
+}
+
+const std::vector<CodecImplementation> ALL_IMPLEMENTATIONS = {
+    CodecImplementation::SCALAR, CodecImplementation::SSE4, CodecImplementation::AVX2
+};
+
+} // anonymous namespace
+
+// Sizes follow collateral: PCK CRL with a few thousand revoked serials passed as hex encoded DER,
+// TCB Info signature and PCK certificate / CRL PEM bodies
+TEST(EncodingBenchmark, decodingOfCollateralSizedInputs)
+{
+    std::mt19937 generator(1234);
+    const auto crl = randomBytes(64 * 1024, generator);
+    const auto crlHex = bytesToHexString(crl);
+    const auto signatureHex = bytesToHexString(randomBytes(64, generator));
+    const auto certificatePem = toBase64Lines(randomBytes(1200, generator), 64);
+    const auto crlPem = toBase64Lines(crl, 64);
+    Bytes decoded(crl.size());
+
+    for (const auto implementation : ALL_IMPLEMENTATIONS)
+    {
+        if (!isCodecImplementationSupported(implementation))
+        {
+            continue;
+        }
+        const std::string name = implementationName(implementation);
+        RecordProperty(name + "HexCrlNs", std::to_string(test::nsPerCall(200, [&]() {
+            EXPECT_EQ(DecodeStatus::OK, decodeHex(crlHex.data(), crlHex.size(), decoded.data(), implementation));
+        })));
+        RecordProperty(name + "HexSignatureNs", std::to_string(test::nsPerCall(100000, [&]() {
+            EXPECT_EQ(DecodeStatus::OK, decodeHex(signatureHex.data(), signatureHex.size(), decoded.data(), implementation));
+        })));
+        size_t length = 0;
+        RecordProperty(name + "Base64CertificateNs", std::to_string(test::nsPerCall(20000, [&]() {
+            EXPECT_EQ(DecodeStatus::OK, intel::sgx::dcap::decodeBase64(certificatePem.data(), certificatePem.size(),
+                                                                       decoded.data(), length, implementation));
+        })));
+        RecordProperty(name + "Base64CrlNs", std::to_string(test::nsPerCall(200, [&]() {
+            EXPECT_EQ(DecodeStatus::OK, intel::sgx::dcap::decodeBase64(crlPem.data(), crlPem.size(), decoded.data(), length, implementation));
+        })));
+        EXPECT_EQ(crl, decoded);
+    }
+
+    // OpenSSL base64 decoder used by PEM reader before, for reference
+    RecordProperty("opensslBase64CrlNs", std::to_string(test::nsPerCall(200, [&]() {
+        auto context = EVP_ENCODE_CTX_new();
+        int length = 0;
+        EVP_DecodeInit(context);
+        EVP_DecodeUpdate(context, decoded.data(), &length, reinterpret_cast<const unsigned char*>(crlPem.data()), static_cast<int>(crlPem.size()));
+        EVP_ENCODE_CTX_free(context);
+    })));
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <SgxEcdsaAttestation/QuoteVerification.h>
+#include <CertVerification/X509Constants.h>
+#include <QuoteV3Generator.h>
+#include <EnclaveIdentityGenerator.h>
+#include <EcdsaSignatureGenerator.h>
+#include <QuoteVerification/QuoteConstants.h>
+#include <TcbInfoJsonGenerator.h>
+#include <X509CertGenerator.h>
+#include <X509CrlGenerator.h>
+#include <DigestUtils.h>
+#include <KeyHelpers.h>
+#include <BenchmarkUtils.h>
+
+#include <algorithm>
+#include <thread>
+
+using namespace testing;
+using namespace intel::sgx::dcap;
+using namespace intel::sgx::dcap::test;
+using namespace intel::sgx::dcap::parser::test;
+
+struct VerifyQuoteBatchBenchmark : public Test
+{
+    X509CertGenerator certGenerator;
+    X509CrlGenerator crlGenerator;
+    QuoteV3Generator quoteV3Generator;
+    EnclaveIdentityVectorModel qeIdentityModel;
+    Bytes ppid = Bytes(16, 0xaa);
+    Bytes cpusvn = Bytes(16, 0xff);
+    Bytes pcesvnLE = {0x01, 0x02};
+
+    crypto::EVP_PKEY_uptr keyInt = certGenerator.generateEcKeypair();
+    crypto::EVP_PKEY_uptr key = certGenerator.generateEcKeypair();
+    crypto::X509_uptr cert = certGenerator.generatePCKCert(2, {0x23, 0x45}, 0, 3600, key.get(), keyInt.get(),
+                                                           constants::PCK_SUBJECT, constants::PLATFORM_CA_SUBJECT,
+                                                           ppid, cpusvn, {0x02, 0x01}, {0x04, 0xf3},
+                                                           {0x04, 0xf3, 0x44, 0x45, 0xaa, 0x00}, 0);
+    crypto::X509_uptr interCert = certGenerator.generateCaCert(2, {0x23, 0x45}, 0, 3600, key.get(), keyInt.get(),
+                                                               constants::PLATFORM_CA_SUBJECT, constants::PLATFORM_CA_SUBJECT);
+
+    static Bytes concat(Bytes first, const Bytes& second)
+    {
+        first.insert(first.end(), second.cbegin(), second.cend());
+        return first;
+    }
+
+    std::array<uint8_t, 64> signAndGetRaw(const Bytes& data)
+    {
+        const auto signature = EcdsaSignatureGenerator::signECDSA_SHA256(data, key.get());
+        std::array<uint8_t, 64> raw{};
+        std::copy_n(signature.begin(), raw.size(), raw.begin());
+        return raw;
+    }
+
+    Bytes buildValidQuoteV3()
+    {
+        QuoteV3Generator::CertificationData certificationData;
+        certificationData.keyDataType = constants::PCK_ID_PLAIN_PPID;
+        certificationData.keyData = concat(ppid, concat(cpusvn, pcesvnLE));
+        certificationData.size = static_cast<uint16_t>(certificationData.keyData.size());
+
+        quoteV3Generator.withcertificationData(certificationData);
+        quoteV3Generator.getAuthSize() += (uint32_t) certificationData.keyData.size();
+        auto& authData = quoteV3Generator.getAuthData();
+        authData.ecdsaAttestationKey.publicKey = getRawPub(*EVP_PKEY_get0_EC_KEY(key.get()));
+
+        QuoteV3Generator::EnclaveReport qeReport;
+        qeIdentityModel.applyTo(qeReport);
+        const auto reportDataDigest = DigestUtils::sha256DigestArray(concat(Bytes(authData.ecdsaAttestationKey.publicKey.cbegin(),
+                                                                                  authData.ecdsaAttestationKey.publicKey.cend()),
+                                                                            authData.qeAuthData.data));
+        std::copy_n(reportDataDigest.begin(), 32, qeReport.reportData.begin());
+        authData.qeReport = qeReport;
+        authData.qeReportSignature.signature = signAndGetRaw(qeReport.bytes());
+        authData.ecdsaSignature.signature = signAndGetRaw(concat(quoteV3Generator.getHeader().bytes(),
+                                                                 quoteV3Generator.getEnclaveReport().bytes()));
+        return quoteV3Generator.buildQuote();
+    }
+
+    std::string getValidCrl()
+    {
+        const auto crl = crlGenerator.generateCRL(CRLVersion::CRL_VERSION_2, 0, 3600, interCert,
+                                                  std::vector<Bytes>{{0x12, 0x10, 0x13, 0x11}, {0x11, 0x33, 0xff, 0x56}});
+        return X509CrlGenerator::x509CrlToDERString(crl.get());
+    }
+
+    std::string getSignedTcbInfoJson()
+    {
+        const auto body = tcbInfoJsonV2Body(2, "2018-08-22T10:09:10Z", "2118-08-23T10:09:10Z", "04F34445AA00", "04F3",
+                                            getRandomTcb(), 1, "UpToDate", 1, 1, "2018-08-01T10:00:00Z");
+        const auto signature = EcdsaSignatureGenerator::signECDSA_SHA256(Bytes(body.cbegin(), body.cend()), key.get());
+        return tcbInfoJsonGenerator(body, EcdsaSignatureGenerator::signatureToHexString(signature));
+    }
+
+    std::string getSignedQeIdentityJson()
+    {
+        const auto body = qeIdentityModel.toV2JSON();
+        const auto signature = EcdsaSignatureGenerator::signECDSA_SHA256(Bytes(body.cbegin(), body.cend()), key.get());
+        return ::enclaveIdentityJsonWithSignature(body, EcdsaSignatureGenerator::signatureToHexString(signature));
+    }
+};
+
+TEST_F(VerifyQuoteBatchBenchmark, throughput)
+{
+    const auto quote = buildValidQuoteV3();
+    const auto pckPem = certGenerator.x509ToString(cert.get());
+    const auto pckCrl = getValidCrl();
+    const auto tcbInfoJsonWithSignature = getSignedTcbInfoJson();
+    const auto qeIdentityJsonWithSignature = getSignedQeIdentityJson();
+
+    const uint32_t batchSize = 256;
+    std::vector<const uint8_t*> quotes;
+    std::vector<uint32_t> quoteSizes;
+    std::vector<const char*> pckCerts(batchSize, pckPem.c_str());
+    for (uint32_t i = 0; i < batchSize; i++)
+    {
+        quotes.push_back(quote.data());
+        quoteSizes.push_back((uint32_t) quote.size());
+    }
+    std::vector<Status> results(batchSize, STATUS_MISSING_PARAMETERS);
+    const auto verifyBatch = [&](uint32_t quoteCount, uint32_t threadCount) {
+        ASSERT_EQ(STATUS_OK, sgxAttestationVerifyQuoteBatch(quotes.data(), quoteSizes.data(), pckCerts.data(), quoteCount,
+                                                            pckCrl.c_str(), tcbInfoJsonWithSignature.c_str(),
+                                                            qeIdentityJsonWithSignature.c_str(), threadCount, results.data()));
+    };
+
+    const auto sequentialNs = elapsedNs([&]() {
+        for (uint32_t i = 0; i < batchSize; i++)
+        {
+            ASSERT_EQ(STATUS_OK, sgxAttestationVerifyQuote(quotes[i], quoteSizes[i], pckCerts[i], pckCrl.c_str(),
+                                                           tcbInfoJsonWithSignature.c_str(), qeIdentityJsonWithSignature.c_str()));
+        }
+    });
+    const auto batchNs = elapsedNs([&]() { verifyBatch(batchSize, 0); });
+    RecordProperty("sequentialQuotesPerSecond", static_cast<int>(batchSize * 1000000000LL / std::max(1LL, sequentialNs)));
+    RecordProperty("batchQuotesPerSecond", static_cast<int>(batchSize * 1000000000LL / std::max(1LL, batchNs)));
+
+    // bursts of small batches, where starting threads for every call would be a noticeable part of the cost
+    const uint32_t burstSize = 8;
+    RecordProperty("burstOf8Us", static_cast<int>(nsPerCall(200, [&]() { verifyBatch(burstSize, burstSize); }) / 1000));
+    RecordProperty("startAndJoin7ThreadsUs", static_cast<int>(nsPerCall(200, [&]() {
+        std::vector<std::thread> threads;
+        for (uint32_t i = 1; i < burstSize; i++)
+        {
+            threads.emplace_back([]() {});
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }) / 1000));
+}
@@ -117,22 +117,27 @@ std::string X509CrlGenerator::x509CrlToPEMString(const X509_CRL *crl)
 }
 
 std::string X509CrlGenerator::x509CrlToDERString(const X509_CRL *crl)
+{
+    return bytesToHexString(x509CrlToDER(crl));
+}
+
+Bytes X509CrlGenerator::x509CrlToDER(const X509_CRL *crl)
 {
     if (nullptr == crl)
     {
-        return "";
+        return {};
     }
     auto crlMutable = const_cast<X509_CRL*>(crl);
     unsigned char *buf = nullptr;
     const auto len = i2d_X509_CRL(crlMutable, &buf);
-    if (0 == len)
+    if (len <= 0)
     {
-        return "";
+        return {};
     }
 
-    std::vector<uint8_t> ret(buf, buf + len);
+    Bytes ret(buf, buf + len);
     OPENSSL_free(buf);
-    return bytesToHexString(ret);
+    return ret;
 }
 
 void X509CrlGenerator::addStandardCrlExtensions(const crypto::X509_CRL_uptr& crl, const crypto::X509_uptr& issuerCert) const
@@ -54,6 +54,7 @@ public:
 
     static std::string x509CrlToPEMString(const X509_CRL *crl);
     static std::string x509CrlToDERString(const X509_CRL *crl);
+    static Bytes x509CrlToDER(const X509_CRL *crl);
 
 private:
     void revokeSerialNumber(const crypto::X509_CRL_uptr &crl, const Bytes &serialNumber) const;
@@ -94,6 +94,24 @@ struct VerifyPCKCertificateIT : public Test
 
         return X509CrlGenerator::x509CrlToDERString(rootCaCRL.get());
     }
+
+    Bytes getValidBinaryCrl(const crypto::X509_uptr &ucert)
+    {
+        auto revokedList = std::vector<Bytes>{{0x12, 0x10, 0x13, 0x11}, {0x11, 0x33, 0xff, 0x56}};
+        auto rootCaCRL = crlGenerator.generateCRL(CRLVersion::CRL_VERSION_2, 0, 3600, ucert, revokedList);
+
+        return X509CrlGenerator::x509CrlToDER(rootCaCRL.get());
+    }
+
+    Bytes getBinaryCertChain()
+    {
+        auto certChain = certGenerator.x509ToDer(rootCert.get());
+        const auto intDer = certGenerator.x509ToDer(intCert.get());
+        const auto pckDer = certGenerator.x509ToDer(cert.get());
+        certChain.insert(certChain.end(), intDer.begin(), intDer.end());
+        certChain.insert(certChain.end(), pckDer.begin(), pckDer.end());
+        return certChain;
+    }
 };
 
 TEST_F(VerifyPCKCertificateIT, shouldReturnedStatusOkWhenPassingArgumnetsAreValidCrlAsPem)
@@ -366,4 +384,79 @@ TEST_F(VerifyPCKCertificateIT, shouldReturnedUsuportedCertFormatWhenRootCertIsNu
 
     // THEN
     EXPECT_EQ(STATUS_UNSUPPORTED_CERT_FORMAT, result);
-}
\ No newline at end of file
+}
+
+TEST_F(VerifyPCKCertificateIT, shouldReturnedStatusOkWhenPassingArgumentsAsDer)
+{
+    // GIVEN
+    auto rootCertDer = certGenerator.x509ToDer(rootCert.get());
+    auto certChain = getBinaryCertChain();
+
+    auto rootCaCrl = getValidBinaryCrl(rootCert);
+    auto intermediateCaCrl = getValidBinaryCrl(intCert);
+
+    const std::array<const uint8_t*, 2> crls{{rootCaCrl.data(), intermediateCaCrl.data()}};
+    const std::array<size_t, 2> crlSizes{{rootCaCrl.size(), intermediateCaCrl.size()}};
+
+    // WHEN
+    auto result = sgxAttestationVerifyPCKCertificateDer(certChain.data(), certChain.size(), crls.data(), crlSizes.data(),
+                                                        rootCertDer.data(), rootCertDer.size(), nullptr);
+
+    // THEN
+    EXPECT_EQ(STATUS_OK, result);
+}
+
+TEST_F(VerifyPCKCertificateIT, shouldReturnedUnsuportedCertFormatWhenDerCertChainHasTrailingData)
+{
+    // GIVEN
+    auto rootCertDer = certGenerator.x509ToDer(rootCert.get());
+    auto certChain = getBinaryCertChain();
+    certChain.push_back(0x30);
+
+    auto rootCaCrl = getValidBinaryCrl(rootCert);
+    auto intermediateCaCrl = getValidBinaryCrl(intCert);
+
+    const std::array<const uint8_t*, 2> crls{{rootCaCrl.data(), intermediateCaCrl.data()}};
+    const std::array<size_t, 2> crlSizes{{rootCaCrl.size(), intermediateCaCrl.size()}};
+
+    // WHEN
+    auto result = sgxAttestationVerifyPCKCertificateDer(certChain.data(), certChain.size(), crls.data(), crlSizes.data(),
+                                                        rootCertDer.data(), rootCertDer.size(), nullptr);
+
+    // THEN
+    EXPECT_EQ(STATUS_UNSUPPORTED_CERT_FORMAT, result);
+}
+
+TEST_F(VerifyPCKCertificateIT, shouldReturnedCrlUnsuportedFormatWhenDerIntermediateCrlIsTruncated)
+{
+    // GIVEN
+    auto rootCertDer = certGenerator.x509ToDer(rootCert.get());
+    auto certChain = getBinaryCertChain();
+
+    auto rootCaCrl = getValidBinaryCrl(rootCert);
+    auto intermediateCaCrl = getValidBinaryCrl(intCert);
+
+    const std::array<const uint8_t*, 2> crls{{rootCaCrl.data(), intermediateCaCrl.data()}};
+    const std::array<size_t, 2> crlSizes{{rootCaCrl.size(), intermediateCaCrl.size() - 1}};
+
+    // WHEN
+    auto result = sgxAttestationVerifyPCKCertificateDer(certChain.data(), certChain.size(), crls.data(), crlSizes.data(),
+                                                        rootCertDer.data(), rootCertDer.size(), nullptr);
+
+    // THEN
+    EXPECT_EQ(STATUS_SGX_CRL_UNSUPPORTED_FORMAT, result);
+}
+
+TEST_F(VerifyPCKCertificateIT, shouldReturnedUsuportedCertFormatWhenDerCrlsAreNull)
+{
+    // GIVEN
+    auto rootCertDer = certGenerator.x509ToDer(rootCert.get());
+    auto certChain = getBinaryCertChain();
+
+    // WHEN
+    auto result = sgxAttestationVerifyPCKCertificateDer(certChain.data(), certChain.size(), nullptr, nullptr,
+                                                        rootCertDer.data(), rootCertDer.size(), nullptr);
+
+    // THEN
+    EXPECT_EQ(STATUS_UNSUPPORTED_CERT_FORMAT, result);
+}
@@ -151,4 +151,45 @@ TEST_F(VerifyPCKRevocationListIT, shouldReturnTrustedRootCaCertUnsupportedFormat
 
     EXPECT_EQ(STATUS_TRUSTED_ROOT_CA_UNSUPPORTED_FORMAT,
               sgxAttestationVerifyPCKRevocationList(rootCaCrlPEM.c_str(), certChain.c_str(), invalidTrustedRootCaCert));
-}
\ No newline at end of file
+}
+TEST_F(VerifyPCKRevocationListIT, shouldVerifyRootCaCrlPositiveWhenInputsAreBinaryDer)
+{
+    const auto rootCaCertDER = certGenerator.x509ToDer(rootCaCert.get());
+    const auto rootCaCrlDER = X509CrlGenerator::x509CrlToDER(rootCaCrl.get());
+
+    EXPECT_EQ(STATUS_OK,
+              sgxAttestationVerifyPCKRevocationListDer(rootCaCrlDER.data(), rootCaCrlDER.size(), rootCaCertDER.data(), rootCaCertDER.size(),
+                                                       rootCaCertDER.data(), rootCaCertDER.size()));
+}
+
+TEST_F(VerifyPCKRevocationListIT, shouldVerifyIntermediateCaCrlPositiveWhenInputsAreBinaryDer)
+{
+    const auto rootCaCertDER = certGenerator.x509ToDer(rootCaCert.get());
+    const auto intermediateCaCertDER = certGenerator.x509ToDer(intermediateCaCert.get());
+    const auto intermediateCaCrlDER = X509CrlGenerator::x509CrlToDER(intermediateCaCrl.get());
+    auto certChain = rootCaCertDER;
+    certChain.insert(certChain.end(), intermediateCaCertDER.begin(), intermediateCaCertDER.end());
+
+    EXPECT_EQ(STATUS_OK,
+              sgxAttestationVerifyPCKRevocationListDer(intermediateCaCrlDER.data(), intermediateCaCrlDER.size(), certChain.data(), certChain.size(),
+                                                       rootCaCertDER.data(), rootCaCertDER.size()));
+}
+
+TEST_F(VerifyPCKRevocationListIT, shouldReturnUnsupportedFormatWhenInvalidBinaryDerInput)
+{
+    const auto rootCaCertDER = certGenerator.x509ToDer(rootCaCert.get());
+    const auto rootCaCrlDER = X509CrlGenerator::x509CrlToDER(rootCaCrl.get());
+    const Bytes notDer {0x01, 0x02, 0x03};
+
+    EXPECT_EQ(STATUS_SGX_CRL_UNSUPPORTED_FORMAT,
+              sgxAttestationVerifyPCKRevocationListDer(nullptr, 0, rootCaCertDER.data(), rootCaCertDER.size(), rootCaCertDER.data(), rootCaCertDER.size()));
+    EXPECT_EQ(STATUS_SGX_CRL_UNSUPPORTED_FORMAT,
+              sgxAttestationVerifyPCKRevocationListDer(notDer.data(), notDer.size(), rootCaCertDER.data(), rootCaCertDER.size(),
+                                                       rootCaCertDER.data(), rootCaCertDER.size()));
+    EXPECT_EQ(STATUS_SGX_CA_CERT_UNSUPPORTED_FORMAT,
+              sgxAttestationVerifyPCKRevocationListDer(rootCaCrlDER.data(), rootCaCrlDER.size(), notDer.data(), notDer.size(),
+                                                       rootCaCertDER.data(), rootCaCertDER.size()));
+    EXPECT_EQ(STATUS_TRUSTED_ROOT_CA_UNSUPPORTED_FORMAT,
+              sgxAttestationVerifyPCKRevocationListDer(rootCaCrlDER.data(), rootCaCrlDER.size(), rootCaCertDER.data(), rootCaCertDER.size(),
+                                                       notDer.data(), notDer.size()));
+}
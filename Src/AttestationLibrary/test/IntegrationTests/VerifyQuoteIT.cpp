@@ -45,6 +45,9 @@
 #include <DigestUtils.h>
 #include <KeyHelpers.h>
 
+#include <algorithm>
+#include <thread>
+
 using namespace std;
 using namespace testing;
 using namespace intel::sgx::dcap;
@@ -107,6 +110,7 @@ struct VerifyQuoteIT : public Test
     string positiveQEIdentityV2JsonBody;
     std::vector<TcbLevelV3> tdxTcbLevels;
 
+    EnclaveIdentityVectorModel qeIdentityModel;
     test::QuoteV3Generator::EnclaveReport enclaveReport;
 
     VerifyQuoteIT()
@@ -151,9 +155,8 @@ struct VerifyQuoteIT : public Test
         });
         positiveTdxTcbInfoV3JsonBody = tcbInfoJsonV3Body("TDX", 3, issueDate, nextUpdate, fmspcStr, pceIdStr,
                                                          1, 1, tdxTcbLevels, true, tdxModule);
-        EnclaveIdentityVectorModel model;
-        positiveQEIdentityV2JsonBody = model.toV2JSON();
-        model.applyTo(enclaveReport);
+        positiveQEIdentityV2JsonBody = qeIdentityModel.toV2JSON();
+        qeIdentityModel.applyTo(enclaveReport);
     }
 
     std::string getValidCrl(const crypto::X509_uptr &ucert)
@@ -204,6 +207,87 @@ struct VerifyQuoteIT : public Test
         return signatureArr;
     }
 
+    std::vector<uint8_t> buildValidQuoteV3()
+    {
+        auto pckCertPubKeyPtr = EVP_PKEY_get0_EC_KEY(key.get());
+        auto pckCertKeyPtr = key.get();
+
+        test::QuoteV3Generator::CertificationData certificationData;
+        certificationData.keyDataType = constants::PCK_ID_PLAIN_PPID;
+        certificationData.keyData = concat(ppid, concat(cpusvn, pcesvnLE));
+        certificationData.size = static_cast<uint16_t>(certificationData.keyData.size());
+
+        quoteV3Generator.withcertificationData(certificationData);
+        quoteV3Generator.getAuthSize() += (uint32_t) certificationData.keyData.size();
+        quoteV3Generator.getAuthData().ecdsaAttestationKey.publicKey = test::getRawPub(*pckCertPubKeyPtr);
+
+        enclaveReport.reportData = assingFirst32(DigestUtils::sha256DigestArray(concat(quoteV3Generator.getAuthData().ecdsaAttestationKey.publicKey,
+                                                                                       quoteV3Generator.getAuthData().qeAuthData.data)));
+
+        quoteV3Generator.getAuthData().qeReport = enclaveReport;
+        quoteV3Generator.getAuthData().qeReportSignature.signature =
+                signEnclaveReport(quoteV3Generator.getAuthData().qeReport, *pckCertKeyPtr);
+        quoteV3Generator.getAuthData().ecdsaSignature.signature =
+                signAndGetRaw(concat(quoteV3Generator.getHeader().bytes(), quoteV3Generator.getEnclaveReport().bytes()), *pckCertKeyPtr);
+
+        return quoteV3Generator.buildQuote();
+    }
+
+    std::vector<uint8_t> buildValidSgxQuoteV4()
+    {
+        auto pckCertPubKeyPtr = EVP_PKEY_get0_EC_KEY(key.get());
+        auto pckCertKeyPtr = key.get();
+
+        test::QuoteV4Generator::EnclaveReport qeReport{};
+        qeIdentityModel.applyTo(qeReport);
+
+        test::QuoteV4Generator::QeAuthData qeAuthData;
+        qeAuthData.data = {};
+        qeAuthData.size = 0;
+
+        test::QuoteV4Generator::CertificationData certificationData;
+        certificationData.keyDataType = constants::PCK_ID_PCK_CERT_CHAIN;
+        certificationData.keyData = {};
+        certificationData.size = 0;
+
+        test::QuoteV4Generator::QEReportCertificationData qeReportCertificationData;
+        qeReportCertificationData.qeAuthData = qeAuthData;
+        qeReportCertificationData.qeReport = qeReport;
+        qeReportCertificationData.certificationData = certificationData;
+        qeReportCertificationData.qeReport.reportData = assingFirst32(DigestUtils::sha256DigestArray(concat(test::getRawPub(*pckCertPubKeyPtr), qeAuthData.data)));
+        qeReportCertificationData.qeReportSignature.signature = signEnclaveReport(qeReportCertificationData.qeReport, *pckCertKeyPtr);
+
+        test::QuoteV4Generator::CertificationData qeCertificationData;
+        qeCertificationData.keyDataType = constants::PCK_ID_QE_REPORT_CERTIFICATION_DATA;
+        qeCertificationData.keyData = qeReportCertificationData.bytes();
+        qeCertificationData.size = static_cast<uint16_t>(qeCertificationData.keyData.size());
+
+        quoteV4Generator.withCertificationData(qeCertificationData);
+        quoteV4Generator.getAuthSize() = 134 + (uint32_t) qeCertificationData.keyData.size();
+        quoteV4Generator.getAuthData().ecdsaAttestationKey.publicKey = test::getRawPub(*pckCertPubKeyPtr);
+        quoteV4Generator.getAuthData().ecdsaSignature.signature =
+                signAndGetRaw(concat(quoteV4Generator.getHeader().bytes(), quoteV4Generator.getEnclaveReport().bytes()), *pckCertKeyPtr);
+
+        return quoteV4Generator.buildSgxQuote();
+    }
+
+    std::string getSignedTcbInfoJson(const std::string& tcbInfoBody)
+    {
+        auto tcbInfoBodyBytes = Bytes{};
+        tcbInfoBodyBytes.insert(tcbInfoBodyBytes.end(), tcbInfoBody.begin(), tcbInfoBody.end());
+        auto signatureTcb = EcdsaSignatureGenerator::signECDSA_SHA256(tcbInfoBodyBytes, key.get());
+        return tcbInfoJsonGenerator(tcbInfoBody, EcdsaSignatureGenerator::signatureToHexString(signatureTcb));
+    }
+
+    std::string getSignedQeIdentityJson()
+    {
+        auto qeIdentityBodyBytes = Bytes{};
+        qeIdentityBodyBytes.insert(qeIdentityBodyBytes.end(), positiveQEIdentityV2JsonBody.begin(), positiveQEIdentityV2JsonBody.end());
+        auto signatureQE = EcdsaSignatureGenerator::signECDSA_SHA256(qeIdentityBodyBytes, key.get());
+        return ::enclaveIdentityJsonWithSignature(positiveQEIdentityV2JsonBody,
+                                                  EcdsaSignatureGenerator::signatureToHexString(signatureQE));
+    }
+
 };
 
 TEST_F(VerifyQuoteIT, shouldReturnedMissingParmatersWhenQuoteIsNull)
@@ -898,4 +982,269 @@ TEST_F(VerifyQuoteIT, shouldReturnedStatusOKWhenVerifyQuoteV3WithSgxTcbInfoV3Suc
 
     // THEN
     EXPECT_EQ(STATUS_OK, result);
-}
\ No newline at end of file
+}
+
+TEST_F(VerifyQuoteIT, shouldReturnedMissingParametersWhenCollateralCreateArgumentsAreNull)
+{
+    // GIVEN
+    Collateral* collateral = nullptr;
+
+    // WHEN / THEN
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationCollateralCreate(nullptr, placeHolder, placeHolder, &collateral));
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationCollateralCreate(placeHolder, nullptr, placeHolder, &collateral));
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationCollateralCreate(placeHolder, placeHolder, placeHolder, nullptr));
+    EXPECT_EQ(nullptr, collateral);
+}
+
+TEST_F(VerifyQuoteIT, shouldReturnedUnsuportedPckCrlFormatWhenCollateralCreateWithInvalidCrl)
+{
+    // GIVEN
+    Collateral* collateral = nullptr;
+    auto tcbInfoJsonWithSignature = getSignedTcbInfoJson(positiveTcbInfoV2JsonBody);
+
+    // WHEN
+    auto result = sgxAttestationCollateralCreate(placeHolder, tcbInfoJsonWithSignature.c_str(), nullptr, &collateral);
+
+    // THEN
+    EXPECT_EQ(STATUS_UNSUPPORTED_PCK_RL_FORMAT, result);
+    EXPECT_EQ(nullptr, collateral);
+}
+
+TEST_F(VerifyQuoteIT, shouldReturnedUnsuportedTcbInfoFormatWhenCollateralCreateWithInvalidTcbInfo)
+{
+    // GIVEN
+    Collateral* collateral = nullptr;
+    auto pckCrl = getValidCrl(interCert);
+
+    // WHEN
+    auto result = sgxAttestationCollateralCreate(pckCrl.c_str(), placeHolder, nullptr, &collateral);
+
+    // THEN
+    EXPECT_EQ(STATUS_UNSUPPORTED_TCB_INFO_FORMAT, result);
+    EXPECT_EQ(nullptr, collateral);
+}
+
+TEST_F(VerifyQuoteIT, shouldReturnedMissingParametersWhenVerifyQuoteWithNullCollateral)
+{
+    // GIVEN / WHEN
+    auto result = sgxAttestationVerifyQuoteWithCollateral(nullptr, quotePlaceHolder, 0, placeHolder);
+
+    // THEN
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, result);
+}
+
+TEST_F(VerifyQuoteIT, shouldReturnedStatusOKWhenVerifyQuoteV3WithReusedCollateral)
+{
+    // GIVEN
+    auto quote = buildValidQuoteV3();
+    auto pckPem = certGenerator.x509ToString(cert.get());
+    auto pckCrl = getValidCrl(interCert);
+    auto tcbInfoJsonWithSignature = getSignedTcbInfoJson(positiveTcbInfoV2JsonBody);
+    auto qeIdentityJsonWithSignature = getSignedQeIdentityJson();
+
+    Collateral* collateral = nullptr;
+    ASSERT_EQ(STATUS_OK, sgxAttestationCollateralCreate(pckCrl.c_str(), tcbInfoJsonWithSignature.c_str(),
+                                                        qeIdentityJsonWithSignature.c_str(), &collateral));
+    ASSERT_NE(nullptr, collateral);
+
+    // WHEN
+    std::vector<Status> results(8, STATUS_MISSING_PARAMETERS);
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        workers.emplace_back([&, i]() {
+            results[i] = sgxAttestationVerifyQuoteWithCollateral(collateral, quote.data(), (uint32_t) quote.size(), pckPem.c_str());
+        });
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    auto invalidPckResult = sgxAttestationVerifyQuoteWithCollateral(collateral, quote.data(), (uint32_t) quote.size(), placeHolder);
+    sgxAttestationCollateralFree(collateral);
+
+    // THEN
+    for (const auto result : results)
+    {
+        EXPECT_EQ(STATUS_OK, result);
+    }
+    EXPECT_EQ(STATUS_UNSUPPORTED_PCK_CERT_FORMAT, invalidPckResult);
+}
+
+TEST_F(VerifyQuoteIT, shouldReturnedMissingParametersWhenVerifyQuoteBatchArgumentsAreNull)
+{
+    // GIVEN
+    const uint8_t* quotes[] = {quotePlaceHolder};
+    const uint32_t quoteSizes[] = {0};
+    const char* pckCerts[] = {placeHolder};
+    Status results[] = {STATUS_OK};
+
+    // WHEN / THEN
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationVerifyQuoteBatch(nullptr, quoteSizes, pckCerts, 1, placeHolder, placeHolder, nullptr, 1, results));
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationVerifyQuoteBatch(quotes, nullptr, pckCerts, 1, placeHolder, placeHolder, nullptr, 1, results));
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationVerifyQuoteBatch(quotes, quoteSizes, nullptr, 1, placeHolder, placeHolder, nullptr, 1, results));
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationVerifyQuoteBatch(quotes, quoteSizes, pckCerts, 1, nullptr, placeHolder, nullptr, 1, results));
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationVerifyQuoteBatch(quotes, quoteSizes, pckCerts, 1, placeHolder, nullptr, nullptr, 1, results));
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationVerifyQuoteBatch(quotes, quoteSizes, pckCerts, 1, placeHolder, placeHolder, nullptr, 1, nullptr));
+}
+
+TEST_F(VerifyQuoteIT, shouldFillAllBatchResultsWithCollateralStatusWhenPckCrlIsInvalid)
+{
+    // GIVEN
+    const uint8_t* quotes[] = {quotePlaceHolder, quotePlaceHolder};
+    const uint32_t quoteSizes[] = {0, 0};
+    const char* pckCerts[] = {placeHolder, placeHolder};
+    Status results[] = {STATUS_OK, STATUS_OK};
+
+    // WHEN
+    auto result = sgxAttestationVerifyQuoteBatch(quotes, quoteSizes, pckCerts, 2, placeHolder, placeHolder, nullptr, 2, results);
+
+    // THEN
+    EXPECT_EQ(STATUS_UNSUPPORTED_PCK_RL_FORMAT, result);
+    EXPECT_EQ(STATUS_UNSUPPORTED_PCK_RL_FORMAT, results[0]);
+    EXPECT_EQ(STATUS_UNSUPPORTED_PCK_RL_FORMAT, results[1]);
+}
+
+TEST_F(VerifyQuoteIT, shouldReturnPerQuoteStatusesWhenVerifyQuoteBatch)
+{
+    // GIVEN
+    auto quoteV3 = buildValidQuoteV3();
+    auto quoteV4 = buildValidSgxQuoteV4();
+    auto pckPem = certGenerator.x509ToString(cert.get());
+    auto pckCrl = getValidCrl(interCert);
+    auto tcbInfoJsonWithSignature = getSignedTcbInfoJson(positiveTcbInfoV2JsonBody);
+    auto qeIdentityJsonWithSignature = getSignedQeIdentityJson();
+
+    const uint8_t* quotes[] = {quoteV3.data(), quoteV4.data(), quotePlaceHolder, quoteV3.data(), nullptr};
+    const uint32_t quoteSizes[] = {(uint32_t) quoteV3.size(), (uint32_t) quoteV4.size(), 0, (uint32_t) quoteV3.size(), 0};
+    const char* pckCerts[] = {pckPem.c_str(), pckPem.c_str(), pckPem.c_str(), placeHolder, pckPem.c_str()};
+    Status results[5] = {};
+
+    // WHEN
+    auto result = sgxAttestationVerifyQuoteBatch(quotes, quoteSizes, pckCerts, 5, pckCrl.c_str(), tcbInfoJsonWithSignature.c_str(),
+                                                 qeIdentityJsonWithSignature.c_str(), 3, results);
+
+    // THEN
+    EXPECT_EQ(STATUS_OK, result);
+    EXPECT_EQ(STATUS_OK, results[0]);
+    EXPECT_EQ(STATUS_OK, results[1]);
+    EXPECT_EQ(STATUS_UNSUPPORTED_QUOTE_FORMAT, results[2]);
+    EXPECT_EQ(STATUS_UNSUPPORTED_PCK_CERT_FORMAT, results[3]);
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, results[4]);
+}
+
+TEST_F(VerifyQuoteIT, shouldVerifyBatchOfQuotesOnResidentThreads)
+{
+    // GIVEN
+    auto quoteV3 = buildValidQuoteV3();
+    auto quoteV4 = buildValidSgxQuoteV4();
+    auto pckPem = certGenerator.x509ToString(cert.get());
+    auto pckCrl = getValidCrl(interCert);
+    auto tcbInfoJsonWithSignature = getSignedTcbInfoJson(positiveTcbInfoV2JsonBody);
+    auto qeIdentityJsonWithSignature = getSignedQeIdentityJson();
+
+    const uint32_t batchSize = 64;
+    std::vector<const uint8_t*> quotes;
+    std::vector<uint32_t> quoteSizes;
+    std::vector<const char*> pckCerts(batchSize, pckPem.c_str());
+    for (uint32_t i = 0; i < batchSize; i++)
+    {
+        const auto& quote = (i % 2 == 0) ? quoteV3 : quoteV4;
+        quotes.push_back(quote.data());
+        quoteSizes.push_back((uint32_t) quote.size());
+    }
+
+    for (const uint32_t threadCount : {0u, 4u, 2u})
+    {
+        std::vector<Status> results(batchSize, STATUS_MISSING_PARAMETERS);
+
+        // WHEN
+        auto result = sgxAttestationVerifyQuoteBatch(quotes.data(), quoteSizes.data(), pckCerts.data(), batchSize, pckCrl.c_str(),
+                                                     tcbInfoJsonWithSignature.c_str(), qeIdentityJsonWithSignature.c_str(),
+                                                     threadCount, results.data());
+
+        // THEN
+        EXPECT_EQ(STATUS_OK, result);
+        EXPECT_EQ(std::vector<Status>(batchSize, STATUS_OK), results) << threadCount;
+    }
+}
+
+TEST_F(VerifyQuoteIT, shouldReuseParsedInputsWhenParseCacheIsEnabled)
+{
+    // GIVEN
+    auto quote = buildValidQuoteV3();
+    auto pckPem = certGenerator.x509ToString(cert.get());
+    auto pckCrl = getValidCrl(interCert);
+    auto tcbInfoJsonWithSignature = getSignedTcbInfoJson(positiveTcbInfoV2JsonBody);
+    auto qeIdentityJsonWithSignature = getSignedQeIdentityJson();
+    sgxAttestationParseCacheSetup(8);
+
+    // WHEN
+    std::vector<Status> results;
+    for (int i = 0; i < 3; i++)
+    {
+        results.push_back(sgxAttestationVerifyQuote(quote.data(), (uint32_t) quote.size(), pckPem.c_str(), pckCrl.c_str(),
+                                                    tcbInfoJsonWithSignature.c_str(), qeIdentityJsonWithSignature.c_str()));
+    }
+    ParseCacheStatistics statistics{};
+    auto statisticsResult = sgxAttestationParseCacheGetStatistics(&statistics);
+    sgxAttestationParseCacheSetup(0);
+
+    // THEN
+    for (const auto result : results)
+    {
+        EXPECT_EQ(STATUS_OK, result);
+    }
+    EXPECT_EQ(STATUS_OK, statisticsResult);
+    EXPECT_EQ(4u, statistics.misses);
+    EXPECT_EQ(8u, statistics.hits);
+    EXPECT_EQ(0u, statistics.evictions);
+    EXPECT_EQ(4u, statistics.entries);
+    EXPECT_EQ(STATUS_MISSING_PARAMETERS, sgxAttestationParseCacheGetStatistics(nullptr));
+}
+
+TEST_F(VerifyQuoteIT, shouldReturnedStatusOKWhenVerifyQuoteV3WithDerInputs)
+{
+    // GIVEN
+    auto quote = buildValidQuoteV3();
+    auto pckDer = certGenerator.x509ToDer(cert.get());
+    auto revokedList = std::vector<Bytes>{{0x12, 0x10, 0x13, 0x11}, {0x11, 0x33, 0xff, 0x56}};
+    auto pckCrl = X509CrlGenerator::x509CrlToDER(
+            crlGenerator.generateCRL(CRLVersion::CRL_VERSION_2, 0, 3600, interCert, revokedList).get());
+    auto tcbInfoJsonWithSignature = getSignedTcbInfoJson(positiveTcbInfoV2JsonBody);
+    auto qeIdentityJsonWithSignature = getSignedQeIdentityJson();
+
+    // WHEN
+    auto result = sgxAttestationVerifyQuoteDer(quote.data(), (uint32_t) quote.size(), pckDer.data(), pckDer.size(),
+                                               pckCrl.data(), pckCrl.size(), tcbInfoJsonWithSignature.c_str(),
+                                               qeIdentityJsonWithSignature.c_str());
+    Collateral* collateral = nullptr;
+    auto collateralResult = sgxAttestationCollateralCreateDer(pckCrl.data(), pckCrl.size(), tcbInfoJsonWithSignature.c_str(),
+                                                              qeIdentityJsonWithSignature.c_str(), &collateral);
+    auto collateralVerifyResult = sgxAttestationVerifyQuoteWithCollateralDer(collateral, quote.data(), (uint32_t) quote.size(),
+                                                                             pckDer.data(), pckDer.size());
+    auto truncatedPckResult = sgxAttestationVerifyQuoteWithCollateralDer(collateral, quote.data(), (uint32_t) quote.size(),
+                                                                         pckDer.data(), pckDer.size() - 1);
+    sgxAttestationCollateralFree(collateral);
+
+    // THEN
+    EXPECT_EQ(STATUS_OK, result);
+    EXPECT_EQ(STATUS_OK, collateralResult);
+    EXPECT_EQ(STATUS_OK, collateralVerifyResult);
+    EXPECT_EQ(STATUS_UNSUPPORTED_PCK_CERT_FORMAT, truncatedPckResult);
+}
+
+TEST_F(VerifyQuoteIT, shouldReturnedUnsuportedPckCrlFormatWhenCollateralCreateWithHexCrlAsDer)
+{
+    // GIVEN
+    auto pckCrl = getValidCrl(interCert);
+    Collateral* collateral = nullptr;
+
+    // WHEN
+    auto result = sgxAttestationCollateralCreateDer(reinterpret_cast<const uint8_t*>(pckCrl.data()), pckCrl.size(),
+                                                    placeHolder, placeHolder, &collateral);
+
+    // THEN
+    EXPECT_EQ(STATUS_UNSUPPORTED_PCK_RL_FORMAT, result);
+    EXPECT_EQ(nullptr, collateral);
+}
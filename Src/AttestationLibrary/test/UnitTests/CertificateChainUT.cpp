@@ -181,6 +181,12 @@ TEST_F(PckCertChainParserTests, parsingThreeElements)
     EXPECT_EQ(*certs[0], rootCert);
     EXPECT_EQ(*certs[1], intermediateCert);
     EXPECT_EQ(*certs[2], finalCert);
+
+    // PCK certificate is kept as a single instance
+    EXPECT_EQ(*certChain.getPckCert(), finalCert);
+    EXPECT_EQ(certChain.getPckCert(), certChain.getTopmostCert());
+    EXPECT_EQ(certChain.getPckCert(), certChain.get(finalCert.getSubject()));
+    EXPECT_EQ(certChain.getPckCert(), certs[2]);
 }
 
 TEST_F(PckCertChainParserTests, parsingTwoElementsWithNewLines)
@@ -0,0 +1,294 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <PckParser/CrlStore.h>
+#include <PckParser/SerialNumberIndex.h>
+#include <OpensslHelpers/SignatureVerification.h>
+#include <CertVerification/X509Constants.h>
+#include <X509CertGenerator.h>
+#include <X509CrlGenerator.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+using namespace testing;
+using namespace intel::sgx::dcap;
+using namespace intel::sgx::dcap::test;
+using namespace intel::sgx::dcap::parser::test;
+
+namespace {
+
+std::vector<Bytes> randomSerialNumbers(size_t count, std::mt19937& generator)
+{
+    std::uniform_int_distribution<int> distribution(0, 255);
+    std::vector<Bytes> serialNumbers(count, Bytes(20));
+    for (auto& serialNumber : serialNumbers)
+    {
+        for (auto& byte : serialNumber)
+        {
+            byte = static_cast<uint8_t>(distribution(generator));
+        }
+        // positive integer without leading zero, so it is stored in CRL and certificate exactly as given
+        serialNumber[0] = static_cast<uint8_t>(serialNumber[0] | 0x01) & 0x7F;
+    }
+    return serialNumbers;
+}
+
+std::vector<ByteRange> toRanges(const std::vector<Bytes>& serialNumbers)
+{
+    return std::vector<ByteRange>(serialNumbers.cbegin(), serialNumbers.cend());
+}
+
+} // anonymous namespace
+
+struct CrlStoreUT : public Test
+{
+    X509CertGenerator certGenerator;
+    X509CrlGenerator crlGenerator;
+    crypto::EVP_PKEY_uptr key = certGenerator.generateEcKeypair();
+    crypto::X509_uptr issuer = certGenerator.generateCaCert(2, {0x01}, 0, 3600, key.get(), key.get(),
+                                                            constants::ROOT_CA_SUBJECT, constants::ROOT_CA_SUBJECT);
+    std::mt19937 generator{1234};
+
+    std::shared_ptr<pckparser::CrlStore> crlWith(const std::vector<Bytes>& revokedSerialNumbers)
+    {
+        const auto crl = crlGenerator.generateCRL(CRLVersion::CRL_VERSION_2, 0, 3600, issuer, revokedSerialNumbers);
+        const auto der = X509CrlGenerator::x509CrlToDER(crl.get());
+        auto crlStore = std::make_shared<pckparser::CrlStore>();
+        EXPECT_TRUE(crlStore->parseDer(der.data(), der.size()));
+        return crlStore;
+    }
+
+    Bytes crlDerWith(const std::vector<Bytes>& revokedSerialNumbers)
+    {
+        const auto crl = crlGenerator.generateCRL(CRLVersion::CRL_VERSION_2, 0, 3600, issuer, revokedSerialNumbers);
+        return X509CrlGenerator::x509CrlToDER(crl.get());
+    }
+
+    Bytes issuerPubKey()
+    {
+        return parser::x509::Certificate::parse(certGenerator.x509ToString(issuer.get())).getPubKey();
+    }
+
+    parser::x509::Certificate certificateWith(const Bytes& serialNumber)
+    {
+        const auto cert = certGenerator.generateCaCert(2, serialNumber, 0, 3600, key.get(), key.get(),
+                                                       constants::PLATFORM_CA_SUBJECT, constants::ROOT_CA_SUBJECT);
+        return parser::x509::Certificate::parse(certGenerator.x509ToString(cert.get()));
+    }
+};
+
+TEST_F(CrlStoreUT, serialNumberIndexShouldContainOnlyInsertedSerialNumbers)
+{
+    const Bytes longSerialNumber(24, 0x11);
+    const std::vector<Bytes> serialNumbers = {{0x01}, {0x01, 0x02}, {0x02, 0x01}, {}, longSerialNumber, {0x01}, longSerialNumber};
+    const pckparser::SerialNumberIndex index(toRanges(serialNumbers));
+
+    EXPECT_EQ(5u, index.size());
+    for (const auto& serialNumber : serialNumbers)
+    {
+        EXPECT_TRUE(index.contains(serialNumber));
+    }
+    EXPECT_FALSE(index.contains(Bytes{0x02}));
+    EXPECT_FALSE(index.contains(Bytes{0x01, 0x00}));
+    EXPECT_FALSE(index.contains(Bytes{0x00, 0x01}));
+    EXPECT_FALSE(index.contains(Bytes(24, 0x12)));
+    EXPECT_FALSE(index.contains(Bytes(20, 0x01)));
+}
+
+TEST_F(CrlStoreUT, emptySerialNumberIndexShouldContainNothing)
+{
+    const pckparser::SerialNumberIndex defaultIndex;
+    const pckparser::SerialNumberIndex emptyIndex(std::vector<ByteRange>{});
+
+    EXPECT_FALSE(defaultIndex.contains(Bytes{}));
+    EXPECT_FALSE(defaultIndex.contains(Bytes{0x01}));
+    EXPECT_FALSE(emptyIndex.contains(Bytes{0x01}));
+    EXPECT_EQ(0u, emptyIndex.size());
+}
+
+TEST_F(CrlStoreUT, shouldReportOnlyRevokedCertificates)
+{
+    const auto revoked = randomSerialNumbers(100, generator);
+    const auto crlStore = crlWith(revoked);
+
+    EXPECT_TRUE(crlStore->isRevoked(certificateWith(revoked.front())));
+    EXPECT_TRUE(crlStore->isRevoked(certificateWith(revoked.back())));
+    EXPECT_FALSE(crlStore->isRevoked(certificateWith(randomSerialNumbers(1, generator).front())));
+    EXPECT_FALSE(pckparser::CrlStore{}.isRevoked(certificateWith(revoked.front())));
+}
+
+TEST_F(CrlStoreUT, indexedLookupShouldMatchLinearScan)
+{
+    const auto notRevokedCert = certificateWith({0x12, 0x34});
+    for (const size_t revokedCount : {size_t{10}, size_t{10000}})
+    {
+        const auto revoked = randomSerialNumbers(revokedCount, generator);
+        const auto crlStore = crlWith(revoked);
+        const auto& entries = crlStore->getRevoked();
+        ASSERT_EQ(revokedCount, entries.size());
+
+        for (const auto& cert : {certificateWith(revoked.front()), certificateWith(revoked[revokedCount / 2]),
+                                 certificateWith(revoked.back()), notRevokedCert})
+        {
+            // former lookup, linear scan over revoked entries
+            const auto found = std::find_if(entries.cbegin(), entries.cend(), [&](const pckparser::Revoked& entry) {
+                return entry.serialNumber == cert.getSerialNumber();
+            });
+            EXPECT_EQ(found != entries.cend(), crlStore->isRevoked(cert)) << revokedCount;
+        }
+        EXPECT_FALSE(crlStore->isRevoked(notRevokedCert));
+    }
+}
+
+TEST_F(CrlStoreUT, streamingParseShouldMatchOpensslParse)
+{
+    auto revoked = randomSerialNumbers(50, generator);
+    revoked.push_back({0x80, 0x01}); // encoded with padding zero
+    revoked.push_back({0x00});
+    const auto der = crlDerWith(revoked);
+    const auto x509Crl = pckparser::der2X509Crl(der.data(), der.size());
+
+    pckparser::CrlStore crlStore;
+    ASSERT_TRUE(crlStore.parseDer(der.data(), der.size()));
+
+    EXPECT_FALSE(crlStore.getTbsCertList().empty());
+    EXPECT_EQ(0, X509_CRL_cmp(x509Crl.get(), &crlStore.getCrl()));
+    EXPECT_EQ(pckparser::getIssuer(*x509Crl), crlStore.getIssuer());
+    EXPECT_EQ(pckparser::getValidity(*x509Crl), crlStore.getValidity());
+    EXPECT_EQ(pckparser::getExtensions(*x509Crl), crlStore.getExtensions());
+    EXPECT_EQ(pckparser::getSignature(*x509Crl).rawDer, crlStore.getSignature().rawDer);
+    EXPECT_EQ(pckparser::getCrlNum(*x509Crl), crlStore.getCrlNum());
+
+    const auto expected = pckparser::getRevoked(*x509Crl);
+    const auto& entries = crlStore.getRevoked();
+    ASSERT_EQ(expected.size(), entries.size());
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+        EXPECT_EQ(expected[i].serialNumber, entries[i].serialNumber);
+        EXPECT_EQ(expected[i].dateStr, entries[i].dateStr);
+    }
+
+    EXPECT_TRUE(crlStore.isRevoked(certificateWith({0x80, 0x01})));
+    EXPECT_TRUE(crypto::verifySignature(crlStore, issuerPubKey()));
+}
+
+TEST_F(CrlStoreUT, streamingParseShouldDetectModifiedRevokedEntries)
+{
+    const auto der = crlDerWith({{0x5A}, {0x5B}});
+    auto modified = der;
+    const Bytes serialNumberEncoding = {V_ASN1_INTEGER, 0x01, 0x5A, V_ASN1_UTCTIME};
+    auto serialNumber = std::search(modified.begin(), modified.end(), serialNumberEncoding.cbegin(), serialNumberEncoding.cend());
+    ASSERT_NE(modified.end(), serialNumber);
+    *(serialNumber + 2) = 0x5C;
+
+    pckparser::CrlStore crlStore;
+    ASSERT_TRUE(crlStore.parseDer(modified.data(), modified.size()));
+    EXPECT_FALSE(crlStore.getTbsCertList().empty());
+    EXPECT_TRUE(crlStore.isRevoked(certificateWith({0x5C})));
+    EXPECT_FALSE(crlStore.isRevoked(certificateWith({0x5A})));
+    EXPECT_FALSE(crypto::verifySignature(crlStore, issuerPubKey()));
+}
+
+TEST_F(CrlStoreUT, crlSignedWithOtherAlgorithmThanEcdsaWithSha256ShouldBeParsedAndVerifiedByOpenssl)
+{
+    const auto crl = crlGenerator.generateCRL(CRLVersion::CRL_VERSION_2, 0, 3600, issuer, {{0x5A}});
+    ASSERT_NE(0, X509_CRL_sign(crl.get(), key.get(), EVP_sha1()));
+    const auto der = X509CrlGenerator::x509CrlToDER(crl.get());
+
+    for (const auto& crlString : {X509CrlGenerator::x509CrlToDERString(crl.get()), X509CrlGenerator::x509CrlToPEMString(crl.get())})
+    {
+        pckparser::CrlStore crlStore;
+        ASSERT_TRUE(crlStore.parse(crlString));
+        EXPECT_TRUE(crlStore.getTbsCertList().empty());
+        EXPECT_TRUE(crlStore.isRevoked(certificateWith({0x5A})));
+        EXPECT_TRUE(crypto::verifySignature(crlStore, issuerPubKey()));
+    }
+
+    pckparser::CrlStore crlStore;
+    ASSERT_TRUE(crlStore.parseDer(der.data(), der.size()));
+    EXPECT_TRUE(crlStore.getTbsCertList().empty());
+    EXPECT_TRUE(crypto::verifySignature(crlStore, issuerPubKey()));
+}
+
+TEST_F(CrlStoreUT, negativeSerialNumberShouldBeParsedByOpenssl)
+{
+    auto der = crlDerWith({{0x5A}});
+    const Bytes serialNumberEncoding = {V_ASN1_INTEGER, 0x01, 0x5A, V_ASN1_UTCTIME};
+    auto serialNumber = std::search(der.begin(), der.end(), serialNumberEncoding.cbegin(), serialNumberEncoding.cend());
+    ASSERT_NE(der.end(), serialNumber);
+    *(serialNumber + 2) = 0xFF; // -1
+
+    pckparser::CrlStore crlStore;
+    ASSERT_TRUE(crlStore.parseDer(der.data(), der.size()));
+    EXPECT_TRUE(crlStore.getTbsCertList().empty());
+    ASSERT_EQ(1u, crlStore.getRevoked().size());
+    EXPECT_EQ(Bytes{0x01}, crlStore.getRevoked().front().serialNumber);
+}
+
+TEST_F(CrlStoreUT, streamingParseShouldAcceptHexAndPem)
+{
+    const auto revoked = randomSerialNumbers(10, generator);
+    const auto crl = crlGenerator.generateCRL(CRLVersion::CRL_VERSION_2, 0, 3600, issuer, revoked);
+
+    for (const auto& crlString : {X509CrlGenerator::x509CrlToDERString(crl.get()), X509CrlGenerator::x509CrlToPEMString(crl.get())})
+    {
+        pckparser::CrlStore crlStore;
+        ASSERT_TRUE(crlStore.parse(crlString));
+        EXPECT_FALSE(crlStore.getTbsCertList().empty());
+        EXPECT_EQ(revoked.size(), crlStore.getRevoked().size());
+        EXPECT_TRUE(crlStore.isRevoked(certificateWith(revoked[3])));
+        EXPECT_TRUE(crypto::verifySignature(crlStore, issuerPubKey()));
+    }
+}
+
+TEST_F(CrlStoreUT, shouldParseMappedDerFile)
+{
+    const auto revoked = randomSerialNumbers(10, generator);
+    const auto der = crlDerWith(revoked);
+    const auto path = ::testing::TempDir() + "CrlStoreUT.crl";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(der.data()), static_cast<std::streamsize>(der.size()));
+    }
+
+    pckparser::CrlStore crlStore;
+    ASSERT_TRUE(crlStore.parseDerFile(path));
+    EXPECT_TRUE(crlStore.isRevoked(certificateWith(revoked.front())));
+    EXPECT_EQ(revoked.size(), crlStore.getRevoked().size());
+    EXPECT_TRUE(crypto::verifySignature(crlStore, issuerPubKey()));
+    EXPECT_FALSE(pckparser::CrlStore{}.parseDerFile(path + ".missing"));
+    std::remove(path.c_str());
+}
@@ -192,3 +192,23 @@ TEST_F(JsonParserTests, shouldParseObjectWithString)
     EXPECT_EQ(dcap::JsonParser::ParseStatus::OK, status);
     EXPECT_EQ(expectedValue, value);
 }
+
+TEST_F(JsonParserTests, shouldParseOnlyGivenLengthOfBuffer)
+{
+    const std::string json = R"json({"data": {"v": 5}}trailing garbage)json";
+    ASSERT_TRUE(jsonParser.parse(json.data(), json.find('}') + 2));
+    const auto data = jsonParser.getField("data");
+    ASSERT_NE(nullptr, data);
+    const auto value = jsonParser.getUintFieldOf(*data, "v");
+    EXPECT_EQ(dcap::JsonParser::OK, value.second);
+    EXPECT_EQ(5u, value.first);
+}
+
+TEST_F(JsonParserTests, shouldKeepStringFieldsValidAfterInSituParsing)
+{
+    ASSERT_TRUE(jsonParser.parse(R"json({"data": {"escaped": "a\"b", "plain": "c"}})json"));
+    const auto data = jsonParser.getField("data");
+    ASSERT_NE(nullptr, data);
+    EXPECT_EQ("a\"b", jsonParser.getStringFieldOf(*data, "escaped").first);
+    EXPECT_EQ("c", jsonParser.getStringFieldOf(*data, "plain").first);
+}
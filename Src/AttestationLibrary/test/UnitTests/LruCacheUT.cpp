@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <Utils/LruCache.h>
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <string>
+
+using namespace intel::sgx::dcap;
+
+namespace {
+
+using Cache = LruCache<int, std::string, std::hash<int>>;
+
+} // anonymous namespace
+
+TEST(LruCacheUT, shouldEvictLeastRecentlyUsedEntry)
+{
+    Cache cache(2);
+    std::string value;
+
+    EXPECT_EQ(0u, cache.put(1, "one"));
+    EXPECT_EQ(0u, cache.put(2, "two"));
+    ASSERT_TRUE(cache.get(1, value));
+    EXPECT_EQ(1u, cache.put(3, "three"));
+
+    EXPECT_TRUE(cache.get(1, value));
+    EXPECT_EQ("one", value);
+    EXPECT_FALSE(cache.get(2, value));
+    EXPECT_TRUE(cache.get(3, value));
+    EXPECT_EQ(2u, cache.size());
+}
+
+TEST(LruCacheUT, shouldReplaceValueOfExistingKey)
+{
+    Cache cache(2);
+    std::string value;
+
+    cache.put(1, "one");
+    EXPECT_EQ(0u, cache.put(1, "uno"));
+
+    ASSERT_TRUE(cache.get(1, value));
+    EXPECT_EQ("uno", value);
+    EXPECT_EQ(1u, cache.size());
+}
+
+TEST(LruCacheUT, shouldRemoveEntryRejectedByValidation)
+{
+    Cache cache(2);
+    std::string value;
+    cache.put(1, "one");
+
+    EXPECT_FALSE(cache.get(1, value, [](const std::string&) { return false; }));
+    EXPECT_EQ(0u, cache.size());
+    EXPECT_FALSE(cache.get(1, value));
+}
+
+TEST(LruCacheUT, shouldStoreNothingWhenDisabled)
+{
+    Cache cache(0);
+    std::string value;
+
+    EXPECT_FALSE(cache.enabled());
+    EXPECT_EQ(0u, cache.put(1, "one"));
+    EXPECT_FALSE(cache.get(1, value));
+
+    cache.setCapacity(1);
+    EXPECT_TRUE(cache.enabled());
+    cache.put(1, "one");
+    EXPECT_TRUE(cache.get(1, value));
+}
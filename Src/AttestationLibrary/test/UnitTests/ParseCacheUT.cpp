@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <Utils/ParseCache.h>
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+using namespace testing;
+using namespace intel::sgx::dcap;
+
+struct ParseCacheUT : public Test
+{
+    ParseCache& cache = ParseCache::instance();
+    int parseCount = 0;
+
+    ~ParseCacheUT() override
+    {
+        cache.setCapacity(0);
+    }
+
+    std::shared_ptr<const int> get(ParseCache::Kind kind, const std::string& input)
+    {
+        return cache.getOrParse<int>(kind, input, [this, &input]() {
+            parseCount++;
+            return std::make_shared<const int>(static_cast<int>(input.size()));
+        });
+    }
+};
+
+TEST_F(ParseCacheUT, shouldParseEveryTimeWhenDisabled)
+{
+    // GIVEN
+    cache.setCapacity(0);
+
+    // WHEN
+    get(ParseCache::Kind::PCK_CRL, "input");
+    get(ParseCache::Kind::PCK_CRL, "input");
+
+    // THEN
+    EXPECT_EQ(2, parseCount);
+    const auto statistics = cache.getStatistics();
+    EXPECT_EQ(0u, statistics.hits);
+    EXPECT_EQ(0u, statistics.misses);
+    EXPECT_EQ(0u, statistics.entries);
+}
+
+TEST_F(ParseCacheUT, shouldReturnCachedObjectForIdenticalInput)
+{
+    // GIVEN
+    cache.setCapacity(4);
+
+    // WHEN
+    const auto first = get(ParseCache::Kind::TCB_INFO, "input");
+    const auto second = get(ParseCache::Kind::TCB_INFO, "input");
+
+    // THEN
+    EXPECT_EQ(1, parseCount);
+    EXPECT_EQ(first.get(), second.get());
+    const auto statistics = cache.getStatistics();
+    EXPECT_EQ(1u, statistics.hits);
+    EXPECT_EQ(1u, statistics.misses);
+    EXPECT_EQ(1u, statistics.entries);
+}
+
+TEST_F(ParseCacheUT, shouldKeepSeparateEntriesForDifferentKinds)
+{
+    // GIVEN
+    cache.setCapacity(4);
+
+    // WHEN
+    get(ParseCache::Kind::TCB_INFO, "input");
+    get(ParseCache::Kind::ENCLAVE_IDENTITY, "input");
+
+    // THEN
+    EXPECT_EQ(2, parseCount);
+    EXPECT_EQ(2u, cache.getStatistics().entries);
+}
+
+TEST_F(ParseCacheUT, shouldEvictLeastRecentlyUsedEntry)
+{
+    // GIVEN
+    cache.setCapacity(2);
+    get(ParseCache::Kind::PCK_CERTIFICATE, "a");
+    get(ParseCache::Kind::PCK_CERTIFICATE, "b");
+    get(ParseCache::Kind::PCK_CERTIFICATE, "a");
+
+    // WHEN
+    get(ParseCache::Kind::PCK_CERTIFICATE, "c");
+    get(ParseCache::Kind::PCK_CERTIFICATE, "a");
+    get(ParseCache::Kind::PCK_CERTIFICATE, "b");
+
+    // THEN
+    EXPECT_EQ(4, parseCount);
+    const auto statistics = cache.getStatistics();
+    EXPECT_EQ(2u, statistics.hits);
+    EXPECT_EQ(4u, statistics.misses);
+    EXPECT_EQ(2u, statistics.evictions);
+    EXPECT_EQ(2u, statistics.entries);
+}
+
+TEST_F(ParseCacheUT, shouldNotCacheFailedParse)
+{
+    // GIVEN
+    cache.setCapacity(2);
+    const auto failingParse = []() -> std::shared_ptr<const int> { return nullptr; };
+    const auto throwingParse = []() -> std::shared_ptr<const int> { throw std::runtime_error("parse error"); };
+
+    // WHEN
+    const auto result = cache.getOrParse<int>(ParseCache::Kind::PCK_CRL, "input", failingParse);
+
+    // THEN
+    EXPECT_EQ(nullptr, result);
+    EXPECT_THROW(cache.getOrParse<int>(ParseCache::Kind::PCK_CRL, "input", throwingParse), std::runtime_error);
+    EXPECT_EQ(0u, cache.getStatistics().entries);
+}
+
+TEST_F(ParseCacheUT, shouldClearEntriesAndStatisticsWhenCapacityIsChanged)
+{
+    // GIVEN
+    cache.setCapacity(2);
+    get(ParseCache::Kind::PCK_CRL, "input");
+    get(ParseCache::Kind::PCK_CRL, "input");
+
+    // WHEN
+    cache.setCapacity(3);
+    get(ParseCache::Kind::PCK_CRL, "input");
+
+    // THEN
+    EXPECT_EQ(2, parseCount);
+    const auto statistics = cache.getStatistics();
+    EXPECT_EQ(0u, statistics.hits);
+    EXPECT_EQ(1u, statistics.misses);
+    EXPECT_EQ(0u, statistics.evictions);
+    EXPECT_EQ(1u, statistics.entries);
+}
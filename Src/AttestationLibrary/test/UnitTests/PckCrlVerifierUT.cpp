@@ -39,10 +39,15 @@
 
 #include <CertVerification/X509Constants.h>
 #include <PckParser/PckParser.h>
+#include <Verifiers/CrlVerificationCache.h>
+#include <X509CertGenerator.h>
+#include <X509CrlGenerator.h>
 
 using namespace testing;
 using namespace intel::sgx::dcap;
 using namespace intel::sgx;
+using namespace intel::sgx::dcap::test;
+using namespace intel::sgx::dcap::parser::test;
 
 
 struct VerifyPckCrlUT : public Test
@@ -652,4 +657,99 @@ TEST_F(VerifyPckCrlUT, shouldReturnTrueWhenPckProcesorIsPresent)
 
     // THEN
     EXPECT_EQ(true, result);
-}
\ No newline at end of file
+}
+struct CrlVerificationMemoizationUT : public Test
+{
+    X509CertGenerator certGenerator;
+    X509CrlGenerator crlGenerator;
+    crypto::EVP_PKEY_uptr key = certGenerator.generateEcKeypair();
+    crypto::EVP_PKEY_uptr otherKey = certGenerator.generateEcKeypair();
+
+    void SetUp() override
+    {
+        CrlVerificationCache::instance().setCapacity(CrlVerificationCache::DEFAULT_CAPACITY);
+    }
+
+    void TearDown() override
+    {
+        CrlVerificationCache::instance().setCapacity(CrlVerificationCache::DEFAULT_CAPACITY);
+    }
+
+    crypto::X509_uptr rootCa(EVP_PKEY* rootKey)
+    {
+        return certGenerator.generateCaCert(2, {0x01}, 0, 3600, rootKey, rootKey,
+                                            constants::ROOT_CA_SUBJECT, constants::ROOT_CA_SUBJECT);
+    }
+
+    dcap::parser::x509::Certificate toCertificate(const crypto::X509_uptr& cert)
+    {
+        return dcap::parser::x509::Certificate::parse(certGenerator.x509ToString(cert.get()));
+    }
+
+    crypto::X509_CRL_uptr crlSignedBy(const crypto::X509_uptr& issuer, long nextUpdateOffset)
+    {
+        return crlGenerator.generateCRL(CRLVersion::CRL_VERSION_2, -3600, nextUpdateOffset, issuer, {{0x05}});
+    }
+
+    std::shared_ptr<pckparser::CrlStore> parse(const std::string& crlString)
+    {
+        auto crlStore = std::make_shared<pckparser::CrlStore>();
+        EXPECT_TRUE(crlStore->parse(crlString));
+        return crlStore;
+    }
+};
+
+TEST_F(CrlVerificationMemoizationUT, cacheShouldExpireEntriesAfterNextUpdate)
+{
+    auto& cache = CrlVerificationCache::instance();
+    const CrlVerificationCache::Key cacheKey{{0x01}, {0x02}};
+    const CrlVerificationCache::Key otherIssuerKey{{0x01}, {0x03}};
+
+    cache.insert(cacheKey, 100);
+
+    EXPECT_TRUE(cache.contains(cacheKey, 100));
+    EXPECT_FALSE(cache.contains(otherIssuerKey, 100));
+    EXPECT_EQ(1u, cache.size());
+    EXPECT_FALSE(cache.contains(cacheKey, 101));
+    EXPECT_EQ(0u, cache.size());
+
+    cache.setCapacity(0);
+    cache.insert(cacheKey, 100);
+    EXPECT_FALSE(cache.contains(cacheKey, 100));
+}
+
+TEST_F(CrlVerificationMemoizationUT, shouldMemoizeOnlySuccessfulVerification)
+{
+    const auto issuer = rootCa(key.get());
+    const auto x509Crl = crlSignedBy(issuer, 3600);
+    const auto crl = parse(X509CrlGenerator::x509CrlToDERString(x509Crl.get()));
+    const auto issuerCert = toCertificate(issuer);
+    const auto otherIssuerCert = toCertificate(rootCa(otherKey.get()));
+    const PckCrlVerifier pckCrlVerifier;
+
+    EXPECT_EQ(STATUS_OK, pckCrlVerifier.verify(*crl, issuerCert));
+    EXPECT_EQ(1u, CrlVerificationCache::instance().size());
+    EXPECT_EQ(STATUS_OK, pckCrlVerifier.verify(*crl, issuerCert));
+
+    // same subject but different key, signature check is not skipped
+    EXPECT_EQ(STATUS_SGX_CRL_INVALID_SIGNATURE, pckCrlVerifier.verify(*crl, otherIssuerCert));
+    EXPECT_EQ(STATUS_SGX_CRL_INVALID_SIGNATURE, pckCrlVerifier.verify(*crl, otherIssuerCert));
+    EXPECT_EQ(1u, CrlVerificationCache::instance().size());
+
+    // the same CRL in other format shares the entry
+    const auto pemCrl = parse(X509CrlGenerator::x509CrlToPEMString(x509Crl.get()));
+    EXPECT_EQ(STATUS_OK, pckCrlVerifier.verify(*pemCrl, issuerCert));
+    EXPECT_EQ(1u, CrlVerificationCache::instance().size());
+}
+
+TEST_F(CrlVerificationMemoizationUT, shouldNotReuseResultOfExpiredCrl)
+{
+    const auto issuer = rootCa(key.get());
+    const auto crl = parse(X509CrlGenerator::x509CrlToDERString(crlSignedBy(issuer, -60).get()));
+    const PckCrlVerifier pckCrlVerifier;
+
+    EXPECT_EQ(STATUS_OK, pckCrlVerifier.verify(*crl, toCertificate(issuer)));
+    EXPECT_EQ(1u, CrlVerificationCache::instance().size());
+    EXPECT_EQ(STATUS_OK, pckCrlVerifier.verify(*crl, toCertificate(issuer)));
+    EXPECT_EQ(1u, CrlVerificationCache::instance().size()); // expired entry was replaced by fresh verification
+}
@@ -95,4 +95,19 @@ TEST_F(PckParserUT, validityIsValidFalseWhenValidityInversed)
     auto result = validityInversed.isValid(toTimestamp("2022-04-14 05:00:00"));
 
     EXPECT_FALSE(result);
-}
\ No newline at end of file
+}
+
+TEST_F(PckParserUT, nameComparisonUsesComponentsAssignedAfterConstruction)
+{
+    Issuer issuer;
+    Subject subject;
+    issuer.commonName = "Intel SGX PCK Platform CA";
+    subject.commonName = "Intel SGX PCK Platform CA";
+
+    EXPECT_TRUE(issuer == subject);
+
+    subject.commonName = "Intel SGX PCK Processor CA";
+
+    EXPECT_TRUE(issuer != subject);
+    EXPECT_TRUE(subject != issuer);
+}
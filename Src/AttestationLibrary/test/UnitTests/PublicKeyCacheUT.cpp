@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <OpensslHelpers/PublicKeyCache.h>
+#include <OpensslHelpers/SignatureVerification.h>
+#include <gtest/gtest.h>
+
+#include "KeyHelpers.h"
+#include "DigestUtils.h"
+
+using namespace intel::sgx;
+
+struct PublicKeyCacheUT : public testing::Test
+{
+    dcap::crypto::PublicKeyCache& cache = dcap::crypto::PublicKeyCache::instance();
+
+    void SetUp() override
+    {
+        cache.setCapacity(dcap::crypto::PublicKeyCache::DEFAULT_CAPACITY);
+    }
+
+    void TearDown() override
+    {
+        cache.setCapacity(dcap::crypto::PublicKeyCache::DEFAULT_CAPACITY);
+    }
+
+    std::array<uint8_t, 64> rawPublicKey() const
+    {
+        const auto pub = dcap::test::pub(dcap::test::PEM_PUB);
+        return dcap::test::getRawPub(*pub);
+    }
+};
+
+TEST_F(PublicKeyCacheUT, shouldReturnKeyVerifyingSignature)
+{
+    auto prv = dcap::test::priv(dcap::test::PEM_PRV);
+    auto evp = dcap::crypto::make_unique(EVP_PKEY_new());
+    ASSERT_EQ(1, EVP_PKEY_set1_EC_KEY(evp.get(), prv.get()));
+    const std::vector<uint8_t> data(150, 0xff);
+    const auto sig = dcap::DigestUtils::signMessageSha256(data, *evp);
+    ASSERT_FALSE(sig.empty());
+
+    const auto key = cache.get(rawPublicKey());
+
+    ASSERT_NE(nullptr, key);
+    EXPECT_TRUE(dcap::crypto::verifySha256Signature(sig, data, *key));
+}
+
+TEST_F(PublicKeyCacheUT, shouldReturnSameKeyForRepeatedRawKey)
+{
+    const auto raw = rawPublicKey();
+    std::vector<uint8_t> uncompressed(raw.size() + 1, 0x04);
+    std::copy(raw.begin(), raw.end(), uncompressed.begin() + 1);
+
+    const auto first = cache.get(raw);
+    const auto second = cache.get(uncompressed);
+
+    ASSERT_NE(nullptr, first);
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_EQ(1u, cache.size());
+}
+
+TEST_F(PublicKeyCacheUT, shouldNotCacheInvalidPoint)
+{
+    std::array<uint8_t, 64> notOnCurve{};
+    notOnCurve.fill(0x01);
+
+    EXPECT_EQ(nullptr, cache.get(notOnCurve));
+    EXPECT_EQ(0u, cache.size());
+}
+
+TEST_F(PublicKeyCacheUT, shouldRejectUncompressedKeyOfWrongSize)
+{
+    EXPECT_EQ(nullptr, cache.get(std::vector<uint8_t>(64, 0x04)));
+}
+
+TEST_F(PublicKeyCacheUT, shouldNotCacheWhenDisabled)
+{
+    cache.setCapacity(0);
+
+    const auto raw = rawPublicKey();
+    const auto first = cache.get(raw);
+    const auto second = cache.get(raw);
+
+    ASSERT_NE(nullptr, first);
+    ASSERT_NE(nullptr, second);
+    EXPECT_NE(first.get(), second.get());
+    EXPECT_EQ(0u, cache.size());
+}
+
+TEST_F(PublicKeyCacheUT, shouldNotCacheConvertedKey)
+{
+    const auto key = dcap::crypto::PublicKeyCache::convert(rawPublicKey());
+
+    ASSERT_NE(nullptr, key);
+    EXPECT_EQ(0u, cache.size());
+    EXPECT_EQ(nullptr, dcap::crypto::PublicKeyCache::convert(std::array<uint8_t, 64>{}));
+}
@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "QuoteV3Generator.h"
+#include "QuoteV4Generator.h"
+#include <QuoteVerification/Quote.h>
+#include <QuoteVerification/QuoteView.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock-matchers.h>
+
+using namespace intel::sgx;
+using namespace ::testing;
+
+namespace {
+
+std::vector<uint8_t> toBytes(const dcap::ByteRange& range)
+{
+    return std::vector<uint8_t>(range.begin(), range.end());
+}
+
+bool isWithin(const dcap::ByteRange& range, const std::vector<uint8_t>& buffer)
+{
+    return range.begin() >= buffer.data() && range.end() <= buffer.data() + buffer.size();
+}
+
+} // anonymous namespace
+
+TEST(QuoteViewUT, shouldPointIntoQuoteV3Buffer)
+{
+    dcap::test::QuoteV3Generator gen;
+    gen.withCertificationData(dcap::constants::PCK_ID_PCK_CERT_CHAIN, {0x01, 0x02, 0x03});
+    gen.getAuthSize() += 3;
+    const auto rawQuote = gen.buildQuote();
+
+    dcap::QuoteView view;
+    ASSERT_TRUE(view.parse(rawQuote.data(), rawQuote.size()));
+    ASSERT_TRUE(view.validate());
+
+    EXPECT_EQ(view.getVersion(), dcap::constants::QUOTE_VERSION_3);
+    EXPECT_EQ(view.getTeeType(), dcap::constants::TEE_TYPE_SGX);
+    EXPECT_EQ(view.getHeader().data(), rawQuote.data());
+    EXPECT_EQ(toBytes(view.getHeader()), gen.getHeader().bytes());
+    EXPECT_EQ(toBytes(view.getReport()), gen.getEnclaveReport().bytes());
+    EXPECT_EQ(view.getSignedData().size(), dcap::constants::HEADER_BYTE_LEN + dcap::constants::ENCLAVE_REPORT_BYTE_LEN);
+    EXPECT_EQ(toBytes(view.getQuoteSignature()), gen.getAuthData().ecdsaSignature.bytes());
+    EXPECT_EQ(toBytes(view.getAttestKeyData()), gen.getAuthData().ecdsaAttestationKey.bytes());
+    EXPECT_EQ(toBytes(view.getQeReport()), gen.getAuthData().qeReport.bytes());
+    EXPECT_EQ(toBytes(view.getQeReportSignature()), gen.getAuthData().qeReportSignature.bytes());
+    EXPECT_EQ(toBytes(view.getQeAuthData()), gen.getAuthData().qeAuthData.data);
+    EXPECT_EQ(view.getCertificationDataType(), dcap::constants::PCK_ID_PCK_CERT_CHAIN);
+    EXPECT_THAT(toBytes(view.getCertificationData()), ElementsAre(0x01, 0x02, 0x03));
+    EXPECT_TRUE(isWithin(view.getCertificationData(), rawQuote));
+    EXPECT_TRUE(isWithin(view.getQeReport(), rawQuote));
+}
+
+TEST(QuoteViewUT, shouldPointIntoNestedQuoteV4CertificationData)
+{
+    dcap::test::QuoteV4Generator gen;
+    dcap::test::QuoteV4Generator::QEReportCertificationData qeReportCertificationData;
+    qeReportCertificationData.qeReport = gen.getEnclaveReport();
+    qeReportCertificationData.qeAuthData.size = 2;
+    qeReportCertificationData.qeAuthData.data = {0xAA, 0xBB};
+    qeReportCertificationData.certificationData.keyDataType = dcap::constants::PCK_ID_PCK_CERT_CHAIN;
+    qeReportCertificationData.certificationData.keyData = {0x01, 0x02, 0x03, 0x04};
+    qeReportCertificationData.certificationData.size = 4;
+
+    dcap::test::QuoteV4Generator::CertificationData certificationData;
+    certificationData.keyDataType = dcap::constants::PCK_ID_QE_REPORT_CERTIFICATION_DATA;
+    certificationData.keyData = qeReportCertificationData.bytes();
+    certificationData.size = static_cast<uint32_t>(certificationData.keyData.size());
+    gen.withCertificationData(certificationData);
+    gen.withAuthDataSize(static_cast<uint32_t>(gen.getAuthData().bytes().size() - sizeof(uint32_t)));
+    const auto rawQuote = gen.buildSgxQuote();
+
+    dcap::QuoteView view;
+    ASSERT_TRUE(view.parse(rawQuote.data(), rawQuote.size()));
+    ASSERT_TRUE(view.validate());
+
+    EXPECT_EQ(view.getVersion(), dcap::constants::QUOTE_VERSION_4);
+    EXPECT_EQ(toBytes(view.getQeReport()), qeReportCertificationData.qeReport.bytes());
+    EXPECT_THAT(toBytes(view.getQeAuthData()), ElementsAre(0xAA, 0xBB));
+    EXPECT_EQ(view.getCertificationDataType(), dcap::constants::PCK_ID_PCK_CERT_CHAIN);
+    EXPECT_THAT(toBytes(view.getCertificationData()), ElementsAre(0x01, 0x02, 0x03, 0x04));
+    EXPECT_TRUE(isWithin(view.getCertificationData(), rawQuote));
+
+    dcap::Quote quote;
+    dcap::crypto::Sha256Digest qeReportDigest{};
+    ASSERT_TRUE(quote.parse(rawQuote.data(), rawQuote.size()));
+    ASSERT_TRUE(dcap::crypto::sha256Digest(qeReportCertificationData.qeReport.bytes(), qeReportDigest));
+    EXPECT_EQ(qeReportDigest, quote.getQeReportDigest());
+}
+
+TEST(QuoteViewUT, shouldMatchQuoteParsing)
+{
+    const auto rawQuote = dcap::test::QuoteV3Generator{}.buildQuote();
+
+    dcap::QuoteView view;
+    dcap::Quote quote;
+    ASSERT_TRUE(view.parse(rawQuote.data(), rawQuote.size()));
+    ASSERT_TRUE(quote.parse(rawQuote.data(), rawQuote.size()));
+
+    dcap::crypto::Sha256Digest signedDataDigest{};
+    dcap::crypto::Sha256Digest qeReportDigest{};
+    ASSERT_TRUE(dcap::crypto::sha256Digest(view.getSignedData(), signedDataDigest));
+    ASSERT_TRUE(dcap::crypto::sha256Digest(view.getQeReport(), qeReportDigest));
+    EXPECT_EQ(signedDataDigest, quote.getSignedDataDigest());
+    EXPECT_EQ(qeReportDigest, quote.getQeReportDigest());
+    EXPECT_EQ(toBytes(view.getQeReport()), toBytes(quote.getQeReport().rawBlob()));
+    EXPECT_EQ(toBytes(view.getCertificationData()), quote.getCertificationData().data);
+    EXPECT_EQ(view.getAuthDataSize(), quote.getAuthDataSize());
+}
+
+TEST(QuoteViewUT, shouldNotParseTruncatedQuote)
+{
+    const auto rawQuote = dcap::test::QuoteV3Generator{}.buildQuote();
+
+    dcap::QuoteView view;
+    EXPECT_FALSE(view.parse(rawQuote.data(), rawQuote.size() - 1));
+    EXPECT_FALSE(view.parse(rawQuote.data(), dcap::constants::QUOTE_MIN_BYTE_LEN - 1));
+}
+
+TEST(QuoteViewUT, shouldNotParseQuoteWithAdditionalData)
+{
+    auto rawQuote = dcap::test::QuoteV3Generator{}.buildQuote();
+    rawQuote.push_back(0x00);
+
+    dcap::QuoteView view;
+    EXPECT_FALSE(view.parse(rawQuote.data(), rawQuote.size()));
+}
+
+TEST(QuoteViewUT, shouldNotParseAuthDataWithAdditionalData)
+{
+    dcap::test::QuoteV3Generator gen;
+    gen.withAuthDataSize(gen.getAuthSize() + 1);
+    auto rawQuote = gen.buildQuote();
+    rawQuote.push_back(0x00);
+
+    dcap::QuoteView view;
+    EXPECT_FALSE(view.parse(rawQuote.data(), rawQuote.size()));
+}
+
+TEST(QuoteViewUT, shouldKeepPreviousQuoteWhenParsingFails)
+{
+    const auto rawQuote = dcap::test::QuoteV3Generator{}.buildQuote();
+    dcap::test::QuoteV3Generator gen;
+    gen.withAuthDataSize(gen.getAuthSize() + 1);
+    auto invalidQuote = gen.buildQuote();
+    invalidQuote.push_back(0x00);
+
+    dcap::QuoteView view;
+    ASSERT_TRUE(view.parse(rawQuote.data(), rawQuote.size()));
+    ASSERT_FALSE(view.parse(invalidQuote.data(), invalidQuote.size()));
+
+    EXPECT_EQ(view.getHeader().data(), rawQuote.data());
+    EXPECT_TRUE(isWithin(view.getQuoteSignature(), rawQuote));
+    EXPECT_TRUE(isWithin(view.getAttestKeyData(), rawQuote));
+    EXPECT_TRUE(isWithin(view.getQeReport(), rawQuote));
+    EXPECT_TRUE(isWithin(view.getQeReportSignature(), rawQuote));
+    EXPECT_TRUE(isWithin(view.getQeAuthData(), rawQuote));
+    EXPECT_TRUE(isWithin(view.getCertificationData(), rawQuote));
+}
+
+TEST(QuoteViewUT, shouldNotValidateUnsupportedVersion)
+{
+    dcap::test::QuoteV3Generator gen;
+    gen.getHeader().version = 5;
+    const auto rawQuote = gen.buildQuote();
+
+    dcap::QuoteView view;
+    EXPECT_FALSE(view.parse(rawQuote.data(), rawQuote.size()) && view.validate());
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <OpensslHelpers/DigestUtils.h>
+#include <gtest/gtest.h>
+
+using namespace intel::sgx;
+
+namespace {
+
+dcap::crypto::Sha256Digest oneShot(const std::vector<uint8_t>& data)
+{
+    dcap::crypto::Sha256Digest digest{};
+    EXPECT_TRUE(dcap::crypto::sha256Digest(data, digest));
+    return digest;
+}
+
+} // anonymous namespace
+
+TEST(Sha256UT, shouldMatchKnownDigestOfEmptyInput)
+{
+    const dcap::crypto::Sha256Digest expected = {{
+        0xe3, 0xb0, 0xc4, 0x42, 0x98, 0xfc, 0x1c, 0x14, 0x9a, 0xfb, 0xf4, 0xc8, 0x99, 0x6f, 0xb9, 0x24,
+        0x27, 0xae, 0x41, 0xe4, 0x64, 0x9b, 0x93, 0x4c, 0xa4, 0x95, 0x99, 0x1b, 0x78, 0x52, 0xb8, 0x55 }};
+
+    dcap::crypto::Sha256Digest digest{};
+    ASSERT_TRUE(dcap::crypto::Sha256().finalize(digest));
+
+    EXPECT_EQ(expected, digest);
+    EXPECT_EQ(expected, oneShot({}));
+}
+
+TEST(Sha256UT, incrementalDigestShouldMatchOneShotDigest)
+{
+    std::vector<uint8_t> data(1000);
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<uint8_t>(i * 7);
+    }
+
+    dcap::crypto::Sha256 sha;
+    for (size_t offset = 0; offset < data.size(); offset += 93)
+    {
+        sha.update(dcap::ByteRange(data.data() + offset, std::min<size_t>(93, data.size() - offset)));
+    }
+    dcap::crypto::Sha256Digest digest{};
+    ASSERT_TRUE(sha.finalize(digest));
+
+    EXPECT_EQ(oneShot(data), digest);
+}
+
+TEST(Sha256UT, multiRangeDigestShouldMatchDigestOfConcatenation)
+{
+    const std::array<uint8_t, 64> attestKey{{ 0x01, 0x02, 0x03 }};
+    const std::vector<uint8_t> qeAuthData(32, 0xaa);
+    std::vector<uint8_t> concatenation(attestKey.size() + qeAuthData.size());
+    std::copy(qeAuthData.begin(), qeAuthData.end(), std::copy(attestKey.begin(), attestKey.end(), concatenation.begin()));
+
+    dcap::crypto::Sha256Digest digest{};
+    ASSERT_TRUE(dcap::crypto::sha256Digest({attestKey, qeAuthData}, digest));
+
+    EXPECT_EQ(oneShot(concatenation), digest);
+    EXPECT_EQ(dcap::crypto::sha256Digest(concatenation), std::vector<uint8_t>(digest.begin(), digest.end()));
+}
@@ -30,6 +30,7 @@
  */
 
 #include <OpensslHelpers/SignatureVerification.h>
+#include <OpensslHelpers/PublicKeyCache.h>
 #include <gtest/gtest.h>
 
 #include "DigestUtils.h"
@@ -65,3 +66,49 @@ TEST(signatureVerification, shouldVerifyRawEcdsaSignature)
     // THEN
     EXPECT_TRUE(dcap::DigestUtils::verifySig(convertedBackSignature, data, *pb));
 }
+
+struct RawEcdsaSignatureVerificationUT : public testing::Test
+{
+    std::vector<uint8_t> data = std::vector<uint8_t>(432, 0xab); // header and enclave report
+    std::array<uint8_t, 64> rawSig{};
+    dcap::crypto::Sha256Digest digest{};
+    dcap::crypto::EVP_PKEY_sptr publicKey;
+
+    void SetUp() override
+    {
+        auto prv = dcap::test::priv(dcap::test::PEM_PRV);
+        auto evp = dcap::crypto::make_unique(EVP_PKEY_new());
+        ASSERT_EQ(1, EVP_PKEY_set1_EC_KEY(evp.get(), prv.get()));
+        auto sig = dcap::DigestUtils::signMessageSha256(data, *evp);
+        ASSERT_FALSE(sig.empty());
+        rawSig = EcdsaSignatureGenerator::convertECDSASignatureToRawArray(sig);
+        ASSERT_TRUE(dcap::crypto::sha256Digest(data, digest));
+
+        const auto pub = dcap::test::pub(dcap::test::PEM_PUB);
+        publicKey = dcap::crypto::PublicKeyCache::convert(dcap::test::getRawPub(*pub));
+        ASSERT_NE(nullptr, publicKey);
+    }
+};
+
+TEST_F(RawEcdsaSignatureVerificationUT, shouldVerifyRawSignatureOverDigest)
+{
+    EXPECT_TRUE(dcap::crypto::verifyRawEcdsaSignature(rawSig, digest, *publicKey));
+    EXPECT_TRUE(dcap::crypto::verifySha256EcdsaSignature(rawSig, data, *publicKey));
+}
+
+TEST_F(RawEcdsaSignatureVerificationUT, shouldNotVerifyTamperedSignatureOrDigest)
+{
+    auto tamperedDigest = digest;
+    tamperedDigest[0] ^= 0x01;
+    auto tamperedSig = rawSig;
+    tamperedSig[40] ^= 0x01;
+
+    EXPECT_FALSE(dcap::crypto::verifyRawEcdsaSignature(rawSig, tamperedDigest, *publicKey));
+    EXPECT_FALSE(dcap::crypto::verifyRawEcdsaSignature(tamperedSig, digest, *publicKey));
+    EXPECT_TRUE(dcap::crypto::verifyRawEcdsaSignature(rawSig, digest, *publicKey));
+}
+
+TEST_F(RawEcdsaSignatureVerificationUT, shouldNotVerifyZeroSignature)
+{
+    EXPECT_FALSE(dcap::crypto::verifyRawEcdsaSignature(std::array<uint8_t, 64>{}, digest, *publicKey));
+}
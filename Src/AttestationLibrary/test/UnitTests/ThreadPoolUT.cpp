@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include <Utils/ThreadPool.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace intel::sgx::dcap;
+
+namespace {
+
+// Every call of returned task waits until callCount calls entered it, so each call runs on its own thread
+std::function<void()> rendezvous(std::atomic<size_t>& entered, size_t callCount, std::mutex& mutex, std::set<std::thread::id>& threadIds)
+{
+    return [&entered, callCount, &mutex, &threadIds]() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            threadIds.insert(std::this_thread::get_id());
+        }
+        entered++;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (entered < callCount && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::yield();
+        }
+    };
+}
+
+} // anonymous namespace
+
+TEST(ThreadPoolUT, shouldShareWorkBetweenCallerAndHelpers)
+{
+    ThreadPool pool(3);
+    std::vector<int> processed(1000, 0);
+    std::atomic<size_t> next{0};
+
+    const auto queued = pool.run(3, [&]() {
+        for (auto i = next++; i < processed.size(); i = next++)
+        {
+            processed[i]++;
+        }
+    });
+
+    EXPECT_EQ(3u, queued);
+    EXPECT_EQ(3u, pool.size());
+    EXPECT_EQ(std::vector<int>(1000, 1), processed);
+}
+
+TEST(ThreadPoolUT, shouldReuseResidentThreadsBetweenCalls)
+{
+    ThreadPool pool(3);
+    std::mutex mutex;
+    std::set<std::thread::id> firstCall;
+    std::set<std::thread::id> secondCall;
+    std::atomic<size_t> firstEntered{0};
+    std::atomic<size_t> secondEntered{0};
+
+    pool.run(2, rendezvous(firstEntered, 3, mutex, firstCall));
+    pool.run(2, rendezvous(secondEntered, 3, mutex, secondCall));
+    pool.run(1, [](){});
+
+    EXPECT_EQ(3u, firstCall.size());
+    EXPECT_EQ(firstCall, secondCall);
+    EXPECT_EQ(1u, firstCall.count(std::this_thread::get_id()));
+    EXPECT_EQ(2u, pool.size());
+}
+
+TEST(ThreadPoolUT, shouldNotWaitForJobsThatDidNotStart)
+{
+    ThreadPool pool(3);
+    std::atomic<bool> helperBusy{false};
+    std::atomic<bool> release{false};
+    std::thread busyCaller([&]() {
+        const auto callerId = std::this_thread::get_id();
+        pool.run(1, [&]() {
+            if (std::this_thread::get_id() == callerId)
+            {
+                // makes sure the pool thread takes the job before this call returns
+                while (!helperBusy)
+                {
+                    std::this_thread::yield();
+                }
+                return;
+            }
+            helperBusy = true;
+            while (!release)
+            {
+                std::this_thread::yield();
+            }
+        });
+    });
+    while (!helperBusy)
+    {
+        std::this_thread::yield();
+    }
+
+    // the only pool thread is blocked, so queued job is dropped once calling thread is done with its own call
+    std::atomic<size_t> calls{0};
+    EXPECT_EQ(1u, pool.run(1, [&]() { calls++; }));
+    EXPECT_EQ(1u, calls.load());
+
+    release = true;
+    busyCaller.join();
+    EXPECT_EQ(1u, calls.load());
+    EXPECT_EQ(1u, pool.size());
+}
+
+TEST(ThreadPoolUT, shouldNotStartMoreThanMaxThreads)
+{
+    ThreadPool pool(1);
+    std::atomic<size_t> calls{0};
+
+    EXPECT_EQ(1u, pool.run(3, [&]() { calls++; }));
+    EXPECT_EQ(1u, pool.size());
+    EXPECT_LE(calls.load(), 2u);
+    EXPECT_GE(calls.load(), 1u);
+
+    ThreadPool callerOnly(0);
+    EXPECT_EQ(0u, callerOnly.run(3, [&]() { calls++; }));
+    EXPECT_EQ(0u, callerOnly.size());
+}
+
+TEST(ThreadPoolUT, sharedPoolShouldNotExceedHardwareThreads)
+{
+    ThreadPool::instance().run(std::numeric_limits<size_t>::max(), [](){});
+
+    EXPECT_LT(ThreadPool::instance().size(), std::max(1u, std::thread::hardware_concurrency()));
+}
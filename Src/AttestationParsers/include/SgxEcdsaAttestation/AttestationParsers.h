@@ -43,6 +43,9 @@
 #endif
 
 #include <vector>
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <set>
 #include <string>
 #include <ctime>
@@ -64,8 +67,6 @@ typedef struct X509_name_st X509_NAME;
 typedef struct asn1_string_st ASN1_STRING;
 typedef struct asn1_string_st ASN1_BIT_STRING;
 typedef struct X509_extension_st X509_EXTENSION;
-struct stack_st_ASN1_TYPE;
-typedef struct asn1_type_st ASN1_TYPE;
 typedef struct x509_st X509;
 
 namespace intel { namespace sgx { namespace dcap { namespace parser
@@ -76,6 +77,8 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
 
         class TcbInfo;
         class TcbLevel;
+        class TcbInfoBlob;
+        class TcbLevelMatcher;
 
         class ATTESTATION_PARSERS_API TcbComponent
         {
@@ -93,7 +96,7 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
             uint8_t _svn = 0;
             std::string _category;
             std::string _type;
-            explicit TcbComponent(const ::rapidjson::Value& tcbComponent);
+            TcbComponent(const ::rapidjson::Value& tcbComponent, JsonParser& jsonParser);
             friend class TcbLevel;
         };
 
@@ -254,7 +257,64 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
              */
             static TcbInfo parse(const std::string& json);
 
+            /**
+             * Parses TCB Info from a character buffer, without copying it into a string first
+             * @param json - text in JSON Format, it doesn't have to be null terminated
+             * @param length - number of characters in json
+             * @return TcbInfo instance
+             *
+             * @throws intel::sgx::dcap::parser::FormatException in case of parsing error
+             */
+            static TcbInfo parse(const char* json, size_t length);
+
+            /**
+             * Find the highest TCB Level that platform TCB is higher or equal to.
+             * TCB Levels are compiled into a contiguous table of SVNs on first call, later calls on the same object
+             * reuse it. Copies of TcbInfo compile their own table.
+             * @param sgxTcbComponentSvns - 16 bytes of SGX TCB component SVNs of the platform (from PCK certificate)
+             * @param pceSvn - PCE SVN of the platform
+             * @param teeTcbSvn - 16 bytes of TDX TEE TCB SVNs or nullptr if TDX TCB components should not be compared
+             * @return pointer to TCB Level from getTcbLevels() or nullptr if platform TCB is lower than every level
+             *
+             * @throws intel::sgx::dcap::parser::FormatException if any TCB Level has CPU SVN other than 16 bytes
+             */
+            const TcbLevel* findTcbLevel(const uint8_t* sgxTcbComponentSvns, uint32_t pceSvn, const uint8_t* teeTcbSvn = nullptr) const;
+
+            /**
+             * Evaluation of platform TCB against TCB Levels of this object with memoized level selection.
+             * On the first call for given SVNs, the level findTcbLevel() would return is selected and remembered.
+             * Later calls with the same SVNs reuse it without matching. evaluate is called with the level on every call.
+             * Lookups are lock free, remembered levels are dropped together with the compiled TCB Levels, i.e. when
+             * TcbInfo is destroyed, copied or assigned.
+             * @param sgxTcbComponentSvns - 16 bytes of SGX TCB component SVNs of the platform (from PCK certificate)
+             * @param pceSvn - PCE SVN of the platform
+             * @param teeTcbSvn - 16 bytes of TDX TEE TCB SVNs or nullptr if TDX TCB components should not be compared
+             * @param evaluate - callable mapping selected level (nullptr if none matched) to a result
+             * @return result of evaluate for the selected level
+             *
+             * @throws intel::sgx::dcap::parser::FormatException if any TCB Level has CPU SVN other than 16 bytes
+             */
+            template<typename Evaluate>
+            auto evaluateTcbLevel(const uint8_t* sgxTcbComponentSvns, uint32_t pceSvn, const uint8_t* teeTcbSvn,
+                                  Evaluate&& evaluate) const -> decltype(evaluate(static_cast<const TcbLevel*>(nullptr)))
+            {
+                return evaluate(findTcbLevelMemoized(sgxTcbComponentSvns, pceSvn, teeTcbSvn));
+            }
+
         private:
+            /// Owns TCB Levels compiled on first use, never shared between TcbInfo copies
+            class TcbLevelMatcherSlot
+            {
+            public:
+                TcbLevelMatcherSlot() = default;
+                TcbLevelMatcherSlot(const TcbLevelMatcherSlot&) {}
+                TcbLevelMatcherSlot& operator=(const TcbLevelMatcherSlot&);
+                ~TcbLevelMatcherSlot();
+                const TcbLevelMatcher& get(const TcbInfo& tcbInfo);
+            private:
+                std::atomic<const TcbLevelMatcher*> _matcher{nullptr};
+            };
+
             std::string _id;
             Version _version = Version::V2;
             std::time_t _issueDate = 0;
@@ -267,10 +327,29 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
             TdxModule _tdxModule;
             int _tcbType{};
             uint32_t _tcbEvaluationDataNumber{};
+            mutable TcbLevelMatcherSlot _tcbLevelMatcher;
 
             void parsePartV2(const ::rapidjson::Value &tcbInfo, JsonParser& jsonParser);
             void parsePartV3(const ::rapidjson::Value &tcbInfo);
-            explicit TcbInfo(const std::string& jsonString);
+            const TcbLevel* findTcbLevelMemoized(const uint8_t* sgxTcbComponentSvns, uint32_t pceSvn, const uint8_t* teeTcbSvn) const;
+            TcbInfo(const char* json, size_t length);
+            friend class TcbInfoBlob;
+        };
+
+        /**
+         * TCB Level status, decoded from its string form once, when TCB Level is created
+         */
+        enum class TcbStatus : uint8_t
+        {
+            UpToDate,
+            SWHardeningNeeded,
+            ConfigurationNeeded,
+            ConfigurationAndSWHardeningNeeded,
+            OutOfDate,
+            OutOfDateConfigurationNeeded,
+            Revoked,
+            /// Status string outside of the known set, only possible for levels created with public constructors
+            Unrecognized
         };
 
         /**
@@ -404,10 +483,18 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
              *          - OutOfDate
              *          - OutOfDateConfigurationNeeded
              *          - Revoked
+             *          or the status given to a public constructor when it was not one of the above
              *
              */
             virtual const std::string& getStatus() const;
 
+            /**
+             * Get TCB level status without string comparisons
+             * @return TcbStatus matching getStatus(), TcbStatus::Unrecognized if the string is not a known status
+             *
+             */
+            TcbStatus getTcbStatus() const;
+
             /**
              * Get date and time when the TCB level was certified not to be vulnerable to any issues described in SAs that were published on or prior to this date.
              * @return std::time_t structure representing TCB Date
@@ -423,28 +510,128 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
             virtual const std::vector<std::string>& getAdvisoryIDs() const;
 
         private:
-            std::string _id;
             TcbInfo::Version _version = TcbInfo::Version::V2;
+            bool _tdx = false;
+            TcbStatus _status = TcbStatus::Unrecognized;
+            /// Position of the status string in the shared table of unrecognized statuses, 0 stands for empty string
+            uint8_t _unrecognizedStatusIndex = 0;
+            uint32_t _pceSvn;
             std::vector<uint8_t> _cpuSvnComponents;
             std::vector<TcbComponent> _sgxTcbComponents;
             std::vector<TcbComponent> _tdxTcbComponents;
-            uint32_t _pceSvn;
-            std::string _status;
             std::time_t _tcbDate;
             std::vector<std::string> _advisoryIDs{};
 
             void setCpuSvn(const ::rapidjson::Value& tcb, JsonParser& jsonParser);
-            void setTcbComponents(const ::rapidjson::Value& tcb);
+            void setTcbComponents(const ::rapidjson::Value& tcb, JsonParser& jsonParser);
             void parseSvns(const ::rapidjson::Value& tcbLevel, JsonParser& jsonParser);
-            void parseStatus(const ::rapidjson::Value &tcbLevel,
-                             const std::vector<std::string> &validStatuses,
-                             const std::string &filedName);
+            void parseStatus(const ::rapidjson::Value &tcbLevel, const std::string &filedName);
             void parseTcbLevelV2(const ::rapidjson::Value& tcbLevel, JsonParser& jsonParser);
             void parseTcbLevelV3(const ::rapidjson::Value &tcbLevel, JsonParser& jsonParser);
             void parseTcbLevelCommon(const ::rapidjson::Value& tcbLevel, JsonParser& jsonParser);
             explicit TcbLevel(const ::rapidjson::Value& tcbLevel, const uint32_t version);
-            explicit TcbLevel(const ::rapidjson::Value& tcbLevel, const uint32_t version, const std::string& id);
+            TcbLevel(const ::rapidjson::Value& tcbLevel, const uint32_t version, const std::string& id, JsonParser& jsonParser);
             friend class TcbInfo;
+            friend class TcbInfoBlob;
+        };
+
+        /**
+         * TCB Info compiled into compact, versioned binary form.
+         *
+         * Blob is position independent (all references are offsets from its beginning, integers are little endian),
+         * so it can be stored in a file and mapped back as is. Strings repeated between TCB Levels (statuses,
+         * component categories and types, advisory IDs) are stored once. Accessors read the blob in place,
+         * toTcbInfo() rebuilds TcbInfo once, without any JSON, hex or date parsing.
+         */
+        class ATTESTATION_PARSERS_API TcbInfoBlob
+        {
+        public:
+            /// Version of the binary format, blobs of other versions are rejected by the loader
+            static const uint32_t FORMAT_VERSION;
+
+            /**
+             * Read-only view of a single TCB Level stored in the blob, valid as long as the blob is
+             */
+            class ATTESTATION_PARSERS_API Level
+            {
+            public:
+                uint8_t getSgxTcbComponentSvn(uint32_t componentNumber) const;
+                uint8_t getTdxTcbComponentSvn(uint32_t componentNumber) const;
+                std::vector<uint8_t> getCpuSvn() const;
+                std::vector<TcbComponent> getSgxTcbComponents() const;
+                std::vector<TcbComponent> getTdxTcbComponents() const;
+                uint32_t getPceSvn() const;
+                std::string getStatus() const;
+                std::time_t getTcbDate() const;
+                std::vector<std::string> getAdvisoryIDs() const;
+
+            private:
+                Level(const uint8_t* blob, const uint8_t* level): _blob(blob), _level(level) {}
+                std::vector<TcbComponent> getTcbComponents(size_t offset, uint32_t flag) const;
+
+                const uint8_t* _blob;
+                const uint8_t* _level;
+                friend class TcbInfoBlob;
+            };
+
+            /**
+             * Compiles TCB Info into binary form
+             * @param tcbInfo - parsed and verified TCB Info
+             * @param keepInfoBody - whether to keep signed tcbInfo body, without it toTcbInfo() can't be verified again
+             * @return blob bytes
+             *
+             * @throws intel::sgx::dcap::parser::FormatException when TCB Info fields don't have sizes defined by spec
+             */
+            static std::vector<uint8_t> compile(const TcbInfo& tcbInfo, bool keepInfoBody = true);
+
+            /**
+             * Loads blob from memory, input is copied
+             * @throws intel::sgx::dcap::parser::FormatException when blob is malformed or in other format version
+             */
+            static TcbInfoBlob load(const std::vector<uint8_t>& blob);
+
+            /**
+             * Maps blob file into memory (reads it where mapping is not available). File must not be modified while
+             * returned object or its copies are alive.
+             * @throws intel::sgx::dcap::parser::FormatException when file can't be read or blob is malformed
+             */
+            static TcbInfoBlob map(const std::string& path);
+
+            std::string getId() const;
+            uint32_t getVersion() const;
+            std::time_t getIssueDate() const;
+            std::time_t getNextUpdate() const;
+            std::vector<uint8_t> getFmspc() const;
+            std::vector<uint8_t> getPceId() const;
+            std::vector<uint8_t> getSignature() const;
+            std::vector<uint8_t> getInfoBody() const;
+            int getTcbType() const;
+            uint32_t getTcbEvaluationDataNumber() const;
+            TdxModule getTdxModule() const;
+
+            /**
+             * @return number of TCB Levels, levels are stored in the same (descending) order as in TcbInfo::getTcbLevels()
+             */
+            size_t getTcbLevelCount() const;
+            Level getTcbLevel(size_t index) const;
+
+            /**
+             * Rebuilds TCB Info equal to the compiled one on first call, later calls and copies of the blob share it
+             * @return reference valid as long as the blob or any of its copies
+             */
+            const TcbInfo& toTcbInfo() const;
+
+        private:
+            TcbInfoBlob(std::shared_ptr<const uint8_t> data, size_t size);
+
+            TcbInfo buildTcbInfo() const;
+
+            /// TCB Info rebuilt by toTcbInfo(), shared between copies
+            struct RebuiltTcbInfo;
+
+            std::shared_ptr<const uint8_t> _data;
+            size_t _size;
+            std::shared_ptr<RebuiltTcbInfo> _rebuiltTcbInfo;
         };
 
     }
@@ -459,7 +646,7 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
         class ATTESTATION_PARSERS_API DistinguishedName
         {
         public:
-            DistinguishedName() = default;
+            DistinguishedName();
             /**
              * Create instance of DistinguishedName class
              * @param raw - string with raw distinguished name
@@ -510,6 +697,11 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
              * @return string with state name
              */
             virtual const std::string& getStateName() const;
+            /**
+             * Get hash of compared name components, consistent with operator==
+             * @return hash value
+             */
+            size_t getHash() const;
 
         private:
             std::string _raw;
@@ -518,6 +710,9 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
             std::string _organizationName;
             std::string _locationName;
             std::string _stateName;
+            size_t _hash;
+            /// Process-wide id of compared name components, equal names share it. 0 if the name was not interned.
+            uint32_t _id;
 
             explicit DistinguishedName(X509_name_st *x509Name);
 
@@ -809,32 +1004,55 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
              */
             static Certificate parse(const std::string& pem);
 
+            /**
+             * Parse DER encoded X.509 certificate
+             * Certificate created this way has no PEM representation, getPem returns empty string.
+             * @param der DER encoded X.509 certificate
+             * @param length length of der buffer, whole buffer has to be consumed by the certificate
+             * @return Certificate instance
+             *
+             * @throws intel::sgx::dcap::parser::FormatException in case of parsing error
+             */
+            static Certificate parseDer(const uint8_t* der, size_t length);
+
         protected:
             uint32_t _version;
-            DistinguishedName _subject;
-            DistinguishedName _issuer;
             Validity _validity;
-            std::vector<Extension> _extensions;
             Signature _signature;
-            std::vector<uint8_t> _serialNumber;
             std::vector<uint8_t> _pubKey;
-            std::vector<uint8_t> _info;
             std::string _pem;
             std::string _crlDistributionPoint;
 
             explicit Certificate(const std::string& pem);
+            Certificate(const uint8_t* der, size_t length);
+
+            /**
+             * Find extension by its OID without materializing all certificate extensions
+             * @param derOid - content octets of DER encoded extension OID
+             * @param derOidLength - length of derOid
+             * @param length - set to length of found extension value
+             * @return pointer to extension value owned by decoded certificate, nullptr if extension is not present
+             */
+            const uint8_t* findExtension(const uint8_t* derOid, size_t derOidLength, size_t& length) const;
 
         private:
-            void setInfo(X509* x509);
+            /**
+             * Decoded certificate together with the fields (info, serial number, subject, issuer, extensions)
+             * that are materialized from it on first access. Shared between copies.
+             */
+            struct LazyFields;
+            std::shared_ptr<LazyFields> _lazyFields;
+
+            LazyFields& lazyFields() const;
+
+            void setMembers(const X509* x509);
             void setVersion(const X509* x509);
-            void setSerialNumber(const X509* x509);
-            void setSubject(const X509* x509);
-            void setIssuer(const X509* x509);
             void setValidity(const X509* x509);
-            void setExtensions(const X509* x509);
             void setSignature(const X509* x509);
             void setPublicKey(const X509* x509);
             void setCrlDistributionPoint(const X509* x509);
+            void validateNames(const X509* x509);
+            void validateExtensions(const X509* x509);
         };
 
         enum ATTESTATION_PARSERS_API SgxType
@@ -901,10 +1119,6 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
             std::vector<uint8_t> _cpuSvn;
             std::vector<uint8_t> _cpuSvnComponents;
             uint32_t _pceSvn{};
-
-            explicit Tcb(const ASN1_TYPE *);
-
-            friend class PckCertificate;
         };
 
         /**
@@ -955,12 +1169,6 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
             bool _dynamicPlatform = true;
             bool _cachedKeys = true;
             bool _smtEnabled = true;
-
-            explicit Configuration(const ASN1_TYPE *configurationSeq);
-
-            friend class PckCertificate;
-            friend class ProcessorPckCertificate;
-            friend class PlatformPckCertificate;
         };
 
         /**
@@ -1031,6 +1239,17 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
              */
             static PckCertificate parse(const std::string& pem);
 
+            /**
+             * Parse DER encoded X.509 PCK certificate
+             * Certificate created this way has no PEM representation, getPem returns empty string.
+             * @param der DER encoded X.509 certificate
+             * @param length length of der buffer, whole buffer has to be consumed by the certificate
+             * @return PCK certificate instance
+             *
+             * @throws intel::sgx::dcap::parser::FormatException in case of parsing error
+             */
+            static PckCertificate parseDer(const uint8_t* der, size_t length);
+
         private:
             std::vector<uint8_t> _ppid;
             std::vector<uint8_t> _pceId;
@@ -1041,13 +1260,14 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
             uint8_t PROCESSOR_CA_EXTENSION_COUNT = 5;
             uint8_t PLATFORM_CA_EXTENSION_COUNT = 7;
 
-            stack_st_ASN1_TYPE* getSgxExtensions();
-            void setMembers(stack_st_ASN1_TYPE *sgxExtensions);
+            const uint8_t* getSgxExtension(size_t& length) const;
+            void setMembers(const uint8_t* sgxExtension, size_t length);
 
             explicit PckCertificate(const std::string& pem);
 
             friend class ProcessorPckCertificate;
             friend class PlatformPckCertificate;
+            friend class UnitTests;
         };
 
         /**
@@ -1076,7 +1296,7 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
         private:
             explicit ProcessorPckCertificate(const std::string& pem);
 
-            void setMembers(stack_st_ASN1_TYPE *sgxExtensions);
+            void setMembers(const uint8_t* sgxExtension, size_t length);
         };
 
         /**
@@ -1131,10 +1351,12 @@ namespace intel { namespace sgx { namespace dcap { namespace parser
         private:
             explicit PlatformPckCertificate(const std::string& pem);
 
-            void setMembers(stack_st_ASN1_TYPE *sgxExtensions);
+            void setMembers(const uint8_t* sgxExtension, size_t length);
 
             std::vector<uint8_t> _platformInstanceId;
             Configuration _configuration;
+
+            friend class UnitTests;
         };
     }
 
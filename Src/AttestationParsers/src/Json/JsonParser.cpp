@@ -32,6 +32,7 @@
 #include "JsonParser.h"
 
 #include "OpensslHelpers/Bytes.h"
+#include "Utils/Encoding.h"
 #include "Utils/TimeUtils.h"
 
 #include <rapidjson/stringbuffer.h>
@@ -42,161 +43,184 @@
 
 namespace intel { namespace sgx { namespace dcap { namespace parser { namespace json {
 
+namespace {
+
+const ::rapidjson::Value* findFieldOf(const ::rapidjson::Value &parent, const std::string &fieldName)
+{
+    if(!parent.IsObject())
+    {
+        throw intel::sgx::dcap::parser::FormatException("Fields can only be get from objects. Parent should be an object");
+    }
+    const auto member = parent.FindMember(fieldName.c_str());
+    return member != parent.MemberEnd() ? &member->value : nullptr;
+}
+
+} // anonymous namespace
+
 bool JsonParser::parse(const std::string& json)
 {
-    if(json.empty())
+    return parse(json.data(), json.size());
+}
+
+bool JsonParser::parse(const char* json, size_t length)
+{
+    if(json == nullptr || length == 0)
     {
         return false;
     }
-    jsonDocument.Parse(json.c_str());
+    jsonBuffer.assign(json, json + length);
+    jsonBuffer.push_back('\0');
+    jsonDocument.ParseInsitu(jsonBuffer.data());
     return !jsonDocument.HasParseError() && jsonDocument.IsObject();
 }
 
+const rapidjson::Value* JsonParser::getRoot() const
+{
+    return &jsonDocument;
+}
+
 const rapidjson::Value* JsonParser::getField(const std::string& fieldName) const
 {
-    if(!jsonDocument.HasMember(fieldName.c_str()))
+    if(!jsonDocument.IsObject())
     {
         return nullptr;
     }
-    return &jsonDocument[fieldName.c_str()];
+    const auto member = jsonDocument.FindMember(fieldName.c_str());
+    return member != jsonDocument.MemberEnd() ? &member->value : nullptr;
 }
 
 std::pair<std::string, JsonParser::ParseStatus> JsonParser::getStringFieldOf(const ::rapidjson::Value &parent, const std::string &fieldName) const
 {
-    if(!parent.IsObject())
-    {
-        throw intel::sgx::dcap::parser::FormatException("Fields can only be get from objects. Parent should be an object");
-    }
-    if(!parent.HasMember(fieldName.c_str()))
+    return getStringField(findFieldOf(parent, fieldName));
+}
+
+std::pair<std::vector<std::string>, JsonParser::ParseStatus> JsonParser::getStringVecFieldOf(
+        const ::rapidjson::Value& parent, const std::string& fieldName) const
+{
+    return getStringVecField(findFieldOf(parent, fieldName));
+}
+
+std::pair<std::vector<uint8_t>, JsonParser::ParseStatus> JsonParser::getBytesFieldOf(
+        const ::rapidjson::Value &parent, const std::string &fieldName, size_t length) const
+{
+    return getBytesField(findFieldOf(parent, fieldName), length);
+}
+
+std::pair<time_t, JsonParser::ParseStatus> JsonParser::getDateFieldOf(
+        const ::rapidjson::Value& parent, const std::string& fieldName) const
+{
+    return getDateField(findFieldOf(parent, fieldName));
+}
+
+std::pair<uint32_t, JsonParser::ParseStatus> JsonParser::getUintFieldOf(
+        const ::rapidjson::Value& parent, const std::string& fieldName) const
+{
+    return getUintField(findFieldOf(parent, fieldName));
+}
+
+std::pair<int, JsonParser::ParseStatus> JsonParser::getIntFieldOf(
+        const ::rapidjson::Value& parent, const std::string& fieldName) const
+{
+    return getIntField(findFieldOf(parent, fieldName));
+}
+
+std::pair<std::string, JsonParser::ParseStatus> JsonParser::getStringField(const ::rapidjson::Value* field) const
+{
+    if(field == nullptr)
     {
         return std::make_pair("", ParseStatus::Missing);
     }
-    const ::rapidjson::Value& property_v = parent[fieldName.c_str()];
-    if(!property_v.IsString())
+    if(!field->IsString())
     {
         return std::make_pair("", ParseStatus::Invalid);
     }
-
-    const std::string propertyStr = property_v.GetString();
-    return std::make_pair(propertyStr, ParseStatus::OK);
+    return std::make_pair(std::string(field->GetString()), ParseStatus::OK);
 }
 
-std::pair<std::vector<std::string>, JsonParser::ParseStatus> JsonParser::getStringVecFieldOf(
-        const ::rapidjson::Value& parent, const std::string& fieldName) const
+std::pair<std::vector<std::string>, JsonParser::ParseStatus> JsonParser::getStringVecField(const ::rapidjson::Value* field) const
 {
-    if(!parent.IsObject())
-    {
-        throw intel::sgx::dcap::parser::FormatException("Fields can only be get from objects. Parent should be an object");
-    }
     std::vector<std::string> advisoryIDs;
-    if(!parent.HasMember(fieldName.c_str()))
+    if(field == nullptr)
     {
         return std::make_pair(advisoryIDs, ParseStatus::Missing);
     }
-    const ::rapidjson::Value& property_v = parent[fieldName.c_str()];
-    if(!property_v.IsArray())
+    if(!field->IsArray())
     {
         return std::make_pair(advisoryIDs, ParseStatus::Invalid);
     }
 
-    for (rapidjson::SizeType i = 0; i < property_v.Size(); i++)
+    advisoryIDs.reserve(field->Size());
+    for (rapidjson::SizeType i = 0; i < field->Size(); i++)
     {
-        if(!property_v[i].IsString())
+        if(!(*field)[i].IsString())
         {
-            return std::make_pair(advisoryIDs, ParseStatus::Invalid);
+            return std::make_pair(std::vector<std::string>{}, ParseStatus::Invalid);
         }
-        advisoryIDs.push_back(property_v[i].GetString());
+        advisoryIDs.emplace_back((*field)[i].GetString());
     }
 
-    return std::make_pair(advisoryIDs, ParseStatus::OK);
+    return std::make_pair(std::move(advisoryIDs), ParseStatus::OK);
 }
 
-std::pair<std::vector<uint8_t>, JsonParser::ParseStatus> JsonParser::getBytesFieldOf(
-        const ::rapidjson::Value &parent, const std::string &fieldName, size_t length) const
+std::pair<std::vector<uint8_t>, JsonParser::ParseStatus> JsonParser::getBytesField(const ::rapidjson::Value* field, size_t length) const
 {
-    if(!parent.IsObject())
-    {
-        throw intel::sgx::dcap::parser::FormatException("Fields can only be get from objects. Parent should be an object");
-    }
-    if(!parent.HasMember(fieldName.c_str()))
+    if(field == nullptr)
     {
         return std::make_pair(std::vector<uint8_t>{}, ParseStatus::Missing);
     }
-    const ::rapidjson::Value& property_v = parent[fieldName.c_str()];
-    if(!property_v.IsString())
+    if(!field->IsString())
     {
         return std::make_pair(std::vector<uint8_t>{}, ParseStatus::Invalid);
     }
 
-    const std::string propertyStr = property_v.GetString();
-    if(propertyStr.length() == length && isValidHexstring(propertyStr))
+    std::vector<uint8_t> bytes(length / 2);
+    if(field->GetStringLength() == length &&
+       decodeHex(field->GetString(), length, bytes.data()) == DecodeStatus::OK)
     {
-        return std::make_pair(hexStringToBytes(propertyStr), ParseStatus::OK);
+        return std::make_pair(std::move(bytes), ParseStatus::OK);
     }
     return std::make_pair(std::vector<uint8_t>{}, ParseStatus::Invalid);
 }
 
-std::pair<time_t, JsonParser::ParseStatus> JsonParser::getDateFieldOf(
-        const ::rapidjson::Value& parent, const std::string& fieldName) const
+std::pair<time_t, JsonParser::ParseStatus> JsonParser::getDateField(const ::rapidjson::Value* field) const
 {
-    if(!parent.IsObject())
-    {
-        throw intel::sgx::dcap::parser::FormatException("Fields can only be get from objects. Parent should be an object");
-    }
-    if(!parent.HasMember(fieldName.c_str()))
+    if(field == nullptr)
     {
         return std::make_pair(time_t{}, ParseStatus::Missing);
     }
-    const auto& date = parent[fieldName.c_str()];
-    if(!date.IsString() || !isValidTimeString(date.GetString()))
+    struct tm date{};
+    time_t epoch = 0;
+    if(!field->IsString() || !parseTimeString(field->GetString(), field->GetStringLength(), date, epoch))
     {
         return std::make_pair(time_t{}, ParseStatus::Invalid);
     }
-    return std::make_pair(getEpochTimeFromString(date.GetString()), ParseStatus::OK);
+    return std::make_pair(epoch, ParseStatus::OK);
 }
 
-std::pair<uint32_t, JsonParser::ParseStatus> JsonParser::getUintFieldOf(
-        const ::rapidjson::Value& parent, const std::string& fieldName) const
+std::pair<uint32_t, JsonParser::ParseStatus> JsonParser::getUintField(const ::rapidjson::Value* field) const
 {
-    if(!parent.IsObject())
-    {
-        throw intel::sgx::dcap::parser::FormatException("Fields can only be get from objects. Parent should be an object");
-    }
-    if(!parent.HasMember(fieldName.c_str()))
+    if(field == nullptr)
     {
         return std::make_pair(0u, ParseStatus::Missing);
     }
-    const ::rapidjson::Value& value = parent[fieldName.c_str()];
-    if(!value.IsUint())
+    if(!field->IsUint())
     {
         return std::make_pair(0u, ParseStatus::Invalid);
     }
-    return std::make_pair(value.GetUint(), ParseStatus::OK);
+    return std::make_pair(field->GetUint(), ParseStatus::OK);
 }
 
-std::pair<int, JsonParser::ParseStatus> JsonParser::getIntFieldOf(
-        const ::rapidjson::Value& parent, const std::string& fieldName) const
+std::pair<int, JsonParser::ParseStatus> JsonParser::getIntField(const ::rapidjson::Value* field) const
 {
-    if(!parent.IsObject())
-    {
-        throw intel::sgx::dcap::parser::FormatException("Fields can only be get from objects. Parent should be an object");
-    }
-    if(!parent.HasMember(fieldName.c_str()))
+    if(field == nullptr)
     {
         return std::make_pair(0, ParseStatus::Missing);
     }
-    const ::rapidjson::Value& value = parent[fieldName.c_str()];
-    if(!value.IsInt())
+    if(!field->IsInt())
     {
         return std::make_pair(0, ParseStatus::Invalid);
     }
-    return std::make_pair(value.GetInt(), ParseStatus::OK);
-}
-
-bool JsonParser::isValidHexstring(const std::string& hexString) const
-{
-    return std::find_if(hexString.cbegin(), hexString.cend(),
-        [](const char c){return !::isxdigit(static_cast<unsigned char>(c));}) == hexString.cend();
+    return std::make_pair(field->GetInt(), ParseStatus::OK);
 }
 
 }}}}} // namespace intel { namespace sgx { namespace dcap { namespace parser { namespace json {
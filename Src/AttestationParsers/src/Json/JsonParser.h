@@ -35,6 +35,8 @@
 #include <rapidjson/fwd.h>
 #include <rapidjson/document.h>
 
+#include <array>
+#include <cstring>
 #include <string>
 #include <vector>
 #include <ctime>
@@ -51,6 +53,9 @@ public:
     };
 
     bool parse(const std::string& json);
+    /// Parses in-situ from a single copy of json, strings of the document point into that copy
+    bool parse(const char* json, size_t length);
+    const rapidjson::Value* getRoot() const;
     const rapidjson::Value* getField(const std::string& fieldName) const;
     std::pair<std::vector<uint8_t>, ParseStatus> getBytesFieldOf(const ::rapidjson::Value &parent,
                                                                  const std::string &fieldName, size_t length) const;
@@ -61,12 +66,65 @@ public:
     std::pair<uint32_t, ParseStatus> getUintFieldOf(const ::rapidjson::Value& parent, const std::string& fieldName) const;
     std::pair<int, ParseStatus> getIntFieldOf(const ::rapidjson::Value& parent, const std::string& fieldName) const;
 
-private:
-    bool isValidHexstring(const std::string& hexString) const;
+    // Same as above for a field that is already looked up, nullptr means a missing field
+    std::pair<std::vector<uint8_t>, ParseStatus> getBytesField(const ::rapidjson::Value* field, size_t length) const;
+    std::pair<std::string, ParseStatus> getStringField(const ::rapidjson::Value* field) const;
+    std::pair<std::vector<std::string>, ParseStatus> getStringVecField(const ::rapidjson::Value* field) const;
+    std::pair<time_t, ParseStatus> getDateField(const ::rapidjson::Value* field) const;
+    std::pair<uint32_t, ParseStatus> getUintField(const ::rapidjson::Value* field) const;
+    std::pair<int, ParseStatus> getIntField(const ::rapidjson::Value* field) const;
 
+private:
+    std::vector<char> jsonBuffer;
     rapidjson::Document jsonDocument;
 };
 
+/**
+ * Looks up a fixed set of fields of a JSON object in a single pass over its members.
+ * Names are tried in the given order first, so an object that follows the schema order
+ * resolves each member with one comparison. As with FindMember, the first occurrence wins.
+ * Every field is missing when value is not an object.
+ */
+template <size_t N>
+class JsonFields
+{
+public:
+    JsonFields(const ::rapidjson::Value& object, const std::array<const char*, N>& names)
+    {
+        fields.fill(nullptr);
+        if (!object.IsObject())
+        {
+            return;
+        }
+
+        size_t expected = 0;
+        for (auto member = object.MemberBegin(); member != object.MemberEnd(); ++member)
+        {
+            const auto* name = member->name.GetString();
+            const auto nameLength = member->name.GetStringLength();
+            for (size_t tried = 0; tried < N; tried++)
+            {
+                const auto index = (expected + tried) % N;
+                if (fields[index] == nullptr
+                    && std::strlen(names[index]) == nameLength && std::memcmp(names[index], name, nameLength) == 0)
+                {
+                    fields[index] = &member->value;
+                    expected = index + 1;
+                    break;
+                }
+            }
+        }
+    }
+
+    const ::rapidjson::Value* operator[](size_t index) const
+    {
+        return fields[index];
+    }
+
+private:
+    std::array<const ::rapidjson::Value*, N> fields;
+};
+
 }}}}} // namespace intel { namespace sgx { namespace dcap { namespace parser { namespace json {
 
 
@@ -47,13 +47,12 @@ namespace intel { namespace sgx { namespace dcap { namespace parser { namespace
         return _type;
     }
 
-    TcbComponent::TcbComponent(const ::rapidjson::Value& tcbComponent) {
+    TcbComponent::TcbComponent(const ::rapidjson::Value& tcbComponent, JsonParser& jsonParser) {
         if (!tcbComponent.IsObject())
         {
             LOG_AND_THROW(FormatException, "TCB Component should be an object");
         }
         _svn = 0;
-        JsonParser jsonParser;
 
         auto status = JsonParser::Missing;
         uint32_t svnTemporary = 0;
@@ -34,11 +34,15 @@
 #include "OpensslHelpers/Bytes.h"
 #include "X509Constants.h"
 #include "JsonParser.h"
+#include "TcbLevelMatcher.h"
+#include "Utils/JsonText.h"
 #include "Utils/Logger.h"
 
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
+#include <array>
+#include <memory>
 #include <tuple>
 
 namespace intel { namespace sgx { namespace dcap { namespace parser { namespace json {
@@ -46,9 +50,25 @@ namespace intel { namespace sgx { namespace dcap { namespace parser { namespace
 const std::string TcbInfo::SGX_ID = "SGX";
 const std::string TcbInfo::TDX_ID = "TDX";
 
+namespace {
+
+enum RootField : size_t { ROOT_TCB_INFO, ROOT_SIGNATURE };
+constexpr std::array<const char*, 2> ROOT_FIELDS = {{"tcbInfo", "signature"}};
+
+enum TcbInfoField : size_t { TCB_INFO_ID, TCB_INFO_VERSION, TCB_INFO_ISSUE_DATE, TCB_INFO_NEXT_UPDATE, TCB_INFO_FMSPC,
+                             TCB_INFO_PCE_ID, TCB_INFO_TCB_LEVELS };
+constexpr std::array<const char*, 7> TCB_INFO_FIELDS = {{"id", "version", "issueDate", "nextUpdate", "fmspc", "pceId", "tcbLevels"}};
+
+} // anonymous namespace
+
 TcbInfo TcbInfo::parse(const std::string& json)
 {
-    return TcbInfo(json);
+    return TcbInfo(json.data(), json.size());
+}
+
+TcbInfo TcbInfo::parse(const char* json, size_t length)
+{
+    return TcbInfo(json, length);
 }
 
 std::string TcbInfo::getId() const
@@ -129,17 +149,56 @@ const TdxModule& TcbInfo::getTdxModule() const
 
     return _tdxModule;
 }
+
+const TcbLevel* TcbInfo::findTcbLevel(const uint8_t* sgxTcbComponentSvns, uint32_t pceSvn, const uint8_t* teeTcbSvn) const
+{
+    return _tcbLevelMatcher.get(*this).match(sgxTcbComponentSvns, pceSvn, teeTcbSvn);
+}
+
 // private
 
-TcbInfo::TcbInfo(const std::string& jsonString)
+const TcbLevel* TcbInfo::findTcbLevelMemoized(const uint8_t* sgxTcbComponentSvns, uint32_t pceSvn, const uint8_t* teeTcbSvn) const
+{
+    return _tcbLevelMatcher.get(*this).matchMemoized(sgxTcbComponentSvns, pceSvn, teeTcbSvn);
+}
+
+TcbInfo::TcbLevelMatcherSlot& TcbInfo::TcbLevelMatcherSlot::operator=(const TcbLevelMatcherSlot&)
+{
+    delete _matcher.exchange(nullptr);
+    return *this;
+}
+
+TcbInfo::TcbLevelMatcherSlot::~TcbLevelMatcherSlot()
+{
+    delete _matcher.load();
+}
+
+const TcbLevelMatcher& TcbInfo::TcbLevelMatcherSlot::get(const TcbInfo& tcbInfo)
+{
+    auto matcher = _matcher.load(std::memory_order_acquire);
+    if (matcher == nullptr)
+    {
+        std::unique_ptr<const TcbLevelMatcher> compiled(new TcbLevelMatcher(
+                tcbInfo.getTcbLevels(), tcbInfo.getVersion() >= 3 && tcbInfo.getId() == TDX_ID));
+        // on a race the table compiled first is kept and the other one is dropped
+        if (_matcher.compare_exchange_strong(matcher, compiled.get(), std::memory_order_acq_rel))
+        {
+            matcher = compiled.release();
+        }
+    }
+    return *matcher;
+}
+
+TcbInfo::TcbInfo(const char* json, size_t length)
 {
     JsonParser jsonParser;
-    if(!jsonParser.parse(jsonString))
+    if(!jsonParser.parse(json, length))
     {
         LOG_AND_THROW(FormatException, "Could not parse TCB info JSON");
     }
 
-    const auto* tcbInfo = jsonParser.getField("tcbInfo");
+    const JsonFields<ROOT_FIELDS.size()> root(*jsonParser.getRoot(), ROOT_FIELDS);
+    const auto* tcbInfo = root[ROOT_TCB_INFO];
     if(tcbInfo == nullptr)
     {
         LOG_AND_THROW(FormatException, "Missing [tcbInfo] field of TCB info JSON");
@@ -150,13 +209,14 @@ TcbInfo::TcbInfo(const std::string& jsonString)
         LOG_AND_THROW(FormatException, "[tcbInfo] field of TCB info JSON should be an object");
     }
 
-    const auto* signatureField = jsonParser.getField("signature");
+    const auto* signatureField = root[ROOT_SIGNATURE];
     if(signatureField == nullptr)
     {
         LOG_AND_THROW(InvalidExtensionException, "Missing [signature] field of TCB info JSON");
     }
 
-    auto version = jsonParser.getUintFieldOf(*tcbInfo, "version");
+    const JsonFields<TCB_INFO_FIELDS.size()> fields(*tcbInfo, TCB_INFO_FIELDS);
+    auto version = jsonParser.getUintField(fields[TCB_INFO_VERSION]);
     JsonParser::ParseStatus status = version.second;
     switch (status)
     {
@@ -181,7 +241,7 @@ TcbInfo::TcbInfo(const std::string& jsonString)
 
     if (_version == Version::V3)
     {
-        std::tie(_id, status) = jsonParser.getStringFieldOf(*tcbInfo, "id");
+        std::tie(_id, status) = jsonParser.getStringField(fields[TCB_INFO_ID]);
         switch (status)
         {
             case JsonParser::ParseStatus::Missing:
@@ -206,7 +266,7 @@ TcbInfo::TcbInfo(const std::string& jsonString)
         _id = SGX_ID;
     }
 
-    std::tie(_issueDate, status) = jsonParser.getDateFieldOf(*tcbInfo, "issueDate");
+    std::tie(_issueDate, status) = jsonParser.getDateField(fields[TCB_INFO_ISSUE_DATE]);
     switch (status)
     {
         case JsonParser::ParseStatus::Missing:
@@ -219,7 +279,7 @@ TcbInfo::TcbInfo(const std::string& jsonString)
             LOG_AND_THROW(InvalidExtensionException, "Could not parse [id] field of TCB info JSON to string");
     }
 
-    std::tie(_nextUpdate, status) = jsonParser.getDateFieldOf(*tcbInfo, "nextUpdate");
+    std::tie(_nextUpdate, status) = jsonParser.getDateField(fields[TCB_INFO_NEXT_UPDATE]);
     switch (status)
     {
         case JsonParser::ParseStatus::Missing:
@@ -232,7 +292,7 @@ TcbInfo::TcbInfo(const std::string& jsonString)
             LOG_AND_THROW(InvalidExtensionException, "Could not parse [id] field of TCB info JSON to string");
     }
 
-    std::tie(_fmspc, status) = jsonParser.getBytesFieldOf(*tcbInfo, "fmspc", constants::FMSPC_BYTE_LEN * 2);
+    std::tie(_fmspc, status) = jsonParser.getBytesField(fields[TCB_INFO_FMSPC], constants::FMSPC_BYTE_LEN * 2);
     switch (status)
     {
         case JsonParser::ParseStatus::Missing:
@@ -245,7 +305,7 @@ TcbInfo::TcbInfo(const std::string& jsonString)
             LOG_AND_THROW(InvalidExtensionException, "Could not parse [id] field of TCB info JSON to string");
     }
 
-    std::tie(_pceId, status) = jsonParser.getBytesFieldOf(*tcbInfo, "pceId", constants::PCEID_BYTE_LEN * 2);
+    std::tie(_pceId, status) = jsonParser.getBytesField(fields[TCB_INFO_PCE_ID], constants::PCEID_BYTE_LEN * 2);
     switch (status)
     {
         case JsonParser::ParseStatus::Missing:
@@ -264,7 +324,7 @@ TcbInfo::TcbInfo(const std::string& jsonString)
     }
     _signature = hexStringToBytes(signatureField->GetString());
 
-    if(!tcbInfo->HasMember("tcbLevels"))
+    if(fields[TCB_INFO_TCB_LEVELS] == nullptr)
     {
         LOG_AND_THROW(InvalidExtensionException, "Missing [tcbLevels] field of TCB info JSON");
     }
@@ -279,7 +339,7 @@ TcbInfo::TcbInfo(const std::string& jsonString)
         parsePartV3(*tcbInfo);
     }
 
-    const auto& tcbs = (*tcbInfo)["tcbLevels"];
+    const auto& tcbs = *fields[TCB_INFO_TCB_LEVELS];
     if(!tcbs.IsArray())
     {
         LOG_AND_THROW(InvalidExtensionException, "[tcbLevels] field of TCB info JSON should be a nonempty array");
@@ -288,7 +348,7 @@ TcbInfo::TcbInfo(const std::string& jsonString)
     for(uint32_t tcbLevelIndex = 0; tcbLevelIndex < tcbs.Size(); ++tcbLevelIndex)
     {
         bool inserted = false;
-        std::tie(std::ignore, inserted) = _tcbLevels.emplace(TcbLevel(tcbs[tcbLevelIndex], static_cast<uint32_t>(_version), _id));
+        std::tie(std::ignore, inserted) = _tcbLevels.emplace(TcbLevel(tcbs[tcbLevelIndex], static_cast<uint32_t>(_version), _id, jsonParser));
         if (!inserted)
         {
 
@@ -301,6 +361,15 @@ TcbInfo::TcbInfo(const std::string& jsonString)
         LOG_AND_THROW(InvalidExtensionException, "Number of parsed [tcbLevels] should not be 0");
     }
 
+    // Signed body is taken from the input as is when it's already compact, serializing is only needed otherwise
+    const char* infoBody = nullptr;
+    size_t infoBodyLength = 0;
+    if(findCompactJsonMember(json, length, "tcbInfo", infoBody, infoBodyLength))
+    {
+        _infoBody.assign(infoBody, infoBody + infoBodyLength);
+        return;
+    }
+
     rapidjson::StringBuffer buffer;
     rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
     writer.SetMaxDecimalPlaces(25);
@@ -343,7 +412,8 @@ void TcbInfo::parsePartV2(const ::rapidjson::Value &tcbInfo, JsonParser &jsonPar
 
 void TcbInfo::parsePartV3(const ::rapidjson::Value &tcbInfo)
 {
-    auto tdxModuleExists = tcbInfo.HasMember("tdxModule");
+    const auto tdxModule = tcbInfo.FindMember("tdxModule");
+    const auto tdxModuleExists = tdxModule != tcbInfo.MemberEnd();
 
     if (_id == TcbInfo::SGX_ID && tdxModuleExists)
     {
@@ -355,7 +425,7 @@ void TcbInfo::parsePartV3(const ::rapidjson::Value &tcbInfo)
         {
             LOG_AND_THROW(InvalidExtensionException, "TCB Info JSON for TDX should have [tdxModule] field");
         }
-        const auto tdxModuleJson = &tcbInfo["tdxModule"];
+        const auto tdxModuleJson = &tdxModule->value;
         if (!tdxModuleJson->IsObject())
         {
             LOG_AND_THROW(FormatException, "[tdxModule] field should be an object");
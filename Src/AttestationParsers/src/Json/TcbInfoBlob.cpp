@@ -0,0 +1,722 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "SgxEcdsaAttestation/AttestationParsers.h"
+
+#include "X509Constants.h"
+#include "Utils/Logger.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <mutex>
+
+#if defined(__unix__) && !defined(SGX_TRUSTED)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#elif !defined(SGX_TRUSTED)
+#include <fstream>
+#include <iterator>
+#endif
+
+namespace intel { namespace sgx { namespace dcap { namespace parser { namespace json {
+
+const uint32_t TcbInfoBlob::FORMAT_VERSION = 1;
+
+struct TcbInfoBlob::RebuiltTcbInfo
+{
+    std::once_flag flag;
+    TcbInfo tcbInfo;
+};
+
+namespace {
+
+constexpr std::array<uint8_t, 8> MAGIC = {{'Q', 'V', 'L', 'T', 'C', 'B', 'I', 0}};
+constexpr size_t COMPONENT_COUNT = 16;
+constexpr size_t MRSIGNER_SIZE = 48;
+constexpr size_t ATTRIBUTES_SIZE = 8;
+
+// Header layout, offsets from the beginning of the blob
+constexpr size_t HEADER_MAGIC = 0;
+constexpr size_t HEADER_FORMAT_VERSION = 8;
+constexpr size_t HEADER_BLOB_SIZE = 12;
+constexpr size_t HEADER_TCB_INFO_VERSION = 16;
+constexpr size_t HEADER_FLAGS = 20;
+constexpr size_t HEADER_TCB_TYPE = 24;
+constexpr size_t HEADER_TCB_EVALUATION_DATA_NUMBER = 28;
+constexpr size_t HEADER_ISSUE_DATE = 32;
+constexpr size_t HEADER_NEXT_UPDATE = 40;
+constexpr size_t HEADER_FMSPC = 48;
+constexpr size_t HEADER_PCE_ID = HEADER_FMSPC + constants::FMSPC_BYTE_LEN;
+constexpr size_t HEADER_SIGNATURE = HEADER_PCE_ID + constants::PCEID_BYTE_LEN;
+constexpr size_t HEADER_MRSIGNER = HEADER_SIGNATURE + constants::ECDSA_P256_SIGNATURE_BYTE_LEN;
+constexpr size_t HEADER_ATTRIBUTES = HEADER_MRSIGNER + MRSIGNER_SIZE;
+constexpr size_t HEADER_ATTRIBUTES_MASK = HEADER_ATTRIBUTES + ATTRIBUTES_SIZE;
+constexpr size_t HEADER_LEVEL_COUNT = HEADER_ATTRIBUTES_MASK + ATTRIBUTES_SIZE;
+constexpr size_t HEADER_LEVELS_OFFSET = HEADER_LEVEL_COUNT + 4;
+constexpr size_t HEADER_STRINGS_OFFSET = HEADER_LEVELS_OFFSET + 4;
+constexpr size_t HEADER_STRINGS_SIZE = HEADER_STRINGS_OFFSET + 4;
+constexpr size_t HEADER_INFO_BODY_OFFSET = HEADER_STRINGS_SIZE + 4;
+constexpr size_t HEADER_INFO_BODY_SIZE = HEADER_INFO_BODY_OFFSET + 4;
+constexpr size_t HEADER_SIZE = HEADER_INFO_BODY_SIZE + 4;
+
+constexpr uint32_t FLAG_TDX = 0x01;
+
+// Level record layout, offsets from the beginning of the record
+constexpr size_t LEVEL_SGX_SVN = 0;
+constexpr size_t LEVEL_TDX_SVN = LEVEL_SGX_SVN + COMPONENT_COUNT;
+constexpr size_t LEVEL_PCE_SVN = LEVEL_TDX_SVN + COMPONENT_COUNT;
+constexpr size_t LEVEL_FLAGS = LEVEL_PCE_SVN + 4;
+constexpr size_t LEVEL_TCB_DATE = LEVEL_FLAGS + 4;
+constexpr size_t LEVEL_STATUS = LEVEL_TCB_DATE + 8;
+constexpr size_t LEVEL_SGX_COMPONENTS = LEVEL_STATUS + 4;
+constexpr size_t LEVEL_TDX_COMPONENTS = LEVEL_SGX_COMPONENTS + 4;
+constexpr size_t LEVEL_ADVISORY_IDS = LEVEL_TDX_COMPONENTS + 4;
+constexpr size_t LEVEL_SIZE = LEVEL_ADVISORY_IDS + 4;
+
+constexpr uint32_t LEVEL_FLAG_SGX_COMPONENTS = 0x01;
+constexpr uint32_t LEVEL_FLAG_TDX_COMPONENTS = 0x02;
+
+// Strings are stored as u32 length followed by bytes, component tables as COMPONENT_COUNT (category, type) pairs
+// of string offsets and advisory ID lists as u32 count followed by string offsets
+constexpr size_t COMPONENT_TABLE_SIZE = COMPONENT_COUNT * 2 * 4;
+
+uint32_t readU32(const uint8_t* data)
+{
+    return static_cast<uint32_t>(data[0]) | static_cast<uint32_t>(data[1]) << 8
+           | static_cast<uint32_t>(data[2]) << 16 | static_cast<uint32_t>(data[3]) << 24;
+}
+
+int64_t readI64(const uint8_t* data)
+{
+    const auto value = static_cast<uint64_t>(readU32(data)) | static_cast<uint64_t>(readU32(data + 4)) << 32;
+    int64_t ret = 0;
+    std::memcpy(&ret, &value, sizeof(ret));
+    return ret;
+}
+
+void writeU32(uint8_t* data, uint32_t value)
+{
+    for (size_t i = 0; i < 4; i++)
+    {
+        data[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+void writeI64(uint8_t* data, int64_t value)
+{
+    uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeU32(data, static_cast<uint32_t>(bits));
+    writeU32(data + 4, static_cast<uint32_t>(bits >> 32));
+}
+
+std::string readString(const uint8_t* blob, uint32_t offset)
+{
+    const auto length = readU32(blob + offset);
+    return std::string(reinterpret_cast<const char*>(blob + offset + 4), length);
+}
+
+void copyFixed(const std::vector<uint8_t>& value, size_t expectedSize, const char* name, uint8_t* out)
+{
+    if (value.size() != expectedSize)
+    {
+        LOG_AND_THROW(FormatException, std::string("Can't compile TCB Info with [") + name + "] of unexpected size");
+    }
+    std::copy(value.cbegin(), value.cend(), out);
+}
+
+/// Collects deduplicated strings, component tables and advisory ID lists of the blob
+class StringsWriter
+{
+public:
+    explicit StringsWriter(size_t baseOffset): _baseOffset(baseOffset) {}
+
+    uint32_t addString(const std::string& value)
+    {
+        const auto it = _strings.find(value);
+        if (it != _strings.end())
+        {
+            return it->second;
+        }
+        const auto offset = append(4 + value.size());
+        writeU32(&_data[offset - _baseOffset], static_cast<uint32_t>(value.size()));
+        std::copy(value.cbegin(), value.cend(), _data.begin() + static_cast<std::ptrdiff_t>(offset - _baseOffset + 4));
+        _strings.emplace(value, offset);
+        return offset;
+    }
+
+    uint32_t addComponents(const std::vector<TcbComponent>& components)
+    {
+        std::vector<uint32_t> table;
+        table.reserve(COMPONENT_COUNT * 2);
+        for (const auto& component : components)
+        {
+            table.push_back(addString(component.getCategory()));
+            table.push_back(addString(component.getType()));
+        }
+        return addTable(table, false);
+    }
+
+    uint32_t addStringList(const std::vector<std::string>& values)
+    {
+        std::vector<uint32_t> table;
+        table.reserve(values.size());
+        for (const auto& value : values)
+        {
+            table.push_back(addString(value));
+        }
+        return addTable(table, true);
+    }
+
+    const std::vector<uint8_t>& data() const
+    {
+        return _data;
+    }
+
+private:
+    uint32_t append(size_t size)
+    {
+        const auto offset = _baseOffset + _data.size();
+        if (offset + size > std::numeric_limits<uint32_t>::max())
+        {
+            LOG_AND_THROW(FormatException, "Compiled TCB Info exceeds 4GB");
+        }
+        _data.resize(_data.size() + size);
+        return static_cast<uint32_t>(offset);
+    }
+
+    uint32_t addTable(const std::vector<uint32_t>& table, bool withCount)
+    {
+        auto& tables = withCount ? _lists : _componentTables;
+        const auto it = tables.find(table);
+        if (it != tables.end())
+        {
+            return it->second;
+        }
+        const auto offset = append((withCount ? 4 : 0) + table.size() * 4);
+        auto out = &_data[offset - _baseOffset];
+        if (withCount)
+        {
+            writeU32(out, static_cast<uint32_t>(table.size()));
+            out += 4;
+        }
+        for (const auto entry : table)
+        {
+            writeU32(out, entry);
+            out += 4;
+        }
+        tables.emplace(table, offset);
+        return offset;
+    }
+
+    size_t _baseOffset;
+    std::vector<uint8_t> _data;
+    std::map<std::string, uint32_t> _strings;
+    std::map<std::vector<uint32_t>, uint32_t> _componentTables;
+    std::map<std::vector<uint32_t>, uint32_t> _lists;
+};
+
+/// Bounds checks of everything accessors read, so they don't have to check anything later
+class BlobValidator
+{
+public:
+    BlobValidator(const uint8_t* blob, uint64_t stringsBegin, uint64_t stringsEnd)
+        : _blob(blob), _stringsBegin(stringsBegin), _stringsEnd(stringsEnd) {}
+
+    bool isValidString(uint64_t offset) const
+    {
+        return contains(offset, 4) && contains(offset + 4, readU32(_blob + offset));
+    }
+
+    bool isValidComponentTable(uint64_t offset) const
+    {
+        if (!contains(offset, COMPONENT_TABLE_SIZE))
+        {
+            return false;
+        }
+        for (size_t i = 0; i < COMPONENT_COUNT * 2; i++)
+        {
+            if (!isValidString(readU32(_blob + offset + i * 4)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool isValidStringList(uint64_t offset) const
+    {
+        if (!contains(offset, 4))
+        {
+            return false;
+        }
+        const uint64_t count = readU32(_blob + offset);
+        if (!contains(offset + 4, count * 4))
+        {
+            return false;
+        }
+        for (uint64_t i = 0; i < count; i++)
+        {
+            if (!isValidString(readU32(_blob + offset + 4 + i * 4)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    bool contains(uint64_t offset, uint64_t size) const
+    {
+        return offset >= _stringsBegin && offset <= _stringsEnd && size <= _stringsEnd - offset;
+    }
+
+    const uint8_t* _blob;
+    uint64_t _stringsBegin;
+    uint64_t _stringsEnd;
+};
+
+void validate(const uint8_t* blob, size_t size)
+{
+    if (size < HEADER_SIZE || !std::equal(MAGIC.cbegin(), MAGIC.cend(), blob + HEADER_MAGIC))
+    {
+        LOG_AND_THROW(FormatException, "Data is not a compiled TCB Info");
+    }
+
+    const auto formatVersion = readU32(blob + HEADER_FORMAT_VERSION);
+    if (formatVersion != TcbInfoBlob::FORMAT_VERSION)
+    {
+        LOG_AND_THROW(FormatException, "Unsupported compiled TCB Info format version [" + std::to_string(formatVersion) + "]");
+    }
+
+    const uint64_t blobSize = readU32(blob + HEADER_BLOB_SIZE);
+    const auto tcbInfoVersion = readU32(blob + HEADER_TCB_INFO_VERSION);
+    const uint64_t levelCount = readU32(blob + HEADER_LEVEL_COUNT);
+    const uint64_t levelsOffset = readU32(blob + HEADER_LEVELS_OFFSET);
+    const uint64_t stringsOffset = readU32(blob + HEADER_STRINGS_OFFSET);
+    const uint64_t stringsEnd = stringsOffset + readU32(blob + HEADER_STRINGS_SIZE);
+    const uint64_t infoBodyEnd = uint64_t{readU32(blob + HEADER_INFO_BODY_OFFSET)} + readU32(blob + HEADER_INFO_BODY_SIZE);
+    if (blobSize > size || blobSize < HEADER_SIZE
+        || (tcbInfoVersion != static_cast<uint32_t>(TcbInfo::Version::V2) && tcbInfoVersion != static_cast<uint32_t>(TcbInfo::Version::V3))
+        || levelCount == 0 || levelsOffset < HEADER_SIZE || levelsOffset + levelCount * LEVEL_SIZE > blobSize
+        || stringsOffset < HEADER_SIZE || stringsEnd > blobSize || infoBodyEnd > blobSize)
+    {
+        LOG_AND_THROW(FormatException, "Compiled TCB Info is malformed");
+    }
+
+    const BlobValidator validator(blob, stringsOffset, stringsEnd);
+    for (uint64_t i = 0; i < levelCount; i++)
+    {
+        const auto level = blob + levelsOffset + i * LEVEL_SIZE;
+        const auto flags = readU32(level + LEVEL_FLAGS);
+        if (!validator.isValidString(readU32(level + LEVEL_STATUS))
+            || !validator.isValidStringList(readU32(level + LEVEL_ADVISORY_IDS))
+            || ((flags & LEVEL_FLAG_SGX_COMPONENTS) != 0 && !validator.isValidComponentTable(readU32(level + LEVEL_SGX_COMPONENTS)))
+            || ((flags & LEVEL_FLAG_TDX_COMPONENTS) != 0 && !validator.isValidComponentTable(readU32(level + LEVEL_TDX_COMPONENTS))))
+        {
+            LOG_AND_THROW(FormatException, "Compiled TCB Info has malformed TCB Level [" + std::to_string(i) + "]");
+        }
+    }
+}
+
+void checkComponentNumber(uint32_t componentNumber)
+{
+    if (componentNumber >= COMPONENT_COUNT)
+    {
+        std::string err = "Invalid component SVN number [" + std::to_string(componentNumber) +
+                          "]. Should be less than " + std::to_string(COMPONENT_COUNT);
+        LOG_AND_THROW(FormatException, err);
+    }
+}
+
+} // anonymous namespace
+
+std::vector<uint8_t> TcbInfoBlob::compile(const TcbInfo& tcbInfo, bool keepInfoBody)
+{
+    const auto& levels = tcbInfo._tcbLevels;
+    if (levels.empty())
+    {
+        LOG_AND_THROW(FormatException, "Can't compile TCB Info without TCB Levels");
+    }
+
+    const auto stringsOffset = HEADER_SIZE + levels.size() * LEVEL_SIZE;
+    StringsWriter strings(stringsOffset);
+    std::vector<uint8_t> records(levels.size() * LEVEL_SIZE);
+    auto record = records.data();
+    for (const auto& level : levels)
+    {
+        copyFixed(level._cpuSvnComponents, COMPONENT_COUNT, "cpuSvn", record + LEVEL_SGX_SVN);
+        uint32_t flags = 0;
+        if (!level._sgxTcbComponents.empty())
+        {
+            if (level._sgxTcbComponents.size() != COMPONENT_COUNT)
+            {
+                LOG_AND_THROW(FormatException, "Can't compile TCB Level with unexpected number of SGX TCB Components");
+            }
+            flags |= LEVEL_FLAG_SGX_COMPONENTS;
+            writeU32(record + LEVEL_SGX_COMPONENTS, strings.addComponents(level._sgxTcbComponents));
+        }
+        if (!level._tdxTcbComponents.empty())
+        {
+            if (level._tdxTcbComponents.size() != COMPONENT_COUNT)
+            {
+                LOG_AND_THROW(FormatException, "Can't compile TCB Level with unexpected number of TDX TCB Components");
+            }
+            flags |= LEVEL_FLAG_TDX_COMPONENTS;
+            for (size_t i = 0; i < COMPONENT_COUNT; i++)
+            {
+                record[LEVEL_TDX_SVN + i] = level._tdxTcbComponents[i].getSvn();
+            }
+            writeU32(record + LEVEL_TDX_COMPONENTS, strings.addComponents(level._tdxTcbComponents));
+        }
+        writeU32(record + LEVEL_PCE_SVN, level._pceSvn);
+        writeU32(record + LEVEL_FLAGS, flags);
+        writeI64(record + LEVEL_TCB_DATE, static_cast<int64_t>(level._tcbDate));
+        writeU32(record + LEVEL_STATUS, strings.addString(level.getStatus()));
+        writeU32(record + LEVEL_ADVISORY_IDS, strings.addStringList(level._advisoryIDs));
+        record += LEVEL_SIZE;
+    }
+
+    const auto infoBodySize = keepInfoBody ? tcbInfo._infoBody.size() : 0;
+    const auto infoBodyOffset = stringsOffset + strings.data().size();
+    if (infoBodyOffset + infoBodySize > std::numeric_limits<uint32_t>::max())
+    {
+        LOG_AND_THROW(FormatException, "Compiled TCB Info exceeds 4GB");
+    }
+
+    std::vector<uint8_t> blob(HEADER_SIZE);
+    std::copy(MAGIC.cbegin(), MAGIC.cend(), blob.begin() + HEADER_MAGIC);
+    writeU32(&blob[HEADER_FORMAT_VERSION], FORMAT_VERSION);
+    writeU32(&blob[HEADER_BLOB_SIZE], static_cast<uint32_t>(infoBodyOffset + infoBodySize));
+    writeU32(&blob[HEADER_TCB_INFO_VERSION], static_cast<uint32_t>(tcbInfo._version));
+    writeU32(&blob[HEADER_FLAGS], tcbInfo._id == TcbInfo::TDX_ID ? FLAG_TDX : 0);
+    writeU32(&blob[HEADER_TCB_TYPE], static_cast<uint32_t>(tcbInfo._tcbType));
+    writeU32(&blob[HEADER_TCB_EVALUATION_DATA_NUMBER], tcbInfo._tcbEvaluationDataNumber);
+    writeI64(&blob[HEADER_ISSUE_DATE], static_cast<int64_t>(tcbInfo._issueDate));
+    writeI64(&blob[HEADER_NEXT_UPDATE], static_cast<int64_t>(tcbInfo._nextUpdate));
+    copyFixed(tcbInfo._fmspc, constants::FMSPC_BYTE_LEN, "fmspc", &blob[HEADER_FMSPC]);
+    copyFixed(tcbInfo._pceId, constants::PCEID_BYTE_LEN, "pceId", &blob[HEADER_PCE_ID]);
+    copyFixed(tcbInfo._signature, constants::ECDSA_P256_SIGNATURE_BYTE_LEN, "signature", &blob[HEADER_SIGNATURE]);
+    if (tcbInfo._id == TcbInfo::TDX_ID)
+    {
+        copyFixed(tcbInfo._tdxModule.getMrSigner(), MRSIGNER_SIZE, "tdxModule.mrsigner", &blob[HEADER_MRSIGNER]);
+        copyFixed(tcbInfo._tdxModule.getAttributes(), ATTRIBUTES_SIZE, "tdxModule.attributes", &blob[HEADER_ATTRIBUTES]);
+        copyFixed(tcbInfo._tdxModule.getAttributesMask(), ATTRIBUTES_SIZE, "tdxModule.attributesMask", &blob[HEADER_ATTRIBUTES_MASK]);
+    }
+    writeU32(&blob[HEADER_LEVEL_COUNT], static_cast<uint32_t>(levels.size()));
+    writeU32(&blob[HEADER_LEVELS_OFFSET], static_cast<uint32_t>(HEADER_SIZE));
+    writeU32(&blob[HEADER_STRINGS_OFFSET], static_cast<uint32_t>(stringsOffset));
+    writeU32(&blob[HEADER_STRINGS_SIZE], static_cast<uint32_t>(strings.data().size()));
+    writeU32(&blob[HEADER_INFO_BODY_OFFSET], static_cast<uint32_t>(infoBodyOffset));
+    writeU32(&blob[HEADER_INFO_BODY_SIZE], static_cast<uint32_t>(infoBodySize));
+
+    blob.reserve(infoBodyOffset + infoBodySize);
+    blob.insert(blob.end(), records.cbegin(), records.cend());
+    blob.insert(blob.end(), strings.data().cbegin(), strings.data().cend());
+    blob.insert(blob.end(), tcbInfo._infoBody.cbegin(), tcbInfo._infoBody.cbegin() + static_cast<std::ptrdiff_t>(infoBodySize));
+    return blob;
+}
+
+TcbInfoBlob TcbInfoBlob::load(const std::vector<uint8_t>& blob)
+{
+    const auto owner = std::make_shared<std::vector<uint8_t>>(blob);
+    return TcbInfoBlob(std::shared_ptr<const uint8_t>(owner, owner->data()), owner->size());
+}
+
+TcbInfoBlob TcbInfoBlob::map(const std::string& path)
+{
+#if defined(__unix__) && !defined(SGX_TRUSTED)
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        LOG_AND_THROW(FormatException, "Can't open compiled TCB Info file: " + path);
+    }
+
+    struct stat fileStat{};
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0)
+    {
+        close(fd);
+        LOG_AND_THROW(FormatException, "Can't read size of compiled TCB Info file or it is empty: " + path);
+    }
+
+    const auto size = static_cast<size_t>(fileStat.st_size);
+    void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        LOG_AND_THROW(FormatException, "Can't map compiled TCB Info file: " + path);
+    }
+
+    return TcbInfoBlob(std::shared_ptr<const uint8_t>(static_cast<const uint8_t*>(mapping), [size](const uint8_t* data) {
+        munmap(const_cast<uint8_t*>(data), size);
+    }), size);
+#elif !defined(SGX_TRUSTED)
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        LOG_AND_THROW(FormatException, "Can't open compiled TCB Info file: " + path);
+    }
+    return load(std::vector<uint8_t>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>()));
+#else
+    LOG_AND_THROW(FormatException, "Compiled TCB Info files are not supported in enclave: " + path);
+#endif
+}
+
+TcbInfoBlob::TcbInfoBlob(std::shared_ptr<const uint8_t> data, size_t size)
+    : _data(std::move(data)), _size(size), _rebuiltTcbInfo(std::make_shared<RebuiltTcbInfo>())
+{
+    validate(_data.get(), _size);
+}
+
+std::string TcbInfoBlob::getId() const
+{
+    if (getVersion() < static_cast<uint32_t>(TcbInfo::Version::V3))
+    {
+        LOG_AND_THROW(FormatException, "TCB identifier is not a valid field in TCB Info V2 structure");
+    }
+    return (readU32(_data.get() + HEADER_FLAGS) & FLAG_TDX) != 0 ? TcbInfo::TDX_ID : TcbInfo::SGX_ID;
+}
+
+uint32_t TcbInfoBlob::getVersion() const
+{
+    return readU32(_data.get() + HEADER_TCB_INFO_VERSION);
+}
+
+std::time_t TcbInfoBlob::getIssueDate() const
+{
+    return static_cast<std::time_t>(readI64(_data.get() + HEADER_ISSUE_DATE));
+}
+
+std::time_t TcbInfoBlob::getNextUpdate() const
+{
+    return static_cast<std::time_t>(readI64(_data.get() + HEADER_NEXT_UPDATE));
+}
+
+std::vector<uint8_t> TcbInfoBlob::getFmspc() const
+{
+    const auto begin = _data.get() + HEADER_FMSPC;
+    return std::vector<uint8_t>(begin, begin + constants::FMSPC_BYTE_LEN);
+}
+
+std::vector<uint8_t> TcbInfoBlob::getPceId() const
+{
+    const auto begin = _data.get() + HEADER_PCE_ID;
+    return std::vector<uint8_t>(begin, begin + constants::PCEID_BYTE_LEN);
+}
+
+std::vector<uint8_t> TcbInfoBlob::getSignature() const
+{
+    const auto begin = _data.get() + HEADER_SIGNATURE;
+    return std::vector<uint8_t>(begin, begin + constants::ECDSA_P256_SIGNATURE_BYTE_LEN);
+}
+
+std::vector<uint8_t> TcbInfoBlob::getInfoBody() const
+{
+    const auto begin = _data.get() + readU32(_data.get() + HEADER_INFO_BODY_OFFSET);
+    return std::vector<uint8_t>(begin, begin + readU32(_data.get() + HEADER_INFO_BODY_SIZE));
+}
+
+int TcbInfoBlob::getTcbType() const
+{
+    const auto value = readU32(_data.get() + HEADER_TCB_TYPE);
+    int ret = 0;
+    std::memcpy(&ret, &value, sizeof(ret));
+    return ret;
+}
+
+uint32_t TcbInfoBlob::getTcbEvaluationDataNumber() const
+{
+    return readU32(_data.get() + HEADER_TCB_EVALUATION_DATA_NUMBER);
+}
+
+TdxModule TcbInfoBlob::getTdxModule() const
+{
+    if (getVersion() < static_cast<uint32_t>(TcbInfo::Version::V3))
+    {
+        LOG_AND_THROW(FormatException, "TdxModule is not a valid field in TCB Info V1 and V2 structure");
+    }
+    if ((readU32(_data.get() + HEADER_FLAGS) & FLAG_TDX) == 0)
+    {
+        LOG_AND_THROW(FormatException, "TdxModule is only valid for TDX TCB Info");
+    }
+
+    const auto blob = _data.get();
+    return TdxModule(std::vector<uint8_t>(blob + HEADER_MRSIGNER, blob + HEADER_MRSIGNER + MRSIGNER_SIZE),
+                     std::vector<uint8_t>(blob + HEADER_ATTRIBUTES, blob + HEADER_ATTRIBUTES + ATTRIBUTES_SIZE),
+                     std::vector<uint8_t>(blob + HEADER_ATTRIBUTES_MASK, blob + HEADER_ATTRIBUTES_MASK + ATTRIBUTES_SIZE));
+}
+
+size_t TcbInfoBlob::getTcbLevelCount() const
+{
+    return readU32(_data.get() + HEADER_LEVEL_COUNT);
+}
+
+TcbInfoBlob::Level TcbInfoBlob::getTcbLevel(size_t index) const
+{
+    if (index >= getTcbLevelCount())
+    {
+        LOG_AND_THROW(FormatException, "Invalid TCB Level index [" + std::to_string(index) + "]");
+    }
+    return Level(_data.get(), _data.get() + readU32(_data.get() + HEADER_LEVELS_OFFSET) + index * LEVEL_SIZE);
+}
+
+const TcbInfo& TcbInfoBlob::toTcbInfo() const
+{
+    std::call_once(_rebuiltTcbInfo->flag, [this] {
+        _rebuiltTcbInfo->tcbInfo = buildTcbInfo();
+    });
+    return _rebuiltTcbInfo->tcbInfo;
+}
+
+TcbInfo TcbInfoBlob::buildTcbInfo() const
+{
+    TcbInfo tcbInfo;
+    tcbInfo._version = static_cast<TcbInfo::Version>(getVersion());
+    tcbInfo._id = (readU32(_data.get() + HEADER_FLAGS) & FLAG_TDX) != 0 ? TcbInfo::TDX_ID : TcbInfo::SGX_ID;
+    tcbInfo._issueDate = getIssueDate();
+    tcbInfo._nextUpdate = getNextUpdate();
+    tcbInfo._fmspc = getFmspc();
+    tcbInfo._pceId = getPceId();
+    tcbInfo._signature = getSignature();
+    tcbInfo._infoBody = getInfoBody();
+    tcbInfo._tcbType = getTcbType();
+    tcbInfo._tcbEvaluationDataNumber = getTcbEvaluationDataNumber();
+    if (tcbInfo._id == TcbInfo::TDX_ID)
+    {
+        tcbInfo._tdxModule = getTdxModule();
+    }
+
+    const auto levelCount = getTcbLevelCount();
+    for (size_t i = 0; i < levelCount; i++)
+    {
+        const auto view = getTcbLevel(i);
+        TcbLevel level(view.getCpuSvn(), view.getPceSvn(), view.getStatus(), view.getTcbDate(), view.getAdvisoryIDs());
+        level._tdx = tcbInfo._id == TcbInfo::TDX_ID;
+        level._version = tcbInfo._version;
+        level._sgxTcbComponents = view.getTcbComponents(LEVEL_SGX_COMPONENTS, LEVEL_FLAG_SGX_COMPONENTS);
+        level._tdxTcbComponents = view.getTcbComponents(LEVEL_TDX_COMPONENTS, LEVEL_FLAG_TDX_COMPONENTS);
+        // levels are stored in set order, so each one goes to the end
+        tcbInfo._tcbLevels.emplace_hint(tcbInfo._tcbLevels.end(), std::move(level));
+    }
+    return tcbInfo;
+}
+
+uint8_t TcbInfoBlob::Level::getSgxTcbComponentSvn(uint32_t componentNumber) const
+{
+    checkComponentNumber(componentNumber);
+    return _level[LEVEL_SGX_SVN + componentNumber];
+}
+
+uint8_t TcbInfoBlob::Level::getTdxTcbComponentSvn(uint32_t componentNumber) const
+{
+    checkComponentNumber(componentNumber);
+    if ((readU32(_level + LEVEL_FLAGS) & LEVEL_FLAG_TDX_COMPONENTS) == 0)
+    {
+        LOG_AND_THROW(FormatException, "TDX TCB Components are present only in TDX TCB Info V3 structure");
+    }
+    return _level[LEVEL_TDX_SVN + componentNumber];
+}
+
+std::vector<uint8_t> TcbInfoBlob::Level::getCpuSvn() const
+{
+    return std::vector<uint8_t>(_level + LEVEL_SGX_SVN, _level + LEVEL_SGX_SVN + COMPONENT_COUNT);
+}
+
+std::vector<TcbComponent> TcbInfoBlob::Level::getSgxTcbComponents() const
+{
+    if ((readU32(_level + LEVEL_FLAGS) & LEVEL_FLAG_SGX_COMPONENTS) == 0)
+    {
+        LOG_AND_THROW(FormatException, "SGX TCB Components is not a valid field in TCB Info V1 and V2 structure");
+    }
+    return getTcbComponents(LEVEL_SGX_COMPONENTS, LEVEL_FLAG_SGX_COMPONENTS);
+}
+
+std::vector<TcbComponent> TcbInfoBlob::Level::getTdxTcbComponents() const
+{
+    if ((readU32(_level + LEVEL_FLAGS) & LEVEL_FLAG_TDX_COMPONENTS) == 0)
+    {
+        LOG_AND_THROW(FormatException, "TDX TCB Components are present only in TDX TCB Info V3 structure");
+    }
+    return getTcbComponents(LEVEL_TDX_COMPONENTS, LEVEL_FLAG_TDX_COMPONENTS);
+}
+
+uint32_t TcbInfoBlob::Level::getPceSvn() const
+{
+    return readU32(_level + LEVEL_PCE_SVN);
+}
+
+std::string TcbInfoBlob::Level::getStatus() const
+{
+    return readString(_blob, readU32(_level + LEVEL_STATUS));
+}
+
+std::time_t TcbInfoBlob::Level::getTcbDate() const
+{
+    return static_cast<std::time_t>(readI64(_level + LEVEL_TCB_DATE));
+}
+
+std::vector<std::string> TcbInfoBlob::Level::getAdvisoryIDs() const
+{
+    const auto list = _blob + readU32(_level + LEVEL_ADVISORY_IDS);
+    const auto count = readU32(list);
+    std::vector<std::string> ret;
+    ret.reserve(count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        ret.push_back(readString(_blob, readU32(list + 4 + i * 4)));
+    }
+    return ret;
+}
+
+std::vector<TcbComponent> TcbInfoBlob::Level::getTcbComponents(size_t offset, uint32_t flag) const
+{
+    if ((readU32(_level + LEVEL_FLAGS) & flag) == 0)
+    {
+        return {};
+    }
+
+    const auto svns = _level + (flag == LEVEL_FLAG_SGX_COMPONENTS ? LEVEL_SGX_SVN : LEVEL_TDX_SVN);
+    const auto table = _blob + readU32(_level + offset);
+    std::vector<TcbComponent> ret;
+    ret.reserve(COMPONENT_COUNT);
+    for (size_t i = 0; i < COMPONENT_COUNT; i++)
+    {
+        ret.emplace_back(svns[i], readString(_blob, readU32(table + i * 8)), readString(_blob, readU32(table + i * 8 + 4)));
+    }
+    return ret;
+}
+
+}}}}} // namespace intel { namespace sgx { namespace dcap { namespace parser { namespace json {
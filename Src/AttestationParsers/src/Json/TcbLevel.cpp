@@ -37,18 +37,103 @@
 #include <array>
 #include <tuple>
 #include <algorithm>
+#include <mutex>
 #include "Utils/Logger.h"
 
 namespace intel { namespace sgx { namespace dcap { namespace parser { namespace json {
 
 static constexpr size_t SGX_TCB_SVN_COMP_COUNT = 16;
 
+// Field names of TCB Level V2 [tcb] object, in the order they are expected to appear
+static constexpr std::array<const char*, SGX_TCB_SVN_COMP_COUNT> SGX_TCB_SVN_COMPONENT_NAMES {{
+        "sgxtcbcomp01svn", "sgxtcbcomp02svn", "sgxtcbcomp03svn", "sgxtcbcomp04svn",
+        "sgxtcbcomp05svn", "sgxtcbcomp06svn", "sgxtcbcomp07svn", "sgxtcbcomp08svn",
+        "sgxtcbcomp09svn", "sgxtcbcomp10svn", "sgxtcbcomp11svn", "sgxtcbcomp12svn",
+        "sgxtcbcomp13svn", "sgxtcbcomp14svn", "sgxtcbcomp15svn", "sgxtcbcomp16svn"
+}};
+
+namespace {
+
+// Indexed by TcbStatus, the last entry stands for TcbStatus::Unrecognized and is never returned by getStatus()
+const std::array<std::string, 8>& tcbStatusNames()
+{
+    static const std::array<std::string, 8> names = {{
+        "UpToDate", "SWHardeningNeeded", "ConfigurationNeeded", "ConfigurationAndSWHardeningNeeded",
+        "OutOfDate", "OutOfDateConfigurationNeeded", "Revoked", ""
+    }};
+    return names;
+}
+
+TcbStatus toTcbStatus(const std::string& status)
+{
+    const auto& names = tcbStatusNames();
+    for (size_t i = 0; i < static_cast<size_t>(TcbStatus::Unrecognized); i++)
+    {
+        if (names[i] == status)
+        {
+            return static_cast<TcbStatus>(i);
+        }
+    }
+    return TcbStatus::Unrecognized;
+}
+
+/**
+ * Unrecognized statuses only come from public constructors, TCB Levels parsed from JSON never keep a string.
+ * Every distinct one is stored once and levels refer to it by index. Entries are never changed once written,
+ * so reads don't lock. When the table is full, further statuses are stored as empty string at index 0.
+ */
+class UnrecognizedStatusTable
+{
+public:
+    static UnrecognizedStatusTable& instance()
+    {
+        static UnrecognizedStatusTable table;
+        return table;
+    }
+
+    uint8_t indexOf(const std::string& status)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const auto begin = _statuses.cbegin();
+        const auto end = begin + _size;
+        const auto found = std::find(begin, end, status);
+        if (found != end)
+        {
+            return static_cast<uint8_t>(found - begin);
+        }
+        if (_size == _statuses.size())
+        {
+            return 0;
+        }
+        _statuses[_size] = status;
+        return static_cast<uint8_t>(_size++);
+    }
+
+    const std::string& at(uint8_t index) const
+    {
+        return _statuses[index];
+    }
+
+private:
+    std::mutex _mutex;
+    std::array<std::string, 256> _statuses{};
+    size_t _size = 1;
+};
+
+uint8_t unrecognizedStatusIndex(TcbStatus tcbStatus, const std::string& status)
+{
+    return tcbStatus == TcbStatus::Unrecognized ? UnrecognizedStatusTable::instance().indexOf(status) : 0;
+}
+
+} // anonymous namespace
+
 TcbLevel::TcbLevel(const std::vector<uint8_t>& cpuSvnComponents,
                    uint32_t pceSvn,
                    const std::string& status): _version(TcbInfo::Version::V2),
-                                               _cpuSvnComponents(cpuSvnComponents),
+                                               _status(toTcbStatus(status)),
+                                               _unrecognizedStatusIndex(unrecognizedStatusIndex(_status, status)),
                                                _pceSvn(pceSvn),
-                                               _status(status),
+                                               _cpuSvnComponents(cpuSvnComponents),
                                                _tcbDate(0)
 {}
 
@@ -57,9 +142,10 @@ TcbLevel::TcbLevel(const std::vector<uint8_t>& cpuSvnComponents,
                    const std::string& status,
                    const  std::time_t tcbDate,
                    std::vector<std::string> advisoryIDs): _version(TcbInfo::Version::V2),
-                                                          _cpuSvnComponents(cpuSvnComponents),
+                                                          _status(toTcbStatus(status)),
+                                                          _unrecognizedStatusIndex(unrecognizedStatusIndex(_status, status)),
                                                           _pceSvn(pceSvn),
-                                                          _status(status),
+                                                          _cpuSvnComponents(cpuSvnComponents),
                                                           _tcbDate(tcbDate),
                                                           _advisoryIDs(std::move(advisoryIDs))
 {}
@@ -68,12 +154,13 @@ TcbLevel::TcbLevel(const std::string& id,
                    const std::vector<TcbComponent>& sgxTcbComponents,
                    const std::vector<TcbComponent>& tdxTcbComponents,
                    const uint32_t pceSvn,
-                   const std::string& status): _id(id),
-                                              _version(TcbInfo::Version::V3),
+                   const std::string& status): _version(TcbInfo::Version::V3),
+                                              _tdx(id == TcbInfo::TDX_ID),
+                                              _status(toTcbStatus(status)),
+                                              _unrecognizedStatusIndex(unrecognizedStatusIndex(_status, status)),
+                                              _pceSvn(pceSvn),
                                               _sgxTcbComponents(sgxTcbComponents),
                                               _tdxTcbComponents(tdxTcbComponents),
-                                              _pceSvn(pceSvn),
-                                              _status(status),
                                               _tcbDate(0)
 {
     for (uint32_t i = 0; i < sgxTcbComponents.size(); i++)
@@ -86,7 +173,7 @@ bool TcbLevel::operator>(const TcbLevel& other) const
 {
     if(_cpuSvnComponents == other._cpuSvnComponents)
     {
-        if (_version == TcbInfo::Version::V3 && _id == TcbInfo::TDX_ID && _pceSvn == other._pceSvn)
+        if (_version == TcbInfo::Version::V3 && _tdx && _pceSvn == other._pceSvn)
         {
             return _tdxTcbComponents > other._tdxTcbComponents;
         }
@@ -138,7 +225,7 @@ const TcbComponent& TcbLevel::getTdxTcbComponent(uint32_t componentNumber) const
     {
         LOG_AND_THROW(FormatException, "TDX TCB Components is not a valid field in TCB Info V1 and V2 structure");
     }
-    if (_id != TcbInfo::TDX_ID)
+    if (!_tdx)
     {
         LOG_AND_THROW(FormatException, "TDX TCB Components is not a valid field in SGX TCB Info structure");
     }
@@ -151,7 +238,7 @@ const std::vector<TcbComponent>& TcbLevel::getTdxTcbComponents() const
     {
         LOG_AND_THROW(FormatException, "TDX TCB Components is not a valid field in TCB Info V1 and V2 structure");
     }
-    if (_id != TcbInfo::TDX_ID)
+    if (!_tdx)
     {
         LOG_AND_THROW(FormatException, "TDX TCB Components is not a valid field in SGX TCB Info structure");
     }
@@ -169,6 +256,15 @@ uint32_t TcbLevel::getPceSvn() const
 }
 
 const std::string& TcbLevel::getStatus() const
+{
+    if (_status == TcbStatus::Unrecognized)
+    {
+        return UnrecognizedStatusTable::instance().at(_unrecognizedStatusIndex);
+    }
+    return tcbStatusNames()[static_cast<size_t>(_status)];
+}
+
+TcbStatus TcbLevel::getTcbStatus() const
 {
     return _status;
 }
@@ -185,11 +281,10 @@ const std::vector<std::string>& TcbLevel::getAdvisoryIDs() const
 
 // private
 
-TcbLevel::TcbLevel(const ::rapidjson::Value& tcbLevel, const uint32_t version, const std::string& id)
+TcbLevel::TcbLevel(const ::rapidjson::Value& tcbLevel, const uint32_t version, const std::string& id, JsonParser& jsonParser)
 {
-    JsonParser jsonParser;
     _version = (TcbInfo::Version)version;
-    _id = id;
+    _tdx = id == TcbInfo::TDX_ID;
     switch(version)
     {
         case 2:
@@ -204,35 +299,36 @@ TcbLevel::TcbLevel(const ::rapidjson::Value& tcbLevel, const uint32_t version, c
     }
 }
 
-void TcbLevel::parseStatus(const ::rapidjson::Value &tcbLevel,
-                           const std::vector<std::string> &validStatuses,
-                           const std::string &filedName)
+void TcbLevel::parseStatus(const ::rapidjson::Value &tcbLevel, const std::string &filedName)
 {
-    if(!tcbLevel.HasMember(filedName.c_str()))
+    const auto status_m = tcbLevel.FindMember(filedName.c_str());
+    if(status_m == tcbLevel.MemberEnd())
     {
         LOG_AND_THROW(FormatException, "TCB level JSON should has [" + filedName + "] field");
     }
 
-    const ::rapidjson::Value& status_v = tcbLevel[filedName.c_str()];
+    const ::rapidjson::Value& status_v = status_m->value;
     if(!status_v.IsString())
     {
         LOG_AND_THROW(FormatException, "TCB level [" + filedName + "] JSON field should be a string");
     }
-    _status = status_v.GetString();
-    if(std::find(validStatuses.cbegin(), validStatuses.cend(), _status) == validStatuses.cend())
+    const std::string status = status_v.GetString();
+    _status = toTcbStatus(status);
+    if(_status == TcbStatus::Unrecognized)
     {
-        LOG_AND_THROW(InvalidExtensionException, "TCB level [" + filedName + "] JSON field has invalid value [" + _status + "]");
+        LOG_AND_THROW(InvalidExtensionException, "TCB level [" + filedName + "] JSON field has invalid value [" + status + "]");
     }
 }
 
 void TcbLevel::parseSvns(const ::rapidjson::Value &tcbLevel, JsonParser& jsonParser)
 {
-    if(!tcbLevel.HasMember("tcb"))
+    const auto tcbMember = tcbLevel.FindMember("tcb");
+    if(tcbMember == tcbLevel.MemberEnd())
     {
         LOG_AND_THROW(FormatException, "TCB level JSON should has [tcb] field");
     }
 
-    const ::rapidjson::Value& tcb = tcbLevel["tcb"];
+    const ::rapidjson::Value& tcb = tcbMember->value;
 
     setCpuSvn(tcb, jsonParser);
 
@@ -274,9 +370,7 @@ void TcbLevel::parseTcbLevelCommon(const ::rapidjson::Value& tcbLevel, JsonParse
             break;
     }
 
-    static const std::vector<std::string> validStatuses =
-            {{"UpToDate", "OutOfDate", "ConfigurationNeeded", "Revoked", "OutOfDateConfigurationNeeded", "SWHardeningNeeded", "ConfigurationAndSWHardeningNeeded"}};
-    parseStatus(tcbLevel, validStatuses, "tcbStatus");
+    parseStatus(tcbLevel, "tcbStatus");
 }
 void TcbLevel::parseTcbLevelV2(const ::rapidjson::Value &tcbLevel, JsonParser& jsonParser)
 {
@@ -287,12 +381,13 @@ void TcbLevel::parseTcbLevelV2(const ::rapidjson::Value &tcbLevel, JsonParser& j
 void TcbLevel::parseTcbLevelV3(const ::rapidjson::Value &tcbLevel, JsonParser& jsonParser)
 {
     parseTcbLevelCommon(tcbLevel, jsonParser);
-    if(!tcbLevel.HasMember("tcb"))
+    const auto tcbMember = tcbLevel.FindMember("tcb");
+    if(tcbMember == tcbLevel.MemberEnd())
     {
         LOG_AND_THROW(FormatException, "TCB level JSON should has [tcb] field");
     }
 
-    const ::rapidjson::Value& tcb = tcbLevel["tcb"];
+    const ::rapidjson::Value& tcb = tcbMember->value;
 
     if(!tcb.IsObject())
     {
@@ -306,16 +401,17 @@ void TcbLevel::parseTcbLevelV3(const ::rapidjson::Value &tcbLevel, JsonParser& j
         LOG_AND_THROW(FormatException, "Could not parse [pcesvn] field of TCB level JSON to unsigned integer");
     }
 
-    setTcbComponents(tcb);
+    setTcbComponents(tcb, jsonParser);
 }
 
-void TcbLevel::setTcbComponents(const rapidjson::Value &tcb) {
-    if(!tcb.HasMember("sgxtcbcomponents"))
+void TcbLevel::setTcbComponents(const rapidjson::Value &tcb, JsonParser& jsonParser) {
+    const auto sgxComponents = tcb.FindMember("sgxtcbcomponents");
+    if(sgxComponents == tcb.MemberEnd())
     {
         LOG_AND_THROW(FormatException, "TCB level JSON should have [sgxtcbcomponents] field");
     }
 
-    const auto& sgxComponentsArray = tcb["sgxtcbcomponents"];
+    const auto& sgxComponentsArray = sgxComponents->value;
 
     if(!sgxComponentsArray.IsArray())
     {
@@ -328,19 +424,20 @@ void TcbLevel::setTcbComponents(const rapidjson::Value &tcb) {
     _sgxTcbComponents.reserve(SGX_TCB_SVN_COMP_COUNT);
     _cpuSvnComponents.reserve(SGX_TCB_SVN_COMP_COUNT);
     for (auto itr = sgxComponentsArray.Begin(); itr != sgxComponentsArray.End(); ++itr) {
-        auto component = TcbComponent(*itr);
+        auto component = TcbComponent(*itr, jsonParser);
         _sgxTcbComponents.push_back(component);
         // backward compatibility
         _cpuSvnComponents.push_back(component.getSvn());
     }
 
-    if(_id == TcbInfo::TDX_ID)
+    if(_tdx)
     {
-        if(!tcb.HasMember("tdxtcbcomponents"))
+        const auto tdxComponents = tcb.FindMember("tdxtcbcomponents");
+        if(tdxComponents == tcb.MemberEnd())
         {
             LOG_AND_THROW(FormatException, "TCB level JSON for TDX should have [tdxtcbcomponents] field");
         }
-        const auto& tdxComponentsArray = tcb["tdxtcbcomponents"];
+        const auto& tdxComponentsArray = tdxComponents->value;
         if(!tdxComponentsArray.IsArray())
         {
             LOG_AND_THROW(FormatException, "TCB level JSON's [tdxtcbcomponents] field should be an array");
@@ -352,7 +449,7 @@ void TcbLevel::setTcbComponents(const rapidjson::Value &tcb) {
         _tdxTcbComponents.reserve(SGX_TCB_SVN_COMP_COUNT);
 
         for (auto itr = tdxComponentsArray.Begin(); itr != tdxComponentsArray.End(); ++itr) {
-            auto component = TcbComponent(*itr);
+            auto component = TcbComponent(*itr, jsonParser);
             _tdxTcbComponents.push_back(component);
         }
     }
@@ -360,44 +457,25 @@ void TcbLevel::setTcbComponents(const rapidjson::Value &tcb) {
 
 void TcbLevel::setCpuSvn(const ::rapidjson::Value& tcb, JsonParser& jsonParser)
 {
-
-    const std::array<std::string, SGX_TCB_SVN_COMP_COUNT> sgxTcbSvnComponentsNames {{
-                                                                                            "sgxtcbcomp01svn",
-                                                                                            "sgxtcbcomp02svn",
-                                                                                            "sgxtcbcomp03svn",
-                                                                                            "sgxtcbcomp04svn",
-                                                                                            "sgxtcbcomp05svn",
-                                                                                            "sgxtcbcomp06svn",
-                                                                                            "sgxtcbcomp07svn",
-                                                                                            "sgxtcbcomp08svn",
-                                                                                            "sgxtcbcomp09svn",
-                                                                                            "sgxtcbcomp10svn",
-                                                                                            "sgxtcbcomp11svn",
-                                                                                            "sgxtcbcomp12svn",
-                                                                                            "sgxtcbcomp13svn",
-                                                                                            "sgxtcbcomp14svn",
-                                                                                            "sgxtcbcomp15svn",
-                                                                                            "sgxtcbcomp16svn",
-                                                                                    }};
-
     if(!tcb.IsObject())
     {
         LOG_AND_THROW(FormatException, "[tcb] field of TCB level should be a JSON object");
     }
 
+    const JsonFields<SGX_TCB_SVN_COMP_COUNT> components(tcb, SGX_TCB_SVN_COMPONENT_NAMES);
     _cpuSvnComponents.reserve(SGX_TCB_SVN_COMP_COUNT);
-    for(const auto &componentName : sgxTcbSvnComponentsNames)
+    for(size_t index = 0; index < SGX_TCB_SVN_COMP_COUNT; index++)
     {
-        const auto componentNameRaw = componentName.data();
+        const auto* componentName = SGX_TCB_SVN_COMPONENT_NAMES[index];
         JsonParser::ParseStatus status = JsonParser::Missing;
         uint32_t componentValue = 0u;
-        std::tie(componentValue, status) = jsonParser.getUintFieldOf(tcb, componentNameRaw);
+        std::tie(componentValue, status) = jsonParser.getUintField(components[index]);
         switch (status)
         {
             case JsonParser::ParseStatus::Missing:
-                LOG_AND_THROW(FormatException, "TCB level JSON should has [" + componentName + "] field");
+                LOG_AND_THROW(FormatException, std::string("TCB level JSON should has [") + componentName + "] field");
             case JsonParser::ParseStatus::Invalid:
-                LOG_AND_THROW(InvalidExtensionException, "Could not parse [" + componentName + "] field of TCB level JSON to unsigned integer");
+                LOG_AND_THROW(InvalidExtensionException, std::string("Could not parse [") + componentName + "] field of TCB level JSON to unsigned integer");
             case JsonParser::ParseStatus::OK:
                 break;
         }
@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "TcbLevelMatcher.h"
+
+#include "Utils/Logger.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace intel { namespace sgx { namespace dcap { namespace parser { namespace json {
+
+constexpr size_t TcbLevelMatcher::SVN_COUNT;
+constexpr size_t TcbLevelMatcher::MEMO_SLOTS;
+constexpr size_t TcbLevelMatcher::MEMO_KEY_WORDS;
+
+namespace {
+
+#if defined(__SSE2__)
+bool isHigherOrEqual(const uint8_t* platform, const uint8_t* level)
+{
+    // a >= b for unsigned bytes is max(a, b) == a
+    const auto platformLow = _mm_loadu_si128(reinterpret_cast<const __m128i*>(platform));
+    const auto platformHigh = _mm_loadu_si128(reinterpret_cast<const __m128i*>(platform + 16));
+    const auto levelLow = _mm_load_si128(reinterpret_cast<const __m128i*>(level));
+    const auto levelHigh = _mm_load_si128(reinterpret_cast<const __m128i*>(level + 16));
+    const auto higherOrEqual = _mm_and_si128(_mm_cmpeq_epi8(_mm_max_epu8(platformLow, levelLow), platformLow),
+                                             _mm_cmpeq_epi8(_mm_max_epu8(platformHigh, levelHigh), platformHigh));
+    return _mm_movemask_epi8(higherOrEqual) == 0xFFFF;
+}
+#else
+bool isHigherOrEqual(const uint8_t* platform, const uint8_t* level)
+{
+    for (size_t i = 0; i < 2 * TcbLevelMatcher::SVN_COUNT; i++)
+    {
+        if (platform[i] < level[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+} // anonymous namespace
+
+TcbLevelMatcher::TcbLevelMatcher(const std::set<TcbLevel, std::greater<TcbLevel>>& tcbLevels, bool tdx)
+    : _memo(new MemoSlot[MEMO_SLOTS]())
+{
+    _entries.reserve(tcbLevels.size());
+    for (const auto& tcbLevel : tcbLevels)
+    {
+        const auto& cpuSvn = tcbLevel.getCpuSvn();
+        if (cpuSvn.size() != SVN_COUNT)
+        {
+            LOG_AND_THROW(FormatException, "TCB Level CPU SVN should have " + std::to_string(SVN_COUNT) + " components");
+        }
+        static const std::vector<TcbComponent> noTdxTcbComponents;
+        const auto& tdxTcbComponents = tdx ? tcbLevel.getTdxTcbComponents() : noTdxTcbComponents;
+        if (!tdxTcbComponents.empty() && tdxTcbComponents.size() != SVN_COUNT)
+        {
+            LOG_AND_THROW(FormatException, "TCB Level TDX TCB Components should have " + std::to_string(SVN_COUNT) + " entries");
+        }
+
+        Entry entry{};
+        std::copy(cpuSvn.cbegin(), cpuSvn.cend(), entry.svns);
+        // Levels without TDX components are matched as if they required 0 for every TEE TCB SVN
+        for (size_t i = 0; i < tdxTcbComponents.size(); i++)
+        {
+            entry.svns[SVN_COUNT + i] = tdxTcbComponents[i].getSvn();
+        }
+        entry.pceSvn = tcbLevel.getPceSvn();
+        entry.tcbLevel = &tcbLevel;
+        _entries.push_back(entry);
+    }
+}
+
+const TcbLevel* TcbLevelMatcher::match(const uint8_t* sgxTcbComponentSvns, uint32_t pceSvn, const uint8_t* teeTcbSvn) const
+{
+    const auto index = matchIndex(sgxTcbComponentSvns, pceSvn, teeTcbSvn);
+    return index < _entries.size() ? _entries[index].tcbLevel : nullptr;
+}
+
+const TcbLevel* TcbLevelMatcher::matchMemoized(const uint8_t* sgxTcbComponentSvns, uint32_t pceSvn, const uint8_t* teeTcbSvn) const
+{
+    MemoKey key{};
+    std::memcpy(key.data(), sgxTcbComponentSvns, SVN_COUNT);
+    if (teeTcbSvn != nullptr)
+    {
+        std::memcpy(key.data() + 2, teeTcbSvn, SVN_COUNT);
+    }
+    key[4] = uint64_t{pceSvn} | (teeTcbSvn != nullptr ? uint64_t{1} << 32 : 0);
+
+    uint64_t hash = 0;
+    for (const auto word : key)
+    {
+        hash = (hash ^ word) * 0x9E3779B97F4A7C15ULL;
+    }
+    auto& slot = _memo[static_cast<size_t>(hash >> 56) % MEMO_SLOTS];
+
+    // Seqlock read, the copy is used only if no writer touched the slot in the meantime
+    const auto sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence != 0 && (sequence & 1) == 0)
+    {
+        MemoKey slotKey{};
+        for (size_t i = 0; i < MEMO_KEY_WORDS; i++)
+        {
+            slotKey[i] = slot.key[i].load(std::memory_order_relaxed);
+        }
+        const auto index = slot.index.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == sequence && slotKey == key)
+        {
+            return index < _entries.size() ? _entries[static_cast<size_t>(index)].tcbLevel : nullptr;
+        }
+    }
+
+    const auto index = matchIndex(sgxTcbComponentSvns, pceSvn, teeTcbSvn);
+
+    // Only one writer at a time, the others just don't remember their level
+    auto expected = slot.sequence.load(std::memory_order_relaxed);
+    if ((expected & 1) == 0 &&
+        slot.sequence.compare_exchange_strong(expected, expected + 1, std::memory_order_acquire, std::memory_order_relaxed))
+    {
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < MEMO_KEY_WORDS; i++)
+        {
+            slot.key[i].store(key[i], std::memory_order_relaxed);
+        }
+        slot.index.store(index, std::memory_order_relaxed);
+        slot.sequence.store(expected + 2, std::memory_order_release);
+    }
+    return index < _entries.size() ? _entries[index].tcbLevel : nullptr;
+}
+
+size_t TcbLevelMatcher::size() const
+{
+    return _entries.size();
+}
+
+// private
+
+size_t TcbLevelMatcher::matchIndex(const uint8_t* sgxTcbComponentSvns, uint32_t pceSvn, const uint8_t* teeTcbSvn) const
+{
+    uint8_t platform[2 * SVN_COUNT];
+    std::memcpy(platform, sgxTcbComponentSvns, SVN_COUNT);
+    if (teeTcbSvn != nullptr)
+    {
+        std::memcpy(platform + SVN_COUNT, teeTcbSvn, SVN_COUNT);
+    }
+    else
+    {
+        // highest possible SVNs pass every TDX comparison
+        std::memset(platform + SVN_COUNT, 0xFF, SVN_COUNT);
+    }
+
+    for (size_t i = 0; i < _entries.size(); i++)
+    {
+        if (pceSvn >= _entries[i].pceSvn && isHigherOrEqual(platform, _entries[i].svns))
+        {
+            return i;
+        }
+    }
+    return _entries.size();
+}
+
+}}}}} // namespace intel { namespace sgx { namespace dcap { namespace parser { namespace json {
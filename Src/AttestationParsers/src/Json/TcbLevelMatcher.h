@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGX_DCAP_PARSERS_TCB_LEVEL_MATCHER_H
+#define SGX_DCAP_PARSERS_TCB_LEVEL_MATCHER_H
+
+#include "SgxEcdsaAttestation/AttestationParsers.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace intel { namespace sgx { namespace dcap { namespace parser { namespace json {
+
+/**
+ * TCB Levels of a single TCB Info compiled into a contiguous table.
+ * Every entry keeps SGX and TDX component SVNs next to each other as 32 bytes, so checking that every platform SVN
+ * is higher or equal takes one vector compare and one movemask instead of 16 or 32 virtual getter calls.
+ */
+class TcbLevelMatcher
+{
+public:
+    static constexpr size_t SVN_COUNT = 16;
+
+    /**
+     * @param tcbLevels - sorted TCB Levels, they have to outlive the matcher
+     * @param tdx - true if levels come from TDX TCB Info V3 and have TDX TCB components
+     * @throws FormatException if any level has CPU SVN or TDX TCB components of unexpected size
+     */
+    TcbLevelMatcher(const std::set<TcbLevel, std::greater<TcbLevel>>& tcbLevels, bool tdx);
+
+    /**
+     * Returns the first (highest) level that platform TCB is higher or equal to or nullptr if there is none.
+     * When teeTcbSvn is nullptr TDX TCB components are not compared.
+     */
+    const TcbLevel* match(const uint8_t* sgxTcbComponentSvns, uint32_t pceSvn, const uint8_t* teeTcbSvn) const;
+
+    /**
+     * Returns the same level as match(), remembered for the same SVNs.
+     * Selected levels live in a fixed size, direct mapped table guarded by per slot sequence counters: lookups never
+     * block and a colliding or concurrent insert simply replaces or skips the slot.
+     */
+    const TcbLevel* matchMemoized(const uint8_t* sgxTcbComponentSvns, uint32_t pceSvn, const uint8_t* teeTcbSvn) const;
+
+    size_t size() const;
+
+    static constexpr size_t MEMO_SLOTS = 256;
+
+private:
+    static constexpr size_t MEMO_KEY_WORDS = 5;
+
+    /// SGX SVNs, TEE TCB SVNs and PCE SVN with flag telling if TEE TCB SVNs were given
+    using MemoKey = std::array<uint64_t, MEMO_KEY_WORDS>;
+
+    struct MemoSlot
+    {
+        /// Odd while being written, 0 while empty
+        std::atomic<uint64_t> sequence;
+        std::atomic<uint64_t> key[MEMO_KEY_WORDS];
+        /// Position of selected level in entries, entries size if none was selected
+        std::atomic<uint64_t> index;
+    };
+
+    struct Entry
+    {
+        alignas(16) uint8_t svns[2 * SVN_COUNT];
+        uint32_t pceSvn;
+        const TcbLevel* tcbLevel;
+    };
+
+    std::vector<Entry> _entries;
+    std::unique_ptr<MemoSlot[]> _memo;
+
+    size_t matchIndex(const uint8_t* sgxTcbComponentSvns, uint32_t pceSvn, const uint8_t* teeTcbSvn) const;
+};
+
+}}}}} // namespace intel { namespace sgx { namespace dcap { namespace parser { namespace json {
+
+#endif //SGX_DCAP_PARSERS_TCB_LEVEL_MATCHER_H
@@ -0,0 +1,284 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "DerReader.h"
+
+#include "SgxEcdsaAttestation/AttestationParsers.h"
+#include "Utils/Logger.h"
+
+#include <climits>
+#include <limits>
+#include <string>
+
+namespace intel { namespace sgx { namespace dcap { namespace crypto {
+
+namespace {
+
+const uint8_t CONSTRUCTED_BIT = 0x20;
+const uint8_t CLASS_MASK = 0xC0;
+const uint8_t TAG_NUMBER_MASK = 0x1F;
+const uint8_t CONTINUATION_BIT = 0x80;
+
+void validateIntegerContent(const DerElement& element)
+{
+    if (element.length == 0)
+    {
+        LOG_AND_THROW(parser::FormatException, "DER integer with empty content");
+    }
+    // first nine bits must not be all zeros or all ones
+    if (element.length > 1 &&
+        ((element.value[0] == 0x00 && (element.value[1] & 0x80) == 0) ||
+         (element.value[0] == 0xFF && (element.value[1] & 0x80) != 0)))
+    {
+        LOG_AND_THROW(parser::FormatException, "DER integer is not minimally encoded");
+    }
+}
+
+void validateObjectContent(const DerElement& element)
+{
+    if (element.length == 0 || (element.value[element.length - 1] & CONTINUATION_BIT) != 0)
+    {
+        LOG_AND_THROW(parser::FormatException, "DER object identifier is truncated");
+    }
+    for (size_t i = 0; i < element.length; i++)
+    {
+        // subidentifiers can't have leading 0x80 octet
+        if (element.value[i] == 0x80 && (i == 0 || (element.value[i - 1] & CONTINUATION_BIT) == 0))
+        {
+            LOG_AND_THROW(parser::FormatException, "DER object identifier is not minimally encoded");
+        }
+    }
+}
+
+void validateContent(const DerElement& element)
+{
+    switch (element.type)
+    {
+        case V_ASN1_SEQUENCE:
+        case V_ASN1_SET:
+            if (!element.constructed)
+            {
+                LOG_AND_THROW(parser::FormatException, "DER " + std::to_string(element.type) + " type must be constructed");
+            }
+            return;
+        case V_ASN1_OTHER:
+            return;
+        default:
+            break;
+    }
+
+    if (element.constructed)
+    {
+        LOG_AND_THROW(parser::FormatException, "DER " + std::to_string(element.type) + " type must be primitive");
+    }
+
+    switch (element.type)
+    {
+        case V_ASN1_EOC:
+            if (element.length == 0)
+            {
+                LOG_AND_THROW(parser::FormatException, "Unexpected DER end-of-contents");
+            }
+            break;
+        case V_ASN1_BOOLEAN:
+            if (element.length != 1)
+            {
+                LOG_AND_THROW(parser::FormatException, "DER boolean length expected [1] given [" + std::to_string(element.length) + "]");
+            }
+            break;
+        case V_ASN1_NULL:
+            if (element.length != 0)
+            {
+                LOG_AND_THROW(parser::FormatException, "DER null length expected [0] given [" + std::to_string(element.length) + "]");
+            }
+            break;
+        case V_ASN1_INTEGER:
+        case V_ASN1_ENUMERATED:
+            validateIntegerContent(element);
+            break;
+        case V_ASN1_OBJECT:
+            validateObjectContent(element);
+            break;
+        case V_ASN1_BIT_STRING:
+            if (element.length == 0 || element.value[0] > 7)
+            {
+                LOG_AND_THROW(parser::FormatException, "DER bit string has invalid number of unused bits");
+            }
+            break;
+        case V_ASN1_BMPSTRING:
+            if (element.length % 2 != 0)
+            {
+                LOG_AND_THROW(parser::FormatException, "DER BMP string has odd length");
+            }
+            break;
+        case V_ASN1_UNIVERSALSTRING:
+            if (element.length % 4 != 0)
+            {
+                LOG_AND_THROW(parser::FormatException, "DER universal string length is not multiple of 4");
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+} // anonymous namespace
+
+DerReader::DerReader(const uint8_t *data, size_t size): _data(data), _size(size)
+{}
+
+DerReader::DerReader(const DerElement& constructed): _data(constructed.value), _size(constructed.length)
+{}
+
+bool DerReader::hasNext() const
+{
+    return _offset < _size;
+}
+
+DerElement DerReader::next()
+{
+    size_t offset = _offset;
+    if (offset >= _size)
+    {
+        LOG_AND_THROW(parser::FormatException, "Unexpected end of DER data");
+    }
+
+    DerElement element;
+    const uint8_t identifier = _data[offset++];
+    element.constructed = (identifier & CONSTRUCTED_BIT) != 0;
+
+    unsigned int tagNumber = identifier & TAG_NUMBER_MASK;
+    if (tagNumber == TAG_NUMBER_MASK)
+    {
+        // high tag number form
+        const size_t firstTagOctet = offset;
+        tagNumber = 0;
+        uint8_t octet = 0;
+        do
+        {
+            if (offset >= _size || tagNumber > (INT_MAX >> 7))
+            {
+                LOG_AND_THROW(parser::FormatException, "Invalid DER tag");
+            }
+            octet = _data[offset++];
+            tagNumber = (tagNumber << 7) | (octet & 0x7Fu);
+        } while ((octet & CONTINUATION_BIT) != 0);
+
+        if (tagNumber < TAG_NUMBER_MASK || _data[firstTagOctet] == CONTINUATION_BIT)
+        {
+            LOG_AND_THROW(parser::FormatException, "DER tag is not minimally encoded");
+        }
+    }
+
+    if (offset >= _size)
+    {
+        LOG_AND_THROW(parser::FormatException, "Unexpected end of DER data");
+    }
+
+    size_t length = _data[offset++];
+    if ((length & CONTINUATION_BIT) != 0)
+    {
+        const size_t lengthOctets = length & 0x7Fu;
+        if (lengthOctets == 0)
+        {
+            LOG_AND_THROW(parser::FormatException, "Indefinite length is not allowed in DER");
+        }
+        if (lengthOctets > sizeof(size_t) || lengthOctets > _size - offset)
+        {
+            LOG_AND_THROW(parser::FormatException, "Invalid DER length");
+        }
+        if (_data[offset] == 0)
+        {
+            LOG_AND_THROW(parser::FormatException, "DER length is not minimally encoded");
+        }
+
+        length = 0;
+        for (size_t i = 0; i < lengthOctets; i++)
+        {
+            length = (length << 8) | _data[offset++];
+        }
+
+        if (length < CONTINUATION_BIT)
+        {
+            LOG_AND_THROW(parser::FormatException, "DER length is not minimally encoded");
+        }
+    }
+
+    if (length > _size - offset)
+    {
+        LOG_AND_THROW(parser::FormatException, "DER length [" + std::to_string(length) + "] exceeds available data [" +
+                                               std::to_string(_size - offset) + "]");
+    }
+
+    element.type = (identifier & CLASS_MASK) == 0 ? static_cast<int>(tagNumber) : V_ASN1_OTHER;
+    element.value = _data + offset;
+    element.length = length;
+    validateContent(element);
+
+    _offset = offset + length;
+    return element;
+}
+
+size_t DerReader::count() const
+{
+    DerReader reader(*this);
+    size_t elements = 0;
+    while (reader.hasNext())
+    {
+        reader.next();
+        elements++;
+    }
+    return elements;
+}
+
+long derToLong(const DerElement& integer)
+{
+    if (integer.length == 0 || integer.length > sizeof(int64_t))
+    {
+        return -1;
+    }
+
+    // sign extension of two's complement content
+    uint64_t value = (integer.value[0] & 0x80) != 0 ? std::numeric_limits<uint64_t>::max() : 0;
+    for (size_t i = 0; i < integer.length; i++)
+    {
+        value = (value << 8) | integer.value[i];
+    }
+
+    const auto signedValue = static_cast<int64_t>(value);
+    if (signedValue > std::numeric_limits<long>::max() || signedValue < std::numeric_limits<long>::min())
+    {
+        return -1;
+    }
+    return static_cast<long>(signedValue);
+}
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace crypto {
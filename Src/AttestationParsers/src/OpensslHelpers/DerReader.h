@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#ifndef SGX_DCAP_PARSERS_DER_READER_H
+#define SGX_DCAP_PARSERS_DER_READER_H
+
+#include <openssl/asn1.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace intel { namespace sgx { namespace dcap { namespace crypto {
+
+/**
+ * Single DER element. Value points into the buffer the element was read from.
+ */
+struct DerElement
+{
+    int type = V_ASN1_EOC; // universal tag number (V_ASN1_*), V_ASN1_OTHER for other tag classes
+    bool constructed = false;
+    const uint8_t *value = nullptr;
+    size_t length = 0;
+};
+
+/**
+ * Allocation-free reader of consecutive DER elements.
+ * Rejects BER-only encodings (indefinite and non-minimal lengths, constructed strings) and validates
+ * contents of universal primitive types the same way OpenSSL does when decoding ASN1_ANY.
+ */
+class DerReader
+{
+public:
+    DerReader(const uint8_t *data, size_t size);
+
+    /**
+     * Create reader over content of constructed element
+     */
+    explicit DerReader(const DerElement& constructed);
+
+    bool hasNext() const;
+
+    /**
+     * Read next element
+     * @throws intel::sgx::dcap::parser::FormatException when element is malformed
+     */
+    DerElement next();
+
+    /**
+     * Count remaining elements without consuming them
+     * @throws intel::sgx::dcap::parser::FormatException when any of the elements is malformed
+     */
+    size_t count() const;
+
+private:
+    const uint8_t *_data;
+    size_t _size;
+    size_t _offset = 0;
+};
+
+/**
+ * Check if OID content octets are equal to parent OID content octets followed by single octet arc
+ * @param oid element of V_ASN1_OBJECT type
+ * @param parent DER content octets of parent OID
+ * @param arc set to value of the last arc on match
+ * @return true if OID is child of parent with arc lower than 128
+ */
+template<size_t N>
+bool isChildOid(const DerElement& oid, const uint8_t (&parent)[N], uint8_t& arc)
+{
+    if (oid.type != V_ASN1_OBJECT || oid.length != N + 1 || (oid.value[N] & 0x80) != 0 ||
+        !std::equal(parent, parent + N, oid.value))
+    {
+        return false;
+    }
+    arc = oid.value[N];
+    return true;
+}
+
+/**
+ * Convert INTEGER or ENUMERATED element to long with ASN1_INTEGER_get semantics
+ * @return value or -1 when it does not fit into long
+ */
+long derToLong(const DerElement& integer);
+
+}}}} // namespace intel { namespace sgx { namespace dcap { namespace crypto {
+
+#endif // SGX_DCAP_PARSERS_DER_READER_H
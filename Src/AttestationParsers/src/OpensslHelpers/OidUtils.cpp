@@ -127,4 +127,66 @@ STACK_OF_ASN1TYPE_uptr oidToStack(const ASN1_TYPE *oidValue)
     return stack;
 }
 
+void validateOid(const std::string& oidName, const DerElement& oidValue, int expectedType)
+{
+    if (oidValue.type != expectedType)
+    {
+        std::string err = "OID [" + oidName + "] type expected [" + std::to_string(expectedType) +
+                          "] given [" + std::to_string(oidValue.type) + "]";
+        LOG_AND_THROW(parser::FormatException, err);
+    }
+}
+
+void validateOid(const std::string& oidName, const DerElement& oidValue, int expectedType, size_t expectedLength)
+{
+    validateOid(oidName, oidValue, expectedType);
+
+    if (oidValue.length != expectedLength)
+    {
+        std::string err = "OID [" + oidName + "] length expected [" + std::to_string(expectedLength) + "] given [" +
+                          std::to_string(oidValue.length) + "]";
+        LOG_AND_THROW(parser::FormatException, err);
+    }
+}
+
+void readOidTuple(const std::string& parentOidName, const DerElement& oidTupleWrapper, DerElement& oidName, DerElement& oidValue)
+{
+    validateOid(parentOidName, oidTupleWrapper, V_ASN1_SEQUENCE);
+
+    DerReader oidTuple(oidTupleWrapper);
+    const auto oidTupleEntries = oidTuple.count();
+    if (oidTupleEntries != 2)
+    {
+        std::string err = "OID tuple [" + parentOidName + "] expected number of elements is [2] given [" +
+                          std::to_string(oidTupleEntries) + "]";
+        LOG_AND_THROW(parser::InvalidExtensionException, err);
+    }
+
+    oidName = oidTuple.next();
+    oidValue = oidTuple.next();
+    validateOid(parentOidName, oidName, V_ASN1_OBJECT);
+}
+
+DerElement readSgxExtensions(const uint8_t* extensionValue, size_t length)
+{
+    DerReader reader(extensionValue, length);
+    DerElement sgxExtensions;
+    try
+    {
+        sgxExtensions = reader.next();
+    }
+    catch (const parser::FormatException& ex)
+    {
+        LOG_AND_THROW(parser::InvalidExtensionException, std::string("Cannot parse SGX extensions: ") + ex.what());
+    }
+
+    if (reader.hasNext())
+    {
+        LOG_AND_THROW(parser::InvalidExtensionException, "Unexpected data after SGX extensions sequence");
+    }
+
+    validateOid(parser::oids::SGX_EXTENSION, sgxExtensions, V_ASN1_SEQUENCE);
+    return sgxExtensions;
+}
+
 }}}} // namespace intel { namespace sgx { namespace dcap { namespace crypto {
@@ -33,6 +33,7 @@
 #define SGX_DCAP_PARSERS_OID_UTILS_H
 
 #include "OpensslHelpers/OpensslTypes.h"
+#include "OpensslHelpers/DerReader.h"
 
 #include <openssl/asn1.h>
 
@@ -49,6 +50,11 @@ uint32_t oidToUInt(const ASN1_TYPE *oidValue);
 int oidToEnum(const ASN1_TYPE *oidValue);
 STACK_OF_ASN1TYPE_uptr oidToStack(const ASN1_TYPE *oidValue);
 
+void validateOid(const std::string& oidName, const DerElement& oidValue, int expectedType);
+void validateOid(const std::string& oidName, const DerElement& oidValue, int expectedType, size_t expectedLength);
+void readOidTuple(const std::string& parentOidName, const DerElement& oidTupleWrapper, DerElement& oidName, DerElement& oidValue);
+DerElement readSgxExtensions(const uint8_t* extensionValue, size_t length);
+
 }}}} // namespace intel { namespace sgx { namespace dcap { namespace crypto {
 
 #endif // SGX_DCAP_PARSERS_OID_UTILS_H
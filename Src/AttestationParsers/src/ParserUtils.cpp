@@ -34,6 +34,7 @@
 #include "ParserUtils.h"
 #include "OpensslHelpers/OpensslTypes.h"
 #include "Utils/TimeUtils.h"
+#include "Utils/CivilTime.h"
 #include "Utils/Logger.h"
 
 #include <openssl/objects.h>
@@ -41,6 +42,7 @@
 #include <openssl/err.h>
 
 #include <algorithm>
+#include <iterator>
 #include <chrono>
 #include <memory>
 #include <sstream>
@@ -184,13 +186,23 @@ std::string getNameEntry(X509_NAME* name, int nid)
     return ret;
 }
 
-// Converts ASN1_TIME to time_t using ASN1_TIME_diff to get number of seconds from 1 Jan 1970
+// Converts ASN1_TIME to time_t, DER forms are converted directly and anything else
+// goes through ASN1_TIME_diff to get number of seconds from 1 Jan 1970
 std::time_t asn1TimeToTimet(
         const ASN1_TIME* asn1Time)
 {
     static_assert(sizeof(std::time_t) >= sizeof(int64_t), "std::time_t size too small, the dates may overflow");
     static constexpr int64_t SECONDS_IN_A_DAY = 24 * 60 * 60;
 
+    const auto type = asn1Time != nullptr ? ASN1_STRING_type(asn1Time) : V_ASN1_UNDEF;
+    time_t epoch = 0;
+    if((type == V_ASN1_UTCTIME || type == V_ASN1_GENERALIZEDTIME)
+       && asn1TimeToEpoch(ASN1_STRING_get0_data(asn1Time), static_cast<size_t>(ASN1_STRING_length(asn1Time)),
+                          type == V_ASN1_GENERALIZEDTIME, epoch))
+    {
+        return epoch;
+    }
+
     int pday;
     int psec;
     auto from = crypto::make_unique(ASN1_TIME_new());
@@ -230,5 +242,26 @@ std::string getLastError()
     return std::string(buff);
 }
 
+void checkRequiredSgxExtensions(const std::string& scope, const std::vector<x509::Extension::Type>& required, uint32_t found)
+{
+    std::vector<x509::Extension::Type> missing;
+    std::copy_if(required.begin(), required.end(), std::back_inserter(missing),
+                 [found](const auto& extension) { return (found & sgxExtensionBit(extension)) == 0; });
+
+    if (!missing.empty())
+    {
+        std::string err = "Required " + scope + " SGX extensions not found. Missing [";
+
+        // Convert all but the last element to avoid a trailing ","
+        std::for_each(missing.begin(), missing.end() - 1, [&err](const auto& extension) {
+            err += oids::type2Description(extension) + ", ";
+        });
+
+        // Now add the last element with no delimiter
+        err += oids::type2Description(missing.back()) + "]";
+        LOG_AND_THROW(InvalidExtensionException, err);
+    }
+}
+
 }}}} // namespace intel { namespace sgx { namespace dcap { namespace parser
 
@@ -52,6 +52,22 @@ std::string getNameEntry(X509_NAME* name, int nid);
 std::tuple<time_t, time_t> asn1TimePeriodToCTime(const ASN1_TIME* validityBegin, const ASN1_TIME* validityEnd);
 std::string getLastError();
 
+/**
+ * Bit representing SGX extension type in mask of found extensions
+ */
+inline uint32_t sgxExtensionBit(x509::Extension::Type type)
+{
+    return 1u << static_cast<uint32_t>(type);
+}
+
+/**
+ * Check if all required SGX extensions are present in mask of found extensions
+ * @param scope name of checked structure used in error message
+ *
+ * @throws intel::sgx::dcap::parser::InvalidExtensionException listing missing extensions
+ */
+void checkRequiredSgxExtensions(const std::string& scope, const std::vector<x509::Extension::Type>& required, uint32_t found);
+
 namespace oids {
 
 const std::string SGX_EXTENSION = "1.2.840.113741.1.13.1";
@@ -84,6 +100,26 @@ const std::string DYNAMIC_PLATFORM = CONFIGURATION + ".1";
 const std::string CACHED_KEYS = CONFIGURATION + ".2";
 const std::string SMT_ENABLED = CONFIGURATION + ".3";
 
+// DER content octets of OIDs containing SGX extensions, children are matched by the last arc (see crypto::isChildOid)
+const uint8_t SGX_EXTENSION_DER[] = {0x2A, 0x86, 0x48, 0x86, 0xF8, 0x4D, 0x01, 0x0D, 0x01};
+const uint8_t TCB_DER[] = {0x2A, 0x86, 0x48, 0x86, 0xF8, 0x4D, 0x01, 0x0D, 0x01, 0x02};
+const uint8_t CONFIGURATION_DER[] = {0x2A, 0x86, 0x48, 0x86, 0xF8, 0x4D, 0x01, 0x0D, 0x01, 0x07};
+
+const uint8_t PPID_ARC = 1;
+const uint8_t TCB_ARC = 2;
+const uint8_t PCEID_ARC = 3;
+const uint8_t FMSPC_ARC = 4;
+const uint8_t SGX_TYPE_ARC = 5;
+const uint8_t PLATFORM_INSTANCE_ID_ARC = 6;
+const uint8_t CONFIGURATION_ARC = 7;
+const uint8_t SGX_TCB_COMP01_SVN_ARC = 1;
+const uint8_t SGX_TCB_COMP16_SVN_ARC = 16;
+const uint8_t PCESVN_ARC = 17;
+const uint8_t CPUSVN_ARC = 18;
+const uint8_t DYNAMIC_PLATFORM_ARC = 1;
+const uint8_t CACHED_KEYS_ARC = 2;
+const uint8_t SMT_ENABLED_ARC = 3;
+
 static const std::map<x509::Extension::Type, std::string> oidEnumToDescription = {
         {x509::Extension::Type::NONE,                 "NONE"},
         {x509::Extension::Type::PPID,                 "PPID"},
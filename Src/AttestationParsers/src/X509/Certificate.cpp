@@ -33,37 +33,75 @@
 
 #include "X509Constants.h"
 #include "ParserUtils.h"
+#include "Utils/Encoding.h"
 #include "Utils/Logger.h"
 
 #include <OpensslHelpers/OpensslTypes.h>
 
 #include <algorithm>
 #include <iterator>
+#include <limits>
+#include <mutex>
 
 namespace intel { namespace sgx { namespace dcap { namespace parser { namespace x509 {
 
+struct Certificate::LazyFields
+{
+    explicit LazyFields(crypto::X509_uptr decoded): x509(std::move(decoded)) {}
+
+    crypto::X509_uptr x509;
+    // Serializes OpenSSL calls on x509, i2d_re_X509_tbs updates its cached encoding
+    std::mutex x509Mutex;
+
+    std::once_flag infoFlag;
+    std::once_flag serialNumberFlag;
+    std::once_flag subjectFlag;
+    std::once_flag issuerFlag;
+    std::once_flag extensionsFlag;
+
+    std::vector<uint8_t> info;
+    std::vector<uint8_t> serialNumber;
+    DistinguishedName subject;
+    DistinguishedName issuer;
+    std::vector<Extension> extensions;
+};
+
+namespace {
+
+template<typename T, typename Materialize>
+const T& materializeOnce(X509* x509, std::mutex& x509Mutex, std::once_flag& flag, T& field, Materialize materialize)
+{
+    std::call_once(flag, [&] {
+        // default constructed certificates have nothing to materialize
+        if (x509 != nullptr)
+        {
+            std::lock_guard<std::mutex> lock(x509Mutex);
+            field = materialize(x509);
+        }
+    });
+    return field;
+}
+
+} // anonymous namespace
+
 Certificate::Certificate(): _version{},
-                            _subject{},
-                            _issuer{},
                             _validity{},
-                            _extensions{},
                             _signature{},
-                            _serialNumber{},
                             _pubKey{},
-                            _info{}
+                            _lazyFields(std::make_shared<LazyFields>(crypto::make_unique<X509>(nullptr)))
 {}
 
 bool Certificate::operator==(const Certificate& other) const
 {
     return _version == other._version &&
-           _subject == other._subject &&
-           _issuer == other._issuer &&
+           getSubject() == other.getSubject() &&
+           getIssuer() == other.getIssuer() &&
            _validity == other._validity &&
-           _extensions == other._extensions &&
+           getExtensions() == other.getExtensions() &&
            _signature == other._signature &&
-           _serialNumber == other._serialNumber &&
+           getSerialNumber() == other.getSerialNumber() &&
            _pubKey == other._pubKey &&
-           _info == other._info &&
+           getInfo() == other.getInfo() &&
            _crlDistributionPoint == other._crlDistributionPoint;
 }
 
@@ -74,17 +112,30 @@ uint32_t Certificate::getVersion() const
 
 const std::vector<uint8_t>& Certificate::getSerialNumber() const
 {
-    return _serialNumber;
+    auto& lazy = lazyFields();
+    return materializeOnce(lazy.x509.get(), lazy.x509Mutex, lazy.serialNumberFlag, lazy.serialNumber, [](const X509* x509) {
+        const ASN1_INTEGER *serialNumber = X509_get0_serialNumber(x509);
+        const crypto::BIGNUM_uptr bn = crypto::make_unique(ASN1_INTEGER_to_BN(serialNumber, nullptr));
+        return bn2Vec(bn.get());
+    });
 }
 
 const DistinguishedName& Certificate::getSubject() const
 {
-    return _subject;
+    auto& lazy = lazyFields();
+    return materializeOnce(lazy.x509.get(), lazy.x509Mutex, lazy.subjectFlag, lazy.subject, [](const X509* x509) {
+        // this is an internal pointer and must not be freed !
+        return DistinguishedName(X509_get_subject_name(x509));
+    });
 }
 
 const DistinguishedName& Certificate::getIssuer() const
 {
-    return _issuer;
+    auto& lazy = lazyFields();
+    return materializeOnce(lazy.x509.get(), lazy.x509Mutex, lazy.issuerFlag, lazy.issuer, [](const X509* x509) {
+        // this is an internal pointer and must not be freed !
+        return DistinguishedName(X509_get_issuer_name(x509));
+    });
 }
 
 const Validity& Certificate::getValidity() const
@@ -94,12 +145,29 @@ const Validity& Certificate::getValidity() const
 
 const std::vector<Extension>& Certificate::getExtensions() const
 {
-    return _extensions;
+    auto& lazy = lazyFields();
+    return materializeOnce(lazy.x509.get(), lazy.x509Mutex, lazy.extensionsFlag, lazy.extensions, [](const X509* x509) {
+        std::vector<Extension> extensions(static_cast<size_t>(X509_get_ext_count(x509)));
+        int index = 0;
+
+        std::generate(extensions.begin(), extensions.end(),
+                      [&x509, &index]{ return Extension(X509_get_ext(x509, index++)); });
+        return extensions;
+    });
 }
 
 const std::vector<uint8_t>& Certificate::getInfo() const
 {
-    return _info;
+    auto& lazy = lazyFields();
+    return materializeOnce(lazy.x509.get(), lazy.x509Mutex, lazy.infoFlag, lazy.info, [](X509* x509) {
+        size_t len = static_cast<size_t>(i2d_re_X509_tbs(x509, NULL));
+
+        std::vector<uint8_t> info(len);
+        auto infoPtr = info.data();
+
+        i2d_re_X509_tbs(x509, &infoPtr);
+        return info;
+    });
 }
 
 const Signature& Certificate::getSignature() const
@@ -126,87 +194,139 @@ Certificate Certificate::parse(const std::string& pem)
     return Certificate(pem);
 }
 
+Certificate Certificate::parseDer(const uint8_t* der, size_t length)
+{
+    return Certificate(der, length);
+}
+
 // Protected
 
 Certificate::Certificate(const std::string &pem)
 {
     _pem = pem;
-    crypto::BIO_uptr bio(BIO_new(BIO_s_mem()), ::BIO_free_all);
-    BIO_puts(bio.get(), pem.c_str());
+    auto x509 = crypto::make_unique<X509>(nullptr);
+
+    // plain PEM block is decoded here, anything else (e.g. block with encapsulated headers) is left to OpenSSL
+    std::vector<uint8_t> der;
+    if (decodePem(pem.data(), pem.size(), PEM_STRING_X509, der) == DecodeStatus::OK && !der.empty())
+    {
+        const uint8_t* data = der.data();
+        x509.reset(d2i_X509(nullptr, &data, static_cast<long>(der.size())));
+    }
 
-    auto x509 = crypto::make_unique(PEM_read_bio_X509(bio.get(), nullptr, nullptr, nullptr));
+    if (!x509) {
+        // errors of fast path are not reported, OpenSSL reader reports its own
+        ERR_clear_error();
+
+        // read-only BIO over PEM data, avoids copying it into BIO buffer
+        crypto::BIO_uptr bio(BIO_new_mem_buf(pem.data(), static_cast<int>(pem.size())), ::BIO_free_all);
+        x509.reset(PEM_read_bio_X509(bio.get(), nullptr, nullptr, nullptr));
+    }
     if (!x509) {
         auto err = getLastError();
         LOG_ERROR("Parsing certificate failed: {}, PEM: {}", err, pem);
         throw FormatException("PEM_read_bio_X509 failed " + err);
     }
 
-    setPublicKey(x509.get());
-    setInfo(x509.get());
-    setSignature(x509.get());
-    setVersion(x509.get());
-    setSerialNumber(x509.get());
-    setSubject(x509.get());
-    setIssuer(x509.get());
-    setValidity(x509.get());
-    setExtensions(x509.get());
-    setCrlDistributionPoint(x509.get());
+    setMembers(x509.get());
+    _lazyFields = std::make_shared<LazyFields>(std::move(x509));
 }
 
-// Private
-
-void Certificate::setInfo(X509 *x509)
+Certificate::Certificate(const uint8_t* der, size_t length)
 {
-    size_t len = static_cast<size_t>(i2d_re_X509_tbs(x509, NULL));
+    if (der == nullptr || length == 0 || length > static_cast<size_t>(std::numeric_limits<long>::max()))
+    {
+        LOG_AND_THROW(FormatException, "DER certificate is empty or too long");
+    }
+
+    auto data = der;
+    auto x509 = crypto::make_unique(d2i_X509(nullptr, &data, static_cast<long>(length)));
+    if (!x509) {
+        auto err = getLastError();
+        LOG_ERROR("Parsing DER certificate failed: {}", err);
+        throw FormatException("d2i_X509 failed " + err);
+    }
+    if (data != der + length)
+    {
+        LOG_AND_THROW(FormatException, "Unexpected data after DER certificate");
+    }
+
+    setMembers(x509.get());
+    _lazyFields = std::make_shared<LazyFields>(std::move(x509));
+}
 
-    _info = std::vector<uint8_t>(len);
-    auto info = _info.data();
+const uint8_t* Certificate::findExtension(const uint8_t* derOid, size_t derOidLength, size_t& length) const
+{
+    const X509 *x509 = lazyFields().x509.get();
+    if (x509 == nullptr)
+    {
+        return nullptr;
+    }
 
-    i2d_re_X509_tbs(x509, &info);
+    for (int index = 0; index < X509_get_ext_count(x509); index++)
+    {
+        // both pointers are internal and must not be freed
+        X509_EXTENSION *extension = X509_get_ext(x509, index);
+        const ASN1_OBJECT *object = X509_EXTENSION_get_object(extension);
+        if (static_cast<size_t>(OBJ_length(object)) == derOidLength &&
+            std::equal(derOid, derOid + derOidLength, OBJ_get0_data(object)))
+        {
+            const ASN1_OCTET_STRING *data = X509_EXTENSION_get_data(extension);
+            length = static_cast<size_t>(data->length);
+            return data->data;
+        }
+    }
+    return nullptr;
 }
 
-void Certificate::setVersion(const X509 *x509)
+// Private
+
+void Certificate::setMembers(const X509 *x509)
 {
-    // version is zero-indexed thus +1
-    _version = static_cast<uint32_t>(X509_get_version(x509) + 1);
+    // Everything that may reject the certificate is checked here, the remaining
+    // fields are materialized from the decoded certificate on first access
+    setPublicKey(x509);
+    setSignature(x509);
+    setVersion(x509);
+    validateNames(x509);
+    setValidity(x509);
+    validateExtensions(x509);
+    setCrlDistributionPoint(x509);
 }
 
-void Certificate::setSerialNumber(const X509 *x509)
+Certificate::LazyFields& Certificate::lazyFields() const
 {
-    const ASN1_INTEGER *serialNumber = X509_get0_serialNumber(x509);
-    const crypto::BIGNUM_uptr bn = crypto::make_unique(ASN1_INTEGER_to_BN(serialNumber, nullptr));
+    if (_lazyFields)
+    {
+        return *_lazyFields;
+    }
 
-    _serialNumber = bn2Vec(bn.get());
+    // moved-from certificate
+    static LazyFields empty(crypto::make_unique<X509>(nullptr));
+    return empty;
 }
 
-void Certificate::setSubject(const X509 *x509)
+void Certificate::setVersion(const X509 *x509)
 {
-    // this is an internal pointer and must not be freed !
-    X509_NAME *subject = X509_get_subject_name(x509);
+    // version is zero-indexed thus +1
+    _version = static_cast<uint32_t>(X509_get_version(x509) + 1);
+}
 
-    if(!subject)
+void Certificate::validateNames(const X509 *x509)
+{
+    if(!X509_get_subject_name(x509))
     {
         auto err = getLastError();
         LOG_ERROR("Retrieve SUBJECT from certificate failed: {}", err);
         throw FormatException(err);
     }
 
-    _subject = DistinguishedName(subject);
-}
-
-void Certificate::setIssuer(const X509 *x509)
-{
-    // this is an internal pointer and must not be freed !
-    X509_NAME *issuer = X509_get_issuer_name(x509);
-
-    if(!issuer)
+    if(!X509_get_issuer_name(x509))
     {
         auto err = getLastError();
         LOG_ERROR("Retrieve ISSUER from certificate failed: {}", err);
         throw FormatException(err);
     }
-
-    _issuer = DistinguishedName(issuer);
 }
 
 void Certificate::setValidity(const X509 *x509)
@@ -235,7 +355,7 @@ void Certificate::setValidity(const X509 *x509)
     _validity = Validity(std::get<0>(period), std::get<1>(period));
 }
 
-void Certificate::setExtensions(const X509 *x509)
+void Certificate::validateExtensions(const X509 *x509)
 {
     const int extsCount = X509_get_ext_count(x509);
 
@@ -246,17 +366,18 @@ void Certificate::setExtensions(const X509 *x509)
         throw FormatException(err);
     }
 
-    std::vector<Extension> extensions(static_cast<size_t>(extsCount));
-    int index = 0;
-
-    std::generate(extensions.begin(), extensions.end(),
-                  [&x509, &index]{ return Extension(X509_get_ext(x509, index++)); });
-
     std::vector<int> expectedExtensions = constants::REQUIRED_X509_EXTENSIONS;
 
-    for (const auto& extension : extensions)
+    for (int index = 0; index < extsCount; index++)
     {
-        expectedExtensions.erase(std::remove(expectedExtensions.begin(), expectedExtensions.end(), extension.getNid()), expectedExtensions.end());
+        X509_EXTENSION *extension = X509_get_ext(x509, index);
+        if(!X509_EXTENSION_get_data(extension))
+        {
+            throw FormatException("Invalid Extension");
+        }
+
+        const int nid = OBJ_obj2nid(X509_EXTENSION_get_object(extension));
+        expectedExtensions.erase(std::remove(expectedExtensions.begin(), expectedExtensions.end(), nid), expectedExtensions.end());
     }
 
     if (!expectedExtensions.empty())
@@ -273,8 +394,6 @@ void Certificate::setExtensions(const X509 *x509)
 
         LOG_AND_THROW(InvalidExtensionException, err);
     }
-
-    _extensions = extensions;
 }
 
 void Certificate::setSignature(const X509 *x509)
@@ -35,8 +35,107 @@
 
 #include <openssl/obj_mac.h>
 
+#include <array>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
 namespace intel { namespace sgx { namespace dcap { namespace parser { namespace x509 {
 
+namespace {
+
+size_t hashComponents(const std::string& commonName,
+                      const std::string& countryName,
+                      const std::string& organizationName,
+                      const std::string& locationName,
+                      const std::string& stateName)
+{
+    // combine as in boost::hash_combine, the constant fits in size_t on 32-bit targets
+    size_t hash = 0;
+    for (const auto *component : {&commonName, &countryName, &organizationName, &locationName, &stateName})
+    {
+        hash ^= std::hash<std::string>{}(*component) + static_cast<size_t>(0x9e3779b9U) + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+constexpr uint32_t NOT_INTERNED = 0;
+
+/**
+ * Process-wide table giving equal name components the same id, so equality of interned names is a single
+ * integer compare. Split into shards with own locks, so threads parsing certificates rarely wait for each other.
+ * Distinct names of Intel SGX certificates are few, a shard stops growing at its limit and names seen after
+ * that get NOT_INTERNED and are compared field by field.
+ */
+class NameIdTable
+{
+public:
+    static NameIdTable& instance()
+    {
+        static NameIdTable table;
+        return table;
+    }
+
+    uint32_t idOf(size_t hash, const std::string& key)
+    {
+        const auto shardIndex = hash % SHARD_COUNT;
+        auto& shard = _shards[shardIndex];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        const auto found = shard.ids.find(key);
+        if (found != shard.ids.end())
+        {
+            return found->second;
+        }
+        if (shard.ids.size() >= MAX_NAMES_PER_SHARD)
+        {
+            return NOT_INTERNED;
+        }
+        // ids of different shards differ in low bits and start at 1
+        const auto id = static_cast<uint32_t>((shard.ids.size() + 1) * SHARD_COUNT + shardIndex);
+        shard.ids.emplace(key, id);
+        return id;
+    }
+
+private:
+    static constexpr size_t SHARD_COUNT = 16;
+    static constexpr size_t MAX_NAMES_PER_SHARD = 256;
+
+    struct Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<std::string, uint32_t> ids;
+    };
+
+    std::array<Shard, SHARD_COUNT> _shards;
+};
+
+constexpr size_t NameIdTable::SHARD_COUNT;
+constexpr size_t NameIdTable::MAX_NAMES_PER_SHARD;
+
+uint32_t internComponents(size_t hash,
+                          const std::string& commonName,
+                          const std::string& countryName,
+                          const std::string& organizationName,
+                          const std::string& locationName,
+                          const std::string& stateName)
+{
+    // length prefixed, so components can't be shifted between each other
+    std::string key;
+    for (const auto *component : {&commonName, &countryName, &organizationName, &locationName, &stateName})
+    {
+        key += std::to_string(component->size());
+        key += ':';
+        key += *component;
+    }
+    return NameIdTable::instance().idOf(hash, key);
+}
+
+} // anonymous namespace
+
+DistinguishedName::DistinguishedName(): _hash(hashComponents("", "", "", "", "")),
+                                        _id(internComponents(_hash, "", "", "", "", ""))
+{}
+
 DistinguishedName::DistinguishedName(const std::string& raw,
                                      const std::string& commonName,
                                      const std::string& countryName,
@@ -48,7 +147,9 @@ DistinguishedName::DistinguishedName(const std::string& raw,
                                         _countryName(countryName),
                                         _organizationName(organizationName),
                                         _locationName(locationName),
-                                        _stateName(stateName)
+                                        _stateName(stateName),
+                                        _hash(hashComponents(commonName, countryName, organizationName, locationName, stateName)),
+                                        _id(internComponents(_hash, commonName, countryName, organizationName, locationName, stateName))
 {}
 
 const std::string& DistinguishedName::getRaw() const
@@ -81,8 +182,18 @@ const std::string& DistinguishedName::getStateName() const
     return _stateName;
 }
 
+size_t DistinguishedName::getHash() const
+{
+    return _hash;
+}
+
 bool DistinguishedName::operator==(const DistinguishedName &other) const {
-    return _commonName == other._commonName && // do not compare RAW as order may differ
+    if (_id != NOT_INTERNED && other._id != NOT_INTERNED)
+    {
+        return _id == other._id;
+    }
+    return _hash == other._hash && // different hashes rule out equality without touching the strings
+           _commonName == other._commonName && // do not compare RAW as order may differ
            _countryName == other._countryName &&
            _organizationName == other._organizationName &&
            _locationName == other._locationName &&
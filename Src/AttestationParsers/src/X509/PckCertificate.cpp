@@ -33,19 +33,87 @@
 
 #include "ParserUtils.h"
 #include "X509Constants.h"
+#include "OpensslHelpers/DerReader.h"
 #include "OpensslHelpers/OidUtils.h"
 #include "Utils/Logger.h"
 
-#include <algorithm> // find_if
-
-#include <openssl/asn1.h>
 
 namespace intel { namespace sgx { namespace dcap { namespace parser { namespace x509 {
 
+namespace {
+
+const std::string* const SGX_TCB_COMP_SVN_OIDS[] = {
+    &oids::SGX_TCB_COMP01_SVN, &oids::SGX_TCB_COMP02_SVN, &oids::SGX_TCB_COMP03_SVN, &oids::SGX_TCB_COMP04_SVN,
+    &oids::SGX_TCB_COMP05_SVN, &oids::SGX_TCB_COMP06_SVN, &oids::SGX_TCB_COMP07_SVN, &oids::SGX_TCB_COMP08_SVN,
+    &oids::SGX_TCB_COMP09_SVN, &oids::SGX_TCB_COMP10_SVN, &oids::SGX_TCB_COMP11_SVN, &oids::SGX_TCB_COMP12_SVN,
+    &oids::SGX_TCB_COMP13_SVN, &oids::SGX_TCB_COMP14_SVN, &oids::SGX_TCB_COMP15_SVN, &oids::SGX_TCB_COMP16_SVN
+};
+
+Tcb readTcb(const crypto::DerElement& tcbSeq)
+{
+    crypto::validateOid(oids::TCB, tcbSeq, V_ASN1_SEQUENCE);
+
+    crypto::DerReader tcb(tcbSeq);
+    const auto tcbEntries = tcb.count();
+    if(tcbEntries != constants::TCB_SEQUENCE_LEN)
+    {
+        std::string err = "TCB length expected [" + std::to_string(constants::TCB_SEQUENCE_LEN) + "] given [" +
+                          std::to_string(tcbEntries) + "]";
+        LOG_AND_THROW(InvalidExtensionException, err);
+    }
+
+    std::vector<uint8_t> cpuSvn;
+    std::vector<uint8_t> cpuSvnComponents(constants::CPUSVN_BYTE_LEN);
+    uint32_t pceSvn = 0;
+    uint32_t found = 0;
+
+    // Iterate through SGX TCB Extensions stored as sequence(tuple) of OIDName and OIDValue
+    while (tcb.hasNext())
+    {
+        crypto::DerElement oidName;
+        crypto::DerElement oidValue;
+        crypto::readOidTuple(oids::TCB, tcb.next(), oidName, oidValue);
+
+        uint8_t arc = 0;
+        if (!crypto::isChildOid(oidName, oids::TCB_DER, arc))
+        {
+            continue;
+        }
+
+        if (arc >= oids::SGX_TCB_COMP01_SVN_ARC && arc <= oids::SGX_TCB_COMP16_SVN_ARC)
+        {
+            const auto component = static_cast<size_t>(arc - oids::SGX_TCB_COMP01_SVN_ARC);
+            crypto::validateOid(*SGX_TCB_COMP_SVN_OIDS[component], oidValue, V_ASN1_INTEGER);
+            cpuSvnComponents[component] = static_cast<uint8_t>(crypto::derToLong(oidValue));
+            found |= sgxExtensionBit(static_cast<Extension::Type>(
+                    static_cast<size_t>(Extension::Type::SGX_TCB_COMP01_SVN) + component));
+        }
+        else if (arc == oids::PCESVN_ARC)
+        {
+            crypto::validateOid(oids::PCESVN, oidValue, V_ASN1_INTEGER);
+            pceSvn = static_cast<uint32_t>(crypto::derToLong(oidValue));
+            found |= sgxExtensionBit(Extension::Type::PCESVN);
+        }
+        else if (arc == oids::CPUSVN_ARC)
+        {
+            crypto::validateOid(oids::CPUSVN, oidValue, V_ASN1_OCTET_STRING, constants::CPUSVN_BYTE_LEN);
+            cpuSvn.assign(oidValue.value, oidValue.value + oidValue.length);
+            found |= sgxExtensionBit(Extension::Type::CPUSVN);
+        }
+    }
+
+    checkRequiredSgxExtensions("TCB", constants::TCB_REQUIRED_SGX_EXTENSIONS, found);
+
+    return Tcb(cpuSvn, cpuSvnComponents, pceSvn);
+}
+
+} // anonymous namespace
+
 PckCertificate::PckCertificate(const Certificate& certificate): Certificate(certificate)
 {
-    auto sgxExtensions = crypto::make_unique(getSgxExtensions());
-    setMembers(sgxExtensions.get());
+    size_t sgxExtensionLength = 0;
+    const auto sgxExtension = getSgxExtension(sgxExtensionLength);
+    setMembers(sgxExtension, sgxExtensionLength);
 }
 
 const std::vector<uint8_t>& PckCertificate::getPpid() const
@@ -88,44 +156,36 @@ PckCertificate PckCertificate::parse(const std::string& pem)
     return PckCertificate(pem);
 }
 
+PckCertificate PckCertificate::parseDer(const uint8_t* der, size_t length)
+{
+    return PckCertificate(Certificate::parseDer(der, length));
+}
+
 // Private
 
 PckCertificate::PckCertificate(const std::string& pem): Certificate(pem)
 {
-    auto sgxExtensions = crypto::make_unique(getSgxExtensions());
-    setMembers(sgxExtensions.get());
+    size_t sgxExtensionLength = 0;
+    const auto sgxExtension = getSgxExtension(sgxExtensionLength);
+    setMembers(sgxExtension, sgxExtensionLength);
 }
 
-stack_st_ASN1_TYPE* PckCertificate::getSgxExtensions()
+const uint8_t* PckCertificate::getSgxExtension(size_t& length) const
 {
-    const auto sgxExtension = std::find_if(_extensions.begin(), _extensions.end(),
-                                           [](const Extension &ext) { return ext.getNid() == NID_undef && ext.getName() == oids::SGX_EXTENSION; });
-
-    if(sgxExtension == _extensions.end())
+    const auto sgxExtension = findExtension(oids::SGX_EXTENSION_DER, sizeof(oids::SGX_EXTENSION_DER), length);
+    if(sgxExtension == nullptr)
     {
         // Certificate has no SGX extensions, probably Root CA or Intermediate CA
         LOG_AND_THROW(InvalidExtensionException, "Certificate is missing SGX Extensions OID[" + oids::SGX_EXTENSION + "]");
     }
 
-    // WARNING! Using this temporary pointer is mandatory!
-    const auto *dtPtr = sgxExtension->getValue().data();
-    const auto topSequence = crypto::make_unique(
-            d2i_ASN1_TYPE(nullptr, &dtPtr, static_cast<long>(sgxExtension->getValue().size())));
-
-    if(!topSequence)
-    {
-        auto err = "d2i_ASN1_TYPE cannot parse data to correct type " + getLastError();
-        LOG_AND_THROW(InvalidExtensionException, err);
-    }
-
-    crypto::validateOid(oids::SGX_EXTENSION, topSequence.get(), V_ASN1_SEQUENCE);
-
-    return crypto::oidToStack(topSequence.get()).release();
+    return sgxExtension;
 }
 
-void PckCertificate::setMembers(stack_st_ASN1_TYPE *sgxExtensions)
+void PckCertificate::setMembers(const uint8_t* sgxExtension, size_t length)
 {
-    const auto stackEntries = sk_ASN1_TYPE_num(sgxExtensions);
+    crypto::DerReader sgxExtensions(crypto::readSgxExtensions(sgxExtension, length));
+    const auto stackEntries = sgxExtensions.count();
     if(stackEntries != PROCESSOR_CA_EXTENSION_COUNT && stackEntries != PLATFORM_CA_EXTENSION_COUNT)
     {
         std::string err = "OID [" + oids::SGX_EXTENSION + "] expected to contain [" +
@@ -134,71 +194,53 @@ void PckCertificate::setMembers(stack_st_ASN1_TYPE *sgxExtensions)
         LOG_AND_THROW(InvalidExtensionException,err);
     }
 
-    std::vector<Extension::Type> expectedExtensions = constants::PCK_REQUIRED_SGX_EXTENSIONS;
+    uint32_t found = 0;
 
     // Iterate through SGX Extensions stored as sequence(tuple) of OIDName and OIDValue
-    for (int i=0; i < stackEntries; i++)
+    while (sgxExtensions.hasNext())
     {
-        const auto oidTupleWrapper = sk_ASN1_TYPE_value(sgxExtensions, i);
-        crypto::validateOid(oids::SGX_EXTENSION, oidTupleWrapper, V_ASN1_SEQUENCE);
+        crypto::DerElement oidName;
+        crypto::DerElement oidValue;
+        crypto::readOidTuple(oids::SGX_EXTENSION, sgxExtensions.next(), oidName, oidValue);
 
-        const auto oidTuple = crypto::oidToStack(oidTupleWrapper);
-        const auto oidTupleEntries = sk_ASN1_TYPE_num(oidTuple.get());
-        if (oidTupleEntries != 2)
+        uint8_t arc = 0;
+        if (!crypto::isChildOid(oidName, oids::SGX_EXTENSION_DER, arc))
         {
-            std::string err = "OID tuple [" + oids::SGX_EXTENSION + "] expected number of elements is [2] given [" +
-                               std::to_string(oidTupleEntries) + "]";
-            LOG_AND_THROW(InvalidExtensionException, err);
+            continue;
         }
 
-        const auto oidName = sk_ASN1_TYPE_value(oidTuple.get(), 0);
-        const auto oidValue = sk_ASN1_TYPE_value(oidTuple.get(), 1);
-        const auto oidNameStr = obj2Str(oidName->value.object);
-
-        if (oidNameStr == oids::PPID) // TODO DRY
+        switch (arc)
         {
-            crypto::validateOid(oids::PPID, oidValue, V_ASN1_OCTET_STRING, constants::PPID_BYTE_LEN);
-            _ppid = crypto::oidToBytes(oidValue);
-            expectedExtensions.erase(std::remove(expectedExtensions.begin(), expectedExtensions.end(), Extension::Type::PPID), expectedExtensions.end());
-        }
-        else if (oidNameStr == oids::TCB)
-        {
-            _tcb = Tcb(oidValue);
-            expectedExtensions.erase(std::remove(expectedExtensions.begin(), expectedExtensions.end(), Extension::Type::TCB), expectedExtensions.end());
-        }
-        else if (oidNameStr == oids::PCEID)
-        {
-            crypto::validateOid(oids::PCEID, oidValue, V_ASN1_OCTET_STRING, constants::PCEID_BYTE_LEN);
-            _pceId = crypto::oidToBytes(oidValue);
-            expectedExtensions.erase(std::remove(expectedExtensions.begin(), expectedExtensions.end(), Extension::Type::PCEID), expectedExtensions.end());
-        }
-        else if (oidNameStr == oids::FMSPC)
-        {
-            crypto::validateOid(oids::FMSPC, oidValue, V_ASN1_OCTET_STRING, constants::FMSPC_BYTE_LEN);
-            _fmspc = crypto::oidToBytes(oidValue);
-            expectedExtensions.erase(std::remove(expectedExtensions.begin(), expectedExtensions.end(), Extension::Type::FMSPC), expectedExtensions.end());
-        }
-        else if (oidNameStr == oids::SGX_TYPE)
-        {
-            crypto::validateOid(oids::SGX_TYPE, oidValue, V_ASN1_ENUMERATED);
-            _sgxType = static_cast<SgxType>(crypto::oidToEnum(oidValue));
-            expectedExtensions.erase(std::remove(expectedExtensions.begin(), expectedExtensions.end(), Extension::Type::SGX_TYPE), expectedExtensions.end());
+            case oids::PPID_ARC:
+                crypto::validateOid(oids::PPID, oidValue, V_ASN1_OCTET_STRING, constants::PPID_BYTE_LEN);
+                _ppid.assign(oidValue.value, oidValue.value + oidValue.length);
+                found |= sgxExtensionBit(Extension::Type::PPID);
+                break;
+            case oids::TCB_ARC:
+                _tcb = readTcb(oidValue);
+                found |= sgxExtensionBit(Extension::Type::TCB);
+                break;
+            case oids::PCEID_ARC:
+                crypto::validateOid(oids::PCEID, oidValue, V_ASN1_OCTET_STRING, constants::PCEID_BYTE_LEN);
+                _pceId.assign(oidValue.value, oidValue.value + oidValue.length);
+                found |= sgxExtensionBit(Extension::Type::PCEID);
+                break;
+            case oids::FMSPC_ARC:
+                crypto::validateOid(oids::FMSPC, oidValue, V_ASN1_OCTET_STRING, constants::FMSPC_BYTE_LEN);
+                _fmspc.assign(oidValue.value, oidValue.value + oidValue.length);
+                found |= sgxExtensionBit(Extension::Type::FMSPC);
+                break;
+            case oids::SGX_TYPE_ARC:
+                crypto::validateOid(oids::SGX_TYPE, oidValue, V_ASN1_ENUMERATED);
+                _sgxType = static_cast<SgxType>(static_cast<int>(crypto::derToLong(oidValue)));
+                found |= sgxExtensionBit(Extension::Type::SGX_TYPE);
+                break;
+            default:
+                break;
         }
     }
 
-    if (!expectedExtensions.empty())
-    {
-        std::string err = "Required PCK SGX extensions not found. Missing [";
-
-        // Convert all but the last element to avoid a trailing ","
-        std::for_each(expectedExtensions.begin(), expectedExtensions.end() - 1, [&err](const auto& extension) {
-            err += oids::type2Description(extension) + ", ";
-        });
-
-        // Now add the last element with no delimiter
-        err += oids::type2Description(expectedExtensions.back()) + "]";
-        LOG_AND_THROW(InvalidExtensionException, err);
-    }
+    checkRequiredSgxExtensions("PCK", constants::PCK_REQUIRED_SGX_EXTENSIONS, found);
 }
 
 }}}}} // namespace intel { namespace sgx { namespace dcap { namespace parser { namespace x509 {
@@ -36,14 +36,70 @@
 #include "ParserUtils.h"
 #include "Utils/Logger.h"
 
-#include <algorithm> // find_if
-
 namespace intel { namespace sgx { namespace dcap { namespace parser { namespace x509 {
 
+namespace {
+
+Configuration readConfiguration(const crypto::DerElement& configurationSeq)
+{
+    crypto::validateOid(oids::CONFIGURATION, configurationSeq, V_ASN1_SEQUENCE);
+
+    crypto::DerReader configuration(configurationSeq);
+    // all entries are validated before any of them is read
+    configuration.count();
+
+    bool dynamicPlatform = true;
+    bool cachedKeys = true;
+    bool smtEnabled = true;
+    uint32_t found = 0;
+
+    // Iterate through SGX Configuration Extensions stored as sequence(tuple) of OIDName and OIDValue
+    while (configuration.hasNext())
+    {
+        crypto::DerElement oidName;
+        crypto::DerElement oidValue;
+        crypto::readOidTuple(oids::CONFIGURATION, configuration.next(), oidName, oidValue);
+
+        uint8_t arc = 0;
+        if (!crypto::isChildOid(oidName, oids::CONFIGURATION_DER, arc))
+        {
+            continue;
+        }
+
+        switch (arc)
+        {
+            case oids::DYNAMIC_PLATFORM_ARC:
+                crypto::validateOid(oids::DYNAMIC_PLATFORM, oidValue, V_ASN1_BOOLEAN);
+                dynamicPlatform = oidValue.value[0] != 0;
+                found |= sgxExtensionBit(Extension::Type::DYNAMIC_PLATFORM);
+                break;
+            case oids::CACHED_KEYS_ARC:
+                crypto::validateOid(oids::CACHED_KEYS, oidValue, V_ASN1_BOOLEAN);
+                cachedKeys = oidValue.value[0] != 0;
+                found |= sgxExtensionBit(Extension::Type::CACHED_KEYS);
+                break;
+            case oids::SMT_ENABLED_ARC:
+                crypto::validateOid(oids::SMT_ENABLED, oidValue, V_ASN1_BOOLEAN);
+                smtEnabled = oidValue.value[0] != 0;
+                found |= sgxExtensionBit(Extension::Type::SMT_ENABLED);
+                break;
+            default:
+                break;
+        }
+    }
+
+    checkRequiredSgxExtensions("Configuration", constants::CONFIGURATION_REQUIRED_SGX_EXTENSIONS, found);
+
+    return Configuration(dynamicPlatform, cachedKeys, smtEnabled);
+}
+
+} // anonymous namespace
+
 PlatformPckCertificate::PlatformPckCertificate(const Certificate& certificate): PckCertificate(certificate)
 {
-    auto sgxExtensions = crypto::make_unique(getSgxExtensions());
-    setMembers(sgxExtensions.get());
+    size_t sgxExtensionLength = 0;
+    const auto sgxExtension = getSgxExtension(sgxExtensionLength);
+    setMembers(sgxExtension, sgxExtensionLength);
 }
 
 bool PlatformPckCertificate::operator==(const PlatformPckCertificate& other) const
@@ -72,16 +128,17 @@ PlatformPckCertificate PlatformPckCertificate::parse(const std::string& pem)
 
 PlatformPckCertificate::PlatformPckCertificate(const std::string& pem): PckCertificate(pem)
 {
-    auto sgxExtensions = crypto::make_unique(getSgxExtensions());
-    setMembers(sgxExtensions.get());
+    size_t sgxExtensionLength = 0;
+    const auto sgxExtension = getSgxExtension(sgxExtensionLength);
+    setMembers(sgxExtension, sgxExtensionLength);
 }
 
 
-void PlatformPckCertificate::setMembers(stack_st_ASN1_TYPE *sgxExtensions)
+void PlatformPckCertificate::setMembers(const uint8_t* sgxExtension, size_t length)
 {
-    PckCertificate::setMembers(sgxExtensions);
-
-    const auto stackEntries = sk_ASN1_TYPE_num(sgxExtensions);
+    // members common with PckCertificate are already set by its constructor
+    crypto::DerReader sgxExtensions(crypto::readSgxExtensions(sgxExtension, length));
+    const auto stackEntries = sgxExtensions.count();
     if(stackEntries != PLATFORM_CA_EXTENSION_COUNT)
     {
         std::string err = "OID [" + oids::SGX_EXTENSION + "] expected to contain [" + std::to_string(PLATFORM_CA_EXTENSION_COUNT) +
@@ -89,53 +146,36 @@ void PlatformPckCertificate::setMembers(stack_st_ASN1_TYPE *sgxExtensions)
         LOG_AND_THROW(InvalidExtensionException, err);
     }
 
-    std::vector<Extension::Type> expectedExtensions = constants::PLATFORM_PCK_REQUIRED_SGX_EXTENSIONS;
+    uint32_t found = 0;
 
     // Iterate through SGX Extensions stored as sequence(tuple) of OIDName and OIDValue
-    for (int i=0; i < stackEntries; i++) {
-        const auto oidTupleWrapper = sk_ASN1_TYPE_value(sgxExtensions, i);
-        crypto::validateOid(oids::SGX_EXTENSION, oidTupleWrapper, V_ASN1_SEQUENCE);
-
-        const auto oidTuple = crypto::oidToStack(oidTupleWrapper);
-        const auto oidTupleEntries = sk_ASN1_TYPE_num(oidTuple.get());
-        if (oidTupleEntries != 2) {
-            std::string err = "OID tuple [" + oids::SGX_EXTENSION + "] expected number of elements is [2] given [" +
-                              std::to_string(oidTupleEntries) + "]";
-            LOG_AND_THROW(InvalidExtensionException, err);
+    while (sgxExtensions.hasNext())
+    {
+        crypto::DerElement oidName;
+        crypto::DerElement oidValue;
+        crypto::readOidTuple(oids::SGX_EXTENSION, sgxExtensions.next(), oidName, oidValue);
+
+        uint8_t arc = 0;
+        if (!crypto::isChildOid(oidName, oids::SGX_EXTENSION_DER, arc))
+        {
+            continue;
         }
 
-        const auto oidName = sk_ASN1_TYPE_value(oidTuple.get(), 0);
-        const auto oidValue = sk_ASN1_TYPE_value(oidTuple.get(), 1);
-        const auto oidNameStr = obj2Str(oidName->value.object);
-
-        if (oidNameStr == oids::PLATFORM_INSTANCE_ID) {
+        if (arc == oids::PLATFORM_INSTANCE_ID_ARC)
+        {
             crypto::validateOid(oids::PLATFORM_INSTANCE_ID, oidValue, V_ASN1_OCTET_STRING,
                                 constants::PLATFORM_INSTANCE_ID_LEN);
-            _platformInstanceId = crypto::oidToBytes(oidValue);
-            expectedExtensions.erase(std::remove(expectedExtensions.begin(), expectedExtensions.end(),
-                                                 Extension::Type::PLATFORM_INSTANCE_ID), expectedExtensions.end());
-        } else if (oidNameStr == oids::CONFIGURATION) {
-            _configuration = Configuration(oidValue);
-            expectedExtensions.erase(
-                    std::remove(expectedExtensions.begin(), expectedExtensions.end(), Extension::Type::CONFIGURATION),
-                    expectedExtensions.end());
+            _platformInstanceId.assign(oidValue.value, oidValue.value + oidValue.length);
+            found |= sgxExtensionBit(Extension::Type::PLATFORM_INSTANCE_ID);
+        }
+        else if (arc == oids::CONFIGURATION_ARC)
+        {
+            _configuration = readConfiguration(oidValue);
+            found |= sgxExtensionBit(Extension::Type::CONFIGURATION);
         }
     }
 
-    if (!expectedExtensions.empty())
-    {
-        std::string err = "Required PCK SGX extensions not found. Missing [";
-
-        // Convert all but the last element to avoid a trailing ","
-        std::for_each(expectedExtensions.begin(), expectedExtensions.end() - 1, [&err](const auto& extension) {
-            err += oids::type2Description(extension) + ", ";
-        });
-
-        // Now add the last element with no delimiter
-        err += oids::type2Description(expectedExtensions.back()) + "]";
-
-        LOG_AND_THROW(InvalidExtensionException, err);
-    }
+    checkRequiredSgxExtensions("PCK", constants::PLATFORM_PCK_REQUIRED_SGX_EXTENSIONS, found);
 }
 
 }}}}} // namespace intel { namespace sgx { namespace dcap { namespace parser { namespace x509 {
@@ -39,8 +39,9 @@ namespace intel { namespace sgx { namespace dcap { namespace parser { namespace
 
 ProcessorPckCertificate::ProcessorPckCertificate(const Certificate& certificate): PckCertificate(certificate)
 {
-    auto sgxExtensions = crypto::make_unique(getSgxExtensions());
-    setMembers(sgxExtensions.get());
+    size_t sgxExtensionLength = 0;
+    const auto sgxExtension = getSgxExtension(sgxExtensionLength);
+    setMembers(sgxExtension, sgxExtensionLength);
 }
 
 ProcessorPckCertificate ProcessorPckCertificate::parse(const std::string& pem)
@@ -52,16 +53,16 @@ ProcessorPckCertificate ProcessorPckCertificate::parse(const std::string& pem)
 
 ProcessorPckCertificate::ProcessorPckCertificate(const std::string& pem): PckCertificate(pem)
 {
-    auto sgxExtensions = crypto::make_unique(getSgxExtensions());
-    setMembers(sgxExtensions.get());
+    size_t sgxExtensionLength = 0;
+    const auto sgxExtension = getSgxExtension(sgxExtensionLength);
+    setMembers(sgxExtension, sgxExtensionLength);
 }
 
 
-void ProcessorPckCertificate::setMembers(stack_st_ASN1_TYPE *sgxExtensions)
+void ProcessorPckCertificate::setMembers(const uint8_t* sgxExtension, size_t length)
 {
-    PckCertificate::setMembers(sgxExtensions);
-
-    const auto stackEntries = sk_ASN1_TYPE_num(sgxExtensions);
+    // members common with PckCertificate are already set by its constructor
+    const auto stackEntries = crypto::DerReader(crypto::readSgxExtensions(sgxExtension, length)).count();
     if(stackEntries != PROCESSOR_CA_EXTENSION_COUNT)
     {
         std::string err = "OID [" + oids::SGX_EXTENSION + "] expected to contain [" + std::to_string(PROCESSOR_CA_EXTENSION_COUNT) +
@@ -354,4 +354,23 @@ std::string X509CertGenerator::x509ToString(const X509 *cert)
     return ret;
 }
 
+Bytes X509CertGenerator::x509ToDer(const X509 *cert)
+{
+    if (nullptr == cert)
+    {
+        return {};
+    }
+
+    unsigned char *buf = nullptr;
+    const auto len = i2d_X509(cert, &buf);
+    if (len <= 0)
+    {
+        return {};
+    }
+
+    Bytes ret(buf, buf + len);
+    OPENSSL_free(buf);
+    return ret;
+}
+
 }}}}}
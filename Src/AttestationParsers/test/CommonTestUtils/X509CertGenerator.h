@@ -71,6 +71,7 @@ public:
     crypto::EVP_PKEY_uptr generateEcKeypair() const;
 
     std::string x509ToString(const X509 *cert);
+    Bytes x509ToDer(const X509 *cert);
 
 private:
     crypto::X509_uptr generateBaseCert(int version, const Bytes &serialNumber,
@@ -37,6 +37,8 @@
 
 #include <gmock/gmock-matchers.h>
 
+#include <thread>
+
 using namespace intel::sgx::dcap;
 using namespace intel::sgx::dcap::parser;
 using namespace ::testing;
@@ -53,7 +55,7 @@ struct CertificateUT: public testing::Test {
     Bytes pcesvn = {0x03, 0xf2};
     Bytes pceId = {0x04, 0xf3};
     Bytes fmspc = {0x05, 0xf4, 0x44, 0x45, 0xaa, 0x00};
-    test::X509CertGenerator certGenerator;
+    parser::test::X509CertGenerator certGenerator;
 
     crypto::EVP_PKEY_uptr keyRoot = crypto::make_unique<EVP_PKEY>(nullptr);
     crypto::EVP_PKEY_uptr keyInt = crypto::make_unique<EVP_PKEY>(nullptr);
@@ -151,3 +153,37 @@ TEST_F(CertificateUT, certificateOperators)
     ASSERT_FALSE(certificate3 == certificate4);
 }
 
+
+TEST_F(CertificateUT, certificateFieldsAreSharedBetweenCopies)
+{
+    const auto certificate = x509::Certificate::parse(pemPckCert);
+    const auto copyCertificate = certificate;
+
+    ASSERT_EQ(&copyCertificate.getInfo(), &certificate.getInfo());
+    ASSERT_EQ(&copyCertificate.getSubject(), &certificate.getSubject());
+    ASSERT_EQ(&copyCertificate.getExtensions(), &certificate.getExtensions());
+    ASSERT_EQ(copyCertificate, certificate);
+}
+
+TEST_F(CertificateUT, certificateConcurrentFirstAccess)
+{
+    const auto certificate = x509::Certificate::parse(pemPckCert);
+    const auto expected = x509::Certificate::parse(pemPckCert);
+    ASSERT_FALSE(expected.getExtensions().empty());
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; i++)
+    {
+        threads.emplace_back([&certificate, &expected] {
+            EXPECT_EQ(expected.getInfo(), certificate.getInfo());
+            EXPECT_EQ(expected.getSerialNumber(), certificate.getSerialNumber());
+            EXPECT_EQ(expected.getSubject(), certificate.getSubject());
+            EXPECT_EQ(expected.getIssuer(), certificate.getIssuer());
+            EXPECT_EQ(expected.getExtensions(), certificate.getExtensions());
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
@@ -0,0 +1,782 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "UnitTests.h"
+
+#include "OpensslHelpers/DerReader.h"
+#include "OpensslHelpers/OidUtils.h"
+#include "ParserUtils.h"
+#include "X509Constants.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <set>
+
+using namespace intel::sgx::dcap;
+using namespace intel::sgx::dcap::parser;
+
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+
+Bytes concat(const std::vector<Bytes>& parts)
+{
+    size_t size = 0;
+    for (const auto& part : parts)
+    {
+        size += part.size();
+    }
+    Bytes result(size);
+    auto out = result.begin();
+    for (const auto& part : parts)
+    {
+        out = std::copy(part.begin(), part.end(), out);
+    }
+    return result;
+}
+
+Bytes tlv(uint8_t tag, const Bytes& content)
+{
+    Bytes length;
+    if (content.size() < 0x80)
+    {
+        length = Bytes(1, static_cast<uint8_t>(content.size()));
+    }
+    else
+    {
+        for (auto remaining = content.size(); remaining > 0; remaining >>= 8)
+        {
+            length.insert(length.begin(), static_cast<uint8_t>(remaining & 0xFF));
+        }
+        length.insert(length.begin(), static_cast<uint8_t>(0x80 | length.size()));
+    }
+    return concat({Bytes(1, tag), length, content});
+}
+
+Bytes oid(const uint8_t* parent, size_t parentSize, uint8_t arc)
+{
+    Bytes content(parentSize + 1);
+    std::copy(parent, parent + parentSize, content.begin());
+    content[parentSize] = arc;
+    return tlv(V_ASN1_OBJECT, content);
+}
+
+Bytes integer(uint8_t tag, long value)
+{
+    Bytes content;
+    bool done = false;
+    while (!done)
+    {
+        const auto byte = static_cast<uint8_t>(value & 0xFF);
+        content.insert(content.begin(), byte);
+        value >>= 8;
+        done = (value == 0 && (byte & 0x80) == 0) || (value == -1 && (byte & 0x80) != 0);
+    }
+    return tlv(tag, content);
+}
+
+/**
+ * Tree representation of DER data used to generate valid SGX extensions and mutate them structurally
+ */
+struct Node
+{
+    uint8_t tag;
+    Bytes content;
+    std::vector<Node> children;
+
+    Bytes encode() const
+    {
+        if (tag != 0x30)
+        {
+            return tlv(tag, content);
+        }
+        std::vector<Bytes> encoded;
+        for (const auto& child : children)
+        {
+            encoded.push_back(child.encode());
+        }
+        return tlv(tag, concat(encoded));
+    }
+};
+
+Node primitive(const Bytes& encoded)
+{
+    // encoded elements built by tlv() with short length form are all that is needed here
+    return Node{encoded[0], Bytes(encoded.begin() + 2, encoded.end()), {}};
+}
+
+Node sequence(std::vector<Node> children)
+{
+    return Node{0x30, {}, std::move(children)};
+}
+
+Node tuple(const Bytes& name, Node value)
+{
+    return sequence({primitive(name), std::move(value)});
+}
+
+Bytes randomBytes(std::mt19937& rng, size_t size)
+{
+    std::uniform_int_distribution<int> byte(0, 255);
+    Bytes bytes(size);
+    std::generate(bytes.begin(), bytes.end(), [&]{ return static_cast<uint8_t>(byte(rng)); });
+    return bytes;
+}
+
+Node sgxExtensions(std::mt19937& rng, bool platform)
+{
+    const auto sgxOid = [](uint8_t arc) { return oid(oids::SGX_EXTENSION_DER, sizeof(oids::SGX_EXTENSION_DER), arc); };
+    std::uniform_int_distribution<int> svn(0, 255);
+
+    std::vector<Node> tcb;
+    for (uint8_t arc = oids::SGX_TCB_COMP01_SVN_ARC; arc <= oids::SGX_TCB_COMP16_SVN_ARC; arc++)
+    {
+        tcb.push_back(tuple(oid(oids::TCB_DER, sizeof(oids::TCB_DER), arc), primitive(integer(V_ASN1_INTEGER, svn(rng)))));
+    }
+    tcb.push_back(tuple(oid(oids::TCB_DER, sizeof(oids::TCB_DER), oids::PCESVN_ARC),
+                        primitive(integer(V_ASN1_INTEGER, std::uniform_int_distribution<long>(0, 65535)(rng)))));
+    tcb.push_back(tuple(oid(oids::TCB_DER, sizeof(oids::TCB_DER), oids::CPUSVN_ARC),
+                        primitive(tlv(V_ASN1_OCTET_STRING, randomBytes(rng, constants::CPUSVN_BYTE_LEN)))));
+
+    std::vector<Node> extensions{
+        tuple(sgxOid(oids::PPID_ARC), primitive(tlv(V_ASN1_OCTET_STRING, randomBytes(rng, constants::PPID_BYTE_LEN)))),
+        tuple(sgxOid(oids::TCB_ARC), sequence(tcb)),
+        tuple(sgxOid(oids::PCEID_ARC), primitive(tlv(V_ASN1_OCTET_STRING, randomBytes(rng, constants::PCEID_BYTE_LEN)))),
+        tuple(sgxOid(oids::FMSPC_ARC), primitive(tlv(V_ASN1_OCTET_STRING, randomBytes(rng, constants::FMSPC_BYTE_LEN)))),
+        tuple(sgxOid(oids::SGX_TYPE_ARC), primitive(integer(V_ASN1_ENUMERATED, std::uniform_int_distribution<long>(0, 2)(rng))))
+    };
+
+    if (platform)
+    {
+        std::vector<Node> configuration;
+        for (uint8_t arc = oids::DYNAMIC_PLATFORM_ARC; arc <= oids::SMT_ENABLED_ARC; arc++)
+        {
+            configuration.push_back(tuple(oid(oids::CONFIGURATION_DER, sizeof(oids::CONFIGURATION_DER), arc),
+                                          primitive(tlv(V_ASN1_BOOLEAN, Bytes(1, static_cast<uint8_t>(svn(rng) % 2 ? 0xFF : 0x00))))));
+        }
+        extensions.push_back(tuple(sgxOid(oids::PLATFORM_INSTANCE_ID_ARC),
+                                   primitive(tlv(V_ASN1_OCTET_STRING, randomBytes(rng, constants::PLATFORM_INSTANCE_ID_LEN)))));
+        extensions.push_back(tuple(sgxOid(oids::CONFIGURATION_ARC), sequence(configuration)));
+    }
+
+    return sequence(extensions);
+}
+
+void collect(Node& node, std::vector<std::pair<Node*, Node*>>& nodes, Node* parent)
+{
+    nodes.emplace_back(&node, parent);
+    for (auto& child : node.children)
+    {
+        collect(child, nodes, &node);
+    }
+}
+
+Node randomElement(std::mt19937& rng)
+{
+    static const uint8_t tags[] = {V_ASN1_BOOLEAN, V_ASN1_INTEGER, V_ASN1_OCTET_STRING, V_ASN1_NULL, V_ASN1_OBJECT,
+                                   V_ASN1_ENUMERATED, V_ASN1_UTF8STRING, 0x80, 0x30};
+    const auto tag = tags[std::uniform_int_distribution<size_t>(0, sizeof(tags) - 1)(rng)];
+    return Node{tag, randomBytes(rng, std::uniform_int_distribution<size_t>(0, 3)(rng)), {}};
+}
+
+void mutateStructure(std::mt19937& rng, Node& root)
+{
+    std::vector<std::pair<Node*, Node*>> nodes;
+    collect(root, nodes, nullptr);
+    auto& picked = nodes[std::uniform_int_distribution<size_t>(0, nodes.size() - 1)(rng)];
+    Node& node = *picked.first;
+    Node* parent = picked.second;
+
+    switch (std::uniform_int_distribution<int>(0, 7)(rng))
+    {
+        case 0: // remove
+            if (parent)
+            {
+                parent->children.erase(std::find_if(parent->children.begin(), parent->children.end(),
+                                                    [&node](const Node& child) { return &child == &node; }));
+            }
+            break;
+        case 1: // duplicate
+            if (parent)
+            {
+                const Node copy = node;
+                parent->children.push_back(copy);
+            }
+            break;
+        case 2: // replace with random element
+            node = randomElement(rng);
+            break;
+        case 3: // change primitive length
+            if (node.tag != 0x30)
+            {
+                if (!node.content.empty() && std::uniform_int_distribution<int>(0, 1)(rng))
+                {
+                    node.content.pop_back();
+                }
+                else
+                {
+                    node.content.push_back(static_cast<uint8_t>(std::uniform_int_distribution<int>(0, 255)(rng)));
+                }
+            }
+            break;
+        case 4: // change tag
+            node.tag = randomElement(rng).tag;
+            break;
+        case 5: // random content
+            if (node.tag != 0x30)
+            {
+                node.content = randomBytes(rng, node.content.size());
+            }
+            break;
+        case 6: // add element
+            if (node.tag == 0x30)
+            {
+                node.children.push_back(randomElement(rng));
+            }
+            break;
+        default: // swap with sibling
+            if (parent && parent->children.size() > 1)
+            {
+                std::swap(node, parent->children[std::uniform_int_distribution<size_t>(0, parent->children.size() - 1)(rng)]);
+            }
+            break;
+    }
+}
+
+void mutateBytes(std::mt19937& rng, Bytes& encoded)
+{
+    const auto position = std::uniform_int_distribution<size_t>(0, encoded.size() - 1)(rng);
+    const auto byte = static_cast<uint8_t>(std::uniform_int_distribution<int>(0, 255)(rng));
+    switch (std::uniform_int_distribution<int>(0, 3)(rng))
+    {
+        case 0:
+            encoded[position] = byte;
+            break;
+        case 1:
+            encoded[position] ^= static_cast<uint8_t>(1u << std::uniform_int_distribution<int>(0, 7)(rng));
+            break;
+        case 2:
+            encoded.insert(encoded.begin() + static_cast<std::ptrdiff_t>(position), byte);
+            break;
+        default:
+            encoded.resize(position);
+            break;
+    }
+}
+
+struct DecodedSgxExtensions
+{
+    Bytes ppid;
+    Bytes pceId;
+    Bytes fmspc;
+    int sgxType = 0;
+    Bytes cpuSvn;
+    Bytes cpuSvnComponents;
+    uint32_t pceSvn = 0;
+    Bytes platformInstanceId;
+    bool dynamicPlatform = true;
+    bool cachedKeys = true;
+    bool smtEnabled = true;
+};
+
+enum class Outcome
+{
+    DECODED,
+    FORMAT_EXCEPTION,
+    INVALID_EXTENSION_EXCEPTION
+};
+
+Outcome run(const std::function<void()>& decode)
+{
+    try
+    {
+        decode();
+        return Outcome::DECODED;
+    }
+    catch (const InvalidExtensionException&)
+    {
+        return Outcome::INVALID_EXTENSION_EXCEPTION;
+    }
+    catch (const FormatException&)
+    {
+        return Outcome::FORMAT_EXCEPTION;
+    }
+}
+
+/**
+ * SGX extensions decoder built on d2i_ASN1_TYPE and d2i_ASN1_SEQUENCE_ANY stacks, following the
+ * decoding order of PCK certificates before DerReader was introduced.
+ * Tracks whether decoded data is DER, OpenSSL also accepts BER encodings that are rejected by DerReader.
+ */
+class OpensslSgxExtensionsDecoder
+{
+public:
+    bool der = true;
+
+    void decode(const Bytes& extension, bool platform, DecodedSgxExtensions& decoded)
+    {
+        decodePck(extension, decoded);
+        if (platform)
+        {
+            decodePlatform(extension, decoded);
+        }
+    }
+
+private:
+    crypto::ASN1_TYPE_uptr top(const Bytes& extension)
+    {
+        const auto *data = extension.data();
+        auto sgxExtensions = crypto::make_unique(d2i_ASN1_TYPE(nullptr, &data, static_cast<long>(extension.size())));
+        if (!sgxExtensions)
+        {
+            throw InvalidExtensionException("d2i_ASN1_TYPE failed");
+        }
+        unsigned char *encoded = nullptr;
+        const auto length = i2d_ASN1_TYPE(sgxExtensions.get(), &encoded);
+        der = der && data == extension.data() + extension.size() && length == static_cast<int>(extension.size()) &&
+              std::equal(encoded, encoded + length, extension.data());
+        OPENSSL_free(encoded);
+        crypto::validateOid(oids::SGX_EXTENSION, sgxExtensions.get(), V_ASN1_SEQUENCE);
+        return sgxExtensions;
+    }
+
+    crypto::STACK_OF_ASN1TYPE_uptr stack(const ASN1_TYPE *sequence)
+    {
+        auto entries = crypto::oidToStack(sequence);
+        unsigned char *encoded = nullptr;
+        const auto length = i2d_ASN1_SEQUENCE_ANY(entries.get(), &encoded);
+        der = der && length == sequence->value.sequence->length &&
+              std::equal(encoded, encoded + length, sequence->value.sequence->data);
+        OPENSSL_free(encoded);
+        return entries;
+    }
+
+    void forEachTuple(const std::string& parentOid, STACK_OF(ASN1_TYPE) *entries,
+                      const std::function<void(const std::string&, const ASN1_TYPE*)>& handle)
+    {
+        for (int i = 0; i < sk_ASN1_TYPE_num(entries); i++)
+        {
+            const auto oidTupleWrapper = sk_ASN1_TYPE_value(entries, i);
+            crypto::validateOid(parentOid, oidTupleWrapper, V_ASN1_SEQUENCE);
+            const auto oidTuple = stack(oidTupleWrapper);
+            if (sk_ASN1_TYPE_num(oidTuple.get()) != 2)
+            {
+                throw InvalidExtensionException("OID tuple expected number of elements is [2]");
+            }
+            const auto oidName = sk_ASN1_TYPE_value(oidTuple.get(), 0);
+            if (oidName->type != V_ASN1_OBJECT)
+            {
+                // previous implementation reinterpreted such value as ASN1_OBJECT
+                throw FormatException("OID tuple name is not an object");
+            }
+            handle(obj2Str(oidName->value.object), sk_ASN1_TYPE_value(oidTuple.get(), 1));
+        }
+    }
+
+    static void requireAll(const std::set<std::string>& found, const std::vector<std::string>& required)
+    {
+        for (const auto& oidName : required)
+        {
+            if (found.count(oidName) == 0)
+            {
+                throw InvalidExtensionException("Missing " + oidName);
+            }
+        }
+    }
+
+    void decodeTcb(const ASN1_TYPE *tcbSeq, DecodedSgxExtensions& decoded)
+    {
+        crypto::validateOid(oids::TCB, tcbSeq, V_ASN1_SEQUENCE);
+        const auto entries = stack(tcbSeq);
+        if (sk_ASN1_TYPE_num(entries.get()) != static_cast<int>(constants::TCB_SEQUENCE_LEN))
+        {
+            throw InvalidExtensionException("TCB length expected [18]");
+        }
+
+        std::vector<std::string> components;
+        for (int i = 1; i <= 16; i++)
+        {
+            components.push_back(oids::TCB + "." + std::to_string(i));
+        }
+
+        Bytes cpuSvn;
+        Bytes cpuSvnComponents(constants::CPUSVN_BYTE_LEN);
+        uint32_t pceSvn = 0;
+        std::set<std::string> found;
+        forEachTuple(oids::TCB, entries.get(), [&](const std::string& oidName, const ASN1_TYPE *oidValue) {
+            const auto component = std::find(components.begin(), components.end(), oidName);
+            if (component != components.end())
+            {
+                crypto::validateOid(oidName, oidValue, V_ASN1_INTEGER);
+                cpuSvnComponents[static_cast<size_t>(component - components.begin())] = crypto::oidToByte(oidValue);
+            }
+            else if (oidName == oids::PCESVN)
+            {
+                crypto::validateOid(oidName, oidValue, V_ASN1_INTEGER);
+                pceSvn = crypto::oidToUInt(oidValue);
+            }
+            else if (oidName == oids::CPUSVN)
+            {
+                crypto::validateOid(oidName, oidValue, V_ASN1_OCTET_STRING, constants::CPUSVN_BYTE_LEN);
+                cpuSvn = crypto::oidToBytes(oidValue);
+            }
+            found.insert(oidName);
+        });
+
+        auto required = components;
+        required.push_back(oids::PCESVN);
+        required.push_back(oids::CPUSVN);
+        requireAll(found, required);
+
+        decoded.cpuSvn = cpuSvn;
+        decoded.cpuSvnComponents = cpuSvnComponents;
+        decoded.pceSvn = pceSvn;
+    }
+
+    void decodeConfiguration(const ASN1_TYPE *configurationSeq, DecodedSgxExtensions& decoded)
+    {
+        crypto::validateOid(oids::CONFIGURATION, configurationSeq, V_ASN1_SEQUENCE);
+        const auto entries = stack(configurationSeq);
+
+        std::set<std::string> found;
+        forEachTuple(oids::CONFIGURATION, entries.get(), [&](const std::string& oidName, const ASN1_TYPE *oidValue) {
+            bool* flag = oidName == oids::DYNAMIC_PLATFORM ? &decoded.dynamicPlatform :
+                         oidName == oids::CACHED_KEYS ? &decoded.cachedKeys :
+                         oidName == oids::SMT_ENABLED ? &decoded.smtEnabled : nullptr;
+            if (flag)
+            {
+                crypto::validateOid(oidName, oidValue, V_ASN1_BOOLEAN);
+                *flag = oidValue->value.boolean != 0;
+                found.insert(oidName);
+            }
+        });
+        requireAll(found, {oids::DYNAMIC_PLATFORM, oids::CACHED_KEYS, oids::SMT_ENABLED});
+    }
+
+    void decodePck(const Bytes& extension, DecodedSgxExtensions& decoded)
+    {
+        const auto sgxExtensions = top(extension);
+        const auto entries = stack(sgxExtensions.get());
+        const auto count = sk_ASN1_TYPE_num(entries.get());
+        if (count != 5 && count != 7)
+        {
+            throw InvalidExtensionException("Unexpected number of SGX extensions");
+        }
+
+        std::set<std::string> found;
+        forEachTuple(oids::SGX_EXTENSION, entries.get(), [&](const std::string& oidName, const ASN1_TYPE *oidValue) {
+            if (oidName == oids::PPID || oidName == oids::PCEID || oidName == oids::FMSPC)
+            {
+                const auto length = oidName == oids::PPID ? constants::PPID_BYTE_LEN :
+                                    oidName == oids::PCEID ? constants::PCEID_BYTE_LEN : constants::FMSPC_BYTE_LEN;
+                crypto::validateOid(oidName, oidValue, V_ASN1_OCTET_STRING, static_cast<int>(length));
+                (oidName == oids::PPID ? decoded.ppid : oidName == oids::PCEID ? decoded.pceId : decoded.fmspc) =
+                        crypto::oidToBytes(oidValue);
+            }
+            else if (oidName == oids::TCB)
+            {
+                decodeTcb(oidValue, decoded);
+            }
+            else if (oidName == oids::SGX_TYPE)
+            {
+                crypto::validateOid(oidName, oidValue, V_ASN1_ENUMERATED);
+                decoded.sgxType = crypto::oidToEnum(oidValue);
+            }
+            found.insert(oidName);
+        });
+        requireAll(found, {oids::PPID, oids::PCEID, oids::FMSPC, oids::SGX_TYPE, oids::TCB});
+    }
+
+    void decodePlatform(const Bytes& extension, DecodedSgxExtensions& decoded)
+    {
+        const auto sgxExtensions = top(extension);
+        const auto entries = stack(sgxExtensions.get());
+        if (sk_ASN1_TYPE_num(entries.get()) != 7)
+        {
+            throw InvalidExtensionException("Unexpected number of SGX extensions");
+        }
+
+        std::set<std::string> found;
+        forEachTuple(oids::SGX_EXTENSION, entries.get(), [&](const std::string& oidName, const ASN1_TYPE *oidValue) {
+            if (oidName == oids::PLATFORM_INSTANCE_ID)
+            {
+                crypto::validateOid(oidName, oidValue, V_ASN1_OCTET_STRING, constants::PLATFORM_INSTANCE_ID_LEN);
+                decoded.platformInstanceId = crypto::oidToBytes(oidValue);
+            }
+            else if (oidName == oids::CONFIGURATION)
+            {
+                decodeConfiguration(oidValue, decoded);
+            }
+            found.insert(oidName);
+        });
+        requireAll(found, {oids::PLATFORM_INSTANCE_ID, oids::CONFIGURATION});
+    }
+};
+
+Outcome decodeWithDerReader(const Bytes& extension, bool platform, DecodedSgxExtensions& decoded)
+{
+    if (platform)
+    {
+        x509::PlatformPckCertificate certificate;
+        const auto outcome = run([&]{ x509::UnitTests::setPlatformPckCertificateMembers(certificate, extension); });
+        decoded.platformInstanceId = certificate.getPlatformInstanceId();
+        decoded.dynamicPlatform = certificate.getConfiguration().isDynamicPlatform();
+        decoded.cachedKeys = certificate.getConfiguration().isCachedKeys();
+        decoded.smtEnabled = certificate.getConfiguration().isSmtEnabled();
+        decoded.ppid = certificate.getPpid();
+        decoded.pceId = certificate.getPceId();
+        decoded.fmspc = certificate.getFmspc();
+        decoded.sgxType = outcome == Outcome::DECODED ? static_cast<int>(certificate.getSgxType()) : 0;
+        decoded.cpuSvn = certificate.getTcb().getCpuSvn();
+        decoded.cpuSvnComponents = certificate.getTcb().getSgxTcbComponents();
+        decoded.pceSvn = certificate.getTcb().getPceSvn();
+        return outcome;
+    }
+
+    x509::PckCertificate certificate;
+    const auto outcome = run([&]{ x509::UnitTests::setPckCertificateMembers(certificate, extension); });
+    decoded.ppid = certificate.getPpid();
+    decoded.pceId = certificate.getPceId();
+    decoded.fmspc = certificate.getFmspc();
+    decoded.sgxType = outcome == Outcome::DECODED ? static_cast<int>(certificate.getSgxType()) : 0;
+    decoded.cpuSvn = certificate.getTcb().getCpuSvn();
+    decoded.cpuSvnComponents = certificate.getTcb().getSgxTcbComponents();
+    decoded.pceSvn = certificate.getTcb().getPceSvn();
+    return outcome;
+}
+
+/**
+ * @return false when input is not DER and was skipped
+ */
+bool expectEquivalentDecoding(const Bytes& extension, bool platform)
+{
+    OpensslSgxExtensionsDecoder reference;
+    DecodedSgxExtensions expected;
+    const auto expectedOutcome = run([&]{ reference.decode(extension, platform, expected); });
+    if (!reference.der)
+    {
+        return false;
+    }
+
+    DecodedSgxExtensions actual;
+    const auto actualOutcome = decodeWithDerReader(extension, platform, actual);
+    EXPECT_EQ(expectedOutcome, actualOutcome);
+    if (expectedOutcome == Outcome::DECODED && actualOutcome == Outcome::DECODED)
+    {
+        EXPECT_EQ(expected.ppid, actual.ppid);
+        EXPECT_EQ(expected.pceId, actual.pceId);
+        EXPECT_EQ(expected.fmspc, actual.fmspc);
+        EXPECT_EQ(expected.sgxType, actual.sgxType);
+        EXPECT_EQ(expected.cpuSvn, actual.cpuSvn);
+        EXPECT_EQ(expected.cpuSvnComponents, actual.cpuSvnComponents);
+        EXPECT_EQ(expected.pceSvn, actual.pceSvn);
+        if (platform)
+        {
+            EXPECT_EQ(expected.platformInstanceId, actual.platformInstanceId);
+            EXPECT_EQ(expected.dynamicPlatform, actual.dynamicPlatform);
+            EXPECT_EQ(expected.cachedKeys, actual.cachedKeys);
+            EXPECT_EQ(expected.smtEnabled, actual.smtEnabled);
+        }
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+TEST(DerReaderUT, readsShortAndLongFormLengths)
+{
+    const Bytes content(300, 0xAB);
+    const auto encoded = concat({tlv(V_ASN1_OCTET_STRING, Bytes(2, 0x01)), tlv(V_ASN1_OCTET_STRING, content)});
+
+    crypto::DerReader reader(encoded.data(), encoded.size());
+    ASSERT_EQ(2, reader.count());
+
+    const auto first = reader.next();
+    EXPECT_EQ(V_ASN1_OCTET_STRING, first.type);
+    EXPECT_EQ(2, first.length);
+    EXPECT_EQ(encoded.data() + 2, first.value);
+
+    const auto second = reader.next();
+    EXPECT_EQ(300, second.length);
+    EXPECT_TRUE(std::equal(content.begin(), content.end(), second.value));
+    EXPECT_FALSE(reader.hasNext());
+}
+
+TEST(DerReaderUT, readsNestedSequence)
+{
+    const auto encoded = tlv(0x30, concat({integer(V_ASN1_INTEGER, 5), tlv(V_ASN1_NULL, {})}));
+
+    crypto::DerReader reader(encoded.data(), encoded.size());
+    const auto sequence = reader.next();
+    ASSERT_EQ(V_ASN1_SEQUENCE, sequence.type);
+    ASSERT_TRUE(sequence.constructed);
+
+    crypto::DerReader content(sequence);
+    EXPECT_EQ(5, crypto::derToLong(content.next()));
+    EXPECT_EQ(V_ASN1_NULL, content.next().type);
+    EXPECT_FALSE(content.hasNext());
+}
+
+TEST(DerReaderUT, nonUniversalTagsAreOther)
+{
+    const Bytes encoded{0xA0, 0x01, 0x00, 0x9F, 0x21, 0x00};
+
+    crypto::DerReader reader(encoded.data(), encoded.size());
+    EXPECT_EQ(V_ASN1_OTHER, reader.next().type);
+    EXPECT_EQ(V_ASN1_OTHER, reader.next().type);
+}
+
+TEST(DerReaderUT, rejectsBerOnlyAndMalformedEncodings)
+{
+    const std::vector<Bytes> malformed{
+        {0x04},                         // missing length
+        {0x04, 0x02, 0x00},             // length exceeds data
+        {0x30, 0x80, 0x00, 0x00},       // indefinite length
+        {0x04, 0x81, 0x01, 0x00},       // non-minimal long form length
+        {0x04, 0x82, 0x00, 0x81},       // leading zero in length
+        {0x24, 0x03, 0x04, 0x01, 0x00}, // constructed octet string
+        {0x10, 0x00},                   // primitive sequence
+        {0x1F, 0x02, 0x01, 0x00},       // universal tag number below 31 in high tag form
+        {0x00, 0x00},                   // end-of-contents
+        {0x01, 0x02, 0x00, 0x00},       // boolean length
+        {0x05, 0x01, 0x00},             // null length
+        {0x02, 0x00},                   // empty integer
+        {0x02, 0x02, 0x00, 0x7F},       // non-minimal integer
+        {0x02, 0x02, 0xFF, 0x80},       // non-minimal negative integer
+        {0x06, 0x00},                   // empty object identifier
+        {0x06, 0x02, 0x2A, 0x86},       // truncated object identifier
+        {0x06, 0x03, 0x2A, 0x80, 0x01}, // non-minimal object identifier arc
+        {0x03, 0x01, 0x08},             // bit string unused bits
+        {0x1E, 0x01, 0x00}              // odd BMP string
+    };
+
+    for (const auto& encoded : malformed)
+    {
+        crypto::DerReader reader(encoded.data(), encoded.size());
+        EXPECT_THROW(reader.next(), FormatException) << testing::PrintToString(encoded);
+    }
+}
+
+TEST(DerReaderUT, derToLongSignExtendsAndReportsOverflowAsMinusOne)
+{
+    const auto value = [](const Bytes& content) {
+        const auto encoded = tlv(V_ASN1_INTEGER, content);
+        return crypto::derToLong(crypto::DerReader(encoded.data(), encoded.size()).next());
+    };
+
+    EXPECT_EQ(0, value({0x00}));
+    EXPECT_EQ(128, value({0x00, 0x80}));
+    EXPECT_EQ(-1, value({0xFF}));
+    EXPECT_EQ(-128, value({0x80}));
+    EXPECT_EQ(-256, value({0xFF, 0x00}));
+    EXPECT_EQ(std::numeric_limits<long>::min(), value({0x80, 0, 0, 0, 0, 0, 0, 0}));
+    EXPECT_EQ(-1, value({0x01, 0, 0, 0, 0, 0, 0, 0, 0}));
+}
+
+TEST(DerReaderUT, isChildOidMatchesEncodedArc)
+{
+    const auto encoded = concat({oid(oids::TCB_DER, sizeof(oids::TCB_DER), oids::CPUSVN_ARC),
+                                 oid(oids::SGX_EXTENSION_DER, sizeof(oids::SGX_EXTENSION_DER), oids::TCB_ARC),
+                                 tlv(V_ASN1_OCTET_STRING, Bytes(oids::TCB_DER, oids::TCB_DER + sizeof(oids::TCB_DER)))});
+    crypto::DerReader reader(encoded.data(), encoded.size());
+
+    uint8_t arc = 0;
+    EXPECT_TRUE(crypto::isChildOid(reader.next(), oids::TCB_DER, arc));
+    EXPECT_EQ(oids::CPUSVN_ARC, arc);
+
+    const auto tcb = reader.next();
+    EXPECT_FALSE(crypto::isChildOid(tcb, oids::TCB_DER, arc));
+    EXPECT_TRUE(crypto::isChildOid(tcb, oids::SGX_EXTENSION_DER, arc));
+    EXPECT_EQ(oids::TCB_ARC, arc);
+
+    EXPECT_FALSE(crypto::isChildOid(reader.next(), oids::SGX_EXTENSION_DER, arc));
+}
+
+TEST(DerReaderUT, sgxExtensionsDecodingIsEquivalentToOpenssl)
+{
+    std::mt19937 rng(20211);
+
+    for (const auto platform : {false, true})
+    {
+        const auto valid = sgxExtensions(rng, platform).encode();
+        ASSERT_TRUE(expectEquivalentDecoding(valid, platform));
+        DecodedSgxExtensions decoded;
+        ASSERT_EQ(Outcome::DECODED, decodeWithDerReader(valid, platform, decoded));
+    }
+}
+
+TEST(DerReaderUT, fuzzSgxExtensionsDecodingAgainstOpenssl)
+{
+    std::mt19937 rng(1337);
+    size_t compared = 0;
+    size_t decoded = 0;
+
+    for (int i = 0; i < 20000 && !HasFailure(); i++)
+    {
+        const bool platform = i % 2 == 1;
+        auto tree = sgxExtensions(rng, platform);
+        const auto structuralMutations = std::uniform_int_distribution<int>(0, 2)(rng);
+        for (int m = 0; m < structuralMutations; m++)
+        {
+            mutateStructure(rng, tree);
+        }
+
+        auto encoded = tree.encode();
+        const auto byteMutations = std::uniform_int_distribution<int>(0, 2)(rng);
+        for (int m = 0; m < byteMutations && !encoded.empty(); m++)
+        {
+            mutateBytes(rng, encoded);
+        }
+
+        for (const auto asPlatform : {false, true})
+        {
+            if (expectEquivalentDecoding(encoded, asPlatform))
+            {
+                compared++;
+                DecodedSgxExtensions ignored;
+                decoded += decodeWithDerReader(encoded, asPlatform, ignored) == Outcome::DECODED ? 1 : 0;
+            }
+            if (HasFailure())
+            {
+                ADD_FAILURE() << "Input: " << testing::PrintToString(encoded) << " platform: " << asPlatform;
+                break;
+            }
+        }
+    }
+
+    RecordProperty("comparedInputs", std::to_string(compared));
+    RecordProperty("decodedInputs", std::to_string(decoded));
+    EXPECT_GT(compared, 30000u);
+    EXPECT_GT(decoded, 1000u);
+}
@@ -34,6 +34,9 @@
 
 #include <gtest/gtest.h>
 
+#include <thread>
+#include <vector>
+
 using namespace intel::sgx::dcap::parser::x509;
 using namespace intel::sgx::dcap::parser;
 using namespace ::testing;
@@ -77,4 +80,62 @@ TEST_F(DistinguishedNameUT, distinguishedNameOperators)
                                                                ORGANIZATION_NAME_ISSUER, "dummy"));
     ASSERT_NE(distinguishedNameIssuer, createDistinguishedName(RAW_ISSUER, COMMON_NAME_ISSUER, COUNTRY_NAME_ISSUER,
                                                                ORGANIZATION_NAME_ISSUER, LOCATION_NAME_ISSUER, "dummy"));
-}
\ No newline at end of file
+}
+
+TEST_F(DistinguishedNameUT, equalDistinguishedNamesHaveEqualHashes)
+{
+    const auto distinguishedName = createDistinguishedName();
+    const auto sameComponents = createDistinguishedName("dummy");
+
+    ASSERT_EQ(distinguishedName.getHash(), sameComponents.getHash());
+    ASSERT_EQ("dummy", sameComponents.getRaw());
+    ASSERT_EQ(DistinguishedName(), DistinguishedName("", "", "", "", "", ""));
+    ASSERT_EQ(DistinguishedName().getHash(), DistinguishedName("", "", "", "", "", "").getHash());
+}
+
+TEST_F(DistinguishedNameUT, componentsAreNotInterchangeable)
+{
+    ASSERT_NE(DistinguishedName("", "A", "B", "", "", ""), DistinguishedName("", "B", "A", "", "", ""));
+    ASSERT_NE(DistinguishedName("", "AB", "", "", "", ""), DistinguishedName("", "A", "B", "", "", ""));
+}
+
+TEST_F(DistinguishedNameUT, copiedDistinguishedNameKeepsHash)
+{
+    const auto distinguishedName = createDistinguishedName();
+    const auto copy = distinguishedName;
+
+    ASSERT_EQ(distinguishedName.getHash(), copy.getHash());
+    ASSERT_EQ(distinguishedName, copy);
+}
+
+TEST_F(DistinguishedNameUT, distinguishedNamesCreatedConcurrentlyAreEqual)
+{
+    std::vector<DistinguishedName> names(8);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+        threads.emplace_back([&names, i]() { names[i] = DistinguishedName("", "Concurrent CN", "US", "O", "L", "S"); });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (const auto& name : names)
+    {
+        ASSERT_EQ(names.front(), name);
+        ASSERT_NE(DistinguishedName("", "Concurrent CN", "US", "O", "L", ""), name);
+    }
+}
+
+TEST_F(DistinguishedNameUT, distinguishedNamesAreComparedWhenNameTableIsFull)
+{
+    // more distinct names than the table holds, the later ones fall back to comparing components
+    for (int i = 0; i < 5000; ++i)
+    {
+        const auto name = std::to_string(i);
+        ASSERT_EQ(DistinguishedName("", name, "", "", "", ""), DistinguishedName("raw", name, "", "", "", ""));
+        ASSERT_NE(DistinguishedName("", name, "", "", "", ""), DistinguishedName("", name, "", "", "", "x"));
+    }
+    ASSERT_EQ(createDistinguishedName(), createDistinguishedName("dummy"));
+}
@@ -259,3 +259,55 @@ TEST_F(JsonParserTests, getIntFieldOfShouldThrowFormatExceptionWhenParentIsNotAn
         EXPECT_EQ("Fields can only be get from objects. Parent should be an object", std::string(ex.what()));
     }
 }
+
+TEST_F(JsonParserTests, shouldParseOnlyGivenLengthOfBuffer)
+{
+    const std::string json = R"json({"data": {"v": "text"}}trailing garbage)json";
+    ASSERT_TRUE(jsonParser.parse(json.data(), json.find('}') + 2));
+    const auto data = jsonParser.getField("data");
+    ASSERT_NE(nullptr, data);
+    const auto value = jsonParser.getStringFieldOf(*data, "v");
+    EXPECT_EQ(JsonParser::OK, value.second);
+    EXPECT_EQ("text", value.first);
+}
+
+TEST_F(JsonParserTests, shouldFailWhenParsingEmptyBuffer)
+{
+    EXPECT_FALSE(jsonParser.parse(nullptr, 0));
+    EXPECT_FALSE(jsonParser.parse("{}", 0));
+}
+
+TEST_F(JsonParserTests, jsonFieldsShouldFindFieldsInAnyOrder)
+{
+    constexpr std::array<const char*, 3> names = {{"first", "second", "third"}};
+    ASSERT_TRUE(jsonParser.parse(R"json({"third": 3, "unknown": 0, "first": 1})json"));
+    const JsonFields<names.size()> fields(*jsonParser.getRoot(), names);
+    EXPECT_EQ(1u, jsonParser.getUintField(fields[0]).first);
+    EXPECT_EQ(JsonParser::Missing, jsonParser.getUintField(fields[1]).second);
+    EXPECT_EQ(3u, jsonParser.getUintField(fields[2]).first);
+}
+
+TEST_F(JsonParserTests, jsonFieldsShouldTakeFirstOccurrenceOfDuplicatedField)
+{
+    constexpr std::array<const char*, 2> names = {{"v", "w"}};
+    ASSERT_TRUE(jsonParser.parse(R"json({"v": 1, "w": 2, "v": 3})json"));
+    const JsonFields<names.size()> fields(*jsonParser.getRoot(), names);
+    EXPECT_EQ(1u, jsonParser.getUintField(fields[0]).first);
+    EXPECT_EQ(jsonParser.getUintFieldOf(*jsonParser.getRoot(), "v").first, jsonParser.getUintField(fields[0]).first);
+}
+
+TEST_F(JsonParserTests, jsonFieldsShouldNotMatchFieldNamePrefixes)
+{
+    constexpr std::array<const char*, 1> names = {{"value"}};
+    ASSERT_TRUE(jsonParser.parse(R"json({"val": 1, "values": 2})json"));
+    const JsonFields<names.size()> fields(*jsonParser.getRoot(), names);
+    EXPECT_EQ(nullptr, fields[0]);
+}
+
+TEST_F(JsonParserTests, jsonFieldsShouldReportMissingFieldsWhenValueIsNotAnObject)
+{
+    constexpr std::array<const char*, 1> names = {{"parent"}};
+    ASSERT_TRUE(jsonParser.parse(R"json({"parent": "test"})json"));
+    const JsonFields<names.size()> fields(*jsonParser.getField("parent"), names);
+    EXPECT_EQ(nullptr, fields[0]);
+}
@@ -0,0 +1,268 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "TcbInfoGenerator.h"
+#include "SgxEcdsaAttestation/AttestationParsers.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+using namespace testing;
+using namespace intel::sgx::dcap;
+
+namespace {
+
+std::string withPceSvn(std::string tcb, const std::string& pceSvn)
+{
+    const std::string defaultPceSvn = R"("pcesvn": 30865)";
+    return tcb.replace(tcb.find(defaultPceSvn), defaultPceSvn.size(), R"("pcesvn": )" + pceSvn);
+}
+
+std::string generateTcbLevels(const std::string& tcb, bool v3)
+{
+    const auto generate = v3 ? &TcbInfoGenerator::generateTcbLevelV3 : &TcbInfoGenerator::generateTcbLevelV2;
+    return generate(validTcbLevelV2Template, tcb, R"("tcbStatus": "UpToDate")", R"("tcbDate": "2019-05-23T10:36:02Z")",
+                    R"("advisoryIDs": ["INTEL-SA-00079","INTEL-SA-00076"])") + "," +
+           generate(validTcbLevelV2Template, withPceSvn(tcb, "5"), R"("tcbStatus": "OutOfDate")",
+                    R"("tcbDate": "2018-01-01T00:00:00Z")", R"("advisoryIDs": ["INTEL-SA-00079"])") + "," +
+           generate(validTcbLevelV2Template, withPceSvn(tcb, "1"), R"("tcbStatus": "Revoked")",
+                    R"("tcbDate": "2017-01-01T00:00:00Z")", R"("advisoryIDs": [])");
+}
+
+void expectSameComponents(const std::vector<parser::json::TcbComponent>& expected,
+                          const std::vector<parser::json::TcbComponent>& actual)
+{
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+        EXPECT_EQ(expected[i].getSvn(), actual[i].getSvn());
+        EXPECT_EQ(expected[i].getCategory(), actual[i].getCategory());
+        EXPECT_EQ(expected[i].getType(), actual[i].getType());
+    }
+}
+
+void expectSameTcbInfo(const parser::json::TcbInfo& expected, const parser::json::TcbInfo& actual)
+{
+    EXPECT_EQ(expected.getVersion(), actual.getVersion());
+    if (expected.getVersion() >= 3)
+    {
+        EXPECT_EQ(expected.getId(), actual.getId());
+    }
+    EXPECT_EQ(expected.getIssueDate(), actual.getIssueDate());
+    EXPECT_EQ(expected.getNextUpdate(), actual.getNextUpdate());
+    EXPECT_EQ(expected.getFmspc(), actual.getFmspc());
+    EXPECT_EQ(expected.getPceId(), actual.getPceId());
+    EXPECT_EQ(expected.getSignature(), actual.getSignature());
+    EXPECT_EQ(expected.getInfoBody(), actual.getInfoBody());
+    EXPECT_EQ(expected.getTcbType(), actual.getTcbType());
+    EXPECT_EQ(expected.getTcbEvaluationDataNumber(), actual.getTcbEvaluationDataNumber());
+
+    ASSERT_EQ(expected.getTcbLevels().size(), actual.getTcbLevels().size());
+    auto actualLevel = actual.getTcbLevels().cbegin();
+    for (const auto& expectedLevel : expected.getTcbLevels())
+    {
+        EXPECT_EQ(expectedLevel.getCpuSvn(), actualLevel->getCpuSvn());
+        EXPECT_EQ(expectedLevel.getPceSvn(), actualLevel->getPceSvn());
+        EXPECT_EQ(expectedLevel.getStatus(), actualLevel->getStatus());
+        EXPECT_EQ(expectedLevel.getTcbDate(), actualLevel->getTcbDate());
+        EXPECT_EQ(expectedLevel.getAdvisoryIDs(), actualLevel->getAdvisoryIDs());
+        if (expected.getVersion() >= 3)
+        {
+            expectSameComponents(expectedLevel.getSgxTcbComponents(), actualLevel->getSgxTcbComponents());
+            if (expected.getId() == parser::json::TcbInfo::TDX_ID)
+            {
+                expectSameComponents(expectedLevel.getTdxTcbComponents(), actualLevel->getTdxTcbComponents());
+            }
+        }
+        ++actualLevel;
+    }
+}
+
+} // anonymous namespace
+
+struct TcbInfoBlobUT : public Test
+{
+    const std::string tcbInfoV2Json = TcbInfoGenerator::generateTcbInfo(validTcbInfoV2Template, generateTcbLevels(validSgxTcb, false));
+    const std::string sgxTcbInfoV3Json = TcbInfoGenerator::generateTcbInfo(validSgxTcbInfoV3Template, generateTcbLevels(validSgxTcbV3, true));
+    const std::string tdxTcbInfoV3Json = TcbInfoGenerator::generateTcbInfo(validTdxTcbInfoV3Template, generateTcbLevels(validTdxTcbV3, true));
+};
+
+TEST_F(TcbInfoBlobUT, shouldRebuildTheSameTcbInfoV2)
+{
+    const auto tcbInfo = parser::json::TcbInfo::parse(tcbInfoV2Json);
+    ASSERT_EQ(3, tcbInfo.getTcbLevels().size());
+
+    const auto blob = parser::json::TcbInfoBlob::load(parser::json::TcbInfoBlob::compile(tcbInfo));
+
+    expectSameTcbInfo(tcbInfo, blob.toTcbInfo());
+}
+
+TEST_F(TcbInfoBlobUT, shouldRebuildTheSameSgxTcbInfoV3)
+{
+    const auto tcbInfo = parser::json::TcbInfo::parse(sgxTcbInfoV3Json);
+
+    const auto blob = parser::json::TcbInfoBlob::load(parser::json::TcbInfoBlob::compile(tcbInfo));
+
+    expectSameTcbInfo(tcbInfo, blob.toTcbInfo());
+}
+
+TEST_F(TcbInfoBlobUT, shouldRebuildTheSameTdxTcbInfoV3)
+{
+    const auto tcbInfo = parser::json::TcbInfo::parse(tdxTcbInfoV3Json);
+
+    const auto blob = parser::json::TcbInfoBlob::load(parser::json::TcbInfoBlob::compile(tcbInfo));
+    const auto rebuilt = blob.toTcbInfo();
+
+    expectSameTcbInfo(tcbInfo, rebuilt);
+    EXPECT_EQ(tcbInfo.getTdxModule().getMrSigner(), rebuilt.getTdxModule().getMrSigner());
+    EXPECT_EQ(tcbInfo.getTdxModule().getAttributes(), rebuilt.getTdxModule().getAttributes());
+    EXPECT_EQ(tcbInfo.getTdxModule().getAttributesMask(), rebuilt.getTdxModule().getAttributesMask());
+}
+
+TEST_F(TcbInfoBlobUT, shouldRebuildTcbInfoOnceAndShareItWithCopies)
+{
+    const auto tcbInfo = parser::json::TcbInfo::parse(sgxTcbInfoV3Json);
+
+    const auto blob = parser::json::TcbInfoBlob::load(parser::json::TcbInfoBlob::compile(tcbInfo));
+    const auto copy = blob;
+
+    std::vector<const parser::json::TcbInfo*> rebuilt(8, nullptr);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < rebuilt.size(); i++)
+    {
+        threads.emplace_back([&, i] { rebuilt[i] = &(i % 2 == 0 ? blob : copy).toTcbInfo(); });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(std::vector<const parser::json::TcbInfo*>(rebuilt.size(), &blob.toTcbInfo()), rebuilt);
+    expectSameTcbInfo(tcbInfo, copy.toTcbInfo());
+
+    const auto otherBlob = parser::json::TcbInfoBlob::load(parser::json::TcbInfoBlob::compile(tcbInfo));
+    EXPECT_NE(&blob.toTcbInfo(), &otherBlob.toTcbInfo());
+}
+
+TEST_F(TcbInfoBlobUT, accessorsShouldMatchParsedTcbInfo)
+{
+    const auto tcbInfo = parser::json::TcbInfo::parse(tdxTcbInfoV3Json);
+
+    const auto blob = parser::json::TcbInfoBlob::load(parser::json::TcbInfoBlob::compile(tcbInfo));
+
+    EXPECT_EQ(blob.getId(), parser::json::TcbInfo::TDX_ID);
+    EXPECT_EQ(blob.getVersion(), tcbInfo.getVersion());
+    EXPECT_EQ(blob.getFmspc(), tcbInfo.getFmspc());
+    EXPECT_EQ(blob.getPceId(), tcbInfo.getPceId());
+    EXPECT_EQ(blob.getTdxModule().getMrSigner(), DEFAULT_TDXMODULE_MRSIGNER);
+    ASSERT_EQ(blob.getTcbLevelCount(), tcbInfo.getTcbLevels().size());
+    size_t index = 0;
+    for (const auto& tcbLevel : tcbInfo.getTcbLevels())
+    {
+        const auto level = blob.getTcbLevel(index++);
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            EXPECT_EQ(level.getSgxTcbComponentSvn(i), tcbLevel.getSgxTcbComponentSvn(i));
+            EXPECT_EQ(level.getTdxTcbComponentSvn(i), tcbLevel.getTdxTcbComponent(i).getSvn());
+        }
+        EXPECT_EQ(level.getPceSvn(), tcbLevel.getPceSvn());
+        EXPECT_EQ(level.getStatus(), tcbLevel.getStatus());
+    }
+    EXPECT_THROW(blob.getTcbLevel(index), parser::FormatException);
+    EXPECT_THROW(blob.getTcbLevel(0).getSgxTcbComponentSvn(16), parser::FormatException);
+}
+
+TEST_F(TcbInfoBlobUT, shouldFailOnV3OnlyFieldsOfTcbInfoV2)
+{
+    const auto blob = parser::json::TcbInfoBlob::load(
+            parser::json::TcbInfoBlob::compile(parser::json::TcbInfo::parse(tcbInfoV2Json)));
+
+    EXPECT_THROW(blob.getId(), parser::FormatException);
+    EXPECT_THROW(blob.getTdxModule(), parser::FormatException);
+    EXPECT_THROW(blob.getTcbLevel(0).getSgxTcbComponents(), parser::FormatException);
+    EXPECT_THROW(blob.getTcbLevel(0).getTdxTcbComponentSvn(0), parser::FormatException);
+}
+
+TEST_F(TcbInfoBlobUT, shouldDropInfoBodyWhenNotKept)
+{
+    const auto tcbInfo = parser::json::TcbInfo::parse(sgxTcbInfoV3Json);
+
+    const auto withBody = parser::json::TcbInfoBlob::compile(tcbInfo);
+    const auto withoutBody = parser::json::TcbInfoBlob::compile(tcbInfo, false);
+
+    EXPECT_EQ(withBody.size(), withoutBody.size() + tcbInfo.getInfoBody().size());
+    EXPECT_TRUE(parser::json::TcbInfoBlob::load(withoutBody).getInfoBody().empty());
+}
+
+TEST_F(TcbInfoBlobUT, shouldRejectCorruptedBlob)
+{
+    const auto blob = parser::json::TcbInfoBlob::compile(parser::json::TcbInfo::parse(sgxTcbInfoV3Json));
+
+    auto badMagic = blob;
+    badMagic[0] ^= 0xFF;
+    EXPECT_THROW(parser::json::TcbInfoBlob::load(badMagic), parser::FormatException);
+
+    auto badVersion = blob;
+    badVersion[8] = 0xFF;
+    EXPECT_THROW(parser::json::TcbInfoBlob::load(badVersion), parser::FormatException);
+
+    const std::vector<uint8_t> truncated(blob.cbegin(), blob.cend() - 1);
+    EXPECT_THROW(parser::json::TcbInfoBlob::load(truncated), parser::FormatException);
+
+    const std::vector<uint8_t> headerOnly(blob.cbegin(), blob.cbegin() + 100);
+    EXPECT_THROW(parser::json::TcbInfoBlob::load(headerOnly), parser::FormatException);
+
+    // status reference of the first TCB Level pointing outside of the blob
+    auto badReference = blob;
+    const size_t firstLevelStatus = 208 + 48;
+    badReference[firstLevelStatus + 3] = 0x7F;
+    EXPECT_THROW(parser::json::TcbInfoBlob::load(badReference), parser::FormatException);
+}
+
+TEST_F(TcbInfoBlobUT, shouldMapCompiledFile)
+{
+    const auto tcbInfo = parser::json::TcbInfo::parse(tdxTcbInfoV3Json);
+    const auto compiled = parser::json::TcbInfoBlob::compile(tcbInfo);
+    const auto path = TempDir() + "TcbInfoBlobUT.bin";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(compiled.data()), static_cast<std::streamsize>(compiled.size()));
+    }
+
+    const auto blob = parser::json::TcbInfoBlob::map(path);
+    std::remove(path.c_str());
+
+    expectSameTcbInfo(tcbInfo, blob.toTcbInfo());
+    EXPECT_THROW(parser::json::TcbInfoBlob::map(path), parser::FormatException);
+}
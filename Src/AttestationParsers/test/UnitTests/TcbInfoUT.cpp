@@ -215,6 +215,7 @@ TEST_F(TcbInfoUT, shouldSuccessfullyParseMultipleTcbLevels)
     }
     EXPECT_EQ(expectedPcesvn, iterator->getPceSvn());
     EXPECT_EQ("UpToDate", iterator->getStatus());
+    EXPECT_EQ(parser::json::TcbStatus::UpToDate, iterator->getTcbStatus());
     std::advance(iterator, 2);
     for (uint32_t i=0; i<constants::CPUSVN_BYTE_LEN; i++)
     {
@@ -222,6 +223,50 @@ TEST_F(TcbInfoUT, shouldSuccessfullyParseMultipleTcbLevels)
     }
     EXPECT_EQ(expectedRevokedPcesvn, iterator->getPceSvn());
     EXPECT_EQ("Revoked", iterator->getStatus());
+    EXPECT_EQ(parser::json::TcbStatus::Revoked, iterator->getTcbStatus());
+}
+
+TEST_F(TcbInfoUT, shouldDecodeTcbStatusOnceWhenTcbLevelIsCreated)
+{
+    const std::vector<uint8_t> cpuSvn(constants::CPUSVN_BYTE_LEN, 0);
+    const std::vector<std::pair<std::string, parser::json::TcbStatus>> statuses = {
+        {"UpToDate", parser::json::TcbStatus::UpToDate},
+        {"SWHardeningNeeded", parser::json::TcbStatus::SWHardeningNeeded},
+        {"ConfigurationNeeded", parser::json::TcbStatus::ConfigurationNeeded},
+        {"ConfigurationAndSWHardeningNeeded", parser::json::TcbStatus::ConfigurationAndSWHardeningNeeded},
+        {"OutOfDate", parser::json::TcbStatus::OutOfDate},
+        {"OutOfDateConfigurationNeeded", parser::json::TcbStatus::OutOfDateConfigurationNeeded},
+        {"Revoked", parser::json::TcbStatus::Revoked}
+    };
+    for (const auto& status : statuses)
+    {
+        const parser::json::TcbLevel tcbLevel(cpuSvn, 1, status.first);
+        EXPECT_EQ(status.second, tcbLevel.getTcbStatus());
+        EXPECT_EQ(status.first, tcbLevel.getStatus());
+    }
+
+    const parser::json::TcbLevel unknown(cpuSvn, 1, "Unknown");
+    EXPECT_EQ(parser::json::TcbStatus::Unrecognized, unknown.getTcbStatus());
+    EXPECT_EQ("Unknown", unknown.getStatus());
+
+    const parser::json::TcbLevel unknownV3("SGX", {}, {}, 1, "Unknown");
+    EXPECT_EQ(parser::json::TcbStatus::Unrecognized, unknownV3.getTcbStatus());
+    EXPECT_EQ("Unknown", unknownV3.getStatus());
+
+    const auto copied = unknownV3;
+    EXPECT_EQ("Unknown", copied.getStatus());
+}
+
+TEST_F(TcbInfoUT, shouldStoreEachUnrecognizedTcbStatusOnce)
+{
+    const std::vector<uint8_t> cpuSvn(constants::CPUSVN_BYTE_LEN, 0);
+    const parser::json::TcbLevel first(cpuSvn, 1, "NotAStatus");
+    const parser::json::TcbLevel second("SGX", {}, {}, 2, "NotAStatus");
+    const parser::json::TcbLevel other(cpuSvn, 1, "NotAStatusEither");
+
+    EXPECT_EQ(&first.getStatus(), &second.getStatus());
+    EXPECT_EQ("NotAStatus", second.getStatus());
+    EXPECT_EQ("NotAStatusEither", other.getStatus());
 }
 
 TEST_F(TcbInfoUT, shouldSuccessfullyParseMultipleRevokedTcbLevels)
@@ -32,10 +32,14 @@
 #include "TcbInfoGenerator.h"
 #include "SgxEcdsaAttestation/AttestationParsers.h"
 #include "X509Constants.h"
+#include <Utils/JsonText.h>
 #include <Utils/TimeUtils.h>
 
 #include <gtest/gtest.h>
 #include "rapidjson/document.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
 
 using namespace testing;
 using namespace intel::sgx::dcap;
@@ -44,6 +48,46 @@ struct TcbInfoV3UT : public Test
 {
 };
 
+namespace {
+
+std::string serialize(const rapidjson::Value& value)
+{
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    writer.SetMaxDecimalPlaces(25);
+    value.Accept(writer);
+    return std::string(buffer.GetString(), buffer.GetSize());
+}
+
+std::string compact(const std::string& json)
+{
+    rapidjson::Document document;
+    document.Parse(json.c_str());
+    return serialize(document);
+}
+
+std::string serializedTcbInfo(const std::string& json)
+{
+    rapidjson::Document document;
+    document.Parse(json.c_str());
+    return serialize(document["tcbInfo"]);
+}
+
+std::string tdxTcbLevels(size_t count)
+{
+    std::string levels;
+    for (size_t i = 0; i < count; i++)
+    {
+        auto tcb = std::string(validTdxTcbV3);
+        const std::string defaultPceSvn = R"("pcesvn": 30865)";
+        tcb.replace(tcb.find(defaultPceSvn), defaultPceSvn.size(), R"("pcesvn": )" + std::to_string(i + 1));
+        levels += (i == 0 ? "" : ",") + TcbInfoGenerator::generateTcbLevelV3(validTcbLevelV3Template, tcb);
+    }
+    return levels;
+}
+
+} // anonymous namespace
+
 void expectCommonDefaultTcbInfo(const parser::json::TcbInfo& tcbInfo)
 {
     EXPECT_EQ(tcbInfo.getPceId(), DEFAULT_PCEID);
@@ -1157,4 +1201,25 @@ TEST_F(TcbInfoV3UT, shouldFailWhenTcbHasInvalidFormat)
     {
         EXPECT_EQ(std::string(err.what()), "TCB level JSON [tcb] field should be an object");
     }
-}
\ No newline at end of file
+}
+TEST_F(TcbInfoV3UT, shouldTakeInfoBodyFromCompactInputAsIs)
+{
+    const auto tcbInfoJson = compact(TcbInfoGenerator::generateTcbInfo(validTdxTcbInfoV3Template, tdxTcbLevels(3)));
+
+    const auto tcbInfo = parser::json::TcbInfo::parse(tcbInfoJson);
+
+    const auto expected = serializedTcbInfo(tcbInfoJson);
+    EXPECT_NE(std::string::npos, tcbInfoJson.find(expected));
+    EXPECT_EQ(std::vector<uint8_t>(expected.begin(), expected.end()), tcbInfo.getInfoBody());
+}
+
+TEST_F(TcbInfoV3UT, shouldSerializeInfoBodyWhenInputIsNotCompact)
+{
+    const auto tcbInfoJson = TcbInfoGenerator::generateTcbInfo(validTdxTcbInfoV3Template, tdxTcbLevels(3));
+
+    const auto tcbInfo = parser::json::TcbInfo::parse(tcbInfoJson);
+
+    const auto expected = serializedTcbInfo(tcbInfoJson);
+    EXPECT_EQ(std::string::npos, tcbInfoJson.find(expected));
+    EXPECT_EQ(std::vector<uint8_t>(expected.begin(), expected.end()), tcbInfo.getInfoBody());
+}
@@ -0,0 +1,274 @@
+/*
+ * Copyright (C) 2011-2021 Intel Corporation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in
+ *     the documentation and/or other materials provided with the
+ *     distribution.
+ *   * Neither the name of Intel Corporation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ */
+
+#include "TcbInfoGenerator.h"
+#include "Json/TcbLevelMatcher.h"
+#include "SgxEcdsaAttestation/AttestationParsers.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <random>
+#include <thread>
+
+using namespace testing;
+using namespace intel::sgx::dcap;
+
+namespace {
+
+using TcbLevels = std::set<parser::json::TcbLevel, std::greater<parser::json::TcbLevel>>;
+using Svns = std::array<uint8_t, 16>;
+
+std::vector<parser::json::TcbComponent> toComponents(const Svns& svns)
+{
+    return std::vector<parser::json::TcbComponent>(svns.cbegin(), svns.cend());
+}
+
+Svns randomSvns(std::mt19937& random)
+{
+    // narrow range, so generated platforms land both below and above generated levels
+    std::uniform_int_distribution<int> svn(0, 4);
+    Svns svns{};
+    for (auto& value : svns)
+    {
+        value = static_cast<uint8_t>(svn(random));
+    }
+    return svns;
+}
+
+TcbLevels generateTdxTcbLevels(std::mt19937& random, size_t count)
+{
+    std::uniform_int_distribution<uint32_t> pceSvn(0, 15);
+    TcbLevels tcbLevels;
+    while (tcbLevels.size() < count)
+    {
+        tcbLevels.emplace(parser::json::TcbInfo::TDX_ID, toComponents(randomSvns(random)), toComponents(randomSvns(random)),
+                          pceSvn(random), "UpToDate");
+    }
+    return tcbLevels;
+}
+
+// Reference implementation walking TCB Levels through their getters
+const parser::json::TcbLevel* findLinear(const TcbLevels& tcbLevels, const Svns& sgxSvns, uint32_t pceSvn, const Svns* teeTcbSvn)
+{
+    for (const auto& tcbLevel : tcbLevels)
+    {
+        bool higherOrEqual = pceSvn >= tcbLevel.getPceSvn();
+        for (uint32_t i = 0; higherOrEqual && i < 16; i++)
+        {
+            higherOrEqual = sgxSvns[i] >= tcbLevel.getSgxTcbComponentSvn(i) &&
+                            (teeTcbSvn == nullptr || (*teeTcbSvn)[i] >= tcbLevel.getTdxTcbComponent(i).getSvn());
+        }
+        if (higherOrEqual)
+        {
+            return &tcbLevel;
+        }
+    }
+    return nullptr;
+}
+
+} // anonymous namespace
+
+struct TcbLevelMatcherUT : public Test
+{
+    std::mt19937 random{20240607};
+};
+
+TEST_F(TcbLevelMatcherUT, shouldSelectTheSameLevelAsLinearWalk)
+{
+    const auto tcbLevels = generateTdxTcbLevels(random, 64);
+    const parser::json::TcbLevelMatcher matcher(tcbLevels, true);
+    ASSERT_EQ(matcher.size(), tcbLevels.size());
+
+    std::uniform_int_distribution<uint32_t> pceSvn(0, 15);
+    size_t matched = 0;
+    for (int i = 0; i < 5000; i++)
+    {
+        auto sgxSvns = randomSvns(random);
+        auto teeTcbSvn = randomSvns(random);
+        for (auto& value : sgxSvns) { value = static_cast<uint8_t>(value + 1); }
+        for (auto& value : teeTcbSvn) { value = static_cast<uint8_t>(value + 1); }
+        const auto platformPceSvn = pceSvn(random);
+
+        const auto expected = findLinear(tcbLevels, sgxSvns, platformPceSvn, &teeTcbSvn);
+        EXPECT_EQ(expected, matcher.match(sgxSvns.data(), platformPceSvn, teeTcbSvn.data()));
+        EXPECT_EQ(findLinear(tcbLevels, sgxSvns, platformPceSvn, nullptr),
+                  matcher.match(sgxSvns.data(), platformPceSvn, nullptr));
+        matched += expected != nullptr ? 1 : 0;
+    }
+    // both outcomes have to be covered
+    EXPECT_GT(matched, 0u);
+    EXPECT_LT(matched, 5000u);
+}
+
+TEST_F(TcbLevelMatcherUT, shouldCompareSvnsAsUnsigned)
+{
+    Svns levelSvns{};
+    levelSvns[3] = 0x80;
+    const TcbLevels tcbLevels{parser::json::TcbLevel{std::vector<uint8_t>(levelSvns.cbegin(), levelSvns.cend()), 2, "UpToDate"}};
+    const parser::json::TcbLevelMatcher matcher(tcbLevels, false);
+
+    Svns platform{};
+    platform[3] = 0x7F;
+    EXPECT_EQ(nullptr, matcher.match(platform.data(), 2, nullptr));
+    platform[3] = 0xFF;
+    EXPECT_EQ(&*tcbLevels.begin(), matcher.match(platform.data(), 2, nullptr));
+    EXPECT_EQ(nullptr, matcher.match(platform.data(), 1, nullptr));
+}
+
+TEST_F(TcbLevelMatcherUT, shouldRejectLevelWithInvalidCpuSvn)
+{
+    const TcbLevels tcbLevels{parser::json::TcbLevel{std::vector<uint8_t>(15, 0), 2, "UpToDate"}};
+
+    EXPECT_THROW(parser::json::TcbLevelMatcher(tcbLevels, false), parser::FormatException);
+}
+
+TEST_F(TcbLevelMatcherUT, tcbInfoShouldFindLevelAndKeepItAfterCopy)
+{
+    auto outOfDateLevel = TcbInfoGenerator::generateTcbLevelV3(validTcbLevelV3Template, validTdxTcbV3, R"("tcbStatus": "OutOfDate")");
+    const std::string defaultPceSvn = R"("pcesvn": 30865)";
+    outOfDateLevel.replace(outOfDateLevel.find(defaultPceSvn), defaultPceSvn.size(), R"("pcesvn": 1)");
+    const auto tcbLevels = TcbInfoGenerator::generateTcbLevelV3(validTcbLevelV3Template, validTdxTcbV3) + "," + outOfDateLevel;
+    const auto original = parser::json::TcbInfo::parse(TcbInfoGenerator::generateTcbInfo(validTdxTcbInfoV3Template, tcbLevels));
+    ASSERT_EQ(2, original.getTcbLevels().size());
+
+    const auto sgxSvns = original.getTcbLevels().begin()->getCpuSvn();
+    Svns teeTcbSvn{};
+    teeTcbSvn.fill(0xFF);
+
+    const auto upToDate = original.findTcbLevel(sgxSvns.data(), 30865, teeTcbSvn.data());
+    ASSERT_NE(nullptr, upToDate);
+    EXPECT_EQ("UpToDate", upToDate->getStatus());
+    const auto outOfDate = original.findTcbLevel(sgxSvns.data(), 30864, teeTcbSvn.data());
+    ASSERT_NE(nullptr, outOfDate);
+    EXPECT_EQ("OutOfDate", outOfDate->getStatus());
+    teeTcbSvn.fill(0);
+    EXPECT_EQ(nullptr, original.findTcbLevel(sgxSvns.data(), 30865, teeTcbSvn.data()));
+    EXPECT_EQ(upToDate, original.findTcbLevel(sgxSvns.data(), 30865, nullptr));
+
+    // copy has to point to its own levels, not to the levels of the original
+    const auto copy = original;
+    const auto copied = copy.findTcbLevel(sgxSvns.data(), 30865, nullptr);
+    ASSERT_NE(nullptr, copied);
+    EXPECT_EQ(&*copy.getTcbLevels().begin(), copied);
+}
+
+TEST_F(TcbLevelMatcherUT, shouldRememberSelectedLevelPerPlatform)
+{
+    const auto tcbLevels = generateTdxTcbLevels(random, 16);
+    const parser::json::TcbLevelMatcher matcher(tcbLevels, true);
+    Svns sgxSvns{};
+    sgxSvns.fill(4);
+    Svns teeTcbSvn{};
+    teeTcbSvn.fill(4);
+
+    const auto expected = matcher.match(sgxSvns.data(), 10, teeTcbSvn.data());
+    ASSERT_NE(nullptr, expected);
+    EXPECT_EQ(expected, matcher.matchMemoized(sgxSvns.data(), 10, teeTcbSvn.data()));
+    EXPECT_EQ(expected, matcher.matchMemoized(sgxSvns.data(), 10, teeTcbSvn.data()));
+
+    // any part of the key makes a different platform
+    EXPECT_EQ(nullptr, matcher.matchMemoized(sgxSvns.data(), 10, Svns{}.data()));
+    EXPECT_EQ(matcher.match(sgxSvns.data(), 11, teeTcbSvn.data()), matcher.matchMemoized(sgxSvns.data(), 11, teeTcbSvn.data()));
+    EXPECT_EQ(matcher.match(sgxSvns.data(), 10, nullptr), matcher.matchMemoized(sgxSvns.data(), 10, nullptr));
+    EXPECT_EQ(expected, matcher.matchMemoized(sgxSvns.data(), 10, teeTcbSvn.data()));
+}
+
+TEST_F(TcbLevelMatcherUT, tcbInfoShouldEvaluateRememberedLevelOnEveryCall)
+{
+    const auto original = parser::json::TcbInfo::parse(TcbInfoGenerator::generateTcbInfo(validSgxTcbInfoV3Template,
+            TcbInfoGenerator::generateTcbLevelV3(validTcbLevelV3Template, validSgxTcbV3)));
+    const auto sgxSvns = original.getTcbLevels().begin()->getCpuSvn();
+    int calls = 0;
+    const auto evaluate = [&calls](const parser::json::TcbLevel* tcbLevel) {
+        ++calls;
+        return tcbLevel;
+    };
+
+    EXPECT_EQ(&*original.getTcbLevels().begin(), original.evaluateTcbLevel(sgxSvns.data(), 30865, nullptr, evaluate));
+    EXPECT_EQ(&*original.getTcbLevels().begin(), original.evaluateTcbLevel(sgxSvns.data(), 30865, nullptr, evaluate));
+    EXPECT_EQ(nullptr, original.evaluateTcbLevel(sgxSvns.data(), 0, nullptr, evaluate));
+    EXPECT_EQ(3, calls);
+
+    EXPECT_THROW(original.evaluateTcbLevel(sgxSvns.data(), 30865, nullptr, [](const parser::json::TcbLevel*) -> uint32_t {
+        throw parser::FormatException("evaluation failed");
+    }), parser::FormatException);
+}
+
+TEST_F(TcbLevelMatcherUT, tcbInfoCopyShouldNotShareRememberedLevel)
+{
+    const auto original = parser::json::TcbInfo::parse(TcbInfoGenerator::generateTcbInfo(validSgxTcbInfoV3Template,
+            TcbInfoGenerator::generateTcbLevelV3(validTcbLevelV3Template, validSgxTcbV3)));
+    const auto sgxSvns = original.getTcbLevels().begin()->getCpuSvn();
+    const auto selected = [](const parser::json::TcbLevel* tcbLevel) { return tcbLevel; };
+
+    EXPECT_EQ(&*original.getTcbLevels().begin(), original.evaluateTcbLevel(sgxSvns.data(), 30865, nullptr, selected));
+
+    const auto copy = original;
+    EXPECT_EQ(&*copy.getTcbLevels().begin(), copy.evaluateTcbLevel(sgxSvns.data(), 30865, nullptr, selected));
+    EXPECT_EQ(&*original.getTcbLevels().begin(), original.evaluateTcbLevel(sgxSvns.data(), 30865, nullptr, selected));
+}
+
+TEST_F(TcbLevelMatcherUT, concurrentMemoizedMatchingShouldReturnConsistentLevels)
+{
+    const auto tcbLevels = generateTdxTcbLevels(random, 32);
+    const parser::json::TcbLevelMatcher matcher(tcbLevels, true);
+
+    // more platforms than memo slots, so threads keep overwriting each other's slots
+    std::vector<Svns> platforms(parser::json::TcbLevelMatcher::MEMO_SLOTS * 2);
+    for (auto& platform : platforms)
+    {
+        platform = randomSvns(random);
+    }
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&, t] {
+            for (size_t i = 0; i < 20000; i++)
+            {
+                const auto& platform = platforms[(i * 7 + t) % platforms.size()];
+                const auto pceSvn = static_cast<uint32_t>(i % 16);
+                if (matcher.matchMemoized(platform.data(), pceSvn, platform.data()) !=
+                    matcher.match(platform.data(), pceSvn, platform.data()))
+                {
+                    ++mismatches;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(0, mismatches.load());
+}
@@ -38,4 +38,15 @@ Extension UnitTests::createExtension(X509_EXTENSION *ext)
     return Extension(ext);
 }
 
+void UnitTests::setPckCertificateMembers(PckCertificate& certificate, const std::vector<uint8_t>& sgxExtension)
+{
+    certificate.setMembers(sgxExtension.data(), sgxExtension.size());
+}
+
+void UnitTests::setPlatformPckCertificateMembers(PlatformPckCertificate& certificate, const std::vector<uint8_t>& sgxExtension)
+{
+    static_cast<PckCertificate&>(certificate).setMembers(sgxExtension.data(), sgxExtension.size());
+    certificate.setMembers(sgxExtension.data(), sgxExtension.size());
+}
+
 }}}}}
@@ -42,6 +42,8 @@ class UnitTests
 {
 public:
     static Extension createExtension(X509_EXTENSION *ext);
+    static void setPckCertificateMembers(PckCertificate& certificate, const std::vector<uint8_t>& sgxExtension);
+    static void setPlatformPckCertificateMembers(PlatformPckCertificate& certificate, const std::vector<uint8_t>& sgxExtension);
 };
 
 }}}}}